@@ -0,0 +1,41 @@
+# check save of columnar model reloads with same values
+
+proc compare_models { model1 model2 name } {
+  set nr [get_charts_data -model $model1 -name num_rows]
+  set nc [get_charts_data -model $model1 -name num_columns]
+
+  set nerr 0
+
+  for {set r 0} {$r < $nr} {incr r} {
+    for {set c 0} {$c < $nc} {incr c} {
+      set v1 [get_charts_data -model $model1 -row $r -column $c -name value]
+      set v2 [get_charts_data -model $model2 -row $r -column $c -name value]
+
+      if {$v1 != $v2} {
+        puts "$name mismatch row $r column $c : $v1 != $v2"
+
+        incr nerr
+      }
+    }
+  }
+
+  if {$nerr == 0} {
+    puts "$name round trip OK"
+  }
+}
+
+set model [load_charts_model -csv data/round_trip.csv -first_line_header -columnar]
+
+# csv (with meta data)
+export_charts_model -model $model -to csv -file /tmp/round_trip.csv
+
+set csvModel [load_charts_model -csv /tmp/round_trip.csv -first_line_header -columnar]
+
+compare_models $model $csvModel csv
+
+# tsv
+export_charts_model -model $model -to tsv -file /tmp/round_trip.tsv
+
+set tsvModel [load_charts_model -tsv /tmp/round_trip.tsv -first_line_header -columnar]
+
+compare_models $model $tsvModel tsv
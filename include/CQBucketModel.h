@@ -4,6 +4,7 @@
 #include <CQBucketer.h>
 #include <QAbstractProxyModel>
 #include <set>
+#include <vector>
 #include <cassert>
 
 /*!
@@ -45,7 +46,7 @@ class CQBucketModel : public QAbstractProxyModel {
 
   //! get/set bucket role
   int bucketRole() const { return bucketRole_; }
-  void setBucketRole(int i) { bucketRole_ = i; }
+  void setBucketRole(int i) { if (i != bucketRole_) { bucketRole_ = i; bucketValid_ = false; } }
 
   //! get/set bucket type
   const CQBucketer::Type &bucketType() const;
@@ -130,6 +131,8 @@ class CQBucketModel : public QAbstractProxyModel {
  private slots:
   void bucketSlot();
 
+  void dataChangedSlot(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+
  private:
   void doResetModel();
 
@@ -140,6 +143,9 @@ class CQBucketModel : public QAbstractProxyModel {
 
   int bucketPos() const { return bucketPos_; }
 
+  // get bucket of row (cached for top level rows)
+  int rowBucket(int r, const QModelIndex &parent) const;
+
   // clear model
   void clear();
 
@@ -153,6 +159,8 @@ class CQBucketModel : public QAbstractProxyModel {
   int unmapColumn(int c) const;
 
  private:
+  using RowBuckets = std::vector<int>;
+
   int        bucketColumn_ { 0 };               //!< bucket source model column
   int        bucketRole_   { Qt::DisplayRole }; //!< bucket role
   bool       multiColumn_  { false };           //!< use multiple columns for bucket values
@@ -160,6 +168,7 @@ class CQBucketModel : public QAbstractProxyModel {
   CQBucketer bucketer_;                         //!< bucketer
   bool       bucketed_     { false };           //!< is bucketer
   bool       bucketValid_  { false };           //!< is bucketer valid
+  RowBuckets rowBuckets_;                       //!< bucket of each top level row
 };
 
 #endif
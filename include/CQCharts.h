@@ -318,8 +318,9 @@ class CQCharts : public QObject {
 
   //---
 
-  const CQChartsExprTcl *currentExpr() const { return currentExpr_; }
-  void setCurrentExpr(CQChartsExprTcl *p) { currentExpr_ = p; }
+  //! current expression evaluator (per thread)
+  const CQChartsExprTcl *currentExpr() const;
+  void setCurrentExpr(CQChartsExprTcl *p);
 
   //---
 
@@ -373,7 +374,6 @@ class CQCharts : public QObject {
   CQChartsManageModelsDlg* manageModelsDlg_ { nullptr }; //!< manage models dialog
   CQChartsEditModelDlg*    editModelDlg_    { nullptr }; //!< edit model dialog
   CQChartsCreatePlotDlg*   createPlotDlg_   { nullptr }; //!< create plot dialog
-  CQChartsExprTcl*         currentExpr_     { nullptr }; //!< current expression evaluator
 };
 
 #endif
@@ -10,6 +10,11 @@ class CQChartsPaintDevice;
 /*!
  * \brief Bivariate (2D) density class
  * \ingroup Charts
+ *
+ * Density values are calculated for a grid of cells over the data range and cached
+ * so redraws (pan/zoom) only need to colorize the cached grid into an image.
+ * The grid is recalculated if the data is invalidated, the grid size changes or the
+ * number of grid cells for the current pixel size changes significantly.
  */
 class CQChartsBivariateDensity {
  public:
@@ -32,7 +37,28 @@ class CQChartsBivariateDensity {
  public:
   CQChartsBivariateDensity() { }
 
+  //! invalidate cached grid (data changed)
+  void invalidate() { grid_.valid = false; }
+
   void draw(const Plot *plot, PaintDevice *device, const Data &data);
+
+ private:
+  void calcGrid(const Data &data, int nx, int ny);
+
+ private:
+  using Reals = std::vector<float>;
+
+  //! cached grid values
+  struct Grid {
+    bool  valid    { false }; //!< is valid
+    int   gridSize { 0 };     //!< grid size (pixels) used for calc
+    int   nx       { 0 };     //!< number of x cells
+    int   ny       { 0 };     //!< number of y cells
+    BBox  bbox;               //!< data range
+    Reals values;             //!< cell values (row major from ymin)
+  };
+
+  Grid grid_; //!< cached grid
 };
 
 #endif
@@ -4,6 +4,7 @@
 #include <CQChartsDensity.h>
 #include <CQChartsUtil.h>
 #include <CQStatData.h>
+#include <CQChartsSortedValues.h>
 #include <QString>
 #include <cassert>
 #include <vector>
@@ -17,9 +18,10 @@
 template<typename VALUE>
 class CQChartsBoxWhiskerT {
  public:
-  using Values   = std::vector<VALUE>;
-  using Outliers = std::vector<int>;
-  using Density  = CQChartsDensity;
+  using Values         = std::vector<VALUE>;
+  using Outliers       = std::vector<int>;
+  using Density        = CQChartsDensity;
+  using SortedValuesFn = CQChartsSortedValuesFn;
 
  public:
   CQChartsBoxWhiskerT() { }
@@ -72,6 +74,9 @@ class CQChartsBoxWhiskerT {
   double fraction() const { return fraction_; }
   void setFraction(double r) { fraction_ = r; invalidate(); }
 
+  //! set function to get (shared) sorted values for values
+  void setSortedValuesFn(const SortedValuesFn &fn) { sortedValuesFn_ = fn; invalidate(); }
+
   //---
 
   double min() const { return statData().min; }
@@ -137,24 +142,43 @@ class CQChartsBoxWhiskerT {
     if (values_.empty())
       return;
 
-    std::sort(values_.begin(), values_.end());
+    // use shared sorted values (stats) and reorder values to sorted order
+    if (sortedValuesFn_) {
+      std::vector<double> rvalues;
 
-    //---
+      rvalues.reserve(values_.size());
 
-    statData_.calcStatValues(values_);
+      for (const auto &v : values_)
+        rvalues.push_back(double(v));
 
-    //---
+      auto sortedValues = sortedValuesFn_(rvalues);
 
-    outliers_.clear();
+      Values values;
 
-    int n = 0;
+      values.reserve(values_.size());
 
-    for (auto v : values_) {
-      if (statData_.isOutlier(v))
-        outliers_.push_back(n);
+      for (auto i : sortedValues->order())
+        values.push_back(values_[i]);
 
-      ++n;
+      values_.swap(values);
+
+      statData_ = sortedValues->statData();
+      outliers_ = sortedValues->outliers();
+
+      return;
     }
+
+    //---
+
+    std::sort(values_.begin(), values_.end());
+
+    //---
+
+    statData_.calcStatValues(values_);
+
+    //---
+
+    statData_.calcOutliers(values_, outliers_);
   }
 
   void initDensity() const {
@@ -190,6 +214,7 @@ class CQChartsBoxWhiskerT {
   Values                    values_;                //!< values
   double                    range_        { 1.5 };  //!< outlier range scale
   double                    fraction_     { 0.95 }; //!< fraction ? TODO
+  SortedValuesFn            sortedValuesFn_;         //!< sorted values function
 
   // calculated data
   mutable std::atomic<bool> calcValid_    { false }; //!< calc valid
@@ -5,6 +5,7 @@
 #include <CCoordFrame3D.h>
 #include <CMatrix3DH.h>
 #include <CPoint3D.h>
+#include <array>
 #include <memory>
 
 class CQChartsPlot3D;
@@ -44,6 +45,7 @@ class CQChartsCamera {
  public:
   using Point3D = CQChartsGeom::Point3D;
   using Range3D = CQChartsGeom::Range3D;
+  using Matrix  = std::array<double, 12>;
 
  public:
   CQChartsCamera(CQChartsPlot3D *plot=nullptr);
@@ -149,6 +151,13 @@ class CQChartsCamera {
   Point3D transform  (const Point3D &p) const;
   Point3D untransform(const Point3D &p) const;
 
+  //! get transform as (row major) 3x4 affine matrix (projection is orthographic)
+  Matrix transformMatrix() const;
+
+  //! transform arrays of n points with matrix
+  static void transformPoints(const Matrix &m, int n, const double *x, const double *y,
+                              const double *z, double *tx, double *ty, double *tz);
+
   void showView(std::ostream &os) const;
 
   void unsetView();
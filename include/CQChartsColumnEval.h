@@ -2,7 +2,6 @@
 #define CQChartsColumnEval_H
 
 #include <CQTclUtil.h>
-#include <mutex>
 
 class CQChartsExprTcl;
 
@@ -11,6 +10,8 @@ class CQChartsExprTcl;
 /*!
  * \brief class to evaluate tcl expression
  * \ingroup Charts
+ *
+ * Instance is per thread so expression columns can be evaluated in parallel.
  */
 class CQChartsColumnEval {
  public:
@@ -64,7 +65,6 @@ class CQChartsColumnEval {
   bool                      debug_ { false };   //!< is debug
   const QAbstractItemModel* model_ { nullptr }; //!< model
   int                       row_   { 0 };       //!< current row
-  mutable std::mutex        mutex_;             //!< mutex
 };
 
 #endif
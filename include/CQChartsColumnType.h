@@ -20,6 +20,7 @@
 #include <CQChartsColorStops.h>
 #include <CQChartsUtil.h>
 #include <CQChartsModelTypes.h>
+#include <CQChartsTimeFormat.h>
 #include <QObject>
 #include <QString>
 #include <future>
@@ -340,6 +341,21 @@ class CQChartsColumnTimeType : public CQChartsColumnType {
   QVariant indexVar(const QVariant &var, const QString &ind) const override;
 
   Type indexType(const QString &) const override;
+
+ private:
+  //! get compiled input time format for column (cached per column by format string)
+  const CQChartsTimeFormat *columnTimeFormat(const QAbstractItemModel *model,
+                                             const CQChartsColumn &column,
+                                             const QString &fmt) const;
+
+  //! get compiled input time format
+  CQChartsTimeFormatP getTimeFormat(const QString &fmt) const;
+
+ private:
+  using TimeFormats = std::map<QString, CQChartsTimeFormatP>;
+
+  mutable TimeFormats timeFormats_;     //!< compiled time formats
+  mutable std::mutex  timeFormatMutex_; //!< compiled time formats mutex
 };
 
 //---
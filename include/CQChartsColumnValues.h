@@ -0,0 +1,47 @@
+#ifndef CQChartsColumnValues_H
+#define CQChartsColumnValues_H
+
+#include <vector>
+#include <memory>
+
+/*!
+ * \brief contiguous real values for a model column (indexed by model row)
+ * \ingroup Charts
+ *
+ * Values which could not be converted to a real are flagged as invalid in
+ * the validity mask.
+ */
+class CQChartsColumnReals {
+ public:
+  using Values = std::vector<double>;
+  using Valid  = std::vector<bool>;
+
+ public:
+  CQChartsColumnReals(int n=0) :
+   values_(n, 0.0), valid_(n, false) {
+  }
+
+  //! number of rows
+  int size() const { return int(values_.size()); }
+
+  //! is row value valid
+  bool isValid(int row) const { return valid_[row]; }
+
+  //! get row value
+  double value(int row) const { return values_[row]; }
+
+  //! set row value
+  void setValue(int row, double r) { values_[row] = r; valid_[row] = true; }
+
+  //! get all values/validity mask
+  const Values &values() const { return values_; }
+  const Valid  &valid () const { return valid_; }
+
+ private:
+  Values values_; //!< row values
+  Valid  valid_;  //!< row valid mask
+};
+
+using CQChartsColumnRealsP = std::shared_ptr<CQChartsColumnReals>;
+
+#endif
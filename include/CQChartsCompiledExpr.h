@@ -0,0 +1,92 @@
+#ifndef CQChartsCompiledExpr_H
+#define CQChartsCompiledExpr_H
+
+#include <QVariant>
+#include <QString>
+#include <vector>
+#include <memory>
+
+/*!
+ * \brief Compiled (parsed once) subset of tcl expression syntax
+ * \ingroup Charts
+ *
+ * Supports:
+ *  . integer, real and string ("..." or {...}) literals
+ *  . variables ($name, ${name}) resolved at compile time by the context
+ *  . unary (- + !), binary (** * / % + - < <= > >= == != eq ne && ||) and ternary (?:)
+ *    operators with tcl precedence and integer/real semantics
+ *  . tcl math functions (abs, sqrt, pow, min, max, ...)
+ *  . context functions (e.g. expression model column, row, cell, norm, ...)
+ *
+ * Anything else (command substitution, variable substitution in strings, unknown
+ * functions) fails to compile so the caller can fall back to tcl evaluation.
+ * Evaluation also fails for values where tcl semantics are not reproduced exactly
+ * (octal/hex strings, integer overflow, NaN/Inf results, ...).
+ */
+class CQChartsCompiledExpr {
+ public:
+  using Values = std::vector<QVariant>;
+
+  //! variable type
+  enum class VarType {
+    NONE,
+    COLUMN,
+    ROW,
+    COL,
+    CONST_PI,
+    CONST_NAN,
+    LAST
+  };
+
+  /*!
+   * \brief context used to resolve names at compile time and get values at evaluation
+   */
+  class Context {
+   public:
+    virtual ~Context() { }
+
+    //! resolve variable name to type (and column for COLUMN)
+    virtual VarType varType(const QString &name, int &column) const = 0;
+
+    //! is function name supported by context
+    virtual bool isFunction(const QString &name) const = 0;
+
+    //! is function name overridden by user defined function
+    virtual bool isUserFunction(const QString &) const { return false; }
+
+    //! get column value for row
+    virtual QVariant columnValue(int row, int column) const = 0;
+
+    //! get last evaluated value
+    virtual QVariant lastValue() const = 0;
+
+    //! call context function for row/column
+    virtual QVariant callFunction(int row, int column, const QString &name,
+                                  const Values &values) = 0;
+  };
+
+  struct Node;
+
+  using NodeP = std::shared_ptr<Node>;
+
+ public:
+  CQChartsCompiledExpr();
+ ~CQChartsCompiledExpr();
+
+  //! compile expression (returns false if unsupported)
+  bool compile(const QString &expr, const Context &context);
+
+  //! is compiled
+  bool isValid() const { return !! root_; }
+
+  //! evaluate for row and column
+  //! (returns false if value can't be calculated without tcl so caller should fall back)
+  bool eval(Context &context, int row, int column, QVariant &value) const;
+
+ private:
+  NodeP root_; //!< root of parsed tree
+};
+
+using CQChartsCompiledExprP = std::shared_ptr<CQChartsCompiledExpr>;
+
+#endif
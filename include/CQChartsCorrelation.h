@@ -0,0 +1,70 @@
+#ifndef CQChartsCorrelation_H
+#define CQChartsCorrelation_H
+
+#include <vector>
+
+/*!
+ * \brief correlation matrix of a set of value columns
+ * \ingroup Charts
+ *
+ * Columns are standardized once into a contiguous buffer and the matrix is calculated
+ * as a blocked Gram product (dot products of standardized columns) split across threads.
+ *
+ * Missing values (NaN) are handled pairwise i.e. each pair is correlated using only the
+ * rows where both values are present. In Spearman mode values are replaced by their
+ * (tie averaged) ranks.
+ */
+class CQChartsCorrelation {
+ public:
+  enum class Type {
+    PEARSON,
+    SPEARMAN
+  };
+
+  using Values  = std::vector<double>;
+  using Columns = std::vector<Values>;
+
+ public:
+  CQChartsCorrelation(Type type=Type::PEARSON);
+
+  //! get/set correlation type
+  const Type &type() const { return type_; }
+  void setType(const Type &t) { type_ = t; }
+
+  //! calc matrix for columns (all columns must have the same number of values)
+  void calc(const Columns &columns);
+
+  //! number of columns
+  int numColumns() const { return nc_; }
+
+  //! get correlation of column pair
+  double corr(int i, int j) const { return corr_[i*nc_ + j]; }
+
+  //! get standard deviation of (non-missing) column values
+  double stddev(int i) const { return stddev_[i]; }
+
+  //! get sum of squares of column's off diagonal correlations
+  double sumSq(int i) const;
+
+ private:
+  void calcRanks(const Values &values, Values &ranks) const;
+
+  void calcComplete();
+
+  void calcPairwise(const Columns &columns);
+
+  double calcPair(const Values &values1, const Values &values2) const;
+
+ private:
+  using Indices = std::vector<int>;
+
+  Type    type_ { Type::PEARSON }; //!< correlation type
+  int     nc_   { 0 };             //!< number of columns
+  int     nr_   { 0 };             //!< number of values per column
+  Values  zvalues_;                //!< standardized complete columns (column major)
+  Indices complete_;               //!< column index into zvalues_ (-1 if has missing values)
+  Values  corr_;                   //!< correlation matrix (row major)
+  Values  stddev_;                 //!< column standard deviations
+};
+
+#endif
@@ -5,6 +5,7 @@
 #include <CQChartsFitData.h>
 #include <CQChartsDensity.h>
 #include <CQDataModel.h>
+#include <mutex>
 
 /*!
  * \brief Wrapper class for CQDataModel to remember correlation input data
@@ -14,27 +15,26 @@ class CQChartsCorrelationModel : public CQDataModel {
  public:
   using Point   = CQChartsGeom::Point;
   using Points  = std::vector<Point>;
+  using Values  = std::vector<double>;
   using RMinMax = CQChartsGeom::RMinMax;
 
  public:
   CQChartsCorrelationModel(int numCols);
 
-  const Points &points(int i, int j) const {
-    auto pi = ijPoints_.find(i);
-    assert(pi != ijPoints_.end());
+  //! get/set values of correlated column (points and best fit are calculated on demand)
+  const Values &values(int i) const {
+    auto p = iValues_.find(i);
+    assert(p != iValues_.end());
 
-    auto pj = (*pi).second.find(j);
-    assert(pj != (*pi).second.end());
-
-    return (*pj).second;
+    return (*p).second;
   }
 
-  void setPoints(int i, int j, const Points &points) {
-    ijPoints_[i][j] = points;
-
-    ijBestFit_[i][j].calc(points);
+  void setValues(int i, Values &&values) {
+    iValues_[i] = std::move(values);
   }
 
+  const Points &points(int i, int j) const;
+
   const RMinMax &minMax(int i) {
     auto p = iMinMax_.find(i);
     assert(p != iMinMax_.end());
@@ -61,15 +61,7 @@ class CQChartsCorrelationModel : public CQDataModel {
     ijDevData_[i][j] = DevData(x, y);
   }
 
-  CQChartsFitData &bestFit(int i, int j) {
-    auto pi = ijBestFit_.find(i);
-    assert(pi != ijBestFit_.end());
-
-    auto pj = (*pi).second.find(j);
-    assert(pj != (*pi).second.end());
-
-    return (*pj).second;
-  }
+  CQChartsFitData &bestFit(int i, int j);
 
   CQChartsDensity *density(int i) {
     auto p = iDensity_.find(i);
@@ -92,6 +84,7 @@ class CQChartsCorrelationModel : public CQDataModel {
     }
   };
 
+  using IValues   = std::map<int, Values>;
   using JPoints   = std::map<int, Points>;
   using IJPoints  = std::map<int, JPoints>;
   using IMinMax   = std::map<int, RMinMax>;
@@ -101,11 +94,15 @@ class CQChartsCorrelationModel : public CQDataModel {
   using IJBestFit = std::map<int, JBestFit>;
   using IDensity  = std::map<int, CQChartsDensity *>;
 
-  IJPoints  ijPoints_;
-  IMinMax   iMinMax_;
-  IJDevData ijDevData_;
-  IJBestFit ijBestFit_;
-  IDensity  iDensity_;
+  IValues   iValues_;   //!< column values
+  IMinMax   iMinMax_;   //!< column value range
+  IJDevData ijDevData_; //!< column pair std devs
+  IDensity  iDensity_;  //!< column density
+
+  // per pair data cache (only calculated for drawn pairs)
+  mutable std::mutex cacheMutex_;
+  mutable IJPoints   ijPoints_;  //!< column pair points
+  mutable IJBestFit  ijBestFit_; //!< column pair best fit
 };
 
 #endif
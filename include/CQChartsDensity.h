@@ -26,6 +26,7 @@ class CQChartsDensity : public QObject {
 
   Q_PROPERTY(int             numSamples      READ numSamples      WRITE setNumSamples     )
   Q_PROPERTY(double          smoothParameter READ smoothParameter WRITE setSmoothParameter)
+  Q_PROPERTY(bool            binned          READ isBinned        WRITE setBinned         )
   Q_PROPERTY(DrawType        drawType        READ drawType        WRITE setDrawType       )
   Q_PROPERTY(Qt::Orientation orientation     READ orientation     WRITE setOrientation    )
 
@@ -77,6 +78,10 @@ class CQChartsDensity : public QObject {
   double smoothParameter() const { return smoothParameter_; }
   void setSmoothParameter(double r) { smoothParameter_ = r; invalidate(); }
 
+  //! get/set use binned estimate (linear binning and fft convolution) for many values
+  bool isBinned() const { return binned_; }
+  void setBinned(bool b) { binned_ = b; invalidate(); }
+
   //---
 
   double xmin() const { constCalc(); return xmin_; }
@@ -150,8 +155,14 @@ class CQChartsDensity : public QObject {
   void constInit() const;
   void init();
 
+  double bandwidth() const;
+
+  void initBinned();
+
   double eval(double x) const;
 
+  double evalExact(double x) const;
+
  signals:
   void dataChanged();
 
@@ -162,6 +173,7 @@ class CQChartsDensity : public QObject {
   Points          opoints_;
   double          smoothParameter_  { -1.0 };
   int             numSamples_       { 100 };
+  bool            binned_           { true };
   bool            initialized_      { false };
   bool            calced_           { false };
   int             nx_               { 0 };
@@ -183,6 +195,11 @@ class CQChartsDensity : public QObject {
   double          ymin1_            { 0.0 };
   double          ymax1_            { 0.0 };
   double          area_             { 1.0 };
+
+  // binned data (density at grid points)
+  XVals           binnedYVals_;
+  double          binnedXMin_       { 0.0 };
+  double          binnedDx_         { 0.0 };
 };
 
 #endif
@@ -15,6 +15,7 @@ class CQChartsExprModelFn;
 class CQChartsModelData;
 class CQChartsExprTcl;
 class CQChartsExprCmdValues;
+class CQChartsCompiledExpr;
 class CQCharts;
 
 class CQTcl;
@@ -195,8 +196,9 @@ class CQChartsExprModel : public QAbstractProxyModel {
  private:
   using OptInt     = boost::optional<int>;
   using OptReal    = boost::optional<double>;
-  using VariantMap = std::map<int, QVariant>;
-  using Args       = std::vector<QString>;
+  using VariantMap    = std::map<int, QVariant>;
+  using Args          = std::vector<QString>;
+  using CompiledExprP = std::shared_ptr<CQChartsCompiledExpr>;
 
   struct ExtraColumn {
     QString               expr;                          //!< expression
@@ -208,6 +210,8 @@ class CQChartsExprModel : public QAbstractProxyModel {
     Values                values;                        //!< assign values
     Function              function   { Function::EVAL }; //!< current eval function
     std::atomic<bool>     evaluating { false };          //!< is evaluating column
+    CompiledExprP         compiledExpr;                  //!< compiled expression
+    bool                  compileTried { false };        //!< has compile been tried
 
     ExtraColumn(const QString &expr, const QString &header="") :
      expr(expr), header(header) {
@@ -222,6 +226,8 @@ class CQChartsExprModel : public QAbstractProxyModel {
 
   using TclCmds = std::vector<CQChartsExprModelFn *>;
 
+  class CompileContext;
+
   friend class CQChartsExprModelFn;
 
  private:
@@ -241,6 +247,13 @@ class CQChartsExprModel : public QAbstractProxyModel {
 
   QVariant calcExtraColumnValue(int row, int column, int ecolumn, bool &rc);
 
+  bool compileExtraColumn(ExtraColumn &extraColumn, int column);
+
+  void calcCompiledExtraColumn(ExtraColumn &extraColumn, int row, int column, bool &rc);
+
+  void setExtraColumnValue(ExtraColumn &extraColumn, int row, int column,
+                           const QVariant &var, bool ok);
+
   //---
 
   void initCalc();
@@ -309,7 +322,29 @@ class CQChartsExprModel : public QAbstractProxyModel {
   CQChartsModelData *getModelData() const;
 
  protected slots:
-  void dataChangedSlot(const QModelIndex &from, const QModelIndex &to);
+  void dataChangedSlot(const QModelIndex &from, const QModelIndex &to, const QVector<int> &roles);
+
+  void rowsAboutToBeInsertedSlot(const QModelIndex &parent, int first, int last);
+  void rowsInsertedSlot(const QModelIndex &parent, int first, int last);
+  void rowsAboutToBeRemovedSlot(const QModelIndex &parent, int first, int last);
+  void rowsRemovedSlot(const QModelIndex &parent, int first, int last);
+
+  void columnsAboutToBeInsertedSlot(const QModelIndex &parent, int first, int last);
+  void columnsInsertedSlot();
+  void columnsAboutToBeRemovedSlot(const QModelIndex &parent, int first, int last);
+  void columnsRemovedSlot();
+
+  void modelAboutToBeResetSlot();
+  void modelResetSlot();
+
+  void layoutAboutToBeChangedSlot();
+  void layoutChangedSlot();
+
+ protected:
+  void insertExtraRows(int row, int n);
+  void removeExtraRows(int row, int n);
+
+  void resetExtraValues();
 
  protected:
   using ExtraColumns = std::vector<ExtraColumn *>;
@@ -317,6 +352,13 @@ class CQChartsExprModel : public QAbstractProxyModel {
   using ColumnNames  = std::map<int, QString>;
   using NameColumns  = std::map<QString, int>;
 
+  //! persistent indices saved over source layout change
+  struct LayoutData {
+    QModelIndexList                    proxyInds;  //!< proxy persistent indices
+    std::vector<QPersistentModelIndex> sourceInds; //!< source row of proxy indices
+    std::vector<QPersistentModelIndex> sourceRows; //!< source rows (for extra values)
+  };
+
   CQCharts*            charts_     { nullptr }; //!< charts
   CQChartsModelFilter* filter_     { nullptr }; //!< parent filter model
   QAbstractItemModel*  model_      { nullptr }; //!< child data model
@@ -332,6 +374,7 @@ class CQChartsExprModel : public QAbstractProxyModel {
   ColumnDatas          columnDatas_;            //!< cached column datas
   ColumnNames          columnNames_;            //!< cached column names
   NameColumns          nameColumns_;            //!< cached named columns
+  LayoutData           layoutData_;             //!< source layout change data
   mutable std::mutex   mutex_;                  //!< update mutex
 };
 
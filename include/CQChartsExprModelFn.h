@@ -24,6 +24,8 @@ class CQChartsExprModelFn {
 
   CQTcl *qtcl() const { return qtcl_; }
 
+  const QString &name() const { return name_; }
+
   static int commandProc(ClientData clientData, Tcl_Interp *, int objc, const Tcl_Obj **objv);
 
   QVariant exec(const Values &values);
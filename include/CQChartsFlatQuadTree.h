@@ -0,0 +1,634 @@
+#ifndef CQChartsFlatQuadTree_H
+#define CQChartsFlatQuadTree_H
+
+#include <cassert>
+#include <algorithm>
+#include <map>
+#include <vector>
+#include <sys/types.h>
+
+/*!
+ * quad tree containing pointers to items of type DATA with an associated rect of type RECT
+ *
+ * same behavior as CQChartsQuadTree but with flat storage for faster queries of large
+ * numbers of items:
+ *   . tree nodes are stored in a single contiguous vector (children of a node are four
+ *     consecutive nodes) and are referenced by index
+ *   . items of each node are stored in a contiguous bucket together with a copy of the
+ *     item's bounding box so queries don't need to access the item data
+ *
+ * the tree is split when the number of elements is greater than the auto split limit
+ *
+ * tree does not take ownership of data. The application must ensure elements are not
+ * deleted while in the tree.
+ *
+ * DATA must support:
+ *   const RECT &rect = data->rect();
+ *
+ * RECT must support:
+ *   constructor RECT(l, b, r, t);
+ *
+ *   T l = rect.getXMin();
+ *   T b = rect.getYMin();
+ *   T r = rect.getXMax();
+ *   T t = rect.getYMax();
+ */
+template<typename DATA, typename RECT, typename T=double>
+class CQChartsFlatQuadTree {
+ public:
+  using DataList = std::vector<DATA *>;
+
+ private:
+  //! item bounding box
+  struct Box {
+    T xmin { 0 };
+    T ymin { 0 };
+    T xmax { 0 };
+    T ymax { 0 };
+
+    Box() = default;
+
+    Box(T xmin, T ymin, T xmax, T ymax) :
+     xmin(xmin), ymin(ymin), xmax(xmax), ymax(ymax) {
+    }
+
+    explicit Box(const RECT &rect) :
+     xmin(rect.getXMin()), ymin(rect.getYMin()), xmax(rect.getXMax()), ymax(rect.getYMax()) {
+    }
+
+    RECT rect() const { return RECT(xmin, ymin, xmax, ymax); }
+
+    bool isValid() const { return (xmin <= xmax && ymin <= ymax); }
+
+    bool contains(T x, T y) const {
+      return (x >= xmin && x <= xmax && y >= ymin && y <= ymax);
+    }
+
+    // is this box inside box
+    bool inside(const Box &box) const {
+      return (xmin >= box.xmin && xmax <= box.xmax && ymin >= box.ymin && ymax <= box.ymax);
+    }
+
+    // does this box overlap box
+    bool overlaps(const Box &box) const {
+      return (xmax >= box.xmin && xmin <= box.xmax && ymax >= box.ymin && ymin <= box.ymax);
+    }
+  };
+
+  //! item (data and bbox it was added with)
+  struct Item {
+    DATA *data { nullptr };
+    Box   box;
+
+    Item(DATA *data, const Box &box) :
+     data(data), box(box) {
+    }
+  };
+
+  using Items = std::vector<Item>;
+
+  //! tree node (children are four consecutive nodes: bottom left, bottom right,
+  //! top left, top right)
+  struct Node {
+    Box   box;                //!< bounding box of node
+    int   parent { -1 };      //!< parent node index (-1 if root)
+    int   child  { -1 };      //!< first child node index (-1 if leaf)
+    Items items;              //!< items which don't fit in child nodes
+
+    Node(const Box &box, int parent) :
+     box(box), parent(parent) {
+    }
+
+    bool hasChildren() const { return child >= 0; }
+  };
+
+  using Nodes = std::vector<Node>;
+  using Inds  = std::vector<int>;
+
+  enum { BL = 0, BR = 1, TL = 2, TR = 3 };
+
+ public:
+  explicit CQChartsFlatQuadTree(const RECT &rect=RECT()) {
+    reset();
+
+    if (rect.isSet())
+      nodes_[0].box = Box(rect);
+  }
+
+  //! reset tree
+  void reset() {
+    nodes_.clear();
+
+    nodes_.emplace_back(Box(1, 1, 0, 0), -1);
+
+    numItems_ = 0;
+  }
+
+  bool isEmpty() const { return (numItems_ == 0); }
+
+  //! get bounding rect
+  RECT rect() const { return nodes_[0].box.rect(); }
+
+  //! get number of tree nodes
+  uint numNodes() const { return uint(nodes_.size()); }
+
+  //! get number of items
+  uint numElements() const { return numItems_; }
+
+  //! get auto split limit
+  static uint autoSplitLimit() { return *autoSplitLimitP(); }
+
+  //! set auto split limit
+  static void setAutoSplitLimit(uint limit) { *autoSplitLimitP() = limit; }
+
+  //----------
+
+ public:
+  //! add data item to the tree
+  void add(DATA *data) {
+    Box box(data->rect());
+
+    assert(box.isValid());
+
+    if (! nodes_[0].box.isValid())
+      nodes_[0].box = box;
+
+    if (! box.inside(nodes_[0].box))
+      grow(box);
+
+    addItem(0, Item(data, box));
+
+    ++numItems_;
+  }
+
+ private:
+  void addItem(int ind, const Item &item) {
+    // descend to deepest node containing item
+    while (nodes_[ind].hasChildren()) {
+      int child = childContaining(ind, item.box);
+      if (child < 0) break;
+
+      ind = child;
+    }
+
+    auto &node = nodes_[ind];
+
+    node.items.push_back(item);
+
+    if (! node.hasChildren()) {
+      uint limit = autoSplitLimit();
+
+      if (limit > 0 && node.items.size() > limit)
+        split(ind);
+    }
+  }
+
+  // get child node index completely containing box (-1 if none)
+  int childContaining(int ind, const Box &box) const {
+    const auto &node = nodes_[ind];
+
+    const auto &bl = nodes_[node.child + BL].box;
+
+    if      (box.xmax <= bl.xmax) {
+      if      (box.ymax <= bl.ymax) return node.child + BL;
+      else if (box.ymin >= bl.ymax) return node.child + TL;
+    }
+    else if (box.xmin >= bl.xmax) {
+      if      (box.ymax <= bl.ymax) return node.child + BR;
+      else if (box.ymin >= bl.ymax) return node.child + TR;
+    }
+
+    return -1;
+  }
+
+  // split leaf node at center and move contained items to new child nodes
+  void split(int ind) {
+    Box box = nodes_[ind].box;
+
+    T x = (box.xmin + box.xmax)/2;
+    T y = (box.ymin + box.ymax)/2;
+
+    if (x <= box.xmin || x >= box.xmax || y <= box.ymin || y >= box.ymax)
+      return;
+
+    // add children (may reallocate nodes so don't hold node reference)
+    int child = int(nodes_.size());
+
+    nodes_.emplace_back(Box(box.xmin, box.ymin, x       , y       ), ind);
+    nodes_.emplace_back(Box(x       , box.ymin, box.xmax, y       ), ind);
+    nodes_.emplace_back(Box(box.xmin, y       , x       , box.ymax), ind);
+    nodes_.emplace_back(Box(x       , y       , box.xmax, box.ymax), ind);
+
+    nodes_[ind].child = child;
+
+    // move items which fit in children (keep others in this node)
+    // (children are split when more items are added to them)
+    Items items;
+
+    std::swap(items, nodes_[ind].items);
+
+    for (const auto &item : items) {
+      int child1 = childContaining(ind, item.box);
+
+      if (child1 >= 0)
+        nodes_[child1].items.push_back(item);
+      else
+        nodes_[ind].items.push_back(item);
+    }
+  }
+
+  //----------
+
+ private:
+  // increase size of bounding box of tree (root) and outer edges of children
+  void grow(const Box &box) {
+    const auto &rbox = nodes_[0].box;
+
+    Box box1(std::min(rbox.xmin, box.xmin), std::min(rbox.ymin, box.ymin),
+             std::max(rbox.xmax, box.xmax), std::max(rbox.ymax, box.ymax));
+
+    growNode(0, box1);
+  }
+
+  void growNode(int ind, const Box &box) {
+    nodes_[ind].box = box;
+
+    if (! nodes_[ind].hasChildren())
+      return;
+
+    int child = nodes_[ind].child;
+
+    T x = nodes_[child + BL].box.xmax;
+    T y = nodes_[child + BL].box.ymax;
+
+    growNode(child + BL, Box(box.xmin, box.ymin, x       , y       ));
+    growNode(child + BR, Box(x       , box.ymin, box.xmax, y       ));
+    growNode(child + TL, Box(box.xmin, y       , x       , box.ymax));
+    growNode(child + TR, Box(x       , y       , box.xmax, box.ymax));
+  }
+
+  //----------
+
+ public:
+  //! remove data from tree using rect it was added with (data rect may have changed)
+  //! (falls back to searching all nodes if not found, returns false if not in tree)
+  bool remove(DATA *data, const RECT &rect) {
+    Box box(rect);
+
+    if (box.isValid() && box.inside(nodes_[0].box)) {
+      int ind = 0;
+
+      for (;;) {
+        if (removeNodeData(ind, data))
+          return true;
+
+        if (! nodes_[ind].hasChildren())
+          break;
+
+        ind = childContaining(ind, box);
+        if (ind < 0) break;
+      }
+    }
+
+    for (int i = 0; i < int(nodes_.size()); ++i) {
+      if (removeNodeData(i, data))
+        return true;
+    }
+
+    return false;
+  }
+
+  //! remove data from tree using its current rect
+  bool remove(DATA *data) {
+    return remove(data, data->rect());
+  }
+
+ private:
+  bool removeNodeData(int ind, DATA *data) {
+    auto &items = nodes_[ind].items;
+
+    for (auto p = items.begin(); p != items.end(); ++p) {
+      if ((*p).data == data) {
+        // order of items is not significant so swap with last
+        std::swap(*p, items.back());
+
+        items.pop_back();
+
+        --numItems_;
+
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  //-------
+
+ public:
+  //! get data items inside the specified bounding rect
+  void dataInsideRect(const RECT &rect, DataList &dataList) const {
+    dataList.clear();
+
+    addDataInsideRect(rect, dataList);
+  }
+
+  void addDataInsideRect(const RECT &rect, DataList &dataList) const {
+    Box box(rect);
+
+    if (! box.isValid())
+      return;
+
+    Inds stack;
+
+    stack.push_back(0);
+
+    while (! stack.empty()) {
+      int ind = stack.back(); stack.pop_back();
+
+      const auto &node = nodes_[ind];
+
+      if (! node.box.overlaps(box))
+        continue;
+
+      // if node completely inside, add all items
+      if (node.box.inside(box)) {
+        addNodeData(ind, dataList);
+        continue;
+      }
+
+      for (const auto &item : node.items) {
+        if (item.box.inside(box))
+          dataList.push_back(item.data);
+      }
+
+      if (node.hasChildren()) {
+        for (int i = 0; i < 4; ++i)
+          stack.push_back(node.child + i);
+      }
+    }
+  }
+
+  //-------
+
+ public:
+  //! get data items touching the specified bounding rect
+  void dataTouchingRect(const RECT &rect, DataList &dataList) const {
+    dataList.clear();
+
+    addDataTouchingRect(rect, dataList);
+  }
+
+  void addDataTouchingRect(const RECT &rect, DataList &dataList) const {
+    Box box(rect);
+
+    if (! box.isValid())
+      return;
+
+    Inds stack;
+
+    stack.push_back(0);
+
+    while (! stack.empty()) {
+      int ind = stack.back(); stack.pop_back();
+
+      const auto &node = nodes_[ind];
+
+      if (! node.box.overlaps(box))
+        continue;
+
+      // if node completely inside, add all items
+      if (node.box.inside(box)) {
+        addNodeData(ind, dataList);
+        continue;
+      }
+
+      for (const auto &item : node.items) {
+        if (item.box.overlaps(box))
+          dataList.push_back(item.data);
+      }
+
+      if (node.hasChildren()) {
+        for (int i = 0; i < 4; ++i)
+          stack.push_back(node.child + i);
+      }
+    }
+  }
+
+  //! check if data items touching the specified bounding box
+  bool isDataTouchingRect(const RECT &rect) const {
+    Box box(rect);
+
+    if (! box.isValid())
+      return false;
+
+    Inds stack;
+
+    stack.push_back(0);
+
+    while (! stack.empty()) {
+      int ind = stack.back(); stack.pop_back();
+
+      const auto &node = nodes_[ind];
+
+      if (! node.box.overlaps(box))
+        continue;
+
+      for (const auto &item : node.items) {
+        if (item.box.overlaps(box))
+          return true;
+      }
+
+      if (node.hasChildren()) {
+        for (int i = 0; i < 4; ++i)
+          stack.push_back(node.child + i);
+      }
+    }
+
+    return false;
+  }
+
+  //-------
+
+ public:
+  //! get data items which have the specified point inside them
+  void dataAtPoint(T x, T y, DataList &dataList) const {
+    dataList.clear();
+
+    addDataAtPoint(x, y, dataList);
+  }
+
+  void addDataAtPoint(T x, T y, DataList &dataList) const {
+    if (isEmpty())
+      return;
+
+    // children don't overlap (except at edges) so only follow single path
+    // (checking all children on edges)
+    Inds stack;
+
+    stack.push_back(0);
+
+    while (! stack.empty()) {
+      int ind = stack.back(); stack.pop_back();
+
+      const auto &node = nodes_[ind];
+
+      if (! node.box.contains(x, y))
+        continue;
+
+      for (const auto &item : node.items) {
+        if (item.box.contains(x, y))
+          dataList.push_back(item.data);
+      }
+
+      if (node.hasChildren()) {
+        for (int i = 0; i < 4; ++i) {
+          if (nodes_[node.child + i].box.contains(x, y))
+            stack.push_back(node.child + i);
+        }
+      }
+    }
+  }
+
+  //-------
+
+ private:
+  // add all items of node and its children
+  void addNodeData(int ind, DataList &dataList) const {
+    Inds stack;
+
+    stack.push_back(ind);
+
+    while (! stack.empty()) {
+      int ind1 = stack.back(); stack.pop_back();
+
+      const auto &node = nodes_[ind1];
+
+      for (const auto &item : node.items)
+        dataList.push_back(item.data);
+
+      if (node.hasChildren()) {
+        for (int i = 0; i < 4; ++i)
+          stack.push_back(node.child + i);
+      }
+    }
+  }
+
+  // number of items in node and its children
+  uint numNodeElements(int ind) const {
+    const auto &node = nodes_[ind];
+
+    uint n = uint(node.items.size());
+
+    if (node.hasChildren()) {
+      for (int i = 0; i < 4; ++i)
+        n += numNodeElements(node.child + i);
+    }
+
+    return n;
+  }
+
+  //-------
+
+ public:
+  //! process items
+  template<typename PROC>
+  void process(PROC &proc) const {
+    for (const auto &node : nodes_) {
+      for (const auto &item : node.items)
+        proc(item.data);
+    }
+  }
+
+  //! process node and item rects
+  template<typename PROC>
+  void processRect(PROC &proc) const {
+    for (const auto &node : nodes_) {
+      int n = int(node.items.size());
+
+      proc(node.box.rect(), n);
+
+      for (const auto &item : node.items)
+        proc(item.box.rect(), 0);
+    }
+  }
+
+  //-------
+
+ public:
+  using FitNodes = std::map<uint, Inds>;
+
+  //! find least used node rect which fits specified size
+  RECT fitRect(double w, double h) const {
+    FitNodes fitNodes;
+
+    for (int i = 0; i < int(nodes_.size()); ++i) {
+      const auto &box = nodes_[i].box;
+
+      if (w > box.xmax - box.xmin || h > box.ymax - box.ymin)
+        continue;
+
+      fitNodes[numNodeElements(i)].push_back(i);
+    }
+
+    if (fitNodes.empty())
+      return rect();
+
+    const auto &inds = (*fitNodes.begin()).second;
+
+    assert(! inds.empty());
+
+    if (inds.size() == 1)
+      return nodes_[inds[0]].box.rect();
+
+    int    minInd  { -1 };
+    double minArea { 0.0 };
+
+    for (const auto &ind : inds) {
+      const auto &node = nodes_[ind];
+      const auto &r    = node.box;
+
+      double xmid = (r.xmin + r.xmax)/2.0;
+      double ymid = (r.ymin + r.ymax)/2.0;
+
+      Box r1(xmid - w/2, ymid - h/2, xmid + w/2, ymid + h/2);
+
+      double area = 0.0;
+
+      if (node.parent >= 0) {
+        for (const auto &item : nodes_[node.parent].items) {
+          const auto &r2 = item.box;
+
+          double xo = std::max(0.0, double(std::min(r1.xmax, r2.xmax) -
+                                           std::max(r1.xmin, r2.xmin)));
+          double yo = std::max(0.0, double(std::min(r1.ymax, r2.ymax) -
+                                           std::max(r1.ymin, r2.ymin)));
+
+          area += xo*yo;
+        }
+      }
+
+      if (minInd < 0 || area < minArea) {
+        minInd  = ind;
+        minArea = area;
+      }
+    }
+
+    assert(minInd >= 0);
+
+    return nodes_[minInd].box.rect();
+  }
+
+ private:
+  static uint *autoSplitLimitP() {
+    static uint autoSplitLimit = 16;
+
+    return &autoSplitLimit;
+  }
+
+ private:
+  Nodes nodes_;           //!< tree nodes (root is first)
+  uint  numItems_ { 0 };  //!< number of items in tree
+};
+
+#endif
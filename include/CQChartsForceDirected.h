@@ -12,6 +12,8 @@ class CQChartsForceDirected {
   CQChartsForceDirected() {
     graph_  = new Springy::Graph;
     layout_ = new Springy::Layout(graph_, stiffness_, repulsion_, damping_);
+
+    layout_->setTheta(theta_);
   }
 
  ~CQChartsForceDirected() {
@@ -28,12 +30,17 @@ class CQChartsForceDirected {
   double damping() const { return damping_; }
   void setDamping(double r) { damping_ = r; }
 
+  double theta() const { return theta_; }
+  void setTheta(double r) { theta_ = r; layout_->setTheta(theta_); }
+
   void reset() {
     delete graph_;
     delete layout_;
 
     graph_  = new Springy::Graph;
     layout_ = new Springy::Layout(graph_, stiffness_, repulsion_, damping_);
+
+    layout_->setTheta(theta_);
   }
 
   template<typename T>
@@ -91,6 +98,7 @@ class CQChartsForceDirected {
   double           stiffness_    { 400.0 };
   double           repulsion_    { 400.0 };
   double           damping_      { 0.5 };
+  double           theta_        { 0.5 };
   Springy::Graph*  graph_        { nullptr };
   Springy::Layout* layout_       { nullptr };
   Springy::Node*   currentNode_  { nullptr };
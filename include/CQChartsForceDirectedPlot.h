@@ -98,6 +98,7 @@ class CQChartsForceDirectedPlot : public CQChartsConnectionPlot,
   Q_PROPERTY(bool   nodeScaled   READ isNodeScaled WRITE setNodeScaled  )
   Q_PROPERTY(double rangeSize    READ rangeSize    WRITE setRangeSize   )
   Q_PROPERTY(double maxLineWidth READ maxLineWidth WRITE setMaxLineWidth)
+  Q_PROPERTY(double theta        READ theta        WRITE setTheta       )
 
   // node stroke/fill
   CQCHARTS_NAMED_SHAPE_DATA_PROPERTIES(Node, node)
@@ -146,6 +147,10 @@ class CQChartsForceDirectedPlot : public CQChartsConnectionPlot,
   double maxLineWidth() const { return maxLineWidth_; }
   void setMaxLineWidth(double r);
 
+  // get/set Barnes-Hut repulsion approximation theta (<= 0 for exact)
+  double theta() const { return theta_; }
+  void setTheta(double r);
+
   //---
 
   double maxValue() const { return maxValue_; }
@@ -298,6 +303,7 @@ class CQChartsForceDirectedPlot : public CQChartsConnectionPlot,
   int    initSteps_           { 100 };  //!< initial steps
   double stepSize_            { 0.01 }; //!< step size
   double maxLineWidth_        { 8.0 };  //!< max line width
+  double theta_               { 0.5 };  //!< Barnes-Hut approximation theta
 
   // data
   IdConnectionsData idConnections_;              //!< id connections
@@ -829,6 +829,7 @@ class CQChartsGraphPlot : public CQChartsConnectionPlot,
   using GraphObj    = CQChartsGraphGraphObj;
   using PosNodeMap  = std::map<double, Node *>;
   using PosEdgeMap  = std::map<double, Edge *>;
+  using PosSet      = std::set<int>;
 
  public:
   CQChartsGraphPlot(View *view, const ModelP &model);
@@ -1008,28 +1009,41 @@ class CQChartsGraphPlot : public CQChartsConnectionPlot,
 
   bool adjustNodes() const;
   bool adjustGraphNodes(Graph *graph, const Nodes &nodes) const;
+  bool adjustGraphPosNodes(Graph *graph, const Nodes &nodes, const PosSet *posSet) const;
 
   void initPosNodesMap(Graph *graph, const Nodes &nodes) const;
 
-  bool adjustNodeCenters(Graph *graph) const;
+  bool adjustNodeCenters(Graph *graph, const PosSet *posSet=nullptr) const;
 
-  bool removeOverlaps(Graph *graph) const;
+  bool adjustPosNodes(const Nodes &nodes) const;
+
+  bool removeOverlaps(Graph *graph, const PosSet *posSet=nullptr) const;
 
   bool removePosOverlaps(Graph *graph, const Nodes &nodes) const;
 
   void spreadPosNodes(Graph *graph, const Nodes &nodes) const;
 
   bool reorderNodeEdges(Graph *graph, const Nodes &nodes) const;
+  bool reorderNodeEdges(Node *node) const;
 
   void createPosNodeMap(const Nodes &nodes, PosNodeMap &posNodeMap) const;
   void createPosEdgeMap(const Edges &edges, PosEdgeMap &posEdgeMap, bool isSrc) const;
 
   bool adjustNode(Node *node) const;
 
+  bool calcNodeAdjust(Node *node, double &dy) const;
+
   void adjustGraphs() const;
 
   //---
 
+  void saveLayout();
+  void resetLayout();
+
+  bool restoreLayout(Graph *graph, PosSet &posSet) const;
+
+  //---
+
   int minNodeMargin() const { return minNodeMargin_; }
 
   //---
@@ -1077,6 +1091,34 @@ class CQChartsGraphPlot : public CQChartsConnectionPlot,
 //double           nodeYMin_      { 0.0 };   //!< node y min
 //double           nodeYMax_      { 0.0 };   //!< node y max
   int              numGroups_     { 1 };     //!< node number of groups
+
+  //! saved node placement (for warm start of next layout)
+  struct LayoutNode {
+    int    xpos { 0 };   //!< x position (depth)
+    double size { 0.0 }; //!< size (edge sum)
+    double y    { 0.0 }; //!< center y
+  };
+
+  using LayoutNodes = std::map<QString, LayoutNode>;
+
+  //! saved graph layout
+  struct LayoutGraph {
+    int         maxNodeDepth { 0 };   //!< max node depth
+    double      valueScale   { 1.0 }; //!< value scale
+    double      valueMargin  { 0.0 }; //!< value margin
+    LayoutNodes nodes;                //!< nodes by name
+  };
+
+  using LayoutGraphs = std::map<int, LayoutGraph>;
+
+  //! saved layout
+  struct LayoutData {
+    bool         valid { false };          //!< is valid
+    Align        align { Align::JUSTIFY }; //!< align
+    LayoutGraphs graphs;                   //!< graphs by id
+  };
+
+  LayoutData layoutData_; //!< saved layout
 };
 
 #endif
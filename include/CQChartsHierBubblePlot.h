@@ -7,6 +7,7 @@
 #include <CQChartsDisplayRange.h>
 #include <CQChartsData.h>
 #include <QModelIndex>
+#include <QHash>
 
 //---
 
@@ -227,6 +228,10 @@ class CQChartsHierBubbleHierNode : public CQChartsHierBubbleNode {
 
   const Children &getChildren() const { return children_; }
 
+  //! get child hier node/node with name (first added if duplicate names)
+  HierNode *childByName(const QString &name) const { return nameChildren_.value(name); }
+  Node *nodeByName(const QString &name) const { return nameNodes_.value(name); }
+
   //---
 
   void packNodes();
@@ -241,11 +246,16 @@ class CQChartsHierBubbleHierNode : public CQChartsHierBubbleNode {
                      int n) const override;
 
  protected:
-  Nodes    nodes_;             //!< child nodes
-  Pack     pack_;              //!< circle pack
-  Children children_;          //!< child hier nodes
-  int      hierInd_  { -1 };   //!< hier index
-  bool     expanded_ { true }; //!< is expanded
+  using NameChildren = QHash<QString, HierNode*>;
+  using NameNodes    = QHash<QString, Node*>;
+
+  Nodes        nodes_;             //!< child nodes
+  Pack         pack_;              //!< circle pack
+  Children     children_;          //!< child hier nodes
+  NameNodes    nameNodes_;         //!< child nodes by name
+  NameChildren nameChildren_;      //!< child hier nodes by name
+  int          hierInd_  { -1 };   //!< hier index
+  bool         expanded_ { true }; //!< is expanded
 };
 
 //---
@@ -22,6 +22,10 @@ struct CQChartsInputData {
   QStringList columns;                     //!< specific input column names/numbers
   int         numRows           { 100 };   //!< number of rows to generate with tcl expression
   int         maxRows           { -1 };    //!< maximum number of rows to read from file
+  bool        columnar          { false }; //!< store file data in typed columns
+  bool        mapped            { false }; //!< memory map file and parse in parallel
+  bool        progressive       { false }; //!< add file rows in batches after first batch
+  bool        tail              { false }; //!< only load appended rows when file changes
 
   FilterType  filterType { FilterType::SIMPLE }; //!< filter type
   QString     filter;                            //!< tcl expression filter
@@ -2,6 +2,7 @@
 #define CQChartsLoader_H
 
 #include <CQChartsFileType.h>
+#include <CQChartsCorrelation.h>
 #include <QVariant>
 #include <vector>
 
@@ -21,8 +22,9 @@ class QAbstractItemModel;
  */
 class CQChartsLoader {
  public:
-  using InputData   = CQChartsInputData;
-  using ModelFilter = CQChartsModelFilter;
+  using InputData       = CQChartsInputData;
+  using ModelFilter     = CQChartsModelFilter;
+  using CorrelationType = CQChartsCorrelation::Type;
 
  public:
   CQChartsLoader(CQCharts *charts);
@@ -43,7 +45,9 @@ class CQChartsLoader {
 
   CQChartsFilterModel *createTclModel(const InputData &inputData);
 
-  CQChartsFilterModel *createCorrelationModel(QAbstractItemModel *model, bool flip=false);
+  CQChartsFilterModel *createCorrelationModel(QAbstractItemModel *model, bool flip=false,
+                                              const CorrelationType &type=
+                                                CorrelationType::PEARSON);
 
  private:
   void setFilter(ModelFilter *model, const InputData &inputData);
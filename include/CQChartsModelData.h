@@ -3,6 +3,9 @@
 
 #include <CQChartsModelTypes.h>
 #include <CQChartsColumn.h>
+#include <CQChartsColumnValues.h>
+#include <CQChartsSortedValues.h>
+#include <CQGroupBy.h>
 #include <QObject>
 #include <QSharedPointer>
 #include <QModelIndex>
@@ -43,6 +46,8 @@ class CQChartsModelData : public QObject {
   using Columns       = std::vector<CQChartsColumn>;
   using ModelDetails  = CQChartsModelDetails;
   using PropertyModel = CQPropertyViewModel;
+  using ColumnRealsP  = CQChartsColumnRealsP;
+  using SortedValuesP = CQChartsSortedValuesP;
 
 #ifdef CQCHARTS_FOLDED_MODEL
   using FoldedModels = std::vector<CQFoldedModel *>;
@@ -138,6 +143,21 @@ class CQChartsModelData : public QObject {
 
   //---
 
+  //! get cached real values of column for all (top level) rows of specified model.
+  //! Proxy models are resolved once and packed data columns are read directly.
+  ColumnRealsP columnReals(const QAbstractItemModel *model, const CQChartsColumn &column) const;
+
+  //! get cached sorted values (and stats) for values of model column.
+  //! The filter names the subset of rows the values come from (empty for all rows).
+  //! Values are only sorted if they differ from the cached values for the key.
+  SortedValuesP sortedValues(const QAbstractItemModel *model, const CQChartsColumn &column,
+                             const QString &filter, const std::vector<double> &values) const;
+
+  //! reset cached column values
+  void resetColumnValues();
+
+  //---
+
   ModelP currentModel() const;
 
   //---
@@ -223,15 +243,43 @@ class CQChartsModelData : public QObject {
 
   QAbstractItemModel *copy(const CopyData &copyData);
 
-  QAbstractItemModel *join(CQChartsModelData *joinModel, const Columns &joinColumns);
+  //! join type
+  enum class JoinType {
+    INNER, //!< rows with matching key in both models
+    LEFT,  //!< all rows of this model (join model values empty if no match)
+    OUTER  //!< all rows of both models
+  };
+
+  //! join rows of this model to rows of join model with same join column(s) values.
+  //! A row matching multiple join model rows produces a row for each match.
+  QAbstractItemModel *join(CQChartsModelData *joinModel, const Columns &joinColumns,
+                           const JoinType &joinType=JoinType::LEFT);
 
+  //! reshape group columns into rows of group (column) name and value with the other
+  //! column values (row per source row and group column, no keys so no group by)
   QAbstractItemModel *groupColumns(const Columns &groupColumns);
 
+  //! aggregate of column values for group by
+  struct GroupAggregate {
+    CQGroupBy::AggType type     { CQGroupBy::AggType::COUNT }; //!< aggregate type
+    CQChartsColumn     column;                                 //!< value column (invalid for rows)
+    double             quantile { 0.5 };                       //!< quantile (0-1)
+  };
+
+  using GroupAggregates = std::vector<GroupAggregate>;
+
+  //! group rows by group column(s) values into new model with row per group of
+  //! group column values and aggregate values
+  QAbstractItemModel *groupBy(const Columns &groupColumns, const GroupAggregates &aggregates);
+
   void copyHeaderRoles(QAbstractItemModel *toModel) const;
 
   void copyColumnHeaderRoles(QAbstractItemModel *toModel, int c1, int c2) const;
 
  private:
+  ColumnRealsP calcColumnReals(const QAbstractItemModel *model,
+                               const CQChartsColumn &column) const;
+
   void updatePropertyModel();
 
   void connectModel(bool b);
@@ -239,10 +287,12 @@ class CQChartsModelData : public QObject {
  private slots:
   void modelDataChangedSlot(const QModelIndex &, const QModelIndex &);
 
+  void modelAboutToChangeSlot();
+
   void modelLayoutChangedSlot();
   void modelResetSlot();
 
-  void modelRowsInsertedSlot();
+  void modelRowsInsertedSlot(const QModelIndex &parent, int first, int last);
   void modelRowsRemovedSlot();
   void modelColumnsInsertedSlot();
   void modelColumnsRemovedSlot();
@@ -255,9 +305,15 @@ class CQChartsModelData : public QObject {
   // data changed
   void dataChanged();
 
+  // model about to change
+  void modelAboutToChange();
+
   // model changed
   void modelChanged();
 
+  // rows appended to model (emitted before modelChanged)
+  void modelRowsAppended(int first, int last);
+
   // current model of model data changed
   void currentModelChanged();
 
@@ -274,6 +330,12 @@ class CQChartsModelData : public QObject {
   using SelectionModelP = QPointer<QItemSelectionModel>;
   using SelectionModels = std::vector<SelectionModelP>;
 
+  using ColumnRealsKey = std::pair<const QAbstractItemModel *, QString>;
+  using ColumnRealsMap = std::map<ColumnRealsKey, ColumnRealsP>;
+
+  using SortedValuesKey = std::pair<ColumnRealsKey, QString>;
+  using SortedValuesMap = std::map<SortedValuesKey, SortedValuesP>;
+
 #ifdef CQCHARTS_FOLDED_MODEL
   using ModelPArray = std::vector<ModelP>;
 #endif
@@ -311,6 +373,12 @@ class CQChartsModelData : public QObject {
 
   CQFileWatcher* fileWatcher_ { nullptr };
 
+  // cached column values
+  mutable ColumnRealsMap columnReals_;              //!< cached column reals
+  mutable std::mutex     columnMutex_;              //!< column values mutex
+  mutable SortedValuesMap sortedValues_;            //!< cached sorted values
+  mutable std::mutex      sortedMutex_;             //!< sorted values mutex
+
   mutable std::mutex mutex_;                        //!< thread mutex
 };
 
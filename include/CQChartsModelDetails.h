@@ -6,9 +6,12 @@
 #include <CQChartsModelTypes.h>
 #include <CQChartsUtil.h>
 #include <future>
+#include <memory>
+#include <cmath>
 
 class CQChartsModelColumnDetails;
 class CQChartsModelData;
+class CQChartsModelVisitor;
 class CQCharts;
 class CQChartsValueSet;
 
@@ -49,6 +52,9 @@ class CQChartsModelDetails : public QObject {
 
   void reset();
 
+  //! update details for rows appended to end of model (returns false if reset)
+  bool appendRows(int first, int last);
+
   std::vector<int> duplicates() const;
   std::vector<int> duplicates(const CQChartsColumn &column) const;
 
@@ -76,6 +82,8 @@ class CQChartsModelDetails : public QObject {
   void initFullData() const;
 
  private:
+  class ColumnsVisitor;
+
   enum class Initialized {
     NONE,
     SIMPLE,
@@ -217,9 +225,43 @@ class CQChartsModelColumnDetails {
 
   const CQChartsColumnType *columnType() const;
 
+  //! is column type value mapped from model value (calculated from unmapped model data)
+  bool isMappedType() const;
+
+  //! update cached data for rows appended to (flat) model from first row
+  bool addRows(int firstRow);
+
+  //! start/end calculation of cached data by shared visit of model rows (see
+  //! CQChartsModelDetails::updateFull). Returns row visitor or nullptr if no visit needed
+  CQChartsModelVisitor *initVisitData();
+  void termVisitData(int numRows);
+
+ private:
+  class DetailVisitor;
+
+  //! running (Welford) mean and variance of numeric values
+  struct Moments {
+    int    n    { 0 };   //!< number of values
+    double mean { 0.0 }; //!< running mean
+    double m2   { 0.0 }; //!< running sum of squared differences from mean
+
+    void add(double x) {
+      ++n;
+
+      double d = x - mean;
+
+      mean += d/n;
+      m2   += d*(x - mean);
+    }
+
+    double stddev() const { return (n > 0 ? std::sqrt(m2/n) : 0.0); }
+  };
+
  private:
   bool initData();
 
+  void updateVisitorData();
+
   void initType() const;
   bool calcType();
 
@@ -257,6 +299,10 @@ class CQChartsModelColumnDetails {
   bool                  increasing_      { true };    //!< values are increasing
   CQChartsValueSet*     valueSet_        { nullptr }; //!< values
   VariantInds           valueInds_;                   //!< unique values
+  Moments               moments_;                     //!< numeric value moments
+
+  // visitor (kept to update for appended rows)
+  std::unique_ptr<DetailVisitor> visitor_;
 
   // table render data
   int                   preferredWidth_ { -1 };
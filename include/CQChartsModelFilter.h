@@ -8,7 +8,10 @@
 #include <QSortFilterProxyModel>
 
 #include <set>
+#include <vector>
 #include <future>
+#include <atomic>
+#include <cstdint>
 #include <cassert>
 
 class CQCharts;
@@ -23,6 +26,7 @@ class CQChartsModelFilterData {
  public:
   using ColumnFilterMap = std::map<int, CQChartsRegExp>;
   using Type            = CQChartsFilterModelType;
+  using RowSet          = std::set<int>;
 
  public:
   CQChartsModelFilterData() { }
@@ -48,6 +52,9 @@ class CQChartsModelFilterData {
   const QModelIndexList &filterRows() const { return filterRows_; }
   void setFilterRows(const QModelIndexList &filterRows) { filterRows_ = filterRows; }
 
+  const RowSet &filterTopRows() const { return filterTopRows_; }
+  void setFilterTopRows(const RowSet &rows) { filterTopRows_ = rows; }
+
   const ColumnFilterMap &columnFilterMap() const { return columnFilterMap_; }
   void setColumnFilterMap(const ColumnFilterMap &v) { columnFilterMap_ = v; }
 
@@ -75,6 +82,7 @@ class CQChartsModelFilterData {
   bool            invert_         { false };            //!< invert filter
   CQChartsRegExp  regexp_;                              //!< cached regexp for REGEXP
   QModelIndexList filterRows_;                          //!< cached rows (for SELECTED)
+  RowSet          filterTopRows_;                       //!< cached top level rows (for SELECTED)
   ColumnFilterMap columnFilterMap_;                     //!< column filters for SIMPLE
   QString         filterExpr_;                          //!< preprocessed filter for EXPRESSION
 };
@@ -103,7 +111,8 @@ class CQChartsModelFilter : public QSortFilterProxyModel {
     OR
   };
 
-  using Type = CQChartsFilterModelType;
+  using Type        = CQChartsFilterModelType;
+  using FilterDatas = std::vector<CQChartsModelFilterData>;
 
  public:
   CQChartsModelFilter(CQCharts *charts);
@@ -112,6 +121,8 @@ class CQChartsModelFilter : public QSortFilterProxyModel {
 
   CQChartsModelExprMatch *exprMatch() const { return expr_; }
 
+  void setSourceModel(QAbstractItemModel *model) override;
+
   virtual CQChartsExprModel  *exprModel() const = 0;
   virtual QAbstractItemModel *baseModel() const = 0;
 
@@ -205,16 +216,34 @@ class CQChartsModelFilter : public QSortFilterProxyModel {
   bool anyChildMatch(const QModelIndex &ind) const;
 
   bool itemMatch(const QModelIndex &ind) const;
+  bool itemMatch(const FilterDatas &filterDatas, const QModelIndex &ind) const;
 
   bool filterItemMatch(const CQChartsModelFilterData &filterData, const QModelIndex &ind) const;
 
+  //! is top level row accepted (from cached row matches)
+  bool rowAccepted(int row) const;
+
+  void initRowMatches() const;
+
+  void calcRowMatches(int r1, int r2, int column) const;
+
+  void invalidateRowMatches();
+
+  void connectDisconnectSourceSlots(QAbstractItemModel *model, bool b);
+
   QString replaceNamedColumns(QAbstractItemModel *model, const QString &expr) const;
 
+ private slots:
+  void sourceDataChangedSlot(const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                             const QVector<int> &roles);
+  void sourceRowsInsertedSlot(const QModelIndex &parent, int first, int last);
+  void sourceRowsRemovedSlot(const QModelIndex &parent, int first, int last);
+  void sourceResetSlot();
+
  protected:
   using IndexMatches = std::map<QModelIndex, bool>;
   using ExpandInds   = std::set<QModelIndex>;
-
-  using FilterDatas = std::vector<CQChartsModelFilterData>;
+  using RowBits      = std::vector<uint64_t>;
 
   CQCharts*               charts_         { nullptr };
   CQChartsModelExprMatch* expr_           { nullptr };
@@ -225,6 +254,14 @@ class CQChartsModelFilter : public QSortFilterProxyModel {
   mutable ExpandInds      expand_;
   bool                    mapping_        { true };
   mutable std::mutex      mutex_;
+
+  // cached top level row matches (bitmap) for non-hierarchical source model
+  mutable RowBits         rowMatches_;                  //!< row match bits
+  mutable int             numRowMatches_   { 0 };       //!< number of rows in bitmap
+  mutable bool            rowMatchesValid_ { false };   //!< row matches valid
+  mutable bool            rowMatchesHier_  { false };   //!< source model is hierarchical
+  mutable std::atomic<bool> rowMatchesBusy_ { false }; //!< row matches being calculated
+  mutable std::mutex      rowMatchesMutex_;             //!< row matches mutex
 };
 
 #endif
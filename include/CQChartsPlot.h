@@ -25,6 +25,8 @@
 #include <CQChartsDrawUtil.h>
 #include <CQChartsModelTypes.h>
 #include <CQChartsModelIndex.h>
+#include <CQChartsColumnValues.h>
+#include <CQChartsSortedValues.h>
 #include <CHRTime.h>
 
 #include <QAbstractItemModel>
@@ -1046,6 +1048,19 @@ class CQChartsPlot : public CQChartsObj,
   bool modelMappedReal(int row, const Column &col, const QModelIndex &ind,
                        double &r, bool log, double def) const;
 
+  //! get mapped real using cached column values (falls back to model value if no cache)
+  bool modelMappedReal(const CQChartsColumnReals *reals, const ModelIndex &ind,
+                       double &r, bool log, double def) const;
+
+  //---
+
+  //! get cached real values for column of plot model (bulk access for plot update)
+  CQChartsColumnRealsP columnReals(const Column &column) const;
+
+  //! get shared sorted values (and stats) for values of column (from rows named by filter)
+  CQChartsSortedValuesP sortedValues(const Column &column, const QString &filter,
+                                     const std::vector<double> &values) const;
+
   //---
 
   int getRowForId(const QString &id) const;
@@ -1557,6 +1572,15 @@ class CQChartsPlot : public CQChartsObj,
   // TODO: need axis update as well
   virtual bool createObjs(PlotObjs &) const = 0;
 
+  // add objects for rows appended to model (first to last) to current objects and
+  // update calculated range (return false if not supported so all objects are recreated)
+  virtual bool createAppendedObjs(int /*first*/, int /*last*/, Range & /*range*/,
+                                  PlotObjs & /*objs*/) const { return false; }
+
+ protected:
+  // add objects for rows appended to model (returns false if full update needed)
+  bool appendRowsAndObjs(int first, int last);
+
  public:
   // add plotObjects to quad tree (create no data object in no objects)
   virtual void initObjTree();
@@ -1615,6 +1639,9 @@ class CQChartsPlot : public CQChartsObj,
 
   void invalidateObjTree();
 
+  //! update object in search tree after its rect changed (rebuilds tree if not built)
+  void updateObjTreeObj(PlotObj *obj);
+
   bool updateInsideObjects(const Point &w);
 
   Obj *insideObject() const;
@@ -1675,6 +1702,14 @@ class CQChartsPlot : public CQChartsObj,
   bool isPlotObjTreeSet() const { return objTreeData_.isSet; }
   void setPlotObjTreeSet(bool b);
 
+  //! notify plot object selected/inside state changed
+  void plotObjSelectedChanged() { stateObjsData_.selectedValid.store(false); }
+  void plotObjInsideChanged  () { stateObjsData_.insideValid  .store(false); }
+
+  //! get selected/inside plot objects (in draw order)
+  PlotObjs selectedPlotObjs() const;
+  PlotObjs insidePlotObjs() const;
+
   //----
 
   // columns
@@ -2203,6 +2238,11 @@ class CQChartsPlot : public CQChartsObj,
 
   virtual bool objInsideBox(PlotObj *plotObj, const BBox &bbox) const;
 
+  //! can object tree (object rects) be used to find objects inside draw box
+  virtual bool isObjTreeDraw() const { return true; }
+
+  void drawLayerObjs(const Layer::Type &layerType, const BBox &bbox, PlotObjs &objs) const;
+
   //---
 
   // draw axes on foreground
@@ -2491,7 +2531,9 @@ class CQChartsPlot : public CQChartsObj,
   void threadTimerSlot();
 
   // model change slots
+  void modelAboutToChangeSlot();
   void modelChangedSlot();
+  void modelRowsAppendedSlot(int first, int last);
 
   void currentModelChangedSlot();
 
@@ -2952,6 +2994,14 @@ class CQChartsPlot : public CQChartsObj,
   // no data
   bool noData_ { false }; //!< is no data
 
+  // pending rows appended to model (handled on model changed)
+  struct AppendRowsData {
+    int first { -1 }; //!< first appended row
+    int last  { -1 }; //!< last appended row
+  };
+
+  AppendRowsData appendRows_; //!< appended rows
+
   // debug
   bool debugUpdate_   { false }; //!< debug update
   bool debugQuadTree_ { false }; //!< debug quad tree
@@ -2984,6 +3034,17 @@ class CQChartsPlot : public CQChartsObj,
 
   ObjTreeData objTreeData_; //!< object tree data
 
+  //! \brief cached selected and inside objects (for selection and mouse over layers)
+  struct StateObjsData {
+    std::atomic<bool> selectedValid { false }; //!< selected objects valid
+    std::atomic<bool> insideValid   { false }; //!< inside objects valid
+    PlotObjs          selectedObjs;            //!< selected objects
+    PlotObjs          insideObjs;              //!< inside objects
+    std::mutex        mutex;                   //!< mutex
+  };
+
+  mutable StateObjsData stateObjsData_; //!< cached selected and inside objects
+
   //---
 
   UpdateData  updateData_;  //!< update data
@@ -7,6 +7,7 @@
 #include <CQChartsCamera.h>
 #include <CQCharts.h>
 #include <CInterval.h>
+#include <mutex>
 
 class CQChartsPlot3DObj;
 
@@ -144,6 +145,8 @@ class CQChartsPlot3D : public CQChartsGroupPlot {
 
   bool objInsideBox(CQChartsPlotObj *, const BBox &) const override { return true; }
 
+  bool isObjTreeDraw() const override { return false; }
+
   //---
 
   double boxZMin() const { return boxZMin_; }
@@ -209,10 +212,51 @@ class CQChartsPlot3D : public CQChartsGroupPlot {
   using Obj       = CQChartsPlot3DObj;
   using Objs      = std::vector<Obj *>;
   using PointObjs = std::map<Point3D, Objs>;
+  using Reals     = std::vector<double>;
+  using Indices   = std::vector<int>;
+  using ObjsArray = std::vector<const Objs *>;
+
+  //! point objects projected in one batch and depth sorted (reused while camera unchanged)
+  struct DepthData {
+    bool           valid  { false }; //!< points valid for point objs
+    bool           sorted { false }; //!< transformed and sorted for matrix
+    Camera::Matrix matrix;           //!< camera transform matrix
+    Reals          x, y, z;          //!< reference points
+    Reals          tx, ty, tz;       //!< transformed reference points
+    ObjsArray      objs;             //!< objects of reference points
+    Indices        order;            //!< back to front order of reference points
+  };
+
+  //! screen space grid of point object draw boxes for picking
+  struct PickGrid {
+    bool    valid { false }; //!< is valid for draw boxes
+    BBox    bbox;            //!< draw boxes bbox
+    int     nx    { 0 };     //!< number of x cells
+    int     ny    { 0 };     //!< number of y cells
+    Objs    objs;            //!< objects with draw box (in point objs order)
+    Indices cellStart;       //!< start of cell object indices (nx*ny + 1)
+    Indices cellObjs;        //!< object indices per cell
+    Indices bigObjs;         //!< object indices of objects spanning many cells
+  };
+
+  void drawDepthObjs(PaintDevice *device, const PointObjs &pointObjs, DepthData &depthData,
+                     const Camera::Matrix &matrix) const;
+
+  void updatePickGrid() const;
+
+  template<typename FN>
+  void pickObjs(const Point &p, const FN &fn) const;
 
   mutable PointObjs bgPointObjs_;
   mutable PointObjs pointObjs_;
   mutable PointObjs fgPointObjs_;
+
+  mutable DepthData bgDepthData_;
+  mutable DepthData depthData_;
+  mutable DepthData fgDepthData_;
+
+  mutable std::mutex pickMutex_;
+  mutable PickGrid   pickGrid_;
 };
 
 //---
@@ -237,12 +281,17 @@ class CQChartsPlot3DObj : public CQChartsPlotObj {
   const CQChartsPenBrush &penBrush() const { return penBrush_; }
   void setPenBrush(const CQChartsPenBrush &v) { penBrush_ = v; }
 
+  //! transformed reference point (set by CQChartsPlot3D::drawPointObjs before draw)
+  const Point3D &drawRefPoint() const { return drawRefPoint_; }
+  void setDrawRefPoint(const Point3D &p) { drawRefPoint_ = p; }
+
   const BBox &drawBBox() const { return drawBBox_; }
   void setDrawBBox(const BBox &b) { drawBBox_ = b; }
 
  private:
   const CQChartsPlot3D* plot3D_ { nullptr }; //!< parent plot
   Point3D               refPoint_;           //!< reference point
+  Point3D               drawRefPoint_;       //!< transformed reference point
   CQChartsPenBrush      penBrush_;           //!< pen/brush
   mutable BBox          drawBBox_;           //!< draw bounding box
 };
@@ -5,6 +5,7 @@
 
 class CQChartsPlot;
 class CQChartsModelExprMatch;
+class CQChartsExprTcl;
 
 //! plot model visitor
 class CQChartsPlotModelVisitor : public CQChartsModelVisitor {
@@ -25,9 +26,10 @@ class CQChartsPlotModelVisitor : public CQChartsModelVisitor {
   State preVisit(const QAbstractItemModel *model, const VisitData &data) override;
 
  private:
-  const Plot*             plot_ { nullptr };
-  int                     vrow_ { 0 };
-  CQChartsModelExprMatch* expr_ { nullptr };
+  const Plot*             plot_     { nullptr };
+  int                     vrow_     { 0 };
+  CQChartsModelExprMatch* expr_     { nullptr };
+  const CQChartsExprTcl*  prevExpr_ { nullptr };
 };
 
 #endif
@@ -68,6 +68,16 @@ class CQChartsPlotObj : public CQChartsObj {
   //! get parent plot
   Plot *plot() const { return plot_; }
 
+  //! get/set index in plot objects (draw order)
+  int plotInd() const { return plotInd_; }
+  void setPlotInd(int i) { plotInd_ = i; }
+
+  //---
+
+  //! set selected/inside (notify plot of change)
+  void setSelected(bool b) override;
+  void setInside(bool b) override;
+
   //---
 
   //! get type name (for id)
@@ -177,6 +187,22 @@ class CQChartsPlotObj : public CQChartsObj {
 
   //---
 
+  // Sub Select Interface (object containing multiple individually selectable items)
+
+  //! has individually selectable items
+  virtual bool hasSubSelect() const { return false; }
+
+  //! select items at point, in rect or matching (normalized) model indices
+  //! (returns true if item selection changed)
+  virtual bool subSelectPoint  (const Point &, CQChartsSelMod) { return false; }
+  virtual bool subSelectRect   (const BBox &, bool /*inside*/, CQChartsSelMod) { return false; }
+  virtual bool subSelectIndices(const Indices &) { return false; }
+
+  //! has item under mouse changed since inside set
+  virtual bool isSubInsideChanged() const { return false; }
+
+  //---
+
   // Edit Interface
 
   //! handle edit press, move, motion, release
@@ -266,6 +292,7 @@ class CQChartsPlotObj : public CQChartsObj {
 
  protected:
   Plot*                plot_        { nullptr };           //!< parent plot
+  int                  plotInd_     { -1 };                //!< index in plot objects
   DetailHint           detailHint_  { DetailHint::MINOR }; //!< interaction detail hint
   ColorInd             is_;                                //!< set index
   ColorInd             ig_;                                //!< group index
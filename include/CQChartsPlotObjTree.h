@@ -1,10 +1,12 @@
 #ifndef CQChartsPlotObjTree_H
 #define CQChartsPlotObjTree_H
 
-#include <CQChartsQuadTree.h>
+#include <CQChartsFlatQuadTree.h>
 #include <CQChartsGeom.h>
 #include <vector>
+#include <unordered_map>
 #include <future>
+#include <mutex>
 
 class CQChartsPlot;
 class CQChartsPlotObj;
@@ -31,12 +33,26 @@ class CQChartsPlotObjTree {
 
   void clearObjects();
 
+  //! add object to built tree (returns false if tree not built)
+  bool addObject(Obj *obj);
+
+  //! remove object from built tree (returns false if tree not built)
+  bool removeObject(Obj *obj);
+
+  //! update object in built tree after rect or visibility change
+  //! (returns false if tree not built)
+  bool moveObject(Obj *obj);
+
   void objectsAtPoint(const Point &p, Objs &objs) const;
 
   void objectsIntersectRect(const BBox &r, Objs &objs, bool inside) const;
 
   bool objectNearest(const Point &p, double searchX, double searchY, Obj* &obj) const;
 
+  //! get objects which may intersect rect for draw (sorted in plot object order)
+  //! (returns false if tree not built yet)
+  bool drawObjectsIntersectRect(const BBox &r, Objs &objs) const;
+
   bool isBusy() const { return busy_.load(); }
 
   BBox findEmptyBBox(double w, double h) const;
@@ -46,23 +62,37 @@ class CQChartsPlotObjTree {
   void draw(QPainter *painter);
 
  private:
-  using PlotObjTree       = CQChartsQuadTree<Obj, BBox>;
+  using PlotObjTree       = CQChartsFlatQuadTree<Obj, BBox>;
   using PlotObjTreeFuture = std::future<PlotObjTree*>;
+  using ObjRects          = std::unordered_map<Obj*, BBox>;
 
  private:
   static PlotObjTree *addObjectsASync(CQChartsPlotObjTree *plotObjTree);
 
   PlotObjTree *addObjectsThread();
 
+  bool waitTreeUnlocked() const;
+
   void interruptTree();
 
+  void addTreeObject(PlotObjTree *plotObjTree, Obj *obj);
+
+  void removeTreeObject(Obj *obj);
+
+  void objectsAtPointBusy(const Point &p, Objs &objs) const;
+
+  void objectsIntersectRectBusy(const BBox &r, Objs &objs, bool inside) const;
+
  private:
   Plot*              plot_              { nullptr }; //!< parent plot
   PlotObjTree*       plotObjTree_       { nullptr }; //!< object tree
+  Objs               otherObjs_;                     //!< objects not in tree
+  ObjRects           objRects_;                      //!< rect of objects when added to tree
   PlotObjTreeFuture  plotObjTreeFuture_;             //!< future
   bool               wait_              { false };   //!< wait for thread
   std::atomic<bool>  busy_              { false };   //!< busy flag
   std::atomic<bool>  interrupt_         { false };   //!< interrupt flag
+  mutable std::mutex mutex_;                         //!< tree mutex
 };
 
 #endif
@@ -819,6 +819,7 @@ class CQChartsSankeyPlot : public CQChartsConnectionPlot,
   using Graph       = CQChartsSankeyPlotGraph;
   using PosNodeMap  = std::map<double, Node *>;
   using PosEdgeMap  = std::map<double, Edge *>;
+  using PosSet      = std::set<int>;
 
  public:
   CQChartsSankeyPlot(View *view, const ModelP &model);
@@ -1035,26 +1036,39 @@ class CQChartsSankeyPlot : public CQChartsConnectionPlot,
 
   bool adjustNodes() const;
   bool adjustGraphNodes(const Nodes &nodes) const;
+  bool adjustGraphPosNodes(const Nodes &nodes, const PosSet *posSet) const;
 
   void initPosNodesMap(const Nodes &nodes) const;
 
-  bool adjustNodeCenters() const;
+  bool adjustNodeCenters(const PosSet *posSet=nullptr) const;
+
+  bool adjustPosNodes(const Nodes &nodes) const;
 
   bool adjustEdgeOverlaps() const;
 
-  bool removeOverlaps() const;
+  bool removeOverlaps(const PosSet *posSet=nullptr) const;
 
   bool removePosOverlaps(const Nodes &nodes) const;
 
   void spreadPosNodes(const Nodes &nodes) const;
 
   bool reorderNodeEdges(const Nodes &nodes) const;
+  bool reorderNodeEdges(Node *node) const;
 
   void createPosNodeMap(const Nodes &nodes, PosNodeMap &posNodeMap) const;
   void createPosEdgeMap(const Edges &edges, PosEdgeMap &posEdgeMap, bool isSrc) const;
 
   bool adjustNode(Node *node) const;
 
+  bool calcNodeAdjust(Node *node, double &dy) const;
+
+  //---
+
+  void saveLayout();
+  void resetLayout();
+
+  bool restoreLayout(PosSet &posSet) const;
+
   //---
 
   int minNodeMargin() const { return minNodeMargin_; }
@@ -1105,6 +1119,28 @@ class CQChartsSankeyPlot : public CQChartsConnectionPlot,
 
   mutable IMinMax pathIdMinMax_; //!< min/max path id
 
+  //! saved node placement (for warm start of next layout)
+  struct LayoutNode {
+    int    xpos { 0 };   //!< x position (depth)
+    double size { 0.0 }; //!< size (edge sum)
+    double y    { 0.0 }; //!< center y
+  };
+
+  using LayoutNodes = std::map<QString, LayoutNode>;
+
+  //! saved layout
+  struct LayoutData {
+    bool        valid       { false };          //!< is valid
+    Align       align       { Align::JUSTIFY }; //!< align
+    int         minX        { 0 };              //!< min x pos
+    int         maxX        { 0 };              //!< max x pos
+    double      valueScale  { 1.0 };            //!< value scale
+    double      valueMargin { 0.0 };            //!< value margin
+    LayoutNodes nodes;                          //!< nodes by name
+  };
+
+  LayoutData layoutData_; //!< saved layout
+
  public:
   //! draw text data
   struct DrawText : public CQChartsRectPlacer::RectData {
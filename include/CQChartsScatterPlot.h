@@ -6,6 +6,7 @@
 #include <CQChartsBoxWhisker.h>
 #include <CQChartsFitData.h>
 #include <CQChartsGridCell.h>
+#include <CQChartsBivariateDensity.h>
 #include <CQChartsImage.h>
 #include <CQStatData.h>
 #include <CInterval.h>
@@ -172,6 +173,144 @@ class CQChartsScatterPointObj : public CQChartsPlotObj {
 
 //---
 
+/*!
+ * \brief Scatter Plot Point Batch object
+ * \ingroup Charts
+ *
+ * Stores many points of a set (with same symbol, size and color) in flat arrays
+ * instead of one plot object per point. Used for large point counts when no
+ * per point style (symbol type, size, color, label, image) columns are specified.
+ *
+ * Points are individually selectable (sub select interface) and the point under
+ * the mouse is used for inside highlight and tip.
+ */
+class CQChartsScatterPointBatchObj : public CQChartsPlotObj {
+  Q_OBJECT
+
+  Q_PROPERTY(int groupInd  READ groupInd )
+  Q_PROPERTY(int numPoints READ numPoints)
+
+ public:
+  using Plot   = CQChartsScatterPlot;
+  using Column = CQChartsColumn;
+  using SelMod = CQChartsSelMod;
+
+ public:
+  CQChartsScatterPointBatchObj(const Plot *plot, int groupInd, const BBox &rect,
+                               const ColorInd &is, const ColorInd &ig, const ColorInd &ib);
+
+  const Plot *plot() const { return plot_; }
+
+  int groupInd() const { return groupInd_; }
+
+  //---
+
+  // points
+  int numPoints() const { return int(xs_.size()); }
+
+  //! reserve space for points
+  void reserve(int n);
+
+  //! add point for (normalized) model row
+  void addPoint(const Point &p, int row);
+
+  //! update rect from points (extended by symbol size in plot units)
+  void updateRect(double sx, double sy);
+
+  Point point(int i) const { return Point(xs_[i], ys_[i]); }
+
+  int row(int i) const { return rows_[i]; }
+
+  //---
+
+  QString typeName() const override { return "points"; }
+
+  QString calcId() const override;
+
+  QString calcTipId() const override;
+
+  //---
+
+  // selected if any point is selected
+  bool isSelected() const override;
+  void setSelected(bool b) override;
+
+  bool isPointSelected(int i) const { return selected_[i]; }
+
+  // inside if point under mouse
+  bool isInside() const override;
+  void setInside(bool b) override;
+
+  //---
+
+  bool inside(const Point &p) const override;
+
+  bool rectIntersect(const BBox &r, bool inside) const override;
+
+  //---
+
+  bool hasSubSelect() const override { return true; }
+
+  bool subSelectPoint  (const Point &p, SelMod selMod) override;
+  bool subSelectRect   (const BBox &r, bool inside, SelMod selMod) override;
+  bool subSelectIndices(const Indices &inds) override;
+
+  bool isSubInsideChanged() const override;
+
+  //---
+
+  void getObjSelectIndices(Indices &inds) const override;
+
+  //---
+
+  void draw(PaintDevice *device) override;
+
+  //---
+
+  void calcPenBrush(PenBrush &penBrush, bool updateState) const;
+
+ private:
+  //! get point symbol bbox (for symbol size in plot units)
+  BBox pointBBox(int i, double sx, double sy) const;
+
+  //! get index of point at position (-1 if none)
+  int pointInd(const Point &p) const;
+
+  //! set point selected
+  bool setPointSelected(int i, bool b);
+
+  //! set point selected depending on selection modifier
+  bool selectPoint(int i, SelMod selMod);
+
+  //! update selected state from selected points and notify plot
+  void updateSelected();
+
+ private:
+  using Reals = std::vector<double>;
+  using Ints  = std::vector<int>;
+  using Bits  = std::vector<bool>;
+
+  //! point state used for pen/brush when drawing
+  struct DrawState {
+    bool set      { false };
+    bool selected { false };
+    bool inside   { false };
+  };
+
+  const Plot*       plot_        { nullptr }; //!< scatter plot
+  int               groupInd_    { -1 };      //!< plot group index
+  Reals             xs_;                      //!< point x values
+  Reals             ys_;                      //!< point y values
+  Ints              rows_;                    //!< point (normalized) model rows
+  Bits              selected_;                //!< point selected flags
+  int               numSelected_ { 0 };       //!< number of selected points
+  int               insideInd_   { -1 };      //!< inside (highlighted) point
+  mutable int       hitInd_      { -1 };      //!< point under mouse
+  mutable DrawState drawState_;               //!< draw point state
+};
+
+//---
+
 /*!
  * \brief Scatter Plot Cell object
  * \ingroup Charts
@@ -367,7 +506,8 @@ class CQChartsScatterPlot : public CQChartsPointPlot,
   Q_PROPERTY(CQChartsColumn labelColumn READ labelColumn WRITE setLabelColumn)
 
   // options
-  Q_PROPERTY(PlotType plotType READ plotType WRITE setPlotType)
+  Q_PROPERTY(PlotType plotType            READ plotType            WRITE setPlotType           )
+  Q_PROPERTY(int      pointBatchThreshold READ pointBatchThreshold WRITE setPointBatchThreshold)
 
   // density map
   Q_PROPERTY(bool   densityMap         READ isDensityMap       WRITE setDensityMap        )
@@ -505,6 +645,14 @@ class CQChartsScatterPlot : public CQChartsPointPlot,
 
   //---
 
+  // number of points above which points are stored in batch objects (<= 0 to disable)
+  int pointBatchThreshold() const { return pointBatchThreshold_; }
+  void setPointBatchThreshold(int n);
+
+  bool isPointBatchValues() const;
+
+  //---
+
   // x/y axis density
   bool isXDensity() const;
   bool isYDensity() const;
@@ -580,11 +728,19 @@ class CQChartsScatterPlot : public CQChartsPointPlot,
 
   bool createObjs(PlotObjs &obj) const override;
 
+  bool createAppendedObjs(int first, int last, Range &range, PlotObjs &objs) const override;
+
   void addPointObjects(PlotObjs &objs) const;
+  void addPointBatchObjects(int groupInd, const ValuesData &valuesData, const ColorInd &is,
+                            const ColorInd &ig, PlotObjs &objs) const;
   void addGridObjects (PlotObjs &objs) const;
   void addHexObjects  (PlotObjs &objs) const;
 
-  void addNameValues() const;
+  CQChartsScatterPointObj *createValuePointObj(int groupInd, const ValueData &valuePoint,
+                                               const ColorInd &is, const ColorInd &ig,
+                                               const ColorInd &iv) const;
+
+  void addNameValues(int firstRow=0) const;
 
   //---
 
@@ -599,14 +755,19 @@ class CQChartsScatterPlot : public CQChartsPointPlot,
 
   //---
 
-  using PointObj = CQChartsScatterPointObj;
-  using CellObj  = CQChartsScatterCellObj;
-  using HexObj   = CQChartsScatterHexObj;
+  using PointObj      = CQChartsScatterPointObj;
+  using PointBatchObj = CQChartsScatterPointBatchObj;
+  using CellObj       = CQChartsScatterCellObj;
+  using HexObj        = CQChartsScatterHexObj;
 
   virtual PointObj *createPointObj(int groupInd, const BBox &rect, const Point &p,
                                    const ColorInd &is, const ColorInd &ig,
                                    const ColorInd &iv) const;
 
+  virtual PointBatchObj *createPointBatchObj(int groupInd, const BBox &rect,
+                                             const ColorInd &is, const ColorInd &ig,
+                                             const ColorInd &ib) const;
+
   virtual CellObj *createCellObj(int groupInd, const BBox &rect, const ColorInd &is,
                                  const ColorInd &ig, int ix, int iy, const Points &points,
                                  int maxN) const;
@@ -756,6 +917,9 @@ class CQChartsScatterPlot : public CQChartsPointPlot,
   using GroupHull     = std::map<int, Hull *>;
   using GroupWhiskers = std::map<int, AxisBoxWhisker *>;
 
+  using NameDensity      = std::map<QString, CQChartsBivariateDensity>;
+  using GroupNameDensity = std::map<int, NameDensity>;
+
   struct DensityMapData {
     bool   visible  { false }; //!< visible
     int    gridSize { 16 };    //!< grid size
@@ -776,7 +940,8 @@ class CQChartsScatterPlot : public CQChartsPointPlot,
   bool uniqueY_ { false }; //!< are y values uniquified (string to int)
 
   // options
-  PlotType plotType_ { PlotType::SYMBOLS }; //!< plot type
+  PlotType plotType_            { PlotType::SYMBOLS }; //!< plot type
+  int      pointBatchThreshold_ { 100000 };            //!< point batch threshold
 
   // axis density data
   AxisDensity*    xAxisDensity_ { nullptr }; //!< x axis whisker density object
@@ -803,6 +968,7 @@ class CQChartsScatterPlot : public CQChartsPointPlot,
   GroupFitData      groupFitData_;      //!< group fit data
   GroupStatData     groupStatData_;     //!< group stat data
   GroupHull         groupHull_;         //!< group hull
+  GroupNameDensity  groupNameDensity_;  //!< group name density map grids
 
   // symbol map
   SymbolMapKeyData symbolMapKeyData_; //!< symbol map key data
@@ -0,0 +1,117 @@
+#ifndef CQChartsSortedValues_H
+#define CQChartsSortedValues_H
+
+#include <CQStatData.h>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+
+/*!
+ * \brief sorted sample of real values with calculated statistics
+ * \ingroup Charts
+ *
+ * Values are sorted once (remembering the input order) so quantiles are O(1) lookups.
+ * Samples are shared (see CQChartsModelData::sortedValues) by the box plot whiskers,
+ * distribution plot stats and model column details instead of each sorting a copy.
+ */
+class CQChartsSortedValues {
+ public:
+  using Values  = std::vector<double>;
+  using Indices = std::vector<int>;
+
+ public:
+  CQChartsSortedValues(const Values &values) {
+    int n = int(values.size());
+
+    // sort values with input index (index keeps order of equal values stable)
+    using ValueInd  = std::pair<double, int>;
+    using ValueInds = std::vector<ValueInd>;
+
+    ValueInds valueInds;
+
+    valueInds.reserve(n);
+
+    for (int i = 0; i < n; ++i)
+      valueInds.push_back(ValueInd(values[i], i));
+
+    std::sort(valueInds.begin(), valueInds.end());
+
+    values_.resize(n);
+    order_ .resize(n);
+
+    for (int i = 0; i < n; ++i) {
+      values_[i] = valueInds[i].first;
+      order_ [i] = valueInds[i].second;
+    }
+
+    //---
+
+    statData_.calcStatValues(values_);
+
+    statData_.calcOutliers(values_, outliers_);
+  }
+
+  //! number of values
+  int size() const { return int(values_.size()); }
+
+  //! get sorted values
+  const Values &values() const { return values_; }
+
+  //! get nth sorted value
+  double value(int i) const { return values_[i]; }
+
+  //! get input index of sorted values
+  const Indices &order() const { return order_; }
+
+  //! get calculated stats
+  const CQStatData &statData() const { return statData_; }
+
+  //! get indices of outlier (sorted) values
+  const Indices &outliers() const { return outliers_; }
+
+  //! get quantile (0-1) value (linear interpolation between closest ranks)
+  double quantile(double p) const {
+    int n = size();
+
+    if (n == 0)
+      return 0.0;
+
+    double h = std::min(std::max(p, 0.0), 1.0)*(n - 1);
+
+    int i = int(std::floor(h));
+
+    if (i >= n - 1)
+      return values_[n - 1];
+
+    return values_[i] + (h - i)*(values_[i + 1] - values_[i]);
+  }
+
+  //! is sorted sample of specified (unsorted) values
+  bool isSame(const Values &values) const {
+    int n = size();
+
+    if (int(values.size()) != n)
+      return false;
+
+    // input values at sorted order must match sorted values
+    for (int i = 0; i < n; ++i) {
+      if (values[order_[i]] != values_[i])
+        return false;
+    }
+
+    return true;
+  }
+
+ private:
+  Values     values_;   //!< sorted values
+  Indices    order_;    //!< input index of sorted values
+  CQStatData statData_; //!< calculated stats
+  Indices    outliers_; //!< outlier indices
+};
+
+using CQChartsSortedValuesP  = std::shared_ptr<CQChartsSortedValues>;
+using CQChartsSortedValuesFn = std::function<CQChartsSortedValuesP (const std::vector<double> &)>;
+
+#endif
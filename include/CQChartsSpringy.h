@@ -3,6 +3,9 @@
 
 #include <vector>
 #include <map>
+#include <future>
+#include <thread>
+#include <algorithm>
 #include <cmath>
 
 namespace Springy {
@@ -419,6 +422,183 @@ namespace Springy {
 
   //-----------
 
+  /*!
+   * \brief Barnes-Hut quad tree of point positions
+   * \ingroup Charts
+   *
+   * Each cell stores the number of points and their centroid so the repulsion from a
+   * distant cell of points can be approximated by a single force from its centroid.
+   */
+  class QuadTree {
+   public:
+    QuadTree() { }
+
+    //! build tree for positions
+    void build(const std::vector<Vector> &positions) {
+      cells_.clear();
+
+      if (positions.empty())
+        return;
+
+      // square root cell containing all positions
+      double xmin = positions[0].x(), xmax = xmin;
+      double ymin = positions[0].y(), ymax = ymin;
+
+      for (const auto &p : positions) {
+        xmin = std::min(xmin, p.x()); xmax = std::max(xmax, p.x());
+        ymin = std::min(ymin, p.y()); ymax = std::max(ymax, p.y());
+      }
+
+      double size = std::max(std::max(xmax - xmin, ymax - ymin)/2.0, 1E-6);
+
+      cells_.reserve(2*positions.size());
+
+      cells_.push_back(Cell((xmin + xmax)/2.0, (ymin + ymax)/2.0, size));
+
+      for (const auto &p : positions)
+        insert(p);
+    }
+
+    //! sum of repulsion directions scaled by inverse square distance from all points
+    //! (cells smaller than theta times their distance use centroid of cell points)
+    Vector force(const Vector &p, double theta) const {
+      double fx = 0.0, fy = 0.0;
+
+      auto addForce = [&](const Cell &cell) {
+        auto d = p.subtract(Vector(cell.sx/cell.count, cell.sy/cell.count));
+
+        // avoid massive forces at small distances (and divide by zero)
+        double distance = d.magnitude() + 0.1;
+
+        auto f = d.normalise().multiply(cell.count/(distance*distance));
+
+        fx += f.x(); fy += f.y();
+      };
+
+      if (cells_.empty())
+        return Vector();
+
+      std::vector<int> stack;
+
+      stack.push_back(0);
+
+      while (! stack.empty()) {
+        const auto &cell = cells_[stack.back()];
+
+        stack.pop_back();
+
+        if (cell.count == 0)
+          continue;
+
+        if (cell.isLeaf()) {
+          addForce(cell);
+          continue;
+        }
+
+        // use centroid if point is outside cell and cell is small compared to distance
+        bool outside = (std::abs(p.x() - cell.xc) > cell.size ||
+                        std::abs(p.y() - cell.yc) > cell.size);
+
+        if (outside) {
+          double dx = p.x() - cell.sx/cell.count;
+          double dy = p.y() - cell.sy/cell.count;
+
+          double size = 2.0*cell.size;
+
+          if (size*size < theta*theta*(dx*dx + dy*dy)) {
+            addForce(cell);
+            continue;
+          }
+        }
+
+        for (int i = 0; i < 4; ++i)
+          stack.push_back(cell.children[i]);
+      }
+
+      return Vector(fx, fy);
+    }
+
+   private:
+    struct Cell {
+      double xc       { 0.0 };              //!< center x
+      double yc       { 0.0 };              //!< center y
+      double size     { 0.0 };              //!< half width
+      int    count    { 0 };                //!< number of points
+      double sx       { 0.0 };              //!< sum of point x
+      double sy       { 0.0 };              //!< sum of point y
+      Vector p;                             //!< single point (leaf)
+      int    children[4] { -1, -1, -1, -1 }; //!< child cells
+
+      Cell(double xc=0.0, double yc=0.0, double size=0.0) :
+       xc(xc), yc(yc), size(size) {
+      }
+
+      bool isLeaf() const { return children[0] < 0; }
+
+      void add(const Vector &p) { ++count; sx += p.x(); sy += p.y(); }
+
+      int childIndex(const Vector &p) const {
+        return (p.x() >= xc ? 1 : 0) + (p.y() >= yc ? 2 : 0);
+      }
+    };
+
+    void insert(const Vector &p) {
+      // coincident points (or points closer than max depth cell size) share a leaf
+      const int maxDepth = 32;
+
+      int c = 0;
+
+      for (int depth = 0; ; ++depth) {
+        if (cells_[c].isLeaf()) {
+          if (cells_[c].count == 0 || depth >= maxDepth) {
+            if (cells_[c].count == 0)
+              cells_[c].p = p;
+
+            cells_[c].add(p);
+
+            return;
+          }
+
+          split(c);
+        }
+
+        cells_[c].add(p);
+
+        c = cells_[c].children[cells_[c].childIndex(p)];
+      }
+    }
+
+    void split(int c) {
+      // add child cells and move leaf point into its child
+      double size = cells_[c].size/2.0;
+
+      for (int i = 0; i < 4; ++i) {
+        double xc = cells_[c].xc + ((i & 1) ? size : -size);
+        double yc = cells_[c].yc + ((i & 2) ? size : -size);
+
+        cells_[c].children[i] = int(cells_.size());
+
+        cells_.push_back(Cell(xc, yc, size));
+      }
+
+      auto p = cells_[c].p;
+
+      auto &child = cells_[cells_[c].children[cells_[c].childIndex(p)]];
+
+      child.p = p;
+      child.count = cells_[c].count;
+      child.sx    = cells_[c].sx;
+      child.sy    = cells_[c].sy;
+    }
+
+   private:
+    using Cells = std::vector<Cell>;
+
+    Cells cells_; //!< cells (root is first)
+  };
+
+  //-----------
+
   /*!
    * \brief Layout
    * \ingroup Charts
@@ -439,6 +619,11 @@ namespace Springy {
 
     Graph *graph() const { return graph_; }
 
+    //! get/set Barnes-Hut theta (max ratio of cell size to distance for a cell of nodes to
+    //! repel as a single node, <= 0 for exact repulsion between all node pairs)
+    double theta() const { return theta_; }
+    void setTheta(double r) { theta_ = r; }
+
     Point *nodePoint(Node *node) const {
       auto *th = const_cast<Layout *>(this);
 
@@ -510,6 +695,14 @@ namespace Springy {
 
     // Physics stuff
     void applyCoulombsLaw() {
+      // approximate using quad tree for large graphs
+      const int minBarnesHutNodes = 256;
+
+      if (theta_ > 0.0 && int(graph_->nodes().size()) >= minBarnesHutNodes) {
+        applyBarnesHutCoulombsLaw();
+        return;
+      }
+
       for (auto n1 : graph_->nodes()) {
         auto point1 = nodePoint(n1);
 
@@ -534,6 +727,33 @@ namespace Springy {
       }
     }
 
+    void applyBarnesHutCoulombsLaw() {
+      auto points = this->points();
+
+      int np = points.size();
+
+      std::vector<Vector> positions;
+
+      positions.reserve(np);
+
+      for (auto *point : points)
+        positions.push_back(point->p());
+
+      QuadTree tree;
+
+      tree.build(positions);
+
+      // each node pair in applyCoulombsLaw applies half the force to both nodes twice
+      double repulsion = 4.0*repulsion_;
+
+      // tree is read only and each node only updates its own point so can run in parallel
+      parallelFor(np, [&](int i) {
+        auto *point = points[i];
+
+        point->applyForce(tree.force(positions[i], theta_).multiply(repulsion));
+      });
+    }
+
     void applyHookesLaw() {
       for (auto edge : graph_->edges()) {
         bool isTemp = false;
@@ -567,25 +787,30 @@ namespace Springy {
     }
 
     void updateVelocity(double timestep) {
-      for (auto node : graph_->nodes()) {
-        auto point = this->nodePoint(node);
+      auto points = this->points();
+
+      parallelFor(int(points.size()), [&](int i) {
+        auto point = points[i];
 
         // Is this, along with updatePosition below, the only places that your
         // integration code exist?
         point->setV(point->v().add(point->a().multiply(timestep)).multiply(damping_));
         point->setA(Vector(0, 0));
-      }
+      });
     }
 
     void updatePosition(double timestep) {
-      for (auto node : graph_->nodes()) {
-        auto point = this->nodePoint(node);
+      auto nodes  = graph_->nodes();
+      auto points = this->points();
+
+      parallelFor(int(points.size()), [&](int i) {
+        auto point = points[i];
 
         // Same question as above; along with updateVelocity, is this all of
         // your integration code?
-        if (! node->isFixed())
+        if (! nodes[i]->isFixed())
           point->setP(point->p().add(point->v().multiply(timestep)));
-      }
+      });
     }
 
     // Calculate the total kinetic energy of the system
@@ -645,6 +870,46 @@ namespace Springy {
       }
     }
 
+   private:
+    using Points = std::vector<Point*>;
+
+    //! get points of graph nodes (in node order)
+    Points points() const {
+      Points points;
+
+      for (auto node : graph_->nodes())
+        points.push_back(nodePoint(node));
+
+      return points;
+    }
+
+    //! call function for indices 0 to n - 1 split over available threads
+    template<typename FUNC>
+    static void parallelFor(int n, const FUNC &f) {
+      auto calcRange = [&](int i1, int i2) {
+        for (int i = i1; i < i2; ++i)
+          f(i);
+      };
+
+      int numThreads = std::max(int(std::thread::hardware_concurrency()), 1);
+
+      const int minThreadItems = 1024;
+
+      if (numThreads > 1 && n > minThreadItems) {
+        std::vector<std::future<void>> futures;
+
+        int n1 = (n + numThreads - 1)/numThreads;
+
+        for (int i1 = 0; i1 < n; i1 += n1)
+          futures.push_back(std::async(std::launch::async, calcRange, i1, std::min(i1 + n1, n)));
+
+        for (auto &future : futures)
+          future.wait();
+      }
+      else
+        calcRange(0, n);
+    }
+
    private:
     using NodePoints  = std::map<int, Point*>;
     using EdgeSprings = std::map<int, Spring*>;
@@ -653,6 +918,7 @@ namespace Springy {
     double      stiffness_          { 400.0 };   //!< spring stiffness constant
     double      repulsion_          { 400.0 };   //!< repulsion constant
     double      damping_            { 0.5 };     //!< velocity damping factor
+    double      theta_              { 0.5 };     //!< Barnes-Hut approximation theta
 //  double      minEnergyThreshold_ { 0.0 };     //!< min energy threshold
     NodePoints  nodePoints_;                     //!< keep track of points associated with nodes
     EdgeSprings edgeSprings_;                    //!< keep track of springs associated with edges
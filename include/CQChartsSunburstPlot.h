@@ -4,6 +4,7 @@
 #include <CQChartsHierPlot.h>
 #include <CQChartsPlotObj.h>
 #include <QModelIndex>
+#include <QHash>
 
 class CQChartsSunburstPlot;
 class CQChartsSunburstRootNode;
@@ -247,6 +248,10 @@ class CQChartsSunburstHierNode : public CQChartsSunburstNode {
 
   const Children &getChildren() const { return children_; }
 
+  //! get child hier node/node with name (first added if duplicate names)
+  HierNode *childByName(const QString &name) const { return nameChildren_.value(name); }
+  Node *nodeByName(const QString &name) const { return nameNodes_.value(name); }
+
   //---
 
   void unplace();
@@ -267,9 +272,14 @@ class CQChartsSunburstHierNode : public CQChartsSunburstNode {
                      const ColorInd &colorInd, int n) const override;
 
  private:
-  Nodes    nodes_;             //!< child nodes
-  Children children_;          //!< child hier nodes
-  bool     expanded_ { true }; //!< is expanded
+  using NameChildren = QHash<QString, HierNode *>;
+  using NameNodes    = QHash<QString, Node *>;
+
+  Nodes        nodes_;             //!< child nodes
+  Children     children_;          //!< child hier nodes
+  NameNodes    nameNodes_;         //!< child nodes by name
+  NameChildren nameChildren_;      //!< child hier nodes by name
+  bool         expanded_ { true }; //!< is expanded
 };
 
 //---
@@ -294,6 +294,9 @@ class CQChartsTablePlot : public CQChartsPlot {
 
   void execDrawBackground(PaintDevice *device) const override;
 
+  // object rects are scrolled so can't use object tree for draw
+  bool isObjTreeDraw() const override { return false; }
+
   //---
 
   void adjustPan() override;
@@ -0,0 +1,76 @@
+#ifndef CQChartsTimeFormat_H
+#define CQChartsTimeFormat_H
+
+#include <QString>
+#include <vector>
+#include <memory>
+
+/*!
+ * \brief Compiled (parsed once) strptime time format
+ * \ingroup Charts
+ *
+ * The format is split into tokens once so strings can be converted to time values
+ * without re-interpreting the format and without the string conversions needed by
+ * strptime. Results match CQChartsUtil::stringToTime (strptime/mktime) for the
+ * supported specifiers:
+ *
+ *   %Y %y %m %d %e %H %I %M %S %p %b %B %h %s %T %D %F %R %n %t %%
+ *
+ * Formats with other specifiers fall back to CQChartsUtil::stringToTime.
+ */
+class CQChartsTimeFormat {
+ public:
+  CQChartsTimeFormat(const QString &format="");
+
+  //! get/set format
+  const QString &format() const { return format_; }
+  void setFormat(const QString &format);
+
+  //! is format compiled (all specifiers supported)
+  bool isCompiled() const { return compiled_; }
+
+  //! convert string to time
+  bool stringToTime(const QString &str, double &t) const;
+
+ private:
+  enum class TokenType {
+    LITERAL,
+    SPACE,
+    YEAR,
+    YEAR2,
+    MONTH,
+    MONTH_NAME,
+    DAY,
+    HOUR,
+    HOUR12,
+    MINUTE,
+    SECOND,
+    AM_PM,
+    EPOCH
+  };
+
+  struct Token {
+    TokenType type { TokenType::LITERAL };
+    QChar     c;
+
+    Token(TokenType type, const QChar &c=QChar()) :
+     type(type), c(c) {
+    }
+  };
+
+  using Tokens = std::vector<Token>;
+
+ private:
+  bool compile();
+
+  bool parse(const QString &str, double &t) const;
+
+ private:
+  QString format_;              //!< format string
+  Tokens  tokens_;              //!< compiled tokens
+  bool    compiled_ { false };  //!< is compiled
+};
+
+using CQChartsTimeFormatP = std::shared_ptr<CQChartsTimeFormat>;
+
+#endif
@@ -6,6 +6,7 @@
 #include <CQChartsDisplayRange.h>
 #include <CQChartsData.h>
 #include <QModelIndex>
+#include <QHash>
 
 //---
 
@@ -222,6 +223,10 @@ class CQChartsTreeMapHierNode : public CQChartsTreeMapNode {
     return children_[i];
   }
 
+  //! get child hier node/node with name (first added if duplicate names)
+  HierNode *childByName(const QString &name) const { return nameChildren_.value(name); }
+  Node *nodeByName(const QString &name) const { return nameNodes_.value(name); }
+
   //---
 
   void packNodes(double x, double y, double w, double h);
@@ -238,11 +243,16 @@ class CQChartsTreeMapHierNode : public CQChartsTreeMapNode {
                      const ColorInd &colorInd, int n) const override;
 
  private:
-  Nodes    nodes_;               //!< child nodes
-  Children children_;            //!< child hier nodes
-  int      hierInd_   { -1 };    //!< hier index
-  bool     showTitle_ { false }; //!< show title
-  bool     expanded_  { true };  //!< is expanded
+  using NameChildren = QHash<QString, HierNode*>;
+  using NameNodes    = QHash<QString, Node*>;
+
+  Nodes        nodes_;               //!< child nodes
+  Children     children_;            //!< child hier nodes
+  NameNodes    nameNodes_;           //!< child nodes by name
+  NameChildren nameChildren_;        //!< child hier nodes by name
+  int          hierInd_   { -1 };    //!< hier index
+  bool         showTitle_ { false }; //!< show title
+  bool         expanded_  { true };  //!< is expanded
 };
 
 //---
@@ -3,6 +3,7 @@
 
 #include <CQChartsUtil.h>
 #include <CQStatData.h>
+#include <CQChartsSortedValues.h>
 #include <CQChartsModelTypes.h>
 #include <vector>
 #include <set>
@@ -34,12 +35,13 @@ class CQChartsRValues {
 
   void clear() {
     values_ .clear();
-    svalues_.clear();
+    sortedValues_.reset();
     valset_ .clear();
     setvals_.clear();
 
     numNull_    = 0;
     calculated_ = false;
+    calcValid_.store(false);
   }
 
   bool isValid() const { return ! values_.empty(); }
@@ -140,7 +142,15 @@ class CQChartsRValues {
 
   bool isOutlier(double i) const;
 
-  double svalue(int i) const { return svalues_[i]; }
+  double svalue(int i) const { return sortedValues_->value(i); }
+
+  // set function to get (shared) sorted values for values
+  void setSortedValuesFn(const CQChartsSortedValuesFn &fn) {
+    sortedValuesFn_ = fn;
+
+    calculated_ = false;
+    calcValid_.store(false);
+  }
 
  private:
   void initCalc() const {
@@ -166,7 +176,8 @@ class CQChartsRValues {
   using SetValues = std::map<int, double>;
 
   OptValues                 values_;               //!< all real values
-  Values                    svalues_;              //!< sorted real values
+  CQChartsSortedValuesP     sortedValues_;         //!< sorted values
+  CQChartsSortedValuesFn    sortedValuesFn_;       //!< sorted values function
   ValueSet                  valset_;               //!< unique indexed real values
   SetValues                 setvals_;              //!< index to real map
   int                       numNull_    { 0 };     //!< number of null values
@@ -197,12 +208,13 @@ class CQChartsIValues {
 
   void clear() {
     values_ .clear();
-    svalues_.clear();
+    sortedValues_.reset();
     valset_ .clear();
     setvals_.clear();
 
     numNull_    = 0;
     calculated_ = false;
+    calcValid_.store(false);
   }
 
   bool isValid() const { return ! values_.empty(); }
@@ -299,7 +311,15 @@ class CQChartsIValues {
 
   bool isOutlier(int v) const;
 
-  double svalue(int i) const { return svalues_[i]; }
+  double svalue(int i) const { return sortedValues_->value(i); }
+
+  // set function to get (shared) sorted values for values
+  void setSortedValuesFn(const CQChartsSortedValuesFn &fn) {
+    sortedValuesFn_ = fn;
+
+    calculated_ = false;
+    calcValid_.store(false);
+  }
 
  private:
   void initCalc() const {
@@ -325,7 +345,8 @@ class CQChartsIValues {
   using SetValues = std::map<int, int>;
 
   OptValues                 values_;               //!< all integer values
-  Values                    svalues_;              //!< sorted integer values
+  CQChartsSortedValuesP     sortedValues_;         //!< sorted values
+  CQChartsSortedValuesFn    sortedValuesFn_;       //!< sorted values function
   ValueSet                  valset_;               //!< unique indexed integer values
   SetValues                 setvals_;              //!< index to integer map
   int                       numNull_    { 0 };     //!< number of null values
@@ -691,6 +712,13 @@ class CQChartsValueSet : public QObject {
 
   void clearVals();
 
+  // set function to get (shared) sorted values for numeric values
+  void setSortedValuesFn(const CQChartsSortedValuesFn &fn) {
+    ivals_.setSortedValuesFn(fn);
+    rvals_.setSortedValuesFn(fn);
+    tvals_.setSortedValuesFn(fn);
+  }
+
   //---
 
   bool canMap() const;
@@ -442,6 +442,9 @@ class CQChartsXYPolylineObj : public CQChartsPlotObj {
 
   bool isOutlier(double y) const;
 
+  //! add points (for appended rows) to end of line
+  void appendPoints(const Polygon &poly);
+
   //---
 
   void resetBestFit();
@@ -534,6 +537,9 @@ class CQChartsXYPolygonObj : public CQChartsPlotObj {
 
   bool isSelectable() const override;
 
+  //! add points (for appended rows) to end of fill under polygon
+  void appendUnderPoints(const Polygon &poly, const Point &underPos);
+
   //---
 
   void getObjSelectIndices(Indices &inds) const override;
@@ -832,6 +838,8 @@ class CQChartsXYPlot : public CQChartsPointPlot,
 
   bool createObjs(PlotObjs &objs) const override;
 
+  bool createAppendedObjs(int first, int last, Range &range, PlotObjs &objs) const override;
+
   //---
 
   void updateColumnNames() override;
@@ -840,8 +848,16 @@ class CQChartsXYPlot : public CQChartsPointPlot,
 
   bool headerSeriesData(std::vector<double> &x) const;
 
+  //! cached x/y column values for row data
+  struct RowColumnReals {
+    CQChartsColumnRealsP              xReals;
+    std::vector<CQChartsColumnRealsP> yReals;
+  };
+
+  void initRowColumnReals(RowColumnReals &reals) const;
+
   bool rowData(const ModelVisitor::VisitData &data, double &x, std::vector<double> &yv,
-               QModelIndex &ind, bool skipBad) const;
+               QModelIndex &ind, bool skipBad, const RowColumnReals *reals=nullptr) const;
 
   //---
 
@@ -988,7 +1004,7 @@ class CQChartsXYPlot : public CQChartsPointPlot,
  private:
   void initAxes();
 
-  void createGroupSetIndPoly(GroupSetIndPoly &groupSetIndPoly) const;
+  void createGroupSetIndPoly(GroupSetIndPoly &groupSetIndPoly, int firstRow=0) const;
   bool createGroupSetObjs(const GroupSetIndPoly &groupSetIndPoly, PlotObjs &objs) const;
 
   bool addBivariateLines(int groupInd, const SetIndPoly &setPoly,
@@ -48,6 +48,9 @@ class CQCsvModel : public CQDataModel {
   //! load CSV from specified file
   bool load(const QString &filename);
 
+  //! load rows appended to file since last load
+  int loadTail() override;
+
   //---
 
   //! save model to CSV file
@@ -58,6 +61,19 @@ class CQCsvModel : public CQDataModel {
   static QString encodeString(const QString &str, const QChar &separator=',');
 
  protected:
+  //! create memory mapped parser for file
+  CQCsvParser *createParser() const;
+
+  //! load CSV using memory mapped parallel parser
+  bool loadMapped();
+
+  //! process meta data fields
+  template<typename META>
+  void processMeta(const META &meta);
+
+  //! process meta data from memory mapped parser
+  void processParserMeta(const CQCsvParser &parser) override;
+
   //! encode variant (suitable for CSV value)
   static std::string encodeVariant(const QVariant &var, const QChar &separator=',');
 
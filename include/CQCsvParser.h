@@ -0,0 +1,146 @@
+#ifndef CQCsvParser_H
+#define CQCsvParser_H
+
+#include <QFile>
+#include <QByteArray>
+#include <QString>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+/*!
+ * \brief memory mapped parser for delimiter separated (csv/tsv) files
+ *
+ * The file is memory mapped and scanned once to find the record boundaries
+ * (respecting quoted separators and newlines), the header line and meta data.
+ * Records can then be split into fields independently (and so in parallel)
+ * without copying the whole file into intermediate strings.
+ *
+ * The scan can be done in steps (open then scan a number of records at a time) so
+ * records can be processed while the rest of the file is still being read, and can
+ * start at a file position to only read data appended since a previous scan.
+ *
+ * Supports:
+ *  . comment lines (starting with #) optionally using first as header
+ *  . meta data block (#META_DATA ... #END_META_DATA)
+ *  . first (non-comment) line header
+ *  . quoted fields with "" escapes (optional)
+ */
+class CQCsvParser {
+ public:
+  using Fields     = std::vector<QString>;
+  using MetaFields = std::vector<std::string>;
+  using Meta       = std::vector<MetaFields>;
+
+ public:
+  CQCsvParser(const QString &filename);
+ ~CQCsvParser();
+
+  //! get/set field separator
+  char separator() const { return separator_; }
+  void setSeparator(char c) { separator_ = c; }
+
+  //! get/set fields can be quoted
+  bool isQuoted() const { return quoted_; }
+  void setQuoted(bool b) { quoted_ = b; }
+
+  //! get/set use first line comment for horizontal header
+  bool isCommentHeader() const { return commentHeader_; }
+  void setCommentHeader(bool b) { commentHeader_ = b; }
+
+  //! get/set use first line as horizontal header
+  bool isFirstLineHeader() const { return firstLineHeader_; }
+  void setFirstLineHeader(bool b) { firstLineHeader_ = b; }
+
+  //! get/set allow meta data
+  bool isAllowMeta() const { return allowMeta_; }
+  void setAllowMeta(bool b) { allowMeta_ = b; }
+
+  //! get/set maximum number of data records to scan (<= 0 for all)
+  int maxRecords() const { return maxRecords_; }
+  void setMaxRecords(int i) { maxRecords_ = i; }
+
+  //! get/set file position to start scan (header is assumed to be before start)
+  qint64 startPos() const { return startPos_; }
+  void setStartPos(qint64 pos) { startPos_ = pos; }
+
+  //! get/set only scan complete (newline terminated) records
+  bool isCompleteRecords() const { return completeRecords_; }
+  void setCompleteRecords(bool b) { completeRecords_ = b; }
+
+  //---
+
+  //! map file and scan records
+  bool load();
+
+  //! map file (records are found by scan)
+  bool open();
+
+  //! scan up to maxNew more records (<= 0 for all)
+  //! (returns true if there are more records to scan)
+  bool scan(int maxNew=-1);
+
+  //! get is scan complete
+  bool isScanDone() const { return scanDone_; }
+
+  //! get file position after last scanned record
+  qint64 scanPos() const { return startPos_ + std::min(pos_, size_); }
+
+  //! get header fields
+  const Fields &header() const { return header_; }
+
+  //! get meta data fields
+  const Meta &meta() const { return meta_; }
+
+  //! get number of data records
+  int numRecords() const { return int(records_.size()); }
+
+  //! get maximum number of fields in data records
+  int maxFields() const { return maxFields_; }
+
+  //! split data record into fields (thread safe)
+  void parseRecord(int i, Fields &fields) const;
+
+ private:
+  struct Record {
+    qint64 pos { 0 }; //!< start position in data
+    int    len { 0 }; //!< length (excluding newline)
+
+    Record(qint64 pos=0, int len=0) :
+     pos(pos), len(len) {
+    }
+  };
+
+  using Records = std::vector<Record>;
+
+ private:
+  void splitFields(const char *str, int len, Fields &fields) const;
+
+  void splitComment(const char *str, int len, Fields &fields) const;
+
+ private:
+  QString     filename_;                    //!< file name
+  QFile       file_;                        //!< file
+  QByteArray  bytes_;                       //!< file data (if can't be mapped)
+  const char* data_            { nullptr }; //!< file data
+  qint64      size_            { 0 };       //!< file data size
+  char        separator_       { ',' };     //!< field separator
+  bool        quoted_          { true };    //!< fields can be quoted
+  bool        commentHeader_   { false };   //!< first comment line has column names
+  bool        firstLineHeader_ { false };   //!< first non-comment line has column names
+  bool        allowMeta_       { true };    //!< allow meta data
+  int         maxRecords_      { -1 };      //!< max records to scan
+  qint64      startPos_        { 0 };       //!< file position to start scan
+  bool        completeRecords_ { false };   //!< only scan newline terminated records
+  Fields      header_;                      //!< header fields
+  Meta        meta_;                        //!< meta data fields
+  Records     records_;                     //!< data records
+  int         maxFields_       { 0 };       //!< max fields in data record
+  qint64      pos_             { 0 };       //!< current scan position
+  bool        inMeta_          { false };   //!< scan in meta data block
+  bool        isFirstComment_  { true };    //!< next comment is first comment
+  bool        headerSet_       { false };   //!< header has been set
+  bool        scanDone_        { false };   //!< scan complete
+};
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef CQDataColumn_H
+#define CQDataColumn_H
+
+#include <CQBaseModelTypes.h>
+#include <QVariant>
+#include <QString>
+#include <QHash>
+#include <vector>
+#include <cstdint>
+
+/*!
+ * \brief typed column storage for CQDataModel
+ *
+ * Values are appended as strings (dictionary encoded) and then packed into the
+ * most compact representation supported by the column values:
+ *  . INTEGER : contiguous array of long
+ *  . REAL    : contiguous array of double
+ *  . STRING  : array of dictionary codes into unique string list
+ *  . VARIANT : array of variants (fallback for non-string input or mixed edits)
+ *
+ * Missing values (short rows or empty values in numeric columns) are recorded
+ * in a null bitmap and returned as an invalid variant.
+ */
+class CQDataColumn {
+ public:
+  enum class Type {
+    STRING,
+    INTEGER,
+    REAL,
+    VARIANT
+  };
+
+  using Code = uint32_t;
+
+ public:
+  CQDataColumn() = default;
+
+  //! get column storage type
+  const Type &type() const { return type_; }
+
+  //! get number of values
+  int size() const { return size_; }
+
+  //! is column packed as number
+  bool isNumeric() const { return (type_ == Type::INTEGER || type_ == Type::REAL); }
+
+  //---
+
+  //! clear values
+  void clear();
+
+  //! reserve space for values
+  void reserve(int n);
+
+  //! append value
+  void append(const QVariant &var);
+  void appendString(const QString &str);
+  void appendNull();
+
+  //! pack values into numeric storage if possible (type is optional hint)
+  void pack(CQBaseModelType hint=CQBaseModelType::NONE);
+
+  //---
+
+  //! is value at row null
+  bool isNull(int row) const { return (! nulls_.empty() && nulls_[row]); }
+
+  //! get value at row
+  QVariant value(int row) const;
+
+  //! set value at row (converts storage type if needed)
+  void setValue(int row, const QVariant &var);
+
+  //---
+
+  //! direct typed access (valid only for matching type)
+  const std::vector<long>   &integers() const { return integers_; }
+  const std::vector<double> &reals   () const { return reals_; }
+  const std::vector<Code>   &codes   () const { return codes_; }
+
+  const QString &codeString(Code code) const { return strings_[code]; }
+
+  //! number of unique strings (STRING type)
+  int numStrings() const { return strings_.size(); }
+
+  //---
+
+  //! estimated memory used by column
+  size_t memUsage() const;
+
+  //---
+
+  //! shortest string for real which converts back to the same value (as used for packing)
+  static QString realToString(double r);
+
+ private:
+  Code stringCode(const QString &str);
+
+  void setNull(int row, bool b);
+
+  static QVariant integerValue(long i);
+
+  void toVariant();
+
+ private:
+  using Strings    = std::vector<QString>;
+  using StringInds = QHash<QString,Code>;
+  using Variants   = std::vector<QVariant>;
+  using Nulls      = std::vector<bool>;
+
+  Type                type_ { Type::STRING }; //!< storage type
+  int                 size_ { 0 };            //!< number of values
+  std::vector<long>   integers_;              //!< integer values
+  std::vector<double> reals_;                 //!< real values
+  std::vector<Code>   codes_;                 //!< string dictionary codes
+  Strings             strings_;               //!< unique strings
+  StringInds          stringInds_;            //!< unique string index
+  Variants            variants_;              //!< fallback variant values
+  Nulls               nulls_;                 //!< null bitmap (empty if no nulls)
+};
+
+#endif
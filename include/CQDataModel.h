@@ -2,22 +2,36 @@
 #define CQDataModel_H
 
 #include <CQBaseModel.h>
+#include <CQDataColumn.h>
 #include <QRegExp>
 #include <vector>
+#include <memory>
 
 class CQModelDetails;
+class CQCsvParser;
 
 /*!
  * \brief model derived from base model which supports a 2d array of variant values
  *
  * Can be made writable to update values.
+ *
+ * Values are stored per row as variants or, when columnar is enabled, per column as
+ * typed arrays (see CQDataColumn) which are packed once the model is loaded.
+ *
+ * Files loaded with the memory mapped parser can be loaded progressively (rows are added
+ * in batches from the event loop after the first batch is loaded) and, for files which
+ * only grow, reloaded by parsing just the rows appended since the last load.
  */
 class CQDataModel : public CQBaseModel {
   Q_OBJECT
 
-  Q_PROPERTY(bool    readOnly READ isReadOnly WRITE setReadOnly)
-  Q_PROPERTY(QString filter   READ filter     WRITE setFilter  )
-  Q_PROPERTY(QString filename READ filename   WRITE setFilename)
+  Q_PROPERTY(bool    readOnly    READ isReadOnly    WRITE setReadOnly   )
+  Q_PROPERTY(QString filter      READ filter        WRITE setFilter     )
+  Q_PROPERTY(QString filename    READ filename      WRITE setFilename   )
+  Q_PROPERTY(bool    columnar    READ isColumnar    WRITE setColumnar   )
+  Q_PROPERTY(bool    mapped      READ isMapped      WRITE setMapped     )
+  Q_PROPERTY(bool    progressive READ isProgressive WRITE setProgressive)
+  Q_PROPERTY(bool    tail        READ isTail        WRITE setTail       )
 
  public:
   CQDataModel();
@@ -31,6 +45,9 @@ class CQDataModel : public CQBaseModel {
   //! resize
   void resizeMode(int numCols, int numRows) { init(numCols, numRows); }
 
+  //! set all rows of cells (bulk load of generated data, resets model)
+  void setRowsData(int numCols, std::vector<std::vector<QVariant>> &&rows);
+
   //---
 
   //! get/set read only
@@ -53,6 +70,45 @@ class CQDataModel : public CQBaseModel {
 
   //--
 
+  //! get/set use columnar (typed column) storage
+  bool isColumnar() const { return columnar_; }
+  void setColumnar(bool b);
+
+  //! get is data stored in typed columns
+  bool isPacked() const { return packed_; }
+
+  //! move row data into typed columns and pack columns to numeric types
+  void packColumns();
+
+  //! unpack typed columns into row data
+  void unpackColumns();
+
+  //! get typed column data (only valid if packed)
+  const CQDataColumn *dataColumn(int column) const;
+
+  //--
+
+  //! get/set load file using memory mapped parallel parser
+  bool isMapped() const { return mapped_; }
+  void setMapped(bool b) { mapped_ = b; }
+
+  //! get/set load mapped file progressively (rows added in batches after load returns)
+  bool isProgressive() const { return progressive_; }
+  void setProgressive(bool b) { progressive_ = b; }
+
+  //! get is progressive load in progress
+  bool isLoading() const { return !! parser_; }
+
+  //! get/set file only has rows appended (on change only new rows are loaded)
+  bool isTail() const { return tail_; }
+  void setTail(bool b) { tail_ = b; }
+
+  //! load rows appended to file since last load. Returns number of rows added or -1 if
+  //! not supported or file is not an append of previous file (needs full load)
+  virtual int loadTail() { return -1; }
+
+  //--
+
   // model interface
   int columnCount(const QModelIndex &parent=QModelIndex()) const override;
 
@@ -75,18 +131,45 @@ class CQDataModel : public CQBaseModel {
 
   Qt::ItemFlags flags(const QModelIndex &index) const override;
 
+ signals:
+  //! signals when progressive load complete
+  void loadFinished();
+
  protected slots:
   void resetColumnCache(int column);
 
+  void progressiveLoadSlot();
+
  protected:
-  using Cells = std::vector<QVariant>;
-  using Data  = std::vector<Cells>;
+  using Cells   = std::vector<QVariant>;
+  using Data    = std::vector<Cells>;
+  using Columns = std::vector<CQDataColumn>;
 
  protected:
   void init(int numCols, int numRows);
 
   //---
 
+  //! number of data rows (row or column storage)
+  int numDataRows() const;
+
+  //! add row of cells (to row or column storage)
+  void addRow(const Cells &cells);
+
+  //! clear row and column storage
+  void clearData();
+
+  //! get cell value (row or column storage)
+  QVariant cellValue(int row, int column) const;
+
+  //! get row cells (row or column storage)
+  Cells rowCells(int row) const;
+
+  //! move row storage into column storage
+  void moveRowsToColumns();
+
+  //---
+
   virtual void initFilter();
 
   virtual bool isFilterInited() const { return filterInited_; }
@@ -102,6 +185,53 @@ class CQDataModel : public CQBaseModel {
 
   void applyFilterColumns(const QStringList &columns);
 
+  //---
+
+  //! load rows from parsed file (fields split in parallel, max rows and columns applied)
+  void loadParserRows(const CQCsvParser &parser, bool firstColumnHeader,
+                      int maxRows, const QStringList &columns);
+
+  //! init header and column selection for load from parsed file
+  void initParserRows(const CQCsvParser &parser, bool firstColumnHeader,
+                      int maxRows, const QStringList &columns);
+
+  //! split parsed records r1 to r2 (exclusive) into filtered rows
+  void parseParserRows(const CQCsvParser &parser, int r1, int r2, Data &rows, Cells &vheaders);
+
+  //! add parsed rows to model
+  void addParserRows(Data &rows, Cells &vheaders);
+
+  //! update column types and storage after load from parsed file
+  void finishParserLoad(const CQCsvParser &parser);
+
+  //! add parsed records r1 to r2 (exclusive) to end of model (with insert notification)
+  //! and return number of rows added
+  int insertParserRows(const CQCsvParser &parser, int r1, int r2);
+
+  //! load records appended to file since previous parser load (see loadTail)
+  int loadParserTail(CQCsvParser &parser);
+
+  //! set file position after parsed data (and save data to detect replaced file)
+  void setParserPos(qint64 pos);
+
+  //! get start of file and data before pos (to check previously parsed data is unchanged)
+  QByteArray parserCheckData(qint64 pos) const;
+
+  //! process parsed file meta data
+  virtual void processParserMeta(const CQCsvParser &) { }
+
+  //---
+
+  //! start progressive load from parser (takes ownership of parser)
+  bool startParserLoad(CQCsvParser *parser, bool firstColumnHeader,
+                       int maxRows, const QStringList &columns);
+
+  //! get are all rows loaded from parser
+  bool parserLoadDone() const;
+
+  //! complete progressive load
+  void finishProgressiveLoad();
+
  protected:
   struct FilterData {
     int     column { -1 };
@@ -111,12 +241,36 @@ class CQDataModel : public CQBaseModel {
 
   typedef std::vector<FilterData> FilterDatas;
 
+  struct ParserLoadData {
+    using ColumnInds = std::vector<int>;
+
+    bool       firstColumnHeader { false }; //!< first column is vertical header
+    int        maxRows           { -1 };    //!< max rows to add
+    ColumnInds columnInds;                  //!< source column for each output column
+    bool       filtered          { false }; //!< rows are filtered
+    int        numRecords        { 0 };     //!< number of records processed
+    int        numRows           { 0 };     //!< number of rows added
+  };
+
+  using ParserP = std::unique_ptr<CQCsvParser>;
+
   bool            readOnly_     { false };   //!< is read only
   QString         filter_;                   //!< filter text
   QString         filename_;                 //!< input filename
   Cells           hheader_;                  //!< horizontal header values
   Cells           vheader_;                  //!< vertical header values
   Data            data_;                     //!< row values
+  bool            columnar_     { false };   //!< use columnar storage
+  bool            mapped_       { false };   //!< use memory mapped parallel parser
+  bool            progressive_  { false };   //!< load mapped file progressively
+  ParserP         parser_;                   //!< parser for progressive load
+  ParserLoadData  parserLoadData_;           //!< parser load data
+  bool            tail_         { false };   //!< only load appended rows on change
+  qint64          parserPos_    { -1 };      //!< file position after parsed data
+  QByteArray      parserCheck_;              //!< file data at start and before parserPos_
+  bool            packed_       { false };   //!< values stored in columns_
+  Columns         columns_;                  //!< column values (if columnar)
+  int             numColRows_   { 0 };       //!< number of rows in columns_
   bool            filterInited_ { false };   //!< filter initialized
   FilterDatas     filterDatas_;              //!< filter datas
   CQModelDetails* details_      { nullptr }; //!< model details
@@ -228,7 +228,7 @@ class CQFoldedModel : public QAbstractProxyModel {
 
     void addSourceRow(int r) {
       sourceRows  .push_back(r);
-      sourceRowSet.insert   (r);
+      sourceRowSet.insert   (sourceRowSet.end(), r); // rows added in order
     }
   };
 
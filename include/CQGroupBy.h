@@ -0,0 +1,186 @@
+#ifndef CQGroupBy_H
+#define CQGroupBy_H
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+#include <cmath>
+
+/*!
+ * \brief group by engine
+ *
+ * Rows are grouped by one or more integer coded key columns (see CQGroupBy::KeyCoder).
+ * Groups are numbered in order of first row and the rows of each group are stored
+ * contiguously. Value columns are aggregated per group using streaming aggregators
+ * (count, sum, mean, min, max) calculated as per thread partials which are then merged,
+ * and quantiles calculated from each group's values.
+ */
+class CQGroupBy {
+ public:
+  enum class AggType {
+    COUNT,
+    SUM,
+    MEAN,
+    MIN,
+    MAX,
+    QUANTILE
+  };
+
+  using Codes  = std::vector<int>;
+  using Values = std::vector<double>;
+  using Rows   = std::vector<int>;
+
+  //! aggregate of value column
+  struct Aggregate {
+    AggType type     { AggType::COUNT };
+    int     column   { -1 };  //!< value column (-1 for count of rows)
+    double  quantile { 0.5 }; //!< quantile (0-1) for QUANTILE
+
+    Aggregate(AggType type=AggType::COUNT, int column=-1, double quantile=0.5) :
+     type(type), column(column), quantile(quantile) {
+    }
+  };
+
+  //! code values of type T into dense codes (0 ... n-1) in order of first use
+  template<typename T, typename HASH=std::hash<T>>
+  class KeyCoder {
+   public:
+    KeyCoder() { }
+
+    //! get code for value
+    int code(const T &value) {
+      auto p = codes_.find(value);
+
+      if (p == codes_.end()) {
+        p = codes_.insert(p, typename CodeMap::value_type(value, int(values_.size())));
+
+        values_.push_back(value);
+      }
+
+      return (*p).second;
+    }
+
+    //! number of codes
+    int numCodes() const { return int(values_.size()); }
+
+    //! value for code
+    const T &value(int code) const { return values_[code]; }
+
+   private:
+    using CodeMap = std::unordered_map<T, int, HASH>;
+
+    CodeMap        codes_;  //!< value to code
+    std::vector<T> values_; //!< code to value
+  };
+
+ public:
+  CQGroupBy(int numRows);
+
+  //! number of rows
+  int numRows() const { return nr_; }
+
+  //---
+
+  //! add key column (codes must be in range [0, numCodes), negative code excludes row)
+  void addKeyColumn(const Codes &codes, int numCodes);
+
+  //! add value column (NaN values are missing), returns value column index
+  int addValueColumn(const Values &values);
+
+  //! add aggregate, returns aggregate index
+  int addAggregate(const Aggregate &aggregate);
+
+  //---
+
+  //! group rows and calculate aggregates
+  void calc();
+
+  //---
+
+  //! number of groups
+  int numGroups() const { return ng_; }
+
+  //! get group of row (-1 if excluded)
+  int rowGroup(int r) const { return rowGroups_[r]; }
+
+  //! get first row of group
+  int groupFirstRow(int g) const { return groupRows_[groupStart_[g]]; }
+
+  //! get number of rows in group
+  int groupNumRows(int g) const { return groupStart_[g + 1] - groupStart_[g]; }
+
+  //! get nth row of group
+  int groupRow(int g, int i) const { return groupRows_[groupStart_[g] + i]; }
+
+  //! get aggregate value for group
+  double value(int g, int aggregate) const {
+    return aggValues_[size_t(g)*aggregates_.size() + aggregate];
+  }
+
+ private:
+  //! streaming aggregate of value column
+  struct Accum {
+    int    count { 0 };
+    double sum   { 0.0 };
+    double min   { NAN };
+    double max   { NAN };
+
+    void add(double v) {
+      if (count == 0) {
+        min = v;
+        max = v;
+      }
+      else {
+        min = std::min(min, v);
+        max = std::max(max, v);
+      }
+
+      sum += v;
+
+      ++count;
+    }
+
+    void merge(const Accum &accum) {
+      if (accum.count == 0)
+        return;
+
+      if (count == 0) {
+        min = accum.min;
+        max = accum.max;
+      }
+      else {
+        min = std::min(min, accum.min);
+        max = std::max(max, accum.max);
+      }
+
+      sum   += accum.sum;
+      count += accum.count;
+    }
+  };
+
+  using Accums     = std::vector<Accum>;
+  using KeyColumns = std::vector<Codes>;
+  using NumCodes   = std::vector<int>;
+  using ValueCols  = std::vector<Values>;
+  using Aggregates = std::vector<Aggregate>;
+
+  void calcGroups();
+
+  void calcAccums(Accums &accums) const;
+
+  double calcQuantile(int g, const Aggregate &aggregate, Values &values) const;
+
+ private:
+  int        nr_ { 0 };   //!< number of rows
+  int        ng_ { 0 };   //!< number of groups
+  KeyColumns keyColumns_; //!< key column codes
+  NumCodes   numCodes_;   //!< number of codes per key column
+  ValueCols  valueCols_;  //!< value columns
+  Aggregates aggregates_; //!< aggregates
+  Codes      rowGroups_;  //!< group of each row
+  Codes      groupStart_; //!< start of group rows in groupRows_ (numGroups + 1)
+  Rows       groupRows_;  //!< rows ordered by group
+  Values     aggValues_;  //!< aggregate values (group major)
+};
+
+#endif
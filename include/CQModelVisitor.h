@@ -49,6 +49,9 @@ class CQModelVisitor {
   int maxRows() const { return maxRows_; }
   void setMaxRows(int i) { maxRows_ = i; }
 
+  int firstRow() const { return firstRow_; }
+  void setFirstRow(int i) { firstRow_ = i; }
+
   bool isHierarchical() const;
 
   //---
@@ -98,6 +101,7 @@ class CQModelVisitor {
   int                       maxDepth_         { 0 };       //!< max depth
   int                       numProcessedRows_ { 0 };       //!< total number of rows processed
   int                       maxRows_          { -1 };      //!< maximum number of rows to process
+  int                       firstRow_         { 0 };       //!< first top level row to process
   bool                      hierarchical_     { false };   //!< is hierarchical
   bool                      hierSet_          { false };   //!< is hierarchical set
   mutable std::mutex        mutex_;                        //!< mutex
@@ -4,9 +4,12 @@
 #include <CQBaseModel.h>
 #include <QStringList>
 #include <QString>
+#include <QHash>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <vector>
+#include <mutex>
 #include <cassert>
 
 /*!
@@ -52,13 +55,17 @@ class CQPivotModel : public CQBaseModel {
 
   //---
 
-  void setHColumns(const Columns &columns) { hColumns_ = columns; invalidateModel(); }
-  void setVColumns(const Columns &columns) { vColumns_ = columns; invalidateModel(); }
+  void setHColumns(const Columns &columns) {
+    if (columns != hColumns_) { hColumns_ = columns; invalidateModel(); } }
+  void setVColumns(const Columns &columns) {
+    if (columns != vColumns_) { vColumns_ = columns; invalidateModel(); } }
 
-  void setValueColumn(const Column &column) { valueColumn_ = column; invalidateModel(); }
+  void setValueColumn(const Column &column) {
+    if (column != valueColumn_) { valueColumn_ = column; invalidateModel(); } }
 
   ValueType valueType() const { return valueType_; }
-  void setValueType(ValueType valueType) { valueType_ = valueType; invalidateModel(); }
+  void setValueType(ValueType valueType) {
+    if (valueType != valueType_) { valueType_ = valueType; invalidateModel(); } }
 
   const QString &hheader() const { return hheader_; }
   const QString &vheader() const { return vheader_; }
@@ -66,7 +73,7 @@ class CQPivotModel : public CQBaseModel {
   //---
 
   bool isIncludeTotals() const { return includeTotals_; }
-  void setIncludeTotals(bool b) { includeTotals_ = b; invalidateModel(); }
+  void setIncludeTotals(bool b) { includeTotals_ = b; }
 
   //---
 
@@ -119,12 +126,21 @@ class CQPivotModel : public CQBaseModel {
   double vmin(int r) const;
   double vmax(int r) const;
 
+ private slots:
+  void sourceRowsInsertedSlot(const QModelIndex &parent, int first, int last);
+
+  void sourceChangedSlot();
+
  private:
+  void connectSlots(bool b);
+
   void invalidateModel() { modelValid_ = false; }
 
   void updateModel() const;
   void updateModel();
 
+  void addRows(int row1, int row2);
+
   void calcData();
 
  private:
@@ -153,58 +169,111 @@ class CQPivotModel : public CQBaseModel {
   };
 
   using KeyInd  = std::map<QString,int>;
-  using IndKeys = std::map<int,Keys>;
+  using IndKeys = std::vector<Keys>;
 
+  //! aggregated values for cell
   class Values {
    public:
-    using Reals = std::vector<double>;
+    using Rows = std::vector<int>;
 
    public:
     Values() { }
 
     // add real value
     void add(double r) {
-      min_ = (! rvalues_.empty() ? std::min(min_, r) : r);
-      max_ = (! rvalues_.empty() ? std::max(max_, r) : r);
+      min_ = (rcount_ > 0 ? std::min(min_, r) : r);
+      max_ = (rcount_ > 0 ? std::max(max_, r) : r);
 
       sum_ += r;
 
-      rvalues_.push_back(r);
+      ++rcount_;
+    }
+
+    // add source row and (dictionary encoded) string value id
+    void add(int row, int sid) {
+      rows_.push_back(row);
+
+      if (sid >= 0)
+        sids_.insert(sid);
     }
 
-    // add string value and index
-    void add(const QModelIndex &ind, const QString &s) {
-      inds_   .push_back(ind);
-      svalues_.insert(s);
+    // add values (with string value ids mapped to new ids)
+    void add(const Values &values, const std::vector<int> &sidMap) {
+      if (values.rcount_ > 0) {
+        min_ = (rcount_ > 0 ? std::min(min_, values.min_) : values.min_);
+        max_ = (rcount_ > 0 ? std::max(max_, values.max_) : values.max_);
+      }
+
+      sum_    += values.sum_;
+      rcount_ += values.rcount_;
+
+      rows_.insert(rows_.end(), values.rows_.begin(), values.rows_.end());
+
+      for (const auto &sid : values.sids_)
+        sids_.insert(sidMap[sid]);
     }
 
     double sum() const { return sum_; }
     double min() const { return min_; }
     double max() const { return max_; }
 
-    double mean() const { int nv = rvalues_.size(); return (nv > 0 ? sum_/nv : 0.0); }
+    double mean() const { return (rcount_ > 0 ? sum_/rcount_ : 0.0); }
 
-    int count      () const { return inds_.size(); }
-    int countUnique() const { return svalues_.size(); }
+    int count      () const { return rows_.size(); }
+    int countUnique() const { return sids_.size(); }
 
-    const Inds &inds() const { return inds_; }
+    const Rows &rows() const { return rows_; }
 
-    int          rcount () const { return rvalues_.size(); }
-    const Reals &rvalues() const { return rvalues_; }
+    int rcount() const { return rcount_; }
 
    private:
-    using Strings = std::set<QString>;
-
-    Reals   rvalues_;
-    Inds    inds_;
-    Strings svalues_;
-    double  sum_   { 0.0 };
-    double  min_   { 0.0 };
-    double  max_   { 0.0 };
+    using SIds = std::set<int>;
+
+    Rows   rows_;             //!< source rows
+    SIds   sids_;             //!< unique string value ids
+    int    rcount_ { 0 };     //!< number of real values
+    double sum_    { 0.0 };   //!< sum of real values
+    double min_    { 0.0 };   //!< min of real values
+    double max_    { 0.0 };   //!< max of real values
+  };
+
+  //! cell values keyed by column/row id
+  using CellValues = std::unordered_map<qint64, Values>;
+
+  static qint64 cellKey(int c, int r) { return (qint64(c) << 32) | qint64(uint(r)); }
+
+  static int cellCol(qint64 key) { return int(key >> 32); }
+  static int cellRow(qint64 key) { return int(key & 0xffffffff); }
+
+  //! dictionary encoded strings
+  struct StringIds {
+    QHash<QString,int>   ids;  //!< string to id
+    std::vector<QString> strs; //!< id to string
+
+    int id(const QString &str) {
+      auto p = ids.find(str);
+
+      if (p == ids.end()) {
+        int id = int(strs.size());
+
+        p = ids.insert(str, id);
+
+        strs.push_back(str);
+      }
+
+      return p.value();
+    }
   };
 
-  using VValues  = std::map<QString,Values>;
-  using HVValues = std::map<QString,VValues>;
+  //! values aggregated for range of source rows (local key ids)
+  struct Partition {
+    StringIds  hkeyIds;  //!< horizontal key ids
+    IndKeys    hkeys;    //!< horizontal keys
+    StringIds  vkeyIds;  //!< vertical key ids
+    IndKeys    vkeys;    //!< vertical keys
+    StringIds  valueIds; //!< string value ids
+    CellValues cells;    //!< cell values
+  };
 
   //---
 
@@ -218,6 +287,10 @@ class CQPivotModel : public CQBaseModel {
   using ValueDatas = std::vector<ValueData>;
 
  private:
+  void calcPartition(Partition &partition, int row1, int row2) const;
+
+  void mergePartition(const Partition &partition);
+
   double typeValue(const Values &values) const;
 
  private:
@@ -230,16 +303,19 @@ class CQPivotModel : public CQBaseModel {
 
   // calculated data
   bool                modelValid_ { false }; //!< is data value
+  int                 numRows_    { 0 };     //!< number of source rows added
   KeyInd              hKeysCol_;             //!< horizontal key to column
   IndKeys             hColKeys_;             //!< horizontal column to key
   KeyInd              vKeysRow_;             //!< vertical key to roe
   IndKeys             vRowKeys_;             //!< row to vertical key
-  HVValues            values_;               //!< grid values
+  StringIds           valueIds_;             //!< string value ids
+  CellValues          values_;               //!< grid values (keyed by column/row)
   QString             hheader_;              //!< horizontal header
   QString             vheader_;              //!< vertical header
   ValueDatas          vdata_;                //!< vertical row data
   ValueDatas          hdata_;                //!< horizontal column data
   ValueData           data_;                 //!< data summary
+  mutable std::mutex  mutex_;                //!< update mutex
 };
 
 #endif
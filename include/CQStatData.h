@@ -2,6 +2,7 @@
 #define CQStatData_H
 
 #include <vector>
+#include <algorithm>
 #include <cmath>
 
 /*!
@@ -41,6 +42,7 @@ struct CQStatData {
     stddev      = 0.0;
   }
 
+  //! calc stat values from sorted values
   template<class T>
   void calcStatValues(const std::vector<T> &values) {
     set = true;
@@ -79,63 +81,148 @@ struct CQStatData {
 
       //---
 
-      // calc outlier range - outside range()*(upper - lower)
-      double routlier = upperMedian - lowerMedian;
+      calcRangeValues(values);
+    }
+    else {
+      reset();
+    }
+  }
 
-      loutlier = lowerMedian - outlierRange*routlier;
-      uoutlier = upperMedian + outlierRange*routlier;
+  //! calc stat values from unsorted values using selection (nth_element) instead of sort.
+  //! Values are partially reordered. Use for one-off stats which don't need the value order.
+  template<class T>
+  void calcSelectStatValues(std::vector<T> &values) {
+    set = true;
 
-      //---
+    int nv = values.size();
 
-      // calc min, max, sum and mean
-      min = lowerMedian;
-      max = min;
+    if (nv > 0) {
+      // calc median (values before nv1 are <= median values, values after nv2 are >=)
+      int nv1, nv2;
 
-      sum = 0.0;
+      selectMedianInd(values, 0, nv - 1, nv1, nv2);
 
-      for (auto v : values) {
-        min = std::min(double(v), min);
-        max = std::max(double(v), max);
+      median = (values[nv1] + values[nv2])/2.0;
 
-        sum += v;
-      }
+      // calc lower median
+      if (nv1 > 0) {
+        int nl1, nl2;
 
-      mean = sum/nv;
+        selectMedianInd(values, 0, nv1 - 1, nl1, nl2);
 
-      //---
+        lowerMedian = (values[nl1] + values[nl2])/2.0;
+      }
+      else
+        lowerMedian = values[0];
 
-      // calc standard deviation
-      double sum2 = 0.0;
+      // calc upper median
+      if (nv2 < nv - 1) {
+        int nu1, nu2;
 
-      for (auto v : values) {
-        double dr = v - mean;
+        selectMedianInd(values, nv2 + 1, nv - 1, nu1, nu2);
 
-        sum2 += dr*dr;
+        upperMedian = (values[nu1] + values[nu2])/2.0;
       }
-
-      // TODO: Brussel's correction divides by (n - 1)
-      // TODO: Also sqrt(sum2/nc - mean*mean) ?
-
-      stddev = sqrt(sum2/nv);
+      else
+        upperMedian = values[nv - 1];
 
       //---
 
-      // calc notch (confidence interval around the median +/- 1.57 x IQR/sqrt of n).
-      notch = 1.57*(upperMedian - lowerMedian)/sqrt(nv);
-
-      lnotch = median - notch;
-      unotch = median + notch;
+      calcRangeValues(values);
     }
     else {
       reset();
     }
   }
 
+  //! calc indices of outlier values
+  template<class T>
+  void calcOutliers(const std::vector<T> &values, std::vector<int> &inds) const {
+    inds.clear();
+
+    int n = 0;
+
+    for (const auto &v : values) {
+      if (isOutlier(v))
+        inds.push_back(n);
+
+      ++n;
+    }
+  }
+
   bool isOutlier(double v) const {
     return (v < loutlier || v > uoutlier);
   }
 
  private:
+  // calc outlier range, min, max, sum, mean, stddev and notch (values in any order)
+  template<class T>
+  void calcRangeValues(const std::vector<T> &values) {
+    int nv = values.size();
+
+    // calc outlier range - outside range()*(upper - lower)
+    double routlier = upperMedian - lowerMedian;
+
+    loutlier = lowerMedian - outlierRange*routlier;
+    uoutlier = upperMedian + outlierRange*routlier;
+
+    //---
+
+    // calc min, max, sum and mean
+    min = lowerMedian;
+    max = min;
+
+    sum = 0.0;
+
+    for (auto v : values) {
+      min = std::min(double(v), min);
+      max = std::max(double(v), max);
+
+      sum += v;
+    }
+
+    mean = sum/nv;
+
+    //---
+
+    // calc standard deviation
+    double sum2 = 0.0;
+
+    for (auto v : values) {
+      double dr = v - mean;
+
+      sum2 += dr*dr;
+    }
+
+    // TODO: Brussel's correction divides by (n - 1)
+    // TODO: Also sqrt(sum2/nc - mean*mean) ?
+
+    stddev = sqrt(sum2/nv);
+
+    //---
+
+    // calc notch (confidence interval around the median +/- 1.57 x IQR/sqrt of n).
+    notch = 1.57*(upperMedian - lowerMedian)/sqrt(nv);
+
+    lnotch = median - notch;
+    unotch = median + notch;
+  }
+
+  // select median indices of range (partial sort so values in range before n1 are <= and
+  // values after n2 are >= the median values)
+  template<class T>
+  void selectMedianInd(std::vector<T> &values, int i1, int i2, int &n1, int &n2) {
+    medianInd(i1, i2, n1, n2);
+
+    auto b = values.begin();
+
+    std::nth_element(b + i1, b + n2, b + i2 + 1);
+
+    // lower value of even range is max of values before upper value
+    if (n1 != n2)
+      std::iter_swap(b + n1, std::max_element(b + i1, b + n2));
+  }
+
   void medianInd(int i1, int i2, int &n1, int &n2) {
     int n = i2 - i1 + 1;
 
@@ -42,6 +42,9 @@ class CQTsvModel : public CQDataModel {
   //! load TSV from specified file
   bool load(const QString &filename);
 
+  //! load rows appended to file since last load
+  int loadTail() override;
+
   //! save model to TSV file
   void save(std::ostream &os);
   void save(QAbstractItemModel *model, std::ostream &os);
@@ -52,6 +55,12 @@ class CQTsvModel : public CQDataModel {
   static QString encodeString(const QString &str);
 
  protected:
+  //! create memory mapped parser for file
+  CQCsvParser *createParser() const;
+
+  //! load TSV using memory mapped parallel parser
+  bool loadMapped();
+
   //! encode variant (suitable for TSV value)
   std::string encodeVariant(const QVariant &var) const;
 
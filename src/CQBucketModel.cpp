@@ -233,6 +233,10 @@ connectDisconnectSlots(bool b)
   connectDisconnect(b,
     SIGNAL(modelReset()), SLOT(bucketSlot()));
 
+  connectDisconnect(b,
+    SIGNAL(dataChanged(const QModelIndex &, const QModelIndex &)),
+    SLOT(dataChangedSlot(const QModelIndex &, const QModelIndex &)));
+
   connectDisconnect(b,
     SIGNAL(rowsInserted(const QModelIndex &, int, int)), SLOT(bucketSlot()));
   connectDisconnect(b,
@@ -245,11 +249,22 @@ void
 CQBucketModel::
 bucketSlot()
 {
-  bucketValid_ = true;
+  bucketValid_ = false;
 
   bucket();
 }
 
+void
+CQBucketModel::
+dataChangedSlot(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+  // only changes to bucket column invalidate buckets
+  if (bucketColumn() < topLeft.column() || bucketColumn() > bottomRight.column())
+    return;
+
+  bucketValid_ = false;
+}
+
 void
 CQBucketModel::
 bucket()
@@ -288,11 +303,43 @@ bucket()
 
   //---
 
+  // cache bucket of each top level row
+  int nr = model->rowCount();
+
+  rowBuckets_.resize(nr);
+
+  for (int r = 0; r < nr; ++r) {
+    QModelIndex ind = model->index(r, bucketColumn());
+
+    QVariant var = model->data(ind, bucketRole());
+
+    rowBuckets_[r] = bucketer_.bucket(var);
+  }
+
+  //---
+
   bucketPos_ = 0;
 //bucketPos_ = numColumns;
   bucketed_  = true;
 }
 
+int
+CQBucketModel::
+rowBucket(int r, const QModelIndex &parent) const
+{
+  // only top level rows are cached
+  if (! parent.isValid() && r >= 0 && r < int(rowBuckets_.size()))
+    return rowBuckets_[r];
+
+  QAbstractItemModel *model = this->sourceModel();
+
+  QModelIndex ind = model->index(r, bucketColumn(), parent);
+
+  QVariant var = model->data(ind, bucketRole());
+
+  return bucketer_.bucket(var);
+}
+
 void
 CQBucketModel::
 calcRMinMax(QAbstractItemModel *model, const QModelIndex &parent,
@@ -337,6 +384,8 @@ CQBucketModel::
 clear()
 {
   bucketed_ = false;
+
+  rowBuckets_.clear();
 }
 
 //------
@@ -432,11 +481,7 @@ data(const QModelIndex &index, int role) const
 
   if (! isMultiColumn()) {
     if (role == Qt::DisplayRole || role == Qt::EditRole || role == Qt::ToolTipRole) {
-      QModelIndex ind = model->index(r, bucketColumn(), index.parent());
-
-      QVariant var = model->data(ind, bucketRole());
-
-      int bucket = bucketer_.bucket(var);
+      int bucket = rowBucket(r, index.parent());
 
       if      (role == Qt::DisplayRole) {
         return bucketer_.bucketName(bucket);
@@ -451,11 +496,7 @@ data(const QModelIndex &index, int role) const
   }
   else {
     if (role == Qt::DisplayRole || role == Qt::EditRole) {
-      QModelIndex ind = model->index(r, bucketColumn(), index.parent());
-
-      QVariant var = model->data(ind, bucketRole());
-
-      int bucket = bucketer_.bucket(var);
+      int bucket = rowBucket(r, index.parent());
 
       if      (c1 == -3) {
         return bucket;
@@ -1360,6 +1360,35 @@ procs(ProcType type) const
 
 //---
 
+namespace {
+
+// current expression evaluator is per thread so plots can visit models in parallel
+struct CurrentExprData {
+  const CQCharts*  charts { nullptr };
+  CQChartsExprTcl* expr   { nullptr };
+};
+
+thread_local CurrentExprData currentExprData;
+
+}
+
+const CQChartsExprTcl *
+CQCharts::
+currentExpr() const
+{
+  return (currentExprData.charts == this ? currentExprData.expr : nullptr);
+}
+
+void
+CQCharts::
+setCurrentExpr(CQChartsExprTcl *expr)
+{
+  currentExprData.charts = this;
+  currentExprData.expr   = expr;
+}
+
+//---
+
 void
 CQCharts::
 emitModelTypeChanged(int modelId)
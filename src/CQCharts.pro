@@ -23,15 +23,18 @@ CQCharts.cpp \
 CQChartsFilterModel.cpp \
 CQChartsExprModel.cpp \
 CQChartsExprModelFn.cpp \
+CQChartsCompiledExpr.cpp \
 CQChartsVarsModel.cpp \
 CQChartsTclModel.cpp \
 CQChartsExprDataModel.cpp \
 CQChartsSelectionModel.cpp \
+CQChartsCorrelation.cpp \
 CQChartsCorrelationModel.cpp \
 \
 CQChartsColumn.cpp \
 CQChartsColumnNum.cpp \
 CQChartsColumnType.cpp \
+CQChartsTimeFormat.cpp \
 CQChartsModelIndex.cpp \
 \
 CQChartsTable.cpp \
@@ -314,6 +317,8 @@ CQHierSepModel.cpp \
 \
 CQBaseModel.cpp \
 CQDataModel.cpp \
+CQDataColumn.cpp \
+CQCsvParser.cpp \
 CQModelDetails.cpp \
 CQModelNameValues.cpp \
 CQModelUtil.cpp \
@@ -328,6 +333,7 @@ CQBucketModel.cpp \
 CQCollapseModel.cpp \
 CQPivotModel.cpp \
 CQBucketer.cpp \
+CQGroupBy.cpp \
 CQTrie.cpp \
 \
 CQHandDrawnPainter.cpp \
@@ -349,15 +355,18 @@ HEADERS += \
 ../include/CQChartsFilterModel.h \
 ../include/CQChartsExprModel.h \
 ../include/CQChartsExprModelFn.h \
+../include/CQChartsCompiledExpr.h \
 ../include/CQChartsVarsModel.h \
 ../include/CQChartsTclModel.h \
 ../include/CQChartsExprDataModel.h \
 ../include/CQChartsSelectionModel.h \
+../include/CQChartsCorrelation.h \
 ../include/CQChartsCorrelationModel.h \
 \
 ../include/CQChartsColumn.h \
 ../include/CQChartsColumnNum.h \
 ../include/CQChartsColumnType.h \
+../include/CQChartsTimeFormat.h \
 ../include/CQChartsModelIndex.h \
 \
 ../include/CQChartsTable.h \
@@ -451,6 +460,7 @@ HEADERS += \
 \
 ../include/CQChartsColumnBucket.h \
 ../include/CQChartsValueSet.h \
+../include/CQChartsSortedValues.h \
 ../include/CQChartsPlotSymbol.h \
 ../include/CQChartsSymbol.h \
 ../include/CQChartsImage.h \
@@ -474,6 +484,7 @@ HEADERS += \
 ../include/CQChartsValueInd.h \
 ../include/CQChartsNameValues.h \
 ../include/CQChartsQuadTree.h \
+../include/CQChartsFlatQuadTree.h \
 ../include/CQChartsEnv.h \
 \
 ../include/CQChartsHtmlPaintDevice.h \
@@ -648,11 +659,14 @@ HEADERS += \
 ../include/CQCollapseModel.h \
 ../include/CQPivotModel.h \
 ../include/CQBucketer.h \
+../include/CQGroupBy.h \
 ../include/CQTrie.h \
 \
 ../include/CQBaseModel.h \
 ../include/CQBaseModelTypes.h \
 ../include/CQDataModel.h \
+../include/CQDataColumn.h \
+../include/CQCsvParser.h \
 ../include/CQModelDetails.h \
 ../include/CQModelUtil.h \
 ../include/CQModelVisitor.h \
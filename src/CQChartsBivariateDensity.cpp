@@ -1,10 +1,15 @@
 #include <CQChartsBivariateDensity.h>
 #include <CQChartsPaintDevice.h>
 #include <CQChartsPlot.h>
+#include <CQChartsImage.h>
 
 #include <CMathCorrelation.h>
 #include <CMathRound.h>
 
+#include <QImage>
+#include <future>
+#include <thread>
+
 void
 CQChartsBivariateDensity::
 draw(const CQChartsPlot *plot, CQChartsPaintDevice *device, const Data &data)
@@ -20,55 +25,54 @@ draw(const CQChartsPlot *plot, CQChartsPaintDevice *device, const Data &data)
 
   //---
 
-  // create bivariate map of normalized values
-  std::vector<double> xv;
-  std::vector<double> yv;
+  // calc number of grid cells for pixel size of data range
+  BBox bbox(xmin, ymin, xmax, ymax);
 
-  for (const auto &v : data.values) {
-    double x1 = (xmax > xmin ? CMathUtil::norm(v.x, xmin, xmax) : 0.0);
-    double y1 = (ymax > ymin ? CMathUtil::norm(v.y, ymin, ymax) : 0.0);
+  auto pbbox = plot->windowToPixel(bbox);
 
-    xv.push_back(x1);
-    yv.push_back(y1);
-  }
+  const int maxCells = 2048;
 
-  CMathBivariate bivariate(xv, yv);
+  int nx = std::min(std::max(int(CMathRound::RoundUp(pbbox.getWidth ()/gridSize)), 1), maxCells);
+  int ny = std::min(std::max(int(CMathRound::RoundUp(pbbox.getHeight()/gridSize)), 1), maxCells);
 
   //---
 
-  // calc pixel grid
-  BBox bbox(xmin, ymin, xmax, ymax);
+  // recalc grid if invalid, data range or grid size changed or cell count changed
+  // by more than factor of two (so pan and small zooms reuse cached values)
+  auto cellsChanged = [](int n1, int n2) {
+    return (2*n1 < n2 || 2*n2 < n1);
+  };
 
-  auto pbbox = plot->windowToPixel(bbox);
+  if (! grid_.valid || grid_.gridSize != gridSize || grid_.bbox != bbox ||
+      cellsChanged(grid_.nx, nx) || cellsChanged(grid_.ny, ny)) {
+    calcGrid(data, nx, ny);
 
-  auto ll = pbbox.getLL();
-  auto ur = pbbox.getUR();
+    grid_.gridSize = gridSize;
+  }
 
-  int x1 = CMathRound::RoundDown(ll.x);
-  int x2 = CMathRound::RoundUp  (ur.x);
-  int y1 = CMathRound::RoundUp  (ll.y);
-  int y2 = CMathRound::RoundDown(ur.y);
+  nx = grid_.nx;
+  ny = grid_.ny;
 
-  assert(x1 <= x2);
-  assert(y1 <= y2);
+  //---
 
-  int dx = gridSize;
-  int dy = gridSize;
+  // palette color lookup for values
+  const int nc = 256;
 
-  //---
+  std::vector<QColor> colors(nc);
+
+  for (int i = 0; i < nc; ++i)
+    colors[i] = plot->interpPaletteColor(CQChartsUtil::ColorInd(double(i)/(nc - 1)));
 
-  // calc values for grid
-  for (int y = y1; y <= y2; y += dy) {
-    for (int x = x1; x <= x2; x += dx) {
-      // calc value at normalized pixel sample point (use box center ?)
-      auto p = plot->pixelToWindow(Point(x, y));
+  //---
 
-      double x1 = (xmax > xmin ? CMathUtil::norm(p.x, xmin, xmax) : 0.0);
-      double y1 = (ymax > ymin ? CMathUtil::norm(p.y, ymin, ymax) : 0.0);
+  // colorize grid into image (one pixel per cell, top row is ymax)
+  QImage image(nx, ny, QImage::Format_ARGB32);
 
-      double v = bivariate.calc(x1, y1);
+  for (int iy = 0; iy < ny; ++iy) {
+    auto *line = reinterpret_cast<QRgb *>(image.scanLine(ny - 1 - iy));
 
-      //---
+    for (int ix = 0; ix < nx; ++ix) {
+      double v = grid_.values[iy*nx + ix];
 
       // set alpha for delta (if defined)
       double a = 1.0;
@@ -81,23 +85,85 @@ draw(const CQChartsPlot *plot, CQChartsPaintDevice *device, const Data &data)
 
       //---
 
-      // set brush
-      CQChartsPenBrush penBrush;
+      int ic = CMathUtil::clamp(int(v*(nc - 1) + 0.5), 0, nc - 1);
 
-      QColor c = plot->interpPaletteColor(CQChartsUtil::ColorInd(v));
+      const auto &c = colors[ic];
 
-      plot->setPenBrush(penBrush,
-        CQChartsPenData  (false),
-        CQChartsBrushData(true, c, CQChartsAlpha(a), CQChartsFillPattern()));
+      line[ix] = qRgba(c.red(), c.green(), c.blue(), int(255*a*c.alphaF()));
+    }
+  }
 
-      //---
+  //---
 
-      // fill rect
-      BBox pb1(x, y, x + dx, y + dy);
+  device->drawImageInRect(bbox, CQChartsImage(image));
+}
 
-      CQChartsDrawUtil::setPenBrush(device, penBrush);
+void
+CQChartsBivariateDensity::
+calcGrid(const Data &data, int nx, int ny)
+{
+  const double xmin = data.xrange.min();
+  const double xmax = data.xrange.max();
+  const double ymin = data.yrange.min();
+  const double ymax = data.yrange.max();
+
+  //---
+
+  // create bivariate map of normalized values
+  std::vector<double> xv;
+  std::vector<double> yv;
+
+  xv.reserve(data.values.size());
+  yv.reserve(data.values.size());
+
+  for (const auto &v : data.values) {
+    double x1 = (xmax > xmin ? CMathUtil::norm(v.x, xmin, xmax) : 0.0);
+    double y1 = (ymax > ymin ? CMathUtil::norm(v.y, ymin, ymax) : 0.0);
+
+    xv.push_back(x1);
+    yv.push_back(y1);
+  }
+
+  //---
+
+  grid_.valid = true;
+  grid_.nx    = nx;
+  grid_.ny    = ny;
+  grid_.bbox  = BBox(xmin, ymin, xmax, ymax);
+
+  grid_.values.resize(nx*ny);
+
+  // calc values at normalized cell centers for range of rows
+  // (each thread uses its own bivariate map)
+  auto calcRows = [&](int iy1, int iy2) {
+    CMathBivariate bivariate(xv, yv);
+
+    for (int iy = iy1; iy < iy2; ++iy) {
+      double y1 = (iy + 0.5)/ny;
+
+      for (int ix = 0; ix < nx; ++ix) {
+        double x1 = (ix + 0.5)/nx;
 
-      device->fillRect(plot->pixelToWindow(pb1));
+        grid_.values[iy*nx + ix] = float(bivariate.calc(x1, y1));
+      }
     }
+  };
+
+  int numThreads = std::max(int(std::thread::hardware_concurrency()), 1);
+
+  const int minThreadCells = 4096;
+
+  if (numThreads > 1 && nx*ny > minThreadCells) {
+    std::vector<std::future<void>> futures;
+
+    int n = (ny + numThreads - 1)/numThreads;
+
+    for (int iy1 = 0; iy1 < ny; iy1 += n)
+      futures.push_back(std::async(std::launch::async, calcRows, iy1, std::min(iy1 + n, ny)));
+
+    for (auto &future : futures)
+      future.wait();
   }
+  else
+    calcRows(0, ny);
 }
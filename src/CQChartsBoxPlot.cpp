@@ -20,6 +20,9 @@
 
 #include <QMenu>
 
+#include <future>
+#include <thread>
+
 CQChartsBoxPlotType::
 CQChartsBoxPlotType()
 {
@@ -1184,11 +1187,61 @@ updateRawWhiskers() const
 
   //---
 
+  // share sorted whisker values (stats) with other plots/details for same column values
+  // (single whisker of all values uses unfiltered key)
+  const auto &column = valueColumns().column();
+
+  std::vector<Whisker *> whiskers;
+
   for (auto &groupIdWhiskers : groupWhiskers_) {
+    int groupInd = groupIdWhiskers.first;
+
     const auto &setWhiskerMap = groupIdWhiskers.second;
 
-    for (auto &setWhiskers : setWhiskerMap)
-      setWhiskers.second->init();
+    for (auto &setWhiskers : setWhiskerMap) {
+      int   setId   = setWhiskers.first;
+      auto *whisker = setWhiskers.second;
+
+      QString filter;
+
+      if (groupWhiskers_.size() > 1 || setWhiskerMap.size() > 1)
+        filter = QString("boxplot:%1:%2").arg(groupInd).arg(setId);
+
+      whisker->setSortedValuesFn([this, column, filter](const std::vector<double> &values) {
+        return this->sortedValues(column, filter, values);
+      });
+
+      whiskers.push_back(whisker);
+    }
+  }
+
+  //---
+
+  // calc whiskers (sort values) in parallel
+  int nw = int(whiskers.size());
+
+  int numThreads = std::min(std::max(int(std::thread::hardware_concurrency()), 1), nw);
+
+  if (numThreads > 1) {
+    std::vector<std::future<void>> futures;
+
+    int nw1 = (nw + numThreads - 1)/numThreads;
+
+    for (int i1 = 0; i1 < nw; i1 += nw1) {
+      int i2 = std::min(i1 + nw1, nw);
+
+      futures.push_back(std::async(std::launch::async, [&whiskers, i1, i2]() {
+        for (int i = i1; i < i2; ++i)
+          whiskers[i]->init();
+      }));
+    }
+
+    for (auto &future : futures)
+      future.wait();
+  }
+  else {
+    for (auto *whisker : whiskers)
+      whisker->init();
   }
 }
 
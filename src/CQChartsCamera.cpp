@@ -213,6 +213,61 @@ untransform(const Point3D &p) const
   return Point3D(x, y, z);
 }
 
+CQChartsCamera::Matrix
+CQChartsCamera::
+transformMatrix() const
+{
+  // transform is affine (range map, rotate, orthographic projection, range map) so
+  // matrix is calculated from transformed range center and center offset by range size
+  // in each axis direction
+  double xc = 0.0, yc = 0.0, zc = 0.0;
+  double dx = 1.0, dy = 1.0, dz = 1.0;
+
+  const auto &range3D = plot_->range3D();
+
+  if (range3D.isSet()) {
+    xc = range3D.xmid(); yc = range3D.ymid(); zc = range3D.zmid();
+
+    if (range3D.xsize() > 0.0) dx = range3D.xsize();
+    if (range3D.ysize() > 0.0) dy = range3D.ysize();
+    if (range3D.zsize() > 0.0) dz = range3D.zsize();
+  }
+
+  auto o  = transform(Point3D(xc     , yc     , zc     ));
+  auto px = transform(Point3D(xc + dx, yc     , zc     ));
+  auto py = transform(Point3D(xc     , yc + dy, zc     ));
+  auto pz = transform(Point3D(xc     , yc     , zc + dz));
+
+  Matrix m {{
+    (px.x - o.x)/dx, (py.x - o.x)/dy, (pz.x - o.x)/dz, 0.0,
+    (px.y - o.y)/dx, (py.y - o.y)/dy, (pz.y - o.y)/dz, 0.0,
+    (px.z - o.z)/dx, (py.z - o.z)/dy, (pz.z - o.z)/dz, 0.0
+  }};
+
+  // translation maps center to transformed center
+  m[ 3] = o.x - (m[0]*xc + m[1]*yc + m[ 2]*zc);
+  m[ 7] = o.y - (m[4]*xc + m[5]*yc + m[ 6]*zc);
+  m[11] = o.z - (m[8]*xc + m[9]*yc + m[10]*zc);
+
+  return m;
+}
+
+void
+CQChartsCamera::
+transformPoints(const Matrix &m, int n, const double *x, const double *y, const double *z,
+                double *tx, double *ty, double *tz)
+{
+  // separate loop per output keeps inner loops simple for vectorization
+  for (int i = 0; i < n; ++i)
+    tx[i] = m[0]*x[i] + m[1]*y[i] + m[ 2]*z[i] + m[ 3];
+
+  for (int i = 0; i < n; ++i)
+    ty[i] = m[4]*x[i] + m[5]*y[i] + m[ 6]*z[i] + m[ 7];
+
+  for (int i = 0; i < n; ++i)
+    tz[i] = m[8]*x[i] + m[9]*y[i] + m[10]*z[i] + m[11];
+}
+
 void
 CQChartsCamera::
 planeZRange(double &zmin, double &zmax) const
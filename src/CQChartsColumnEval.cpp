@@ -3,6 +3,7 @@
 #include <CQChartsVariant.h>
 #include <CMathUtil.h>
 #include <QColor>
+#include <memory>
 
 //------
 
@@ -10,12 +11,13 @@ CQChartsColumnEval *
 CQChartsColumnEval::
 instance()
 {
-  static CQChartsColumnEval *inst;
+  // one evaluator per thread (tcl interpreter can only be used by its creating thread)
+  static thread_local std::unique_ptr<CQChartsColumnEval> inst;
 
   if (! inst)
-    inst = new CQChartsColumnEval;
+    inst.reset(new CQChartsColumnEval);
 
-  return inst;
+  return inst.get();
 }
 
 CQChartsColumnEval::
@@ -48,8 +50,6 @@ addFunc(const QString &name, CQTcl::ObjCmdProc proc)
 {
   assert(name.length());
 
-  std::unique_lock<std::mutex> lock(mutex_);
-
   qtcl_->createExprCommand(name, proc, (CQTcl::ObjCmdData) this);
 }
 
@@ -62,8 +62,6 @@ evaluateExpression(const QString &expr, QVariant &value, bool showError)
   if (expr.length() == 0)
     return false;
 
-  std::unique_lock<std::mutex> lock(mutex_);
-
   qtcl_->setModel(const_cast<QAbstractItemModel *>(model()));
   qtcl_->setRow  (row());
 
@@ -1331,8 +1331,8 @@ desc() const
 
 QVariant
 CQChartsColumnTimeType::
-userData(CQCharts *, const QAbstractItemModel *, const CQChartsColumn &, const QVariant &var,
-         const CQChartsModelTypeData &typeData, bool &converted) const
+userData(CQCharts *, const QAbstractItemModel *model, const CQChartsColumn &column,
+         const QVariant &var, const CQChartsModelTypeData &typeData, bool &converted) const
 {
   if (! var.isValid() || var.type() == QVariant::Double)
     return var;
@@ -1344,9 +1344,12 @@ userData(CQCharts *, const QAbstractItemModel *, const CQChartsColumn &, const Q
   if (! fmt.length())
     return var;
 
+  // use compiled format (format is parsed once and reused for all column values)
+  const auto *timeFormat = columnTimeFormat(model, column, fmt);
+
   double t;
 
-  if (! CQChartsUtil::stringToTime(fmt, var.toString(), t))
+  if (! timeFormat->stringToTime(var.toString(), t))
     return var;
 
   converted = true;
@@ -1384,6 +1387,48 @@ dataName(CQCharts *, const QAbstractItemModel *, const CQChartsColumn &, const Q
   return CQChartsUtil::timeToString(fmt, t);
 }
 
+const CQChartsTimeFormat *
+CQChartsColumnTimeType::
+columnTimeFormat(const QAbstractItemModel *model, const CQChartsColumn &column,
+                 const QString &fmt) const
+{
+  // per thread cache of column compiled format (so converting column values does not lock
+  // shared format map), reset if column format string changes
+  struct ColumnFormat {
+    QString             fmt;
+    CQChartsTimeFormatP timeFormat;
+  };
+
+  using ColumnKey     = std::pair<const QAbstractItemModel *, CQChartsColumn>;
+  using ColumnFormats = std::map<ColumnKey, ColumnFormat>;
+
+  static thread_local ColumnFormats columnFormats;
+
+  auto &columnFormat = columnFormats[ColumnKey(model, column)];
+
+  if (! columnFormat.timeFormat || columnFormat.fmt != fmt) {
+    columnFormat.fmt        = fmt;
+    columnFormat.timeFormat = getTimeFormat(fmt);
+  }
+
+  return columnFormat.timeFormat.get();
+}
+
+CQChartsTimeFormatP
+CQChartsColumnTimeType::
+getTimeFormat(const QString &fmt) const
+{
+  std::unique_lock<std::mutex> lock(timeFormatMutex_);
+
+  auto p = timeFormats_.find(fmt);
+
+  if (p == timeFormats_.end())
+    p = timeFormats_.insert(p, TimeFormats::value_type(fmt,
+          std::make_shared<CQChartsTimeFormat>(fmt)));
+
+  return (*p).second;
+}
+
 QString
 CQChartsColumnTimeType::
 getIFormat(const CQChartsNameValues &nameValues) const
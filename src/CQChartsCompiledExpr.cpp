@@ -0,0 +1,1299 @@
+#include <CQChartsCompiledExpr.h>
+
+#include <cmath>
+#include <cstring>
+#include <climits>
+
+namespace {
+
+enum class ValueType {
+  INTEGER,
+  REAL,
+  STRING
+};
+
+// typed expression value
+struct Value {
+  ValueType type    { ValueType::STRING };
+  long long integer { 0 };
+  double    real    { 0.0 };
+  QString   str;
+
+  Value() { }
+
+  static Value makeInteger(long long i) { Value v; v.type = ValueType::INTEGER; v.integer = i; return v; }
+  static Value makeReal   (double r)    { Value v; v.type = ValueType::REAL   ; v.real    = r; return v; }
+  static Value makeString (const QString &s) { Value v; v.str = s; return v; }
+
+  bool isInteger() const { return type == ValueType::INTEGER; }
+  bool isReal   () const { return type == ValueType::REAL; }
+  bool isString () const { return type == ValueType::STRING; }
+
+  double toReal() const { return (isInteger() ? double(integer) : real); }
+};
+
+// string number type
+enum class NumType {
+  NUMBER,
+  STRING,
+  AMBIGUOUS
+};
+
+// classify string as number (plain decimal), string (can't be a tcl number) or
+// ambiguous (tcl may interpret as number e.g. octal, hex, padded or inf/nan)
+NumType parseNumber(const QString &str, Value &value) {
+  int len = str.length();
+
+  if (len == 0)
+    return NumType::STRING;
+
+  int i = 0;
+
+  auto c = str[0];
+
+  if (c != '+' && c != '-' && c != '.' && ! c.isDigit() && c != 'i' && c != 'I' &&
+      c != 'n' && c != 'N' && ! c.isSpace())
+    return NumType::STRING;
+
+  if (c == '+' || c == '-')
+    ++i;
+
+  int intStart = i;
+
+  while (i < len && str[i].isDigit())
+    ++i;
+
+  int numIntDigits = i - intStart;
+
+  // integer (no leading zero so not octal)
+  if (i == len) {
+    if (numIntDigits == 0)
+      return NumType::AMBIGUOUS;
+
+    if (numIntDigits > 1 && str[intStart] == '0')
+      return NumType::AMBIGUOUS;
+
+    if (numIntDigits > 18)
+      return NumType::AMBIGUOUS;
+
+    bool ok;
+
+    long long integer = str.toLongLong(&ok);
+
+    if (! ok)
+      return NumType::AMBIGUOUS;
+
+    value = Value::makeInteger(integer);
+
+    return NumType::NUMBER;
+  }
+
+  // real
+  int numFracDigits = 0;
+
+  if (str[i] == '.') {
+    ++i;
+
+    int fracStart = i;
+
+    while (i < len && str[i].isDigit())
+      ++i;
+
+    numFracDigits = i - fracStart;
+  }
+
+  if (numIntDigits == 0 && numFracDigits == 0)
+    return NumType::AMBIGUOUS;
+
+  if (i < len && (str[i] == 'e' || str[i] == 'E')) {
+    ++i;
+
+    if (i < len && (str[i] == '+' || str[i] == '-'))
+      ++i;
+
+    int expStart = i;
+
+    while (i < len && str[i].isDigit())
+      ++i;
+
+    if (i == expStart)
+      return NumType::AMBIGUOUS;
+  }
+
+  if (i != len)
+    return NumType::AMBIGUOUS;
+
+  bool ok;
+
+  double real = str.toDouble(&ok);
+
+  if (! ok || ! std::isfinite(real))
+    return NumType::AMBIGUOUS;
+
+  value = Value::makeReal(real);
+
+  return NumType::NUMBER;
+}
+
+// get numeric value (fails for non-numeric or ambiguous strings)
+bool toNumber(const Value &value, Value &num) {
+  if (! value.isString()) {
+    num = value;
+    return true;
+  }
+
+  return (parseNumber(value.str, num) == NumType::NUMBER);
+}
+
+// check integer result is in range of tcl int (larger values are wide/big in tcl)
+bool isIntRange(long long i) {
+  return (i >= INT_MIN && i <= INT_MAX);
+}
+
+// convert variant to value
+bool variantToValue(const QVariant &var, Value &value) {
+  if      (! var.isValid())
+    value = Value::makeString("");
+  else if (var.type() == QVariant::Int || var.type() == QVariant::LongLong)
+    value = Value::makeInteger(var.toLongLong());
+  else if (var.type() == QVariant::Bool)
+    value = Value::makeInteger(var.toBool() ? 1 : 0);
+  else if (var.type() == QVariant::Double) {
+    value = Value::makeReal(var.toDouble());
+
+    // NaN/Inf operands raise tcl errors
+    if (! std::isfinite(value.real))
+      return false;
+  }
+  else if (var.type() == QVariant::String)
+    value = Value::makeString(var.toString());
+  else
+    return false;
+
+  return true;
+}
+
+// convert value to variant
+bool valueToVariant(const Value &value, QVariant &var) {
+  if      (value.isInteger()) {
+    if (! isIntRange(value.integer))
+      return false;
+
+    var = QVariant(int(value.integer));
+  }
+  else if (value.isReal())
+    var = QVariant(value.real);
+  else
+    var = QVariant(value.str);
+
+  return true;
+}
+
+// check real result is finite (tcl raises errors for NaN/Inf results)
+bool realResult(double r, Value &value) {
+  if (! std::isfinite(r))
+    return false;
+
+  value = Value::makeReal(r);
+
+  return true;
+}
+
+}
+
+//---
+
+namespace {
+
+enum class NodeType {
+  LITERAL,
+  VARIABLE,
+  UNARY,
+  BINARY,
+  TERNARY,
+  MATH_FUNCTION,
+  CONTEXT_FUNCTION
+};
+
+enum class OpType {
+  NONE,
+  NEGATE, PLUS, NOT,
+  POWER, TIMES, DIVIDE, MODULUS, ADD, SUBTRACT,
+  LESS, LESS_EQUAL, GREATER, GREATER_EQUAL, EQUAL, NOT_EQUAL,
+  STR_EQUAL, STR_NOT_EQUAL,
+  AND, OR
+};
+
+enum class MathFn {
+  NONE,
+  ABS, ACOS, ASIN, ATAN, ATAN2, CEIL, COS, COSH, DOUBLE, EXP, FLOOR, FMOD,
+  HYPOT, INT, LOG, LOG10, MAX, MIN, POW, ROUND, SIN, SINH, SQRT, TAN, TANH
+};
+
+struct MathFnData {
+  const char *name;
+  MathFn      fn;
+  int         minArgs;
+  int         maxArgs;
+};
+
+MathFnData mathFnData[] = {
+  { "abs"   , MathFn::ABS   , 1, 1 },
+  { "acos"  , MathFn::ACOS  , 1, 1 },
+  { "asin"  , MathFn::ASIN  , 1, 1 },
+  { "atan"  , MathFn::ATAN  , 1, 1 },
+  { "atan2" , MathFn::ATAN2 , 2, 2 },
+  { "ceil"  , MathFn::CEIL  , 1, 1 },
+  { "cos"   , MathFn::COS   , 1, 1 },
+  { "cosh"  , MathFn::COSH  , 1, 1 },
+  { "double", MathFn::DOUBLE, 1, 1 },
+  { "exp"   , MathFn::EXP   , 1, 1 },
+  { "floor" , MathFn::FLOOR , 1, 1 },
+  { "fmod"  , MathFn::FMOD  , 2, 2 },
+  { "hypot" , MathFn::HYPOT , 2, 2 },
+  { "int"   , MathFn::INT   , 1, 1 },
+  { "log"   , MathFn::LOG   , 1, 1 },
+  { "log10" , MathFn::LOG10 , 1, 1 },
+  { "max"   , MathFn::MAX   , 1, INT_MAX },
+  { "min"   , MathFn::MIN   , 1, INT_MAX },
+  { "pow"   , MathFn::POW   , 2, 2 },
+  { "round" , MathFn::ROUND , 1, 1 },
+  { "sin"   , MathFn::SIN   , 1, 1 },
+  { "sinh"  , MathFn::SINH  , 1, 1 },
+  { "sqrt"  , MathFn::SQRT  , 1, 1 },
+  { "tan"   , MathFn::TAN   , 1, 1 },
+  { "tanh"  , MathFn::TANH  , 1, 1 },
+  { nullptr , MathFn::NONE  , 0, 0 }
+};
+
+const MathFnData *lookupMathFn(const QString &name) {
+  for (int i = 0; mathFnData[i].name; ++i) {
+    if (name == mathFnData[i].name)
+      return &mathFnData[i];
+  }
+
+  return nullptr;
+}
+
+}
+
+//---
+
+struct CQChartsCompiledExpr::Node {
+  using Children = std::vector<NodeP>;
+
+  NodeType     type     { NodeType::LITERAL };
+  OpType       op       { OpType::NONE };
+  Value        value;                        //!< literal value
+  VarType      varType  { VarType::NONE };   //!< variable type
+  int          column   { -1 };              //!< variable column
+  MathFn       mathFn   { MathFn::NONE };    //!< math function
+  QString      name;                         //!< context function name
+  Children     children;                     //!< child nodes
+};
+
+//---
+
+namespace {
+
+using Node  = CQChartsCompiledExpr::Node;
+using NodeP = CQChartsCompiledExpr::NodeP;
+
+// recursive descent parser for tcl expression (fails on unsupported syntax)
+class Parser {
+ public:
+  Parser(const QString &str, const CQChartsCompiledExpr::Context &context) :
+   str_(str), len_(str.length()), context_(context) {
+  }
+
+  NodeP parse() {
+    auto node = parseTernary();
+
+    if (! node)
+      return NodeP();
+
+    skipSpace();
+
+    if (pos_ != len_)
+      return NodeP();
+
+    return node;
+  }
+
+ private:
+  // cond ? expr : expr (right associative)
+  NodeP parseTernary() {
+    auto node = parseOr();
+    if (! node) return NodeP();
+
+    skipSpace();
+
+    if (! isChar('?'))
+      return node;
+
+    ++pos_;
+
+    auto node1 = parseTernary();
+    if (! node1) return NodeP();
+
+    skipSpace();
+
+    if (! isChar(':'))
+      return NodeP();
+
+    ++pos_;
+
+    auto node2 = parseTernary();
+    if (! node2) return NodeP();
+
+    auto tnode = std::make_shared<Node>();
+
+    tnode->type     = NodeType::TERNARY;
+    tnode->children = { node, node1, node2 };
+
+    return tnode;
+  }
+
+  NodeP parseOr() {
+    auto node = parseAnd();
+    if (! node) return NodeP();
+
+    while (matchOp("||"))
+      if (! (node = binaryNode(OpType::OR, node, parseAnd()))) return NodeP();
+
+    return node;
+  }
+
+  NodeP parseAnd() {
+    auto node = parseStrEqual();
+    if (! node) return NodeP();
+
+    while (matchOp("&&"))
+      if (! (node = binaryNode(OpType::AND, node, parseStrEqual()))) return NodeP();
+
+    return node;
+  }
+
+  NodeP parseStrEqual() {
+    auto node = parseEqual();
+    if (! node) return NodeP();
+
+    while (true) {
+      OpType op;
+
+      if      (matchWordOp("eq")) op = OpType::STR_EQUAL;
+      else if (matchWordOp("ne")) op = OpType::STR_NOT_EQUAL;
+      else break;
+
+      if (! (node = binaryNode(op, node, parseEqual()))) return NodeP();
+    }
+
+    return node;
+  }
+
+  NodeP parseEqual() {
+    auto node = parseCompare();
+    if (! node) return NodeP();
+
+    while (true) {
+      OpType op;
+
+      if      (matchOp("==")) op = OpType::EQUAL;
+      else if (matchOp("!=")) op = OpType::NOT_EQUAL;
+      else break;
+
+      if (! (node = binaryNode(op, node, parseCompare()))) return NodeP();
+    }
+
+    return node;
+  }
+
+  NodeP parseCompare() {
+    auto node = parseAdd();
+    if (! node) return NodeP();
+
+    while (true) {
+      OpType op;
+
+      if      (matchOp("<=")) op = OpType::LESS_EQUAL;
+      else if (matchOp(">=")) op = OpType::GREATER_EQUAL;
+      else if (isOp("<<") || isOp(">>")) return NodeP();
+      else if (matchOp("<" )) op = OpType::LESS;
+      else if (matchOp(">" )) op = OpType::GREATER;
+      else break;
+
+      if (! (node = binaryNode(op, node, parseAdd()))) return NodeP();
+    }
+
+    return node;
+  }
+
+  NodeP parseAdd() {
+    auto node = parseMult();
+    if (! node) return NodeP();
+
+    while (true) {
+      OpType op;
+
+      if      (matchOp("+")) op = OpType::ADD;
+      else if (matchOp("-")) op = OpType::SUBTRACT;
+      else break;
+
+      if (! (node = binaryNode(op, node, parseMult()))) return NodeP();
+    }
+
+    return node;
+  }
+
+  NodeP parseMult() {
+    auto node = parsePower();
+    if (! node) return NodeP();
+
+    while (true) {
+      OpType op;
+
+      if      (isOp("**")) break;
+      else if (matchOp("*")) op = OpType::TIMES;
+      else if (matchOp("/")) op = OpType::DIVIDE;
+      else if (matchOp("%")) op = OpType::MODULUS;
+      else break;
+
+      if (! (node = binaryNode(op, node, parsePower()))) return NodeP();
+    }
+
+    return node;
+  }
+
+  // a ** b (right associative, binds less tightly than unary operators)
+  NodeP parsePower() {
+    auto node = parseUnary();
+    if (! node) return NodeP();
+
+    if (matchOp("**"))
+      return binaryNode(OpType::POWER, node, parsePower());
+
+    return node;
+  }
+
+  NodeP parseUnary() {
+    skipSpace();
+
+    OpType op = OpType::NONE;
+
+    if      (isChar('-')) op = OpType::NEGATE;
+    else if (isChar('+')) op = OpType::PLUS;
+    else if (isChar('!') && ! isOp("!=")) op = OpType::NOT;
+
+    if (op == OpType::NONE)
+      return parsePrimary();
+
+    ++pos_;
+
+    auto child = parseUnary();
+    if (! child) return NodeP();
+
+    auto node = std::make_shared<Node>();
+
+    node->type     = NodeType::UNARY;
+    node->op       = op;
+    node->children = { child };
+
+    return node;
+  }
+
+  NodeP parsePrimary() {
+    skipSpace();
+
+    if (pos_ >= len_)
+      return NodeP();
+
+    auto c = str_[pos_];
+
+    // ( <expr> )
+    if      (c == '(') {
+      ++pos_;
+
+      auto node = parseTernary();
+      if (! node) return NodeP();
+
+      skipSpace();
+
+      if (! isChar(')'))
+        return NodeP();
+
+      ++pos_;
+
+      return node;
+    }
+    // number
+    else if (c.isDigit() || c == '.') {
+      int pos = pos_;
+
+      while (pos_ < len_ && (str_[pos_].isLetterOrNumber() || str_[pos_] == '.' ||
+             ((str_[pos_] == '+' || str_[pos_] == '-') &&
+              (str_[pos_ - 1] == 'e' || str_[pos_ - 1] == 'E'))))
+        ++pos_;
+
+      Value value;
+
+      if (parseNumber(str_.mid(pos, pos_ - pos), value) != NumType::NUMBER)
+        return NodeP();
+
+      return literalNode(value);
+    }
+    // "<string>" (no substitutions)
+    else if (c == '"') {
+      int pos = ++pos_;
+
+      while (pos_ < len_ && str_[pos_] != '"') {
+        auto c1 = str_[pos_];
+
+        if (c1 == '$' || c1 == '[' || c1 == '\\')
+          return NodeP();
+
+        ++pos_;
+      }
+
+      if (pos_ >= len_)
+        return NodeP();
+
+      auto str = str_.mid(pos, pos_ - pos);
+
+      ++pos_;
+
+      return literalNode(Value::makeString(str));
+    }
+    // {<string>}
+    else if (c == '{') {
+      int pos = ++pos_;
+
+      int depth = 1;
+
+      while (pos_ < len_) {
+        auto c1 = str_[pos_];
+
+        if      (c1 == '\\')
+          return NodeP();
+        else if (c1 == '{')
+          ++depth;
+        else if (c1 == '}') {
+          --depth;
+
+          if (depth == 0)
+            break;
+        }
+
+        ++pos_;
+      }
+
+      if (pos_ >= len_)
+        return NodeP();
+
+      auto str = str_.mid(pos, pos_ - pos);
+
+      ++pos_;
+
+      return literalNode(Value::makeString(str));
+    }
+    // $<name> or ${<name>}
+    else if (c == '$') {
+      ++pos_;
+
+      QString name;
+
+      if (isChar('{')) {
+        int pos = ++pos_;
+
+        while (pos_ < len_ && str_[pos_] != '}')
+          ++pos_;
+
+        if (pos_ >= len_)
+          return NodeP();
+
+        name = str_.mid(pos, pos_ - pos);
+
+        ++pos_;
+      }
+      else {
+        int pos = pos_;
+
+        while (pos_ < len_ && (str_[pos_].isLetterOrNumber() || str_[pos_] == '_'))
+          ++pos_;
+
+        name = str_.mid(pos, pos_ - pos);
+
+        // array element or namespace
+        if (isChar('(') || (isChar(':') && pos_ + 1 < len_ && str_[pos_ + 1] == ':'))
+          return NodeP();
+      }
+
+      if (name.isEmpty())
+        return NodeP();
+
+      int column = -1;
+
+      auto varType = context_.varType(name, column);
+
+      if (varType == CQChartsCompiledExpr::VarType::NONE)
+        return NodeP();
+
+      auto node = std::make_shared<Node>();
+
+      node->type    = NodeType::VARIABLE;
+      node->varType = varType;
+      node->column  = column;
+
+      return node;
+    }
+    // <function>(<args>)
+    else if (c.isLetter()) {
+      int pos = pos_;
+
+      while (pos_ < len_ && (str_[pos_].isLetterOrNumber() || str_[pos_] == '_'))
+        ++pos_;
+
+      auto name = str_.mid(pos, pos_ - pos);
+
+      skipSpace();
+
+      // barewords (true, false, inf, ...) not supported
+      if (! isChar('('))
+        return NodeP();
+
+      ++pos_;
+
+      auto node = std::make_shared<Node>();
+
+      if (context_.isUserFunction(name))
+        return NodeP();
+
+      const auto *fnData = lookupMathFn(name);
+
+      if      (fnData) {
+        node->type   = NodeType::MATH_FUNCTION;
+        node->mathFn = fnData->fn;
+      }
+      else if (context_.isFunction(name)) {
+        node->type = NodeType::CONTEXT_FUNCTION;
+        node->name = name;
+      }
+      else
+        return NodeP();
+
+      skipSpace();
+
+      if (! isChar(')')) {
+        while (true) {
+          auto arg = parseTernary();
+          if (! arg) return NodeP();
+
+          node->children.push_back(arg);
+
+          skipSpace();
+
+          if (isChar(','))
+            ++pos_;
+          else
+            break;
+        }
+      }
+
+      if (! isChar(')'))
+        return NodeP();
+
+      ++pos_;
+
+      if (fnData) {
+        int nargs = int(node->children.size());
+
+        if (nargs < fnData->minArgs || nargs > fnData->maxArgs)
+          return NodeP();
+      }
+
+      return node;
+    }
+
+    return NodeP();
+  }
+
+  //---
+
+  NodeP literalNode(const Value &value) const {
+    auto node = std::make_shared<Node>();
+
+    node->type  = NodeType::LITERAL;
+    node->value = value;
+
+    return node;
+  }
+
+  NodeP binaryNode(OpType op, const NodeP &lhs, const NodeP &rhs) const {
+    if (! lhs || ! rhs)
+      return NodeP();
+
+    auto node = std::make_shared<Node>();
+
+    node->type     = NodeType::BINARY;
+    node->op       = op;
+    node->children = { lhs, rhs };
+
+    return node;
+  }
+
+  //---
+
+  void skipSpace() {
+    while (pos_ < len_ && str_[pos_].isSpace())
+      ++pos_;
+  }
+
+  bool isChar(char c) const {
+    return (pos_ < len_ && str_[pos_] == c);
+  }
+
+  bool isOp(const char *op) {
+    skipSpace();
+
+    int n = int(strlen(op));
+
+    if (pos_ + n > len_)
+      return false;
+
+    for (int i = 0; i < n; ++i)
+      if (str_[pos_ + i] != op[i])
+        return false;
+
+    return true;
+  }
+
+  bool matchOp(const char *op) {
+    if (! isOp(op))
+      return false;
+
+    pos_ += int(strlen(op));
+
+    return true;
+  }
+
+  // match operator word (must not be followed by identifier character)
+  bool matchWordOp(const char *op) {
+    if (! isOp(op))
+      return false;
+
+    int n = int(strlen(op));
+
+    if (pos_ + n < len_ && (str_[pos_ + n].isLetterOrNumber() || str_[pos_ + n] == '_'))
+      return false;
+
+    pos_ += n;
+
+    return true;
+  }
+
+ private:
+  const QString&                           str_;
+  int                                      len_ { 0 };
+  int                                      pos_ { 0 };
+  const CQChartsCompiledExpr::Context&     context_;
+};
+
+}
+
+//---
+
+namespace {
+
+// evaluation state for single row
+struct EvalData {
+  CQChartsCompiledExpr::Context &context;
+  int                            row     { -1 };
+  int                            column  { -1 };
+  bool                           operand { false }; //!< is last value plain operand
+
+  EvalData(CQChartsCompiledExpr::Context &context, int row, int column) :
+   context(context), row(row), column(column) {
+  }
+};
+
+bool evalNode(const Node *node, EvalData &data, Value &value);
+
+bool evalBool(const Node *node, EvalData &data, bool &b) {
+  Value value, num;
+
+  if (! evalNode(node, data, value) || ! toNumber(value, num))
+    return false;
+
+  b = (num.isInteger() ? num.integer != 0 : num.real != 0.0);
+
+  return true;
+}
+
+bool evalUnary(const Node *node, EvalData &data, Value &value) {
+  Value value1, num;
+
+  if (! evalNode(node->children[0].get(), data, value1) || ! toNumber(value1, num))
+    return false;
+
+  switch (node->op) {
+    case OpType::NEGATE:
+      if (num.isInteger())
+        value = Value::makeInteger(-num.integer);
+      else
+        value = Value::makeReal(-num.real);
+      break;
+    case OpType::PLUS:
+      value = num;
+      break;
+    case OpType::NOT:
+      value = Value::makeInteger(num.toReal() == 0.0 ? 1 : 0);
+      break;
+    default:
+      return false;
+  }
+
+  return true;
+}
+
+bool evalCompare(OpType op, const Value &lhs, const Value &rhs, Value &value) {
+  int cmp = 0;
+
+  Value num1, num2;
+
+  auto type1 = (lhs.isString() ? parseNumber(lhs.str, num1) : NumType::NUMBER);
+  auto type2 = (rhs.isString() ? parseNumber(rhs.str, num2) : NumType::NUMBER);
+
+  if (type1 == NumType::AMBIGUOUS || type2 == NumType::AMBIGUOUS)
+    return false;
+
+  if      (type1 == NumType::NUMBER && type2 == NumType::NUMBER) {
+    if (! lhs.isString()) num1 = lhs;
+    if (! rhs.isString()) num2 = rhs;
+
+    if (num1.isInteger() && num2.isInteger())
+      cmp = (num1.integer < num2.integer ? -1 : (num1.integer > num2.integer ? 1 : 0));
+    else {
+      double r1 = num1.toReal(), r2 = num2.toReal();
+
+      cmp = (r1 < r2 ? -1 : (r1 > r2 ? 1 : 0));
+    }
+  }
+  else {
+    // string compare (number string representation must match tcl)
+    if (lhs.isReal() || rhs.isReal())
+      return false;
+
+    auto str1 = (lhs.isInteger() ? QString::number(lhs.integer) : lhs.str);
+    auto str2 = (rhs.isInteger() ? QString::number(rhs.integer) : rhs.str);
+
+    cmp = str1.compare(str2);
+  }
+
+  bool b = false;
+
+  switch (op) {
+    case OpType::LESS         : b = (cmp <  0); break;
+    case OpType::LESS_EQUAL   : b = (cmp <= 0); break;
+    case OpType::GREATER      : b = (cmp >  0); break;
+    case OpType::GREATER_EQUAL: b = (cmp >= 0); break;
+    case OpType::EQUAL        : b = (cmp == 0); break;
+    case OpType::NOT_EQUAL    : b = (cmp != 0); break;
+    default                   : return false;
+  }
+
+  value = Value::makeInteger(b ? 1 : 0);
+
+  return true;
+}
+
+bool evalBinary(const Node *node, EvalData &data, Value &value) {
+  auto op = node->op;
+
+  // short circuit logical operators
+  if (op == OpType::AND || op == OpType::OR) {
+    bool b1;
+
+    if (! evalBool(node->children[0].get(), data, b1))
+      return false;
+
+    if      (op == OpType::AND && ! b1) { value = Value::makeInteger(0); return true; }
+    else if (op == OpType::OR  &&   b1) { value = Value::makeInteger(1); return true; }
+
+    bool b2;
+
+    if (! evalBool(node->children[1].get(), data, b2))
+      return false;
+
+    value = Value::makeInteger(b2 ? 1 : 0);
+
+    return true;
+  }
+
+  //---
+
+  Value lhs, rhs;
+
+  if (! evalNode(node->children[0].get(), data, lhs) ||
+      ! evalNode(node->children[1].get(), data, rhs))
+    return false;
+
+  // string equality
+  if (op == OpType::STR_EQUAL || op == OpType::STR_NOT_EQUAL) {
+    if (lhs.isReal() || rhs.isReal())
+      return false;
+
+    auto str1 = (lhs.isInteger() ? QString::number(lhs.integer) : lhs.str);
+    auto str2 = (rhs.isInteger() ? QString::number(rhs.integer) : rhs.str);
+
+    bool b = (str1 == str2);
+
+    if (op == OpType::STR_NOT_EQUAL)
+      b = ! b;
+
+    value = Value::makeInteger(b ? 1 : 0);
+
+    return true;
+  }
+
+  // compare (numeric if both numbers else string)
+  if (op == OpType::LESS    || op == OpType::LESS_EQUAL    ||
+      op == OpType::GREATER || op == OpType::GREATER_EQUAL ||
+      op == OpType::EQUAL   || op == OpType::NOT_EQUAL)
+    return evalCompare(op, lhs, rhs, value);
+
+  //---
+
+  // arithmetic
+  Value num1, num2;
+
+  if (! toNumber(lhs, num1) || ! toNumber(rhs, num2))
+    return false;
+
+  if (num1.isInteger() && num2.isInteger()) {
+    long long i1 = num1.integer, i2 = num2.integer, i = 0;
+
+    switch (op) {
+      case OpType::ADD: {
+        if (__builtin_add_overflow(i1, i2, &i)) return false;
+        break;
+      }
+      case OpType::SUBTRACT: {
+        if (__builtin_sub_overflow(i1, i2, &i)) return false;
+        break;
+      }
+      case OpType::TIMES: {
+        if (__builtin_mul_overflow(i1, i2, &i)) return false;
+        break;
+      }
+      case OpType::DIVIDE: {
+        if (i2 == 0) return false;
+
+        // tcl integer division rounds towards negative infinity
+        i = i1/i2;
+
+        if ((i1 % i2 != 0) && ((i1 < 0) != (i2 < 0)))
+          --i;
+
+        break;
+      }
+      case OpType::MODULUS: {
+        if (i2 == 0) return false;
+
+        // tcl remainder has same sign as divisor
+        i = i1 % i2;
+
+        if (i != 0 && ((i < 0) != (i2 < 0)))
+          i += i2;
+
+        break;
+      }
+      case OpType::POWER: {
+        if (i2 < 0) return false;
+
+        if      (i1 == 0 || i1 == 1)
+          i = (i2 == 0 ? 1 : i1);
+        else if (i1 == -1)
+          i = (i2 % 2 == 0 ? 1 : -1);
+        else {
+          // overflows after at most 63 multiplies
+          i = 1;
+
+          for (long long n = 0; n < i2; ++n) {
+            if (__builtin_mul_overflow(i, i1, &i)) return false;
+          }
+        }
+
+        break;
+      }
+      default:
+        return false;
+    }
+
+    value = Value::makeInteger(i);
+
+    return true;
+  }
+
+  //---
+
+  double r1 = num1.toReal(), r2 = num2.toReal(), r = 0.0;
+
+  switch (op) {
+    case OpType::ADD     : r = r1 + r2; break;
+    case OpType::SUBTRACT: r = r1 - r2; break;
+    case OpType::TIMES   : r = r1*r2; break;
+    case OpType::DIVIDE  : {
+      if (r2 == 0.0) return false;
+
+      r = r1/r2;
+
+      break;
+    }
+    case OpType::POWER   : r = std::pow(r1, r2); break;
+    default              : return false;
+  }
+
+  return realResult(r, value);
+}
+
+bool evalMathFn(const Node *node, EvalData &data, Value &value) {
+  std::vector<Value> nums;
+
+  for (const auto &child : node->children) {
+    Value value1, num;
+
+    if (! evalNode(child.get(), data, value1) || ! toNumber(value1, num))
+      return false;
+
+    nums.push_back(num);
+  }
+
+  auto r0 = nums[0].toReal();
+  auto r1 = (nums.size() > 1 ? nums[1].toReal() : 0.0);
+
+  switch (node->mathFn) {
+    case MathFn::ABS: {
+      if (nums[0].isInteger())
+        value = Value::makeInteger(std::abs(nums[0].integer));
+      else
+        value = Value::makeReal(std::abs(r0));
+
+      return true;
+    }
+    case MathFn::DOUBLE: {
+      value = Value::makeReal(r0);
+
+      return true;
+    }
+    case MathFn::INT: {
+      if (nums[0].isInteger()) {
+        value = nums[0];
+        return true;
+      }
+
+      if (std::abs(r0) > double(INT_MAX))
+        return false;
+
+      value = Value::makeInteger((long long) r0);
+
+      return true;
+    }
+    case MathFn::ROUND: {
+      if (nums[0].isInteger()) {
+        value = nums[0];
+        return true;
+      }
+
+      if (std::abs(r0) > double(INT_MAX))
+        return false;
+
+      value = Value::makeInteger(std::llround(r0));
+
+      return true;
+    }
+    case MathFn::MAX:
+    case MathFn::MIN: {
+      int ind = 0;
+
+      for (int i = 1; i < int(nums.size()); ++i) {
+        double r = nums[i].toReal(), rind = nums[ind].toReal();
+
+        if (node->mathFn == MathFn::MAX ? r > rind : r < rind)
+          ind = i;
+      }
+
+      value = nums[ind];
+
+      return true;
+    }
+    case MathFn::ACOS : return realResult(std::acos (r0), value);
+    case MathFn::ASIN : return realResult(std::asin (r0), value);
+    case MathFn::ATAN : return realResult(std::atan (r0), value);
+    case MathFn::ATAN2: return realResult(std::atan2(r0, r1), value);
+    case MathFn::CEIL : return realResult(std::ceil (r0), value);
+    case MathFn::COS  : return realResult(std::cos  (r0), value);
+    case MathFn::COSH : return realResult(std::cosh (r0), value);
+    case MathFn::EXP  : return realResult(std::exp  (r0), value);
+    case MathFn::FLOOR: return realResult(std::floor(r0), value);
+    case MathFn::FMOD : return realResult(std::fmod (r0, r1), value);
+    case MathFn::HYPOT: return realResult(std::hypot(r0, r1), value);
+    case MathFn::LOG  : return realResult(std::log  (r0), value);
+    case MathFn::LOG10: return realResult(std::log10(r0), value);
+    case MathFn::POW  : return realResult(std::pow  (r0, r1), value);
+    case MathFn::SIN  : return realResult(std::sin  (r0), value);
+    case MathFn::SINH : return realResult(std::sinh (r0), value);
+    case MathFn::SQRT : return realResult(std::sqrt (r0), value);
+    case MathFn::TAN  : return realResult(std::tan  (r0), value);
+    case MathFn::TANH : return realResult(std::tanh (r0), value);
+    default           : break;
+  }
+
+  return false;
+}
+
+bool evalContextFn(const Node *node, EvalData &data, Value &value) {
+  CQChartsCompiledExpr::Values values;
+
+  for (const auto &child : node->children) {
+    Value value1;
+
+    if (! evalNode(child.get(), data, value1))
+      return false;
+
+    QVariant var;
+
+    if (! valueToVariant(value1, var))
+      return false;
+
+    values.push_back(var);
+  }
+
+  auto var = data.context.callFunction(data.row, data.column, node->name, values);
+
+  return variantToValue(var, value);
+}
+
+bool evalVariable(const Node *node, EvalData &data, Value &value) {
+  using VarType = CQChartsCompiledExpr::VarType;
+
+  switch (node->varType) {
+    case VarType::COLUMN:
+      return variantToValue(data.context.columnValue(data.row, node->column), value);
+    case VarType::ROW:
+      value = Value::makeInteger(data.row);
+      return true;
+    case VarType::COL:
+      value = Value::makeInteger(data.column);
+      return true;
+    case VarType::CONST_PI:
+      value = Value::makeReal(M_PI);
+      return true;
+    case VarType::LAST: {
+      auto var = data.context.lastValue();
+
+      if (! var.isValid())
+        var = QVariant(0.0);
+
+      return variantToValue(var, value);
+    }
+    default:
+      // NaN operands are errors in tcl
+      return false;
+  }
+}
+
+bool evalNode(const Node *node, EvalData &data, Value &value) {
+  bool rc = false;
+
+  switch (node->type) {
+    case NodeType::LITERAL:
+      value = node->value;
+      rc    = true;
+      break;
+    case NodeType::VARIABLE:
+      rc = evalVariable(node, data, value);
+      break;
+    case NodeType::UNARY:
+      rc = evalUnary(node, data, value);
+      break;
+    case NodeType::BINARY:
+      rc = evalBinary(node, data, value);
+      break;
+    case NodeType::TERNARY: {
+      bool b;
+
+      if (! evalBool(node->children[0].get(), data, b))
+        return false;
+
+      // operand state is that of chosen branch
+      return evalNode(node->children[b ? 1 : 2].get(), data, value);
+    }
+    case NodeType::MATH_FUNCTION:
+      rc = evalMathFn(node, data, value);
+      break;
+    case NodeType::CONTEXT_FUNCTION:
+      rc = evalContextFn(node, data, value);
+      break;
+    default:
+      break;
+  }
+
+  data.operand = (node->type == NodeType::LITERAL || node->type == NodeType::VARIABLE);
+
+  return rc;
+}
+
+}
+
+//---
+
+CQChartsCompiledExpr::
+CQChartsCompiledExpr()
+{
+}
+
+CQChartsCompiledExpr::
+~CQChartsCompiledExpr()
+{
+}
+
+bool
+CQChartsCompiledExpr::
+compile(const QString &expr, const Context &context)
+{
+  root_ = NodeP();
+
+  Parser parser(expr, context);
+
+  root_ = parser.parse();
+
+  return isValid();
+}
+
+bool
+CQChartsCompiledExpr::
+eval(Context &context, int row, int column, QVariant &var) const
+{
+  if (! root_)
+    return false;
+
+  EvalData data(context, row, column);
+
+  Value value;
+
+  if (! evalNode(root_.get(), data, value))
+    return false;
+
+  // plain operand string results are returned as numbers if numeric
+  if (value.isString() && data.operand) {
+    Value num;
+
+    auto type = parseNumber(value.str, num);
+
+    if      (type == NumType::AMBIGUOUS)
+      return false;
+    else if (type == NumType::NUMBER)
+      value = num;
+  }
+
+  return valueToVariant(value, var);
+}
@@ -0,0 +1,375 @@
+#include <CQChartsCorrelation.h>
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <thread>
+
+namespace {
+
+// process work items [0, n) in chunks across threads (serial if little work)
+template<typename FN>
+void processParallel(int n, long work, const FN &fn) {
+  int numThreads = std::max(int(std::thread::hardware_concurrency()), 1);
+
+  const long minThreadWork = 100000;
+
+  numThreads = std::min(numThreads, n);
+
+  if (numThreads < 2 || work < minThreadWork) {
+    fn(0, n);
+    return;
+  }
+
+  int n1 = (n + numThreads - 1)/numThreads;
+
+  std::vector<std::future<void>> futures;
+
+  for (int i1 = 0; i1 < n; i1 += n1)
+    futures.push_back(std::async(std::launch::async, fn, i1, std::min(i1 + n1, n)));
+
+  for (auto &future : futures)
+    future.wait();
+}
+
+// pearson correlation of (complete) values (centered two pass for accuracy)
+double pearson(const double *x, const double *y, int n) {
+  if (n < 2)
+    return 0.0;
+
+  double sx = 0.0, sy = 0.0;
+
+  for (int i = 0; i < n; ++i) {
+    sx += x[i];
+    sy += y[i];
+  }
+
+  double mx = sx/n;
+  double my = sy/n;
+
+  double sxx = 0.0, syy = 0.0, sxy = 0.0;
+
+  for (int i = 0; i < n; ++i) {
+    double dx = x[i] - mx;
+    double dy = y[i] - my;
+
+    sxx += dx*dx;
+    syy += dy*dy;
+    sxy += dx*dy;
+  }
+
+  // constant values have no correlation
+  if (sxx <= 0.0 || syy <= 0.0)
+    return 0.0;
+
+  return std::min(std::max(sxy/std::sqrt(sxx*syy), -1.0), 1.0);
+}
+
+}
+
+//---
+
+CQChartsCorrelation::
+CQChartsCorrelation(Type type) :
+ type_(type)
+{
+}
+
+void
+CQChartsCorrelation::
+calc(const Columns &columns)
+{
+  nc_ = int(columns.size());
+  nr_ = (nc_ > 0 ? int(columns[0].size()) : 0);
+
+  corr_    .assign(size_t(nc_)*nc_, 0.0);
+  stddev_  .assign(nc_, 0.0);
+  complete_.assign(nc_, -1);
+
+  //---
+
+  // assign contiguous slot for each column with no missing values
+  int nz = 0;
+
+  for (int ic = 0; ic < nc_; ++ic) {
+    const auto &values = columns[ic];
+
+    bool complete = std::none_of(values.begin(), values.end(),
+                                 [](double v) { return std::isnan(v); });
+
+    if (complete)
+      complete_[ic] = nz++;
+  }
+
+  zvalues_.assign(size_t(nz)*nr_, 0.0);
+
+  //---
+
+  // calc column std dev and standardize complete columns ((x - mean)/|x - mean|)
+  processParallel(nc_, long(nc_)*nr_, [&](int ic1, int ic2) {
+    Values ranks;
+
+    for (int ic = ic1; ic < ic2; ++ic) {
+      const auto &values = columns[ic];
+
+      double sum = 0.0;
+      int    n   = 0;
+
+      for (const auto &v : values) {
+        if (std::isnan(v)) continue;
+
+        sum += v;
+        ++n;
+      }
+
+      double mean = (n > 0 ? sum/n : 0.0);
+
+      double ss = 0.0;
+
+      for (const auto &v : values) {
+        if (std::isnan(v)) continue;
+
+        ss += (v - mean)*(v - mean);
+      }
+
+      stddev_[ic] = (n > 0 ? std::sqrt(ss/n) : 0.0);
+
+      //---
+
+      int iz = complete_[ic];
+      if (iz < 0) continue;
+
+      const double *x = values.data();
+
+      if (type_ == Type::SPEARMAN) {
+        calcRanks(values, ranks);
+
+        x = ranks.data();
+
+        // mean rank is (n + 1)/2
+        mean = (nr_ + 1)/2.0;
+        ss   = 0.0;
+
+        for (int ir = 0; ir < nr_; ++ir)
+          ss += (x[ir] - mean)*(x[ir] - mean);
+      }
+
+      // constant column is left as zeros (no correlation)
+      if (ss <= 0.0) continue;
+
+      double s = 1.0/std::sqrt(ss);
+
+      double *z = &zvalues_[size_t(iz)*nr_];
+
+      for (int ir = 0; ir < nr_; ++ir)
+        z[ir] = (x[ir] - mean)*s;
+    }
+  });
+
+  //---
+
+  calcComplete();
+
+  calcPairwise(columns);
+
+  for (int ic = 0; ic < nc_; ++ic)
+    corr_[size_t(ic)*nc_ + ic] = 1.0;
+
+  zvalues_.clear();
+  zvalues_.shrink_to_fit();
+}
+
+double
+CQChartsCorrelation::
+sumSq(int i) const
+{
+  double sum = 0.0;
+
+  for (int j = 0; j < nc_; ++j) {
+    if (j == i) continue;
+
+    double c = corr(i, j);
+
+    sum += c*c;
+  }
+
+  return sum;
+}
+
+void
+CQChartsCorrelation::
+calcRanks(const Values &values, Values &ranks) const
+{
+  // rank non-missing values (ties get average rank), missing values stay missing
+  int n = int(values.size());
+
+  std::vector<int> inds;
+
+  inds.reserve(n);
+
+  for (int i = 0; i < n; ++i) {
+    if (! std::isnan(values[i]))
+      inds.push_back(i);
+  }
+
+  std::sort(inds.begin(), inds.end(), [&](int i1, int i2) {
+    return values[i1] < values[i2];
+  });
+
+  ranks.assign(n, NAN);
+
+  int ni = int(inds.size());
+
+  for (int i1 = 0; i1 < ni; ) {
+    int i2 = i1 + 1;
+
+    while (i2 < ni && values[inds[i2]] == values[inds[i1]])
+      ++i2;
+
+    double rank = (i1 + i2 + 1)/2.0; // average of ranks i1 + 1 ... i2
+
+    for (int i = i1; i < i2; ++i)
+      ranks[inds[i]] = rank;
+
+    i1 = i2;
+  }
+}
+
+void
+CQChartsCorrelation::
+calcComplete()
+{
+  // columns with no missing values
+  std::vector<int> cols;
+
+  for (int ic = 0; ic < nc_; ++ic) {
+    if (complete_[ic] >= 0)
+      cols.push_back(ic);
+  }
+
+  int n = int(cols.size());
+  if (n == 0) return;
+
+  // correlation of standardized columns is their dot product so the matrix is the Gram
+  // product Z'Z. Column and row blocks keep the two column tiles in cache while the
+  // inner loop is a plain (vectorizable) dot product.
+  const int colBlock = 32;
+  const int rowBlock = 512;
+
+  int nb = (n + colBlock - 1)/colBlock;
+
+  // upper triangle tile pairs
+  using Tile  = std::pair<int, int>;
+  using Tiles = std::vector<Tile>;
+
+  Tiles tiles;
+
+  for (int ib = 0; ib < nb; ++ib)
+    for (int jb = ib; jb < nb; ++jb)
+      tiles.push_back(Tile(ib, jb));
+
+  int nt = int(tiles.size());
+
+  processParallel(nt, long(n)*n*nr_/2, [&](int it1, int it2) {
+    Values acc(colBlock*colBlock);
+
+    for (int it = it1; it < it2; ++it) {
+      int i1 = tiles[it].first *colBlock, i2 = std::min(i1 + colBlock, n);
+      int j1 = tiles[it].second*colBlock, j2 = std::min(j1 + colBlock, n);
+
+      std::fill(acc.begin(), acc.end(), 0.0);
+
+      for (int r1 = 0; r1 < nr_; r1 += rowBlock) {
+        int nr1 = std::min(rowBlock, nr_ - r1);
+
+        for (int i = i1; i < i2; ++i) {
+          const double *zi = &zvalues_[size_t(complete_[cols[i]])*nr_ + r1];
+
+          for (int j = std::max(j1, i + 1); j < j2; ++j) {
+            const double *zj = &zvalues_[size_t(complete_[cols[j]])*nr_ + r1];
+
+            double sum = 0.0;
+
+            for (int r = 0; r < nr1; ++r)
+              sum += zi[r]*zj[r];
+
+            acc[(i - i1)*colBlock + (j - j1)] += sum;
+          }
+        }
+      }
+
+      for (int i = i1; i < i2; ++i) {
+        for (int j = std::max(j1, i + 1); j < j2; ++j) {
+          double c = std::min(std::max(acc[(i - i1)*colBlock + (j - j1)], -1.0), 1.0);
+
+          corr_[size_t(cols[i])*nc_ + cols[j]] = c;
+          corr_[size_t(cols[j])*nc_ + cols[i]] = c;
+        }
+      }
+    }
+  });
+}
+
+void
+CQChartsCorrelation::
+calcPairwise(const Columns &columns)
+{
+  // pairs with missing values in either column
+  using Pair  = std::pair<int, int>;
+  using Pairs = std::vector<Pair>;
+
+  Pairs pairs;
+
+  for (int ic1 = 0; ic1 < nc_; ++ic1) {
+    for (int ic2 = ic1 + 1; ic2 < nc_; ++ic2) {
+      if (complete_[ic1] < 0 || complete_[ic2] < 0)
+        pairs.push_back(Pair(ic1, ic2));
+    }
+  }
+
+  int np = int(pairs.size());
+  if (np == 0) return;
+
+  processParallel(np, long(np)*nr_, [&](int ip1, int ip2) {
+    for (int ip = ip1; ip < ip2; ++ip) {
+      int ic1 = pairs[ip].first;
+      int ic2 = pairs[ip].second;
+
+      double c = calcPair(columns[ic1], columns[ic2]);
+
+      corr_[size_t(ic1)*nc_ + ic2] = c;
+      corr_[size_t(ic2)*nc_ + ic1] = c;
+    }
+  });
+}
+
+double
+CQChartsCorrelation::
+calcPair(const Values &values1, const Values &values2) const
+{
+  // correlate rows where both values are present
+  Values x, y;
+
+  x.reserve(nr_);
+  y.reserve(nr_);
+
+  for (int ir = 0; ir < nr_; ++ir) {
+    if (std::isnan(values1[ir]) || std::isnan(values2[ir]))
+      continue;
+
+    x.push_back(values1[ir]);
+    y.push_back(values2[ir]);
+  }
+
+  // spearman ranks are calculated on the rows used
+  if (type_ == Type::SPEARMAN) {
+    Values rx, ry;
+
+    calcRanks(x, rx);
+    calcRanks(y, ry);
+
+    return pearson(rx.data(), ry.data(), int(rx.size()));
+  }
+
+  return pearson(x.data(), y.data(), int(x.size()));
+}
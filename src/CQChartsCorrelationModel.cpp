@@ -1,7 +1,65 @@
 #include <CQChartsCorrelationModel.h>
+#include <cmath>
 
 CQChartsCorrelationModel::
 CQChartsCorrelationModel(int numCols) :
  CQDataModel(numCols, numCols)
 {
 }
+
+const CQChartsCorrelationModel::Points &
+CQChartsCorrelationModel::
+points(int i, int j) const
+{
+  std::unique_lock<std::mutex> lock(cacheMutex_);
+
+  auto &jpoints = ijPoints_[i];
+
+  auto pj = jpoints.find(j);
+
+  if (pj == jpoints.end()) {
+    const auto &values1 = values(i);
+    const auto &values2 = values(j);
+
+    assert(values1.size() == values2.size());
+
+    Points points;
+
+    int nv = int(values1.size());
+
+    points.reserve(nv);
+
+    // skip missing values
+    for (int k = 0; k < nv; ++k) {
+      if (std::isnan(values1[k]) || std::isnan(values2[k]))
+        continue;
+
+      points.push_back(Point(values1[k], values2[k]));
+    }
+
+    pj = jpoints.insert(pj, JPoints::value_type(j, std::move(points)));
+  }
+
+  return (*pj).second;
+}
+
+CQChartsFitData &
+CQChartsCorrelationModel::
+bestFit(int i, int j)
+{
+  const auto &points = this->points(i, j);
+
+  std::unique_lock<std::mutex> lock(cacheMutex_);
+
+  auto &jbestFit = ijBestFit_[i];
+
+  auto pj = jbestFit.find(j);
+
+  if (pj == jbestFit.end()) {
+    pj = jbestFit.insert(pj, JBestFit::value_type(j, CQChartsFitData()));
+
+    (*pj).second.calc(points);
+  }
+
+  return (*pj).second;
+}
@@ -4,8 +4,77 @@
 #include <CQChartsPaintDevice.h>
 #include <CQChartsBoxWhisker.h>
 #include <CQUtil.h>
+#include <complex>
 #include <cassert>
 
+namespace {
+
+// minimum number of values for binned estimate
+const int minBinnedValues = 1000;
+
+// grid points per bandwidth for binned estimate (and minimum allowed)
+const int binnedGridBandwidth    = 16;
+const int binnedMinGridBandwidth = 4;
+
+// maximum number of grid points for binned estimate
+const int maxBinnedGrid = 65536;
+
+// bandwidths either side of data for binned grid
+const double binnedGridExtend = 4.0;
+
+// bandwidths after which kernel contribution is ignored
+const double kernelCutoff = 10.0;
+
+using Complex  = std::complex<double>;
+using Complexs = std::vector<Complex>;
+
+// in place radix-2 fft (size must be power of 2)
+void fft(Complexs &a, bool inverse)
+{
+  int n = a.size();
+
+  // bit reverse order
+  for (int i = 1, j = 0; i < n; ++i) {
+    int bit = n >> 1;
+
+    for ( ; j & bit; bit >>= 1)
+      j ^= bit;
+
+    j ^= bit;
+
+    if (i < j)
+      std::swap(a[i], a[j]);
+  }
+
+  // butterflies
+  for (int len = 2; len <= n; len <<= 1) {
+    double a1 = 2.0*M_PI/len*(inverse ? 1 : -1);
+
+    Complex wl(std::cos(a1), std::sin(a1));
+
+    for (int i = 0; i < n; i += len) {
+      Complex w(1.0);
+
+      for (int j = 0; j < len/2; ++j) {
+        auto u = a[i + j];
+        auto v = a[i + j + len/2]*w;
+
+        a[i + j        ] = u + v;
+        a[i + j + len/2] = u - v;
+
+        w *= wl;
+      }
+    }
+  }
+
+  if (inverse) {
+    for (auto &c : a)
+      c /= double(n);
+  }
+}
+
+}
+
 CQChartsDensity::
 CQChartsDensity()
 {
@@ -37,6 +106,8 @@ calc()
   if (nx_ < 2)
     return;
 
+  initBinned();
+
   // set num samples between end points
   double step = (xmax_ - xmin_)/(numSamples_ - 1);
 
@@ -249,31 +320,163 @@ yval(double x) const
 
 //---
 
+double
+CQChartsDensity::
+bandwidth() const
+{
+  /* If the supplied bandwidth is zero of less, the default bandwidth is used. */
+  if (smoothParameter_ <= 0)
+    return defaultBandwidth_;
+  else
+    return smoothParameter_;
+}
+
+void
+CQChartsDensity::
+initBinned()
+{
+  binnedYVals_.clear();
+
+  if (! isBinned() || nx_ < minBinnedValues)
+    return;
+
+  double bandwidth = this->bandwidth();
+
+  if (bandwidth <= 0.0)
+    return;
+
+  //---
+
+  // grid of points over value range (extended by a few bandwidths)
+  double xmin = xmin_ - binnedGridExtend*bandwidth;
+  double xmax = xmax_ + binnedGridExtend*bandwidth;
+
+  double dx = bandwidth/binnedGridBandwidth;
+
+  int m = int(std::ceil((xmax - xmin)/dx)) + 1;
+
+  if (m > maxBinnedGrid) {
+    m  = maxBinnedGrid;
+    dx = (xmax - xmin)/(m - 1);
+
+    // grid too coarse for bandwidth so use exact estimate
+    if (dx > bandwidth/binnedMinGridBandwidth)
+      return;
+  }
+
+  //---
+
+  // linear binning of values (weight split between adjacent grid points)
+  XVals weights(m, 0.0);
+
+  for (int i = 0; i < nx_; ++i) {
+    double r = (xvals_[i] - xmin)/dx;
+
+    int    j = std::min(std::max(int(r), 0), m - 2);
+    double f = std::min(std::max(r - j, 0.0), 1.0);
+
+    weights[j    ] += 1.0 - f;
+    weights[j + 1] += f;
+  }
+
+  //---
+
+  // convolve weights with gaussian kernel using fft
+  int nk = std::min(int(std::ceil(kernelCutoff*bandwidth/dx)), m);
+
+  int n = 1;
+
+  while (n < m + nk + 1)
+    n <<= 1;
+
+  Complexs a(n), k(n);
+
+  for (int i = 0; i < m; ++i)
+    a[i] = weights[i];
+
+  double s = 1.0/(bandwidth*sqrt(2.0*M_PI));
+
+  for (int i = 0; i <= nk; ++i) {
+    double z = i*dx/bandwidth;
+
+    double y = s*exp(-0.5*z*z);
+
+    k[i] = y;
+
+    if (i > 0)
+      k[n - i] = y;
+  }
+
+  fft(a, /*inverse*/false);
+  fft(k, /*inverse*/false);
+
+  for (int i = 0; i < n; ++i)
+    a[i] *= k[i];
+
+  fft(a, /*inverse*/true);
+
+  //---
+
+  binnedYVals_.resize(m);
+
+  for (int i = 0; i < m; ++i)
+    binnedYVals_[i] = std::max(a[i].real(), 0.0);
+
+  binnedXMin_ = xmin;
+  binnedDx_   = dx;
+}
+
 double
 CQChartsDensity::
 eval(double x) const
 {
   assert(initialized_ && calced_);
 
-  double bandwidth;
+  // interpolate binned values inside grid
+  int m = binnedYVals_.size();
 
-  /* If the supplied bandwidth is zero of less, the default bandwidth is used. */
-  if (smoothParameter_ <= 0)
-    bandwidth = defaultBandwidth_;
-  else
-    bandwidth = smoothParameter_;
+  if (m > 1) {
+    double r = (x - binnedXMin_)/binnedDx_;
+
+    if (r >= 0.0 && r <= m - 1) {
+      int    i = std::min(int(r), m - 2);
+      double f = r - i;
+
+      return (1.0 - f)*binnedYVals_[i] + f*binnedYVals_[i + 1];
+    }
+  }
+
+  return evalExact(x);
+}
+
+double
+CQChartsDensity::
+evalExact(double x) const
+{
+  double bandwidth = this->bandwidth();
+
+  double ibandwidth = 1.0/bandwidth;
 
   //---
 
+  // only sum (sorted) values within kernel cutoff of x
+  auto pl = std::lower_bound(sxvals_.begin(), sxvals_.end(), x - kernelCutoff*bandwidth);
+  auto pu = std::upper_bound(pl             , sxvals_.end(), x + kernelCutoff*bandwidth);
+
+  const double *xvals = sxvals_.data();
+
+  int i1 = int(pl - sxvals_.begin());
+  int i2 = int(pu - sxvals_.begin());
+
   double y = 0;
 
-  for (int i = 0; i < nx_; i++) {
-    double z = (x - xvals_[i])/bandwidth;
+  for (int i = i1; i < i2; i++) {
+    double z = (x - xvals[i])*ibandwidth;
 
-    y += exp(-0.5*z*z)/bandwidth;
+    y += exp(-0.5*z*z);
   }
 
-  y /= sqrt(2.0*M_PI);
+  y *= ibandwidth/sqrt(2.0*M_PI);
 
   return y;
 }
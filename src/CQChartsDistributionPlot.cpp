@@ -882,6 +882,30 @@ bucketGroupValues() const
 
   //---
 
+  // get real value using cached column values (top level rows only)
+  std::map<Column, CQChartsColumnRealsP> columnRealsMap;
+
+  auto indReal = [&](const ModelIndex &ind, bool &ok) {
+    if (ind.parent().isValid() || ind.column().isColumn() || ind.column().isCell())
+      return modelReal(ind, ok);
+
+    auto pc = columnRealsMap.find(ind.column());
+
+    if (pc == columnRealsMap.end())
+      pc = columnRealsMap.insert(pc, std::make_pair(ind.column(), columnReals(ind.column())));
+
+    const auto *reals = (*pc).second.get();
+
+    if (! reals || ind.row() < 0 || ind.row() >= reals->size())
+      return modelReal(ind, ok);
+
+    ok = reals->isValid(ind.row());
+
+    return (ok ? reals->value(ind.row()) : 0.0);
+  };
+
+  //---
+
   // bucket grouped sets of values
   for (auto &groupValues : groupData_.groupValues) {
     int   groupInd = groupValues.first;
@@ -902,7 +926,7 @@ bucketGroupValues() const
         auto type = values->valueSet->type();
 
         if      (type == CQChartsValueSet::Type::REAL) {
-          double r = modelReal(ind, ok);
+          double r = indReal(ind, ok);
           if (! ok || CMathUtil::isNaN(r)) continue;
 
           if (! isIncludeOutlier()) {
@@ -1427,6 +1451,15 @@ getGroupIndValues(int groupInd, const ModelIndex &ind) const
 
   valueSet->setColumn(ind.column());
 
+  // share sorted group values (stats) with other plots/details for same column values
+  auto column = ind.column();
+
+  QString filter = (groupInd >= 0 ? QString("distribution:%1").arg(groupInd) : QString());
+
+  valueSet->setSortedValuesFn([this, column, filter](const std::vector<double> &values) {
+    return this->sortedValues(column, filter, values);
+  });
+
   auto pg = th->groupData_.groupValues.insert(th->groupData_.groupValues.end(),
               GroupValues::value_type(groupInd, new Values(valueSet)));
 
@@ -2338,10 +2371,12 @@ calcVarIndsData(VariantIndsData &varInds) const
 {
   RMinMax valueRange;
 
-  CQChartsRValues rvals;
+  std::vector<double> rvals;
 
   int n = varInds.inds.size();
 
+  rvals.reserve(n);
+
   for (int i = 0; i < n; ++i) {
     const auto &var = varInds.inds[i];
 
@@ -2357,14 +2392,16 @@ calcVarIndsData(VariantIndsData &varInds) const
     if (! ok)
       continue;
 
-    rvals.addValue(r);
+    rvals.push_back(r);
 
     valueRange.add(r);
   }
 
-  varInds.min      = valueRange.min(0);
-  varInds.max      = valueRange.max(0);
-  varInds.statData = rvals.statData();
+  varInds.min = valueRange.min(0);
+  varInds.max = valueRange.max(0);
+
+  // one-off bucket stats so select medians instead of sort
+  varInds.statData.calcSelectStatValues(rvals);
 }
 
 CQChartsDistributionPlot::BarValue
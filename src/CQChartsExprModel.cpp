@@ -2,6 +2,7 @@
 #include <CQChartsExprModelFn.h>
 #include <CQChartsExprCmdValues.h>
 #include <CQChartsExprTcl.h>
+#include <CQChartsCompiledExpr.h>
 #include <CQChartsModelData.h>
 #include <CQChartsModelDetails.h>
 #include <CQChartsModelFilter.h>
@@ -17,6 +18,67 @@
 
 //------
 
+//! compiled expression context for expression model (resolves tcl variables and functions)
+class CQChartsExprModel::CompileContext : public CQChartsCompiledExpr::Context {
+ public:
+  using VarType = CQChartsCompiledExpr::VarType;
+
+ public:
+  CompileContext(CQChartsExprModel *model) :
+   model_(model) {
+  }
+
+  VarType varType(const QString &name, int &column) const override {
+    column = model_->qtcl_->nameColumn(name);
+
+    if (column >= 0) return VarType::COLUMN;
+
+    if (name == "row"    || name == "x"  ) return VarType::ROW;
+    if (name == "column" || name == "col") return VarType::COL;
+    if (name == "PI"                     ) return VarType::CONST_PI;
+    if (name == "NaN"                    ) return VarType::CONST_NAN;
+    if (name == "_"                      ) return VarType::LAST;
+
+    return VarType::NONE;
+  }
+
+  bool isFunction(const QString &name) const override {
+    // functions which edit the model are left to tcl so row evaluation order is unchanged
+    if (name.startsWith("set"))
+      return false;
+
+    for (const auto &tclCmd : model_->tclCmds_) {
+      if (tclCmd->name() == name)
+        return true;
+    }
+
+    return false;
+  }
+
+  bool isUserFunction(const QString &name) const override {
+    const auto &procs = model_->charts_->procs(CQCharts::ProcType::TCL);
+
+    return (procs.find(name) != procs.end());
+  }
+
+  QVariant columnValue(int row, int column) const override {
+    return model_->getCmdData(row, column);
+  }
+
+  QVariant lastValue() const override {
+    return model_->qtcl_->lastValue();
+  }
+
+  QVariant callFunction(int, int, const QString &name, const Values &values) override {
+    return model_->processCmd(name, values);
+  }
+
+ private:
+  CQChartsExprModel *model_ { nullptr };
+};
+
+//------
+
 CQChartsExprModel::
 CQChartsExprModel(CQCharts *charts, CQChartsModelFilter *filter, QAbstractItemModel *model) :
  charts_(charts), filter_(filter), model_(model)
@@ -31,8 +93,35 @@ CQChartsExprModel(CQCharts *charts, CQChartsModelFilter *filter, QAbstractItemMo
 
   setSourceModel(model);
 
-  connect(model, SIGNAL(dataChanged(const QModelIndex &, const QModelIndex &)),
-          this, SLOT(dataChangedSlot(const QModelIndex &, const QModelIndex &)));
+  connect(model, SIGNAL(dataChanged(const QModelIndex &, const QModelIndex &,
+                                    const QVector<int> &)),
+          this, SLOT(dataChangedSlot(const QModelIndex &, const QModelIndex &,
+                                     const QVector<int> &)));
+
+  // forward source structure changes (e.g. rows appended by progressive load)
+  connect(model, SIGNAL(rowsAboutToBeInserted(const QModelIndex &, int, int)),
+          this, SLOT(rowsAboutToBeInsertedSlot(const QModelIndex &, int, int)));
+  connect(model, SIGNAL(rowsInserted(const QModelIndex &, int, int)),
+          this, SLOT(rowsInsertedSlot(const QModelIndex &, int, int)));
+  connect(model, SIGNAL(rowsAboutToBeRemoved(const QModelIndex &, int, int)),
+          this, SLOT(rowsAboutToBeRemovedSlot(const QModelIndex &, int, int)));
+  connect(model, SIGNAL(rowsRemoved(const QModelIndex &, int, int)),
+          this, SLOT(rowsRemovedSlot(const QModelIndex &, int, int)));
+
+  connect(model, SIGNAL(columnsAboutToBeInserted(const QModelIndex &, int, int)),
+          this, SLOT(columnsAboutToBeInsertedSlot(const QModelIndex &, int, int)));
+  connect(model, SIGNAL(columnsInserted(const QModelIndex &, int, int)),
+          this, SLOT(columnsInsertedSlot()));
+  connect(model, SIGNAL(columnsAboutToBeRemoved(const QModelIndex &, int, int)),
+          this, SLOT(columnsAboutToBeRemovedSlot(const QModelIndex &, int, int)));
+  connect(model, SIGNAL(columnsRemoved(const QModelIndex &, int, int)),
+          this, SLOT(columnsRemovedSlot()));
+
+  connect(model, SIGNAL(modelAboutToBeReset()), this, SLOT(modelAboutToBeResetSlot()));
+  connect(model, SIGNAL(modelReset()), this, SLOT(modelResetSlot()));
+
+  connect(model, SIGNAL(layoutAboutToBeChanged()), this, SLOT(layoutAboutToBeChangedSlot()));
+  connect(model, SIGNAL(layoutChanged()), this, SLOT(layoutChangedSlot()));
 }
 
 CQChartsExprModel::
@@ -405,6 +494,9 @@ assignExtraColumn(const QString &header, int column, const QString &expr)
 
   extraColumn->expr = expr;
 
+  extraColumn->compiledExpr = CompiledExprP();
+  extraColumn->compileTried = false;
+
   extraColumn->variantMap.clear();
 
   extraColumn->function = Function::ASSIGN;
@@ -530,6 +622,12 @@ initCalc()
   qtcl_->resetLastValue();
   qtcl_->resetColumns();
 
+  // column names may have changed so recompile expressions
+  for (auto &extraColumn : extraColumns_) {
+    extraColumn->compiledExpr = CompiledExprP();
+    extraColumn->compileTried = false;
+  }
+
   //---
 
   // add user defined functions
@@ -959,15 +1057,111 @@ calcExtraColumnValue(int row, int column, int ecolumn, bool &rc)
 
   extraColumn.evaluating = true;
 
+  // compiled expression evaluates all remaining rows in a single pass
+  if (compileExtraColumn(extraColumn, column)) {
+    calcCompiledExtraColumn(extraColumn, row, column, rc);
+
+    extraColumn.evaluating = false;
+
+    auto p = extraColumn.variantMap.find(row);
+
+    return (p != extraColumn.variantMap.end() ? (*p).second : QVariant());
+  }
+
+  //---
+
   QString expr = extraColumn.expr;
 
   expr = replaceExprColumns(expr, row, column).simplified();
 
   QVariant var;
 
-  if (evaluateExpression(expr, var)) {
-    std::string str;
+  bool ok = evaluateExpression(expr, var);
+
+  if (! ok)
+    rc = false;
+
+  setExtraColumnValue(extraColumn, row, column, var, ok);
+
+  extraColumn.evaluating = false;
+
+  return var;
+}
+
+bool
+CQChartsExprModel::
+compileExtraColumn(ExtraColumn &extraColumn, int column)
+{
+  if (extraColumn.compileTried)
+    return !! extraColumn.compiledExpr;
+
+  extraColumn.compileTried = true;
+
+  // stringified and current row/column (@#, @r, @c, @v) values are substituted
+  // per row so need tcl
+  if (extraColumn.expr.contains("@#"))
+    return false;
+
+  QString expr = replaceExprColumns(extraColumn.expr, -1, column).simplified();
+
+  if (expr.contains('@'))
+    return false;
+
+  CompileContext context(this);
+
+  auto compiledExpr = std::make_shared<CQChartsCompiledExpr>();
+
+  if (! compiledExpr->compile(expr, context))
+    return false;
+
+  extraColumn.compiledExpr = compiledExpr;
+
+  return true;
+}
+
+void
+CQChartsExprModel::
+calcCompiledExtraColumn(ExtraColumn &extraColumn, int row, int column, bool &rc)
+{
+  CQPerfTrace trace("CQChartsExprModel::calcCompiledExtraColumn");
 
+  CompileContext context(this);
+
+  int nr = rowCount();
+
+  for (int r = 0; r < nr; ++r) {
+    if (extraColumn.variantMap.find(r) != extraColumn.variantMap.end())
+      continue;
+
+    currentRow_ = r;
+    currentCol_ = column;
+
+    QVariant var;
+
+    bool ok = true;
+
+    if (extraColumn.compiledExpr->eval(context, r, column, var))
+      qtcl_->setLastValue(var);
+    else {
+      // value not supported by compiled expression so use tcl
+      QString expr = replaceExprColumns(extraColumn.expr, r, column).simplified();
+
+      ok = evaluateExpression(expr, var);
+    }
+
+    if (! ok && r == row)
+      rc = false;
+
+    setExtraColumnValue(extraColumn, r, column, var, ok);
+  }
+}
+
+void
+CQChartsExprModel::
+setExtraColumnValue(ExtraColumn &extraColumn, int row, int column, const QVariant &var, bool ok)
+{
+  // update column type from value
+  if (ok) {
     if      (var.type() == QVariant::Double) {
       double real = var.value<double>();
 
@@ -999,11 +1193,8 @@ calcExtraColumnValue(int row, int column, int ecolumn, bool &rc)
         extraColumn.typeData.type = CQBaseModelType::STRING;
     }
   }
-  else
-    rc = false;
 
-  auto p = extraColumn.variantMap.insert(extraColumn.variantMap.end(),
-                                         VariantMap::value_type(row, var));
+  extraColumn.variantMap[row] = var;
 
   if (extraColumn.function == Function::ADD) {
     if (! extraColumn.values.empty())
@@ -1013,10 +1204,6 @@ calcExtraColumnValue(int row, int column, int ecolumn, bool &rc)
   if (isDebug())
     std::cerr << "Set Row " << row << " Column " << column << " = " <<
                  var.toString().toStdString() << std::endl;
-
-  extraColumn.evaluating = false;
-
-  return (*p).second;
 }
 
 bool
@@ -2403,7 +2590,291 @@ getModelData() const
 
 void
 CQChartsExprModel::
-dataChangedSlot(const QModelIndex &from, const QModelIndex &to)
+dataChangedSlot(const QModelIndex &from, const QModelIndex &to, const QVector<int> &roles)
+{
+  emit dataChanged(mapFromSource(from), mapFromSource(to), roles);
+}
+
+//---
+
+void
+CQChartsExprModel::
+rowsAboutToBeInsertedSlot(const QModelIndex &parent, int first, int last)
 {
-  emit dataChanged(mapFromSource(from), mapFromSource(to));
+  beginInsertRows(mapFromSource(parent), first, last);
+}
+
+void
+CQChartsExprModel::
+rowsInsertedSlot(const QModelIndex &parent, int first, int last)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  // extra column values are only stored for top level rows
+  if (! parent.isValid())
+    insertExtraRows(first, last - first + 1);
+
+  lock.unlock();
+
+  endInsertRows();
+}
+
+void
+CQChartsExprModel::
+rowsAboutToBeRemovedSlot(const QModelIndex &parent, int first, int last)
+{
+  beginRemoveRows(mapFromSource(parent), first, last);
+}
+
+void
+CQChartsExprModel::
+rowsRemovedSlot(const QModelIndex &parent, int first, int last)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  if (! parent.isValid())
+    removeExtraRows(first, last - first + 1);
+
+  lock.unlock();
+
+  endRemoveRows();
+}
+
+//---
+
+// extra columns follow source columns so source column numbers are unchanged
+void
+CQChartsExprModel::
+columnsAboutToBeInsertedSlot(const QModelIndex &parent, int first, int last)
+{
+  beginInsertColumns(mapFromSource(parent), first, last);
+}
+
+void
+CQChartsExprModel::
+columnsInsertedSlot()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  resetExtraValues();
+
+  lock.unlock();
+
+  endInsertColumns();
+}
+
+void
+CQChartsExprModel::
+columnsAboutToBeRemovedSlot(const QModelIndex &parent, int first, int last)
+{
+  beginRemoveColumns(mapFromSource(parent), first, last);
+}
+
+void
+CQChartsExprModel::
+columnsRemovedSlot()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  resetExtraValues();
+
+  lock.unlock();
+
+  endRemoveColumns();
+}
+
+//---
+
+void
+CQChartsExprModel::
+modelAboutToBeResetSlot()
+{
+  beginResetModel();
+}
+
+void
+CQChartsExprModel::
+modelResetSlot()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  // assigned values no longer match rows
+  int nr = rowCount();
+
+  for (auto &extraColumn : extraColumns_) {
+    if (! extraColumn->values.empty())
+      extraColumn->values = Values(nr);
+  }
+
+  resetExtraValues();
+
+  lock.unlock();
+
+  endResetModel();
+}
+
+//---
+
+void
+CQChartsExprModel::
+layoutAboutToBeChangedSlot()
+{
+  emit layoutAboutToBeChanged();
+
+  // save source index of persistent indices (extra columns use source row)
+  layoutData_ = LayoutData();
+
+  layoutData_.proxyInds = persistentIndexList();
+
+  for (const auto &ind : layoutData_.proxyInds)
+    layoutData_.sourceInds.push_back(model_->index(ind.row(), 0, mapToSource(ind.parent())));
+
+  // save source rows if assigned values need to be moved
+  bool hasValues = false;
+
+  for (auto &extraColumn : extraColumns_) {
+    if (! extraColumn->values.empty())
+      hasValues = true;
+  }
+
+  if (hasValues) {
+    int nr = model_->rowCount();
+
+    for (int r = 0; r < nr; ++r)
+      layoutData_.sourceRows.push_back(model_->index(r, 0, QModelIndex()));
+  }
+}
+
+void
+CQChartsExprModel::
+layoutChangedSlot()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  // move assigned values to new rows
+  int nr = int(layoutData_.sourceRows.size());
+
+  if (nr > 0) {
+    for (auto &extraColumn : extraColumns_) {
+      if (extraColumn->values.empty())
+        continue;
+
+      Values values(model_->rowCount());
+
+      for (int r = 0; r < nr && r < int(extraColumn->values.size()); ++r) {
+        const auto &ind = layoutData_.sourceRows[r];
+
+        if (ind.isValid() && ind.row() < int(values.size()))
+          values[ind.row()] = extraColumn->values[r];
+      }
+
+      extraColumn->values = values;
+    }
+  }
+
+  resetExtraValues();
+
+  lock.unlock();
+
+  //---
+
+  // update persistent indices to new source positions
+  QModelIndexList newInds;
+
+  int ni = layoutData_.proxyInds.size();
+
+  for (int i = 0; i < ni; ++i) {
+    const auto &ind       = layoutData_.proxyInds[i];
+    const auto &sourceInd = layoutData_.sourceInds[i];
+
+    if (sourceInd.isValid())
+      newInds.push_back(index(sourceInd.row(), ind.column(), mapFromSource(sourceInd.parent())));
+    else
+      newInds.push_back(QModelIndex());
+  }
+
+  changePersistentIndexList(layoutData_.proxyInds, newInds);
+
+  layoutData_ = LayoutData();
+
+  emit layoutChanged();
+}
+
+//---
+
+// insert n rows at row into cached extra column values (mutex must be locked)
+void
+CQChartsExprModel::
+insertExtraRows(int row, int n)
+{
+  for (auto &extraColumn : extraColumns_) {
+    if (! extraColumn->values.empty() && row <= int(extraColumn->values.size()))
+      extraColumn->values.insert(extraColumn->values.begin() + row, size_t(n), QVariant());
+
+    // calculated values after insert row move down (appended rows keep all values)
+    auto p = extraColumn->variantMap.lower_bound(row);
+
+    if (p != extraColumn->variantMap.end()) {
+      VariantMap variantMap;
+
+      for (auto p1 = extraColumn->variantMap.begin(); p1 != p; ++p1)
+        variantMap.insert(variantMap.end(), *p1);
+
+      for ( ; p != extraColumn->variantMap.end(); ++p)
+        variantMap.insert(variantMap.end(), VariantMap::value_type((*p).first + n, (*p).second));
+
+      extraColumn->variantMap.swap(variantMap);
+    }
+  }
+
+  // column ranges/buckets include new rows
+  columnDatas_.clear();
+}
+
+// remove n rows at row from cached extra column values (mutex must be locked)
+void
+CQChartsExprModel::
+removeExtraRows(int row, int n)
+{
+  for (auto &extraColumn : extraColumns_) {
+    int nv = int(extraColumn->values.size());
+
+    if (row < nv)
+      extraColumn->values.erase(extraColumn->values.begin() + row,
+                                extraColumn->values.begin() + std::min(row + n, nv));
+
+    auto p = extraColumn->variantMap.lower_bound(row);
+
+    if (p != extraColumn->variantMap.end()) {
+      VariantMap variantMap;
+
+      for (auto p1 = extraColumn->variantMap.begin(); p1 != p; ++p1)
+        variantMap.insert(variantMap.end(), *p1);
+
+      for ( ; p != extraColumn->variantMap.end(); ++p) {
+        if ((*p).first >= row + n)
+          variantMap.insert(variantMap.end(), VariantMap::value_type((*p).first - n, (*p).second));
+      }
+
+      extraColumn->variantMap.swap(variantMap);
+    }
+  }
+
+  columnDatas_.clear();
+}
+
+// clear calculated extra column values and cached column data (recalculated on demand)
+// (mutex must be locked)
+void
+CQChartsExprModel::
+resetExtraValues()
+{
+  for (auto &extraColumn : extraColumns_) {
+    extraColumn->variantMap.clear();
+
+    extraColumn->compiledExpr = CompiledExprP();
+    extraColumn->compileTried = false;
+  }
+
+  columnDatas_.clear();
 }
@@ -169,6 +169,15 @@ setMaxLineWidth(double r)
   CQChartsUtil::testAndSet(maxLineWidth_, r, [&]() { drawObjs(); } );
 }
 
+void
+CQChartsForceDirectedPlot::
+setTheta(double r)
+{
+  CQChartsUtil::testAndSet(theta_, r, [&]() {
+    if (forceDirected_) forceDirected_->setTheta(theta_);
+  } );
+}
+
 //---
 
 int
@@ -204,6 +213,8 @@ addProperties()
   addProp("options", "running"     , "", "Is running");
   addProp("options", "rangeSize"   , "", "Range size");
   addProp("options", "maxLineWidth", "", "Max line width");
+  addProp("options", "theta"       , "", "Barnes-Hut repulsion approximation (0 for exact)")->
+    setMinValue(0.0);
 
   // node/edge
   addProp("node", "nodeRadius", "radius"     , "Node radius in pixels")->setMinValue(0.0);
@@ -268,6 +279,8 @@ createObjs(PlotObjs &) const
 
   th->forceDirected_ = new CQChartsForceDirected;
 
+  th->forceDirected_->setTheta(theta_);
+
   th->idConnections_.clear();
   th->nameNodeMap_  .clear();
 
@@ -25,6 +25,35 @@
 #include <CQPerfMonitor.h>
 
 #include <deque>
+#include <future>
+#include <thread>
+
+namespace {
+
+// process sub ranges of [0, n) in separate threads (if threaded) or in current thread
+template<typename FN>
+void processRange(int n, bool threaded, const FN &fn) {
+  int numThreads = std::max(int(std::thread::hardware_concurrency()), 1);
+
+  if (threaded && numThreads > 1 && n > 1) {
+    std::vector<std::future<void>> futures;
+
+    int n1 = (n + numThreads - 1)/numThreads;
+
+    for (int i1 = 0; i1 < n; i1 += n1)
+      futures.push_back(std::async(std::launch::async, fn, i1, std::min(i1 + n1, n)));
+
+    for (auto &future : futures)
+      future.wait();
+  }
+  else
+    fn(0, n);
+}
+
+// min number of nodes to process in separate threads
+const int minThreadNodes = 1000;
+
+}
 
 CQChartsGraphPlotType::
 CQChartsGraphPlotType()
@@ -247,7 +276,7 @@ void
 CQChartsGraphPlot::
 setAdjustNodes(bool b)
 {
-  CQChartsUtil::testAndSet(adjustNodes_, b, [&]() { updateRangeAndObjs(); } );
+  CQChartsUtil::testAndSet(adjustNodes_, b, [&]() { resetLayout(); updateRangeAndObjs(); } );
 }
 
 void
@@ -439,6 +468,9 @@ createObjs(PlotObjs &objs) const
 
   //---
 
+  // save current placement to start next layout from
+  th->saveLayout();
+
   // init objects
   th->clearNodesAndEdges();
 
@@ -1179,8 +1211,14 @@ placeGraphNodes(Graph *graph, const Nodes &nodes) const
 
   //---
 
-  // adjust nodes in graph
-  adjustGraphNodes(graph, nodes);
+  // adjust nodes in graph (starting from previous layout if possible and only
+  // re-adjusting changed depths)
+  PosSet posSet;
+
+  if (restoreLayout(graph, posSet))
+    adjustGraphPosNodes(graph, nodes, &posSet);
+  else
+    adjustGraphNodes(graph, nodes);
 
   //---
 
@@ -1722,6 +1760,15 @@ bool
 CQChartsGraphPlot::
 adjustGraphNodes(Graph *graph, const Nodes &nodes) const
 {
+  return adjustGraphPosNodes(graph, nodes, nullptr);
+}
+
+bool
+CQChartsGraphPlot::
+adjustGraphPosNodes(Graph *graph, const Nodes &nodes, const PosSet *posSet) const
+{
+  CQPerfTrace trace("CQChartsGraphPlot::adjustGraphPosNodes");
+
 //auto *th = const_cast<CQChartsGraphPlot *>(this);
 
   //---
@@ -1738,17 +1785,24 @@ adjustGraphNodes(Graph *graph, const Nodes &nodes) const
   //---
 
   if (isAdjustNodes()) {
-    int numPasses = 25;
+    // adjust all depths (no pos set) or only specified depths
+    if (! posSet || ! posSet->empty()) {
+      int numPasses = 25;
 
-    for (int pass = 0; pass < numPasses; ++pass) {
-      //std::cerr << "Pass " << pass << "\n";
+      for (int pass = 0; pass < numPasses; ++pass) {
+        //std::cerr << "Pass " << pass << "\n";
 
-      if (! adjustNodeCenters(graph)) {
-        std::cerr << "adjustNodeCenters (#" << pass + 1 << " Passes)\n";
-        break;
+        if (! adjustNodeCenters(graph, posSet)) {
+          std::cerr << "adjustNodeCenters (#" << pass + 1 << " Passes)\n";
+          break;
+        }
       }
     }
 
+    // restored depths may overlap after node size change
+    if (posSet)
+      removeOverlaps(graph);
+
     //---
 
     reorderNodeEdges(graph, nodes);
@@ -1780,58 +1834,109 @@ initPosNodesMap(Graph *graph, const Nodes &nodes) const
 
 bool
 CQChartsGraphPlot::
-adjustNodeCenters(Graph *graph) const
+adjustNodeCenters(Graph *graph, const PosSet *posSet) const
 {
   // adjust nodes so centered on src nodes
   bool changed = false;
 
+  auto adjustDepthNodes = [&](int xpos) {
+    if (! graph->hasPosNodes(xpos)) return;
+
+    if (posSet && posSet->find(xpos) == posSet->end()) return;
+
+    if (adjustPosNodes(graph->posNodes(xpos)))
+      changed = true;
+  };
+
   // second to last
   int posNodesDepth = graph->posNodesMap().size();
 
-  for (int xpos = 1; xpos <= posNodesDepth; ++xpos) {
-    if (! graph->hasPosNodes(xpos)) continue;
+  for (int xpos = 1; xpos <= posNodesDepth; ++xpos)
+    adjustDepthNodes(xpos);
 
-    const auto &nodes = graph->posNodes(xpos);
+  removeOverlaps(graph, posSet);
 
-    for (const auto &node : nodes) {
-      if (adjustNode(node))
-        changed = true;
+  //---
+
+  // second to last to first
+  for (int xpos = posNodesDepth - 1; xpos >= 0; --xpos)
+    adjustDepthNodes(xpos);
+
+  removeOverlaps(graph, posSet);
+
+  return changed;
+}
+
+bool
+CQChartsGraphPlot::
+adjustPosNodes(const Nodes &nodes) const
+{
+  // calc move of all nodes at depth from current positions (in parallel for large
+  // number of nodes) and then move nodes (sub graph move also moves its nodes)
+  int n = int(nodes.size());
+
+  std::vector<double> dys(n, 0.0);
+
+  auto calcNodes = [&](int i1, int i2) {
+    for (int i = i1; i < i2; ++i) {
+      double dy;
+
+      if (calcNodeAdjust(nodes[i], dy))
+        dys[i] = dy;
     }
-  }
+  };
 
-  removeOverlaps(graph);
+  processRange(n, n >= minThreadNodes, calcNodes);
 
   //---
 
-  // second to last to first
-  for (int xpos = posNodesDepth - 1; xpos >= 0; --xpos) {
-    if (! graph->hasPosNodes(xpos)) continue;
+  bool changed = false;
 
-    const auto &nodes = graph->posNodes(xpos);
+  for (int i = 0; i < n; ++i) {
+    if (dys[i] == 0.0) continue;
 
-    for (const auto &node : nodes) {
-      if (adjustNode(node))
-        changed = true;
-    }
-  }
+    nodes[i]->moveBy(Point(0, dys[i]));
 
-  removeOverlaps(graph);
+    changed = true;
+  }
 
   return changed;
 }
 
 bool
 CQChartsGraphPlot::
-removeOverlaps(Graph *graph) const
+removeOverlaps(Graph *graph, const PosSet *posSet) const
 {
-  bool changed = false;
+  // get nodes for each depth (all or specified depths)
+  std::vector<const Nodes *> posNodesArray;
+
+  int numNodes = 0;
 
   for (const auto &posNodes : graph->posNodesMap()) {
-    if (removePosOverlaps(graph, posNodes.second))
-      changed = true;
+    if (posSet && posSet->find(posNodes.first) == posSet->end()) continue;
+
+    posNodesArray.push_back(&posNodes.second);
+
+    numNodes += int(posNodes.second.size());
   }
 
-  return changed;
+  //---
+
+  // nodes at each depth are only moved in y so depths are processed in parallel
+  int n = int(posNodesArray.size());
+
+  std::vector<int> changed(n, 0);
+
+  auto removeDepthOverlaps = [&](int i1, int i2) {
+    for (int i = i1; i < i2; ++i) {
+      if (removePosOverlaps(graph, *posNodesArray[i]))
+        changed[i] = 1;
+    }
+  };
+
+  processRange(n, numNodes >= minThreadNodes, removeDepthOverlaps);
+
+  return (std::find(changed.begin(), changed.end(), 1) != changed.end());
 }
 
 bool
@@ -1929,42 +2034,61 @@ spreadPosNodes(Graph *, const Nodes &nodes) const
 bool
 CQChartsGraphPlot::
 reorderNodeEdges(Graph *, const Nodes &nodes) const
+{
+  // sort node edges nodes by bbox
+  // (only updates edges of each node so nodes are processed in parallel)
+  int n = int(nodes.size());
+
+  std::vector<int> changed(n, 0);
+
+  auto reorderNodes = [&](int i1, int i2) {
+    for (int i = i1; i < i2; ++i) {
+      if (reorderNodeEdges(nodes[i]))
+        changed[i] = 1;
+    }
+  };
+
+  processRange(n, n >= minThreadNodes, reorderNodes);
+
+  return (std::find(changed.begin(), changed.end(), 1) != changed.end());
+}
+
+bool
+CQChartsGraphPlot::
+reorderNodeEdges(Node *node) const
 {
   bool changed = false;
 
-  // sort node edges nodes by bbox
-  for (const auto &node : nodes) {
-    PosEdgeMap srcPosEdgeMap;
+  PosEdgeMap srcPosEdgeMap;
 
-    createPosEdgeMap(node->srcEdges(), srcPosEdgeMap, /*isSrc*/true);
+  createPosEdgeMap(node->srcEdges(), srcPosEdgeMap, /*isSrc*/true);
 
-    if (srcPosEdgeMap.size() > 1) {
-      Edges srcEdges;
+  if (srcPosEdgeMap.size() > 1) {
+    Edges srcEdges;
 
-      for (const auto &srcPosNode : srcPosEdgeMap)
-        srcEdges.push_back(srcPosNode.second);
+    for (const auto &srcPosNode : srcPosEdgeMap)
+      srcEdges.push_back(srcPosNode.second);
 
-      node->setSrcEdges(srcEdges);
+    node->setSrcEdges(srcEdges);
 
-      changed = true;
-    }
+    changed = true;
+  }
 
-    //---
+  //---
 
-    PosEdgeMap destPosEdgeMap;
+  PosEdgeMap destPosEdgeMap;
 
-    createPosEdgeMap(node->destEdges(), destPosEdgeMap, /*isSrc*/false);
+  createPosEdgeMap(node->destEdges(), destPosEdgeMap, /*isSrc*/false);
 
-    if (destPosEdgeMap.size() > 1) {
-      Edges destEdges;
+  if (destPosEdgeMap.size() > 1) {
+    Edges destEdges;
 
-      for (const auto &destPosNode : destPosEdgeMap)
-        destEdges.push_back(destPosNode.second);
+    for (const auto &destPosNode : destPosEdgeMap)
+      destEdges.push_back(destPosNode.second);
 
-      node->setDestEdges(destEdges);
+    node->setDestEdges(destEdges);
 
-      changed = true;
-    }
+    changed = true;
   }
 
   return changed;
@@ -2022,6 +2146,20 @@ createPosEdgeMap(const Edges &edges, PosEdgeMap &posEdgeMap, bool isSrc) const
 bool
 CQChartsGraphPlot::
 adjustNode(Node *node) const
+{
+  double dy;
+
+  if (! calcNodeAdjust(node, dy))
+    return false;
+
+  node->moveBy(Point(0, dy));
+
+  return true;
+}
+
+bool
+CQChartsGraphPlot::
+calcNodeAdjust(Node *node, double &dy) const
 {
   BBox bbox;
 
@@ -2046,12 +2184,132 @@ adjustNode(Node *node) const
   if (! bbox.isValid())
     return false;
 
-  double dy = bbox.getYMid() - node->rect().getYMid();
+  dy = bbox.getYMid() - node->rect().getYMid();
 
   if (std::abs(dy) < 1E-6)
     return false;
 
-  node->moveBy(Point(0, dy));
+  return true;
+}
+
+//---
+
+void
+CQChartsGraphPlot::
+saveLayout()
+{
+  resetLayout();
+
+  layoutData_.align = align();
+
+  for (const auto &pg : graphs_) {
+    auto *graph = pg.second;
+    if (! graph->isPlaced()) continue;
+
+    auto &layoutGraph = layoutData_.graphs[graph->id()];
+
+    layoutGraph.maxNodeDepth = graph->maxNodeDepth();
+    layoutGraph.valueScale   = graph->valueScale ();
+    layoutGraph.valueMargin  = graph->valueMargin();
+
+    for (const auto &node : graph->placeNodes()) {
+      const auto &rect = node->rect();
+      if (! rect.isValid()) continue;
+
+      auto &layoutNode = layoutGraph.nodes[node->name()];
+
+      layoutNode.xpos = node->xpos();
+      layoutNode.size = node->edgeSum();
+      layoutNode.y    = rect.getYMid();
+    }
+  }
+
+  layoutData_.valid = ! layoutData_.graphs.empty();
+}
+
+void
+CQChartsGraphPlot::
+resetLayout()
+{
+  layoutData_.valid = false;
+
+  layoutData_.graphs.clear();
+}
+
+bool
+CQChartsGraphPlot::
+restoreLayout(Graph *graph, PosSet &posSet) const
+{
+  // only restore adjusted layout with same x placement
+  if (! layoutData_.valid || ! isAdjustNodes() || layoutData_.align != align())
+    return false;
+
+  auto pg = layoutData_.graphs.find(graph->id());
+  if (pg == layoutData_.graphs.end()) return false;
+
+  const auto &layoutGraph = (*pg).second;
+
+  if (layoutGraph.maxNodeDepth != graph->maxNodeDepth())
+    return false;
+
+  // all depths adjusted if node size scale or margin changed (e.g. resize)
+  bool scaleChanged = (! CMathUtil::realEq(layoutGraph.valueScale , graph->valueScale ()) ||
+                       ! CMathUtil::realEq(layoutGraph.valueMargin, graph->valueMargin()));
+
+  // get number of saved nodes at each depth
+  std::map<int, int> xposCount;
+
+  for (const auto &pn : layoutGraph.nodes)
+    ++xposCount[pn.second.xpos];
+
+  //---
+
+  // move nodes to previous center and get depths with added, removed or resized nodes
+  PosSet changedPos;
+
+  for (const auto &depthNodes : graph->depthNodesMap()) {
+    int         xpos  = depthNodes.first;
+    const auto &nodes = depthNodes.second.nodes;
+
+    bool changed = (scaleChanged || xposCount[xpos] != int(nodes.size()));
+
+    for (const auto &node : nodes) {
+      auto p = layoutGraph.nodes.find(node->name());
+
+      if (p == layoutGraph.nodes.end() || (*p).second.xpos != xpos) {
+        changed = true;
+        continue;
+      }
+
+      const auto &layoutNode = (*p).second;
+
+      if (! CMathUtil::realEq(layoutNode.size, node->edgeSum()))
+        changed = true;
+
+      node->moveBy(Point(0, layoutNode.y - node->rect().getYMid()));
+    }
+
+    if (changed)
+      changedPos.insert(xpos);
+  }
+
+  //---
+
+  // adjust changed depths and depths of nodes connected to them
+  for (const auto &depthNodes : graph->depthNodesMap()) {
+    int xpos = depthNodes.first;
+    if (changedPos.find(xpos) == changedPos.end()) continue;
+
+    posSet.insert(xpos);
+
+    for (const auto &node : depthNodes.second.nodes) {
+      for (const auto &edge : node->srcEdges())
+        posSet.insert(edge->srcNode()->xpos());
+
+      for (const auto &edge : node->destEdges())
+        posSet.insert(edge->destNode()->xpos());
+    }
+  }
 
   return true;
 }
@@ -2728,6 +2986,14 @@ editMove(const Point &p)
 
   editChanged_ = true;
 
+  // update moved node and its edges in search tree
+  plot()->updateObjTreeObj(this);
+
+  for (auto *obj : getConnected()) {
+    if (obj)
+      plot()->updateObjTreeObj(obj);
+  }
+
   plot()->drawObjs();
 
   return true;
@@ -2744,9 +3010,7 @@ bool
 CQChartsGraphNodeObj::
 editRelease(const Point &)
 {
-  if (editChanged_)
-    plot()->invalidateObjTree();
-
+  // search tree updated on move
   return true;
 }
 
@@ -905,22 +905,14 @@ CQChartsHierBubbleHierNode *
 CQChartsHierBubblePlot::
 childHierNode(HierNode *parent, const QString &name) const
 {
-  for (const auto &child : parent->getChildren())
-    if (child->name() == name)
-      return child;
-
-  return nullptr;
+  return parent->childByName(name);
 }
 
 CQChartsHierBubbleNode *
 CQChartsHierBubblePlot::
 childNode(HierNode *parent, const QString &name) const
 {
-  for (const auto &node : parent->getNodes())
-    if (node->name() == name)
-      return node;
-
-  return nullptr;
+  return parent->nodeByName(name);
 }
 
 bool
@@ -1644,8 +1636,12 @@ CQChartsHierBubbleHierNode(const Plot *plot, HierNode *parent, const QString &na
                            const QModelIndex &ind) :
  CQChartsHierBubbleNode(plot, parent, name, 0.0, ind)
 {
-  if (parent_)
+  if (parent_) {
     parent_->children_.push_back(this);
+
+    if (! parent_->nameChildren_.contains(name))
+      parent_->nameChildren_.insert(name, this);
+  }
 }
 
 CQChartsHierBubbleHierNode::
@@ -1744,6 +1740,9 @@ CQChartsHierBubbleHierNode::
 addNode(CQChartsHierBubbleNode *node)
 {
   nodes_.push_back(node);
+
+  if (! nameNodes_.contains(node->name()))
+    nameNodes_.insert(node->name(), node);
 }
 
 void
@@ -1767,6 +1766,18 @@ removeNode(CQChartsHierBubbleNode *node)
     nodes_[i - 1] = nodes_[i];
 
   nodes_.pop_back();
+
+  // update name lookup (to next node with same name)
+  if (nameNodes_.value(node->name()) == node) {
+    nameNodes_.remove(node->name());
+
+    for (const auto &node1 : nodes_) {
+      if (node1->name() == node->name()) {
+        nameNodes_.insert(node1->name(), node1);
+        break;
+      }
+    }
+  }
 }
 
 void
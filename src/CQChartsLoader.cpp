@@ -19,7 +19,7 @@
 
 #include <CQPerfMonitor.h>
 #include <CQTclUtil.h>
-#include <CMathCorrelation.h>
+#include <CMathUtil.h>
 
 CQChartsLoader::
 CQChartsLoader(CQCharts *charts) :
@@ -145,6 +145,11 @@ loadCsv(const QString &filename, const InputData &inputData)
   if (inputData.maxRows > 0)
     csvModel->setMaxRows(inputData.maxRows);
 
+  csvModel->setColumnar   (inputData.columnar);
+  csvModel->setMapped     (inputData.mapped);
+  csvModel->setProgressive(inputData.progressive);
+  csvModel->setTail       (inputData.tail);
+
   if (inputData.columns.length() > 0)
     csvModel->setColumns(inputData.columns);
 
@@ -177,6 +182,11 @@ loadTsv(const QString &filename, const InputData &inputData)
   if (inputData.columns.length() > 0)
     tsvModel->setColumns(inputData.columns);
 
+  tsvModel->setColumnar   (inputData.columnar);
+  tsvModel->setMapped     (inputData.mapped);
+  tsvModel->setProgressive(inputData.progressive);
+  tsvModel->setTail       (inputData.tail);
+
   if (! tsvModel->load(filename)) {
     delete tsv;
     return nullptr;
@@ -559,7 +569,7 @@ createTclModel(const InputData &inputData)
 
 CQChartsFilterModel *
 CQChartsLoader::
-createCorrelationModel(QAbstractItemModel *model, bool flip)
+createCorrelationModel(QAbstractItemModel *model, bool flip, const CorrelationType &type)
 {
   CQPerfTrace trace("CQChartsLoader::createCorrelationModel");
 
@@ -570,7 +580,7 @@ createCorrelationModel(QAbstractItemModel *model, bool flip)
 
   auto *columnTypeMgr = charts_->columnTypeMgr();
 
-  using ColumnValues = std::vector<CMathCorrelation::Values>;
+  using ColumnValues = CQChartsCorrelation::Columns;
   using ColumnNames  = std::vector<QString>;
   using RMinMax      = CQChartsGeom::RMinMax;
   using ColumnMinMax = std::vector<RMinMax>;
@@ -628,6 +638,12 @@ createCorrelationModel(QAbstractItemModel *model, bool flip)
 
         double v = CQChartsModelUtil::modelReal(model, ind, ok);
 
+        // missing values are skipped pairwise
+        if (! ok || CMathUtil::isNaN(v)) {
+          values[ir] = CMathUtil::getNaN();
+          continue;
+        }
+
         values[ir] = v;
 
         minMax.add(v);
@@ -662,6 +678,11 @@ createCorrelationModel(QAbstractItemModel *model, bool flip)
 
         double v = CQChartsModelUtil::modelReal(model, ind, ok);
 
+        if (! ok || CMathUtil::isNaN(v)) {
+          values[ic] = CMathUtil::getNaN();
+          continue;
+        }
+
         values[ic] = v;
 
         minMax.add(v);
@@ -671,79 +692,10 @@ createCorrelationModel(QAbstractItemModel *model, bool flip)
 
   //---
 
-  // calc off diagonal values
-  using ColumnReal          = std::map<int, double>;
-  using ColumnColumnReal    = std::map<int, ColumnReal>;
-  using ColumnPoints        = std::map<int, CQChartsCorrelationModel::Points>;
-  using ColumnColumnPoints  = std::map<int, ColumnPoints>;
-  using DevData             = std::pair<double, double>;
-  using ColumnDevData       = std::map<int, DevData>;
-  using ColumnColumnDevData = std::map<int, ColumnDevData>;
-  using ColumnDensity       = std::map<int, CQChartsDensity *>;
-  using Point               = CQChartsGeom::Point;
-
-  ColumnReal          columnSumSq;
-  ColumnColumnReal    columnsCorr;
-  ColumnColumnPoints  columnsPoints;
-  ColumnColumnDevData columnsDevData;
-  ColumnDensity       columnDensity;
-
-  for (int ic1 = 0; ic1 < nv; ++ic1) {
-    CQChartsColumn c1(ic1);
-
-    auto &values1 = columnValues[ic1];
-
-    for (int ic2 = ic1; ic2 < nv; ++ic2) {
-      if (ic1 != ic2) {
-        CQChartsColumn c2(ic2);
-
-        auto &values2 = columnValues[ic2];
-
-        double corr = CMathCorrelation::calc(values1, values2);
-
-        columnsCorr[ic1][ic2] = corr;
-        columnsCorr[ic2][ic1] = corr;
-
-        columnSumSq[ic1] += corr*corr;
-        columnSumSq[ic2] += corr*corr;
-
-        CQChartsCorrelationModel::Points points1, points2;
-
-        assert(values1.size() == values2.size());
-
-        int nv1 = values1.size();
-
-        for (int j = 0; j < nv1; ++j) {
-          points1.push_back(Point(values1[j], values2[j]));
-          points2.push_back(Point(values2[j], values1[j]));
-        }
-
-        columnsPoints[ic1][ic2] = points1;
-        columnsPoints[ic2][ic1] = points2;
-
-        double stddev1 = CMathCorrelation::stddev(values1);
-        double stddev2 = CMathCorrelation::stddev(values2);
-
-        columnsDevData[ic1][ic2] = DevData(stddev1, stddev2);
-        columnsDevData[ic2][ic1] = DevData(stddev2, stddev1);
-      }
-      else {
-        CQChartsCorrelationModel::Points points1;
-
-        int nv1 = values1.size();
-
-        CQChartsDensity::XVals xvals;
-
-        for (int j = 0; j < nv1; ++j)
-          xvals.push_back(values1[j]);
+  // calc correlation matrix
+  CQChartsCorrelation correlation(type);
 
-        if (! columnDensity[ic1])
-          columnDensity[ic1] = new CQChartsDensity;
-
-        columnDensity[ic1]->setXVals(xvals);
-      }
-    }
-  }
+  correlation.calc(columnValues);
 
   //---
 
@@ -753,9 +705,8 @@ createCorrelationModel(QAbstractItemModel *model, bool flip)
 
   SumColumns sumColumns;
 
-  for (const auto &pc : columnSumSq) {
-    sumColumns[pc.second].push_back(pc.first);
-  }
+  for (int ic = 0; ic < nv; ++ic)
+    sumColumns[correlation.sumSq(ic)].push_back(ic);
 
   ColumnNums sortedColumns;
 
@@ -770,6 +721,25 @@ createCorrelationModel(QAbstractItemModel *model, bool flip)
   // create model
   auto *correlationModel = new CQChartsCorrelationModel(nv);
 
+  // set all (sorted) correlation values in one step
+  using Cells = std::vector<QVariant>;
+  using Rows  = std::vector<Cells>;
+
+  Rows rows(nv);
+
+  for (int ic1 = 0; ic1 < nv; ++ic1) {
+    int ic1s = sortedColumns[ic1];
+
+    auto &cells = rows[ic1];
+
+    cells.resize(nv);
+
+    for (int ic2 = 0; ic2 < nv; ++ic2)
+      cells[ic2] = QVariant(correlation.corr(ic1s, sortedColumns[ic2]));
+  }
+
+  correlationModel->setRowsData(nv, std::move(rows));
+
   auto *filterModel = new CQChartsFilterModel(charts_, correlationModel);
 
   for (int ic = 0; ic < nv; ++ic) {
@@ -780,62 +750,57 @@ createCorrelationModel(QAbstractItemModel *model, bool flip)
 
   //---
 
-  // set header values and diagonal values
+  // set header values
   for (int ic = 0; ic < nv; ++ic) {
     int ics = sortedColumns[ic];
 
-    CQChartsColumn c(ic);
-
     QString columnName = columnNames[ics];
 
     CQChartsModelUtil::setModelHeaderValue(correlationModel, ic, Qt::Horizontal,
                                            columnName, Qt::DisplayRole);
     CQChartsModelUtil::setModelHeaderValue(correlationModel, ic, Qt::Vertical  ,
                                            columnName, Qt::DisplayRole);
-
-    CQChartsModelUtil::setModelValue(correlationModel, ic, c, 1.0);
   }
 
   //---
 
-  // set off diagonal values
+  // set column data (pair points and best fit are calculated when drawn)
   for (int ic1 = 0; ic1 < nv; ++ic1) {
     int ic1s = sortedColumns[ic1];
 
-    CQChartsColumn c1(ic1);
+    auto &values1 = columnValues[ic1s];
 
-    auto &minMax = columnMinMax[ic1s];
+    correlationModel->setMinMax(ic1, columnMinMax[ic1s]);
 
-    correlationModel->setMinMax(ic1, minMax);
+    //---
 
-    for (int ic2 = ic1; ic2 < nv; ++ic2) {
-      if (ic1 != ic2) {
-        int ic2s = sortedColumns[ic2];
+    auto *density = new CQChartsDensity;
 
-        CQChartsColumn c2(ic2);
+    CQChartsDensity::XVals xvals;
 
-        double corr = columnsCorr[ic1s][ic2s];
+    xvals.reserve(values1.size());
 
-        CQChartsModelUtil::setModelValue(correlationModel, ic1, c2, corr);
-        CQChartsModelUtil::setModelValue(correlationModel, ic2, c1, corr);
+    for (const auto &v : values1) {
+      if (! CMathUtil::isNaN(v))
+        xvals.push_back(v);
+    }
 
-        correlationModel->setPoints(ic1, ic2, columnsPoints[ic1s][ic2s]);
-        correlationModel->setPoints(ic2, ic1, columnsPoints[ic2s][ic1s]);
+    density->setXVals(xvals);
 
-        correlationModel->setDevData(ic1, ic2,
-          columnsDevData[ic1s][ic2s].first, columnsDevData[ic1s][ic2s].second);
-        correlationModel->setDevData(ic2, ic1,
-          columnsDevData[ic2s][ic1s].first, columnsDevData[ic2s][ic1s].second);
-      }
-      else {
-        CQChartsModelUtil::setModelValue(correlationModel, ic1, c1, 1.0);
-        CQChartsModelUtil::setModelValue(correlationModel, ic1, c1, 1.0); // Dup OK
+    correlationModel->setDensity(ic1, density);
+
+    //---
 
-        correlationModel->setDensity(ic1, columnDensity[ic1s]);
+    double stddev1 = correlation.stddev(ic1s);
 
+    for (int ic2 = 0; ic2 < nv; ++ic2) {
+      if (ic1 != ic2)
+        correlationModel->setDevData(ic1, ic2, stddev1, correlation.stddev(sortedColumns[ic2]));
+      else
         correlationModel->setDevData(ic1, ic1, 0.0, 0.0);
-      }
     }
+
+    correlationModel->setValues(ic1, std::move(values1));
   }
 
   //---
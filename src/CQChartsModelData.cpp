@@ -9,6 +9,7 @@
 #include <CQCharts.h>
 #include <CQChartsHtml.h>
 #include <CQChartsWidgetUtil.h>
+#include <CQChartsExprModel.h>
 
 #include <CQSummaryModel.h>
 #include <CQBucketModel.h>
@@ -23,11 +24,18 @@
 #include <CQPropertyViewModel.h>
 #include <CQTclUtil.h>
 #include <CQFileWatcher.h>
+#include <CQDataModel.h>
+#include <CQPerfMonitor.h>
+#include <CMathUtil.h>
 
 #include <QSortFilterProxyModel>
+#include <QAbstractProxyModel>
 #include <QItemSelectionModel>
 
 #include <fstream>
+#include <unordered_map>
+#include <future>
+#include <thread>
 
 QString
 CQChartsModelData::
@@ -182,10 +190,22 @@ fileChangedSlot(const QString &)
   ModelP model = this->currentModel();
 
   auto *absModel = CQChartsModelUtil::getBaseModel(model.data());
+
+  // if file only has rows appended then add new rows (model notifies rows inserted
+  // so plots can add objects for new rows)
+  auto *dataModel = qobject_cast<CQDataModel *>(absModel);
+
+  if (dataModel && dataModel->isTail() && dataModel->loadTail() >= 0)
+    return;
+
+  // otherwise (file replaced or truncated) reload whole file
   auto *csvModel = qobject_cast<CQCsvModel *>(absModel);
+  auto *tsvModel = qobject_cast<CQTsvModel *>(absModel);
 
-  if (csvModel)
+  if      (csvModel)
     csvModel->load(filename_);
+  else if (tsvModel)
+    tsvModel->load(filename_);
   else
     return;
 
@@ -252,7 +272,7 @@ connectModel(bool b)
 
   CQChartsWidgetUtil::connectDisconnect(b,
     model().data(), SIGNAL(rowsInserted(QModelIndex, int, int)),
-    this, SLOT(modelRowsInsertedSlot()));
+    this, SLOT(modelRowsInsertedSlot(QModelIndex, int, int)));
   CQChartsWidgetUtil::connectDisconnect(b,
     model().data(), SIGNAL(rowsRemoved(QModelIndex, int, int)),
     this, SLOT(modelRowsRemovedSlot()));
@@ -262,6 +282,37 @@ connectModel(bool b)
   CQChartsWidgetUtil::connectDisconnect(b,
     model().data(), SIGNAL(columnsRemoved(QModelIndex, int, int)),
     this, SLOT(modelColumnsRemovedSlot()));
+
+  // notify before rows/columns added or layout changed (e.g. by progressive load) so
+  // plot update threads reading the model can be stopped. The base model is also
+  // connected as filter proxy models only forward some of these after the change.
+  std::vector<QAbstractItemModel *> models;
+
+  models.push_back(model().data());
+
+  auto *baseModel = CQChartsModelUtil::getBaseModel(model().data());
+
+  if (baseModel && baseModel != model().data())
+    models.push_back(baseModel);
+
+  for (auto *model1 : models) {
+    CQChartsWidgetUtil::connectDisconnect(b,
+      model1, SIGNAL(layoutAboutToBeChanged()), this, SLOT(modelAboutToChangeSlot()));
+    CQChartsWidgetUtil::connectDisconnect(b,
+      model1, SIGNAL(modelAboutToBeReset()), this, SLOT(modelAboutToChangeSlot()));
+    CQChartsWidgetUtil::connectDisconnect(b,
+      model1, SIGNAL(rowsAboutToBeInserted(QModelIndex, int, int)),
+      this, SLOT(modelAboutToChangeSlot()));
+    CQChartsWidgetUtil::connectDisconnect(b,
+      model1, SIGNAL(rowsAboutToBeRemoved(QModelIndex, int, int)),
+      this, SLOT(modelAboutToChangeSlot()));
+    CQChartsWidgetUtil::connectDisconnect(b,
+      model1, SIGNAL(columnsAboutToBeInserted(QModelIndex, int, int)),
+      this, SLOT(modelAboutToChangeSlot()));
+    CQChartsWidgetUtil::connectDisconnect(b,
+      model1, SIGNAL(columnsAboutToBeRemoved(QModelIndex, int, int)),
+      this, SLOT(modelAboutToChangeSlot()));
+  }
 }
 
 void
@@ -277,9 +328,18 @@ modelDataChangedSlot(const QModelIndex & /*tl*/, const QModelIndex & /*br*/)
   if (details_)
     details_->reset();
 
+  resetColumnValues();
+
   emit modelChanged();
 }
 
+void
+CQChartsModelData::
+modelAboutToChangeSlot()
+{
+  emit modelAboutToChange();
+}
+
 void
 CQChartsModelData::
 modelLayoutChangedSlot()
@@ -287,6 +347,8 @@ modelLayoutChangedSlot()
   if (details_)
     details_->reset();
 
+  resetColumnValues();
+
   emit modelChanged();
 }
 
@@ -297,15 +359,31 @@ modelResetSlot()
   if (details_)
     details_->reset();
 
+  resetColumnValues();
+
   emit modelChanged();
 }
 
 void
 CQChartsModelData::
-modelRowsInsertedSlot()
+modelRowsInsertedSlot(const QModelIndex &parent, int first, int last)
 {
-  if (details_)
-    details_->reset();
+  bool appended = (! parent.isValid() && last == model()->rowCount() - 1);
+
+  // update details incrementally for rows added to end of model
+  if (details_) {
+    if (appended)
+      (void) details_->appendRows(first, last);
+    else
+      details_->reset();
+  }
+
+  resetColumnValues();
+
+  // notify rows added to end of model (before model changed) so plots can add objects
+  // for new rows instead of recalculating all
+  if (appended)
+    emit modelRowsAppended(first, last);
 
   emit modelChanged();
 }
@@ -317,6 +395,8 @@ modelRowsRemovedSlot()
   if (details_)
     details_->reset();
 
+  resetColumnValues();
+
   emit modelChanged();
 }
 
@@ -327,6 +407,8 @@ modelColumnsInsertedSlot()
   if (details_)
     details_->reset();
 
+  resetColumnValues();
+
   emit modelChanged();
 }
 
@@ -337,9 +419,208 @@ modelColumnsRemovedSlot()
   if (details_)
     details_->reset();
 
+  resetColumnValues();
+
   emit modelChanged();
 }
 
+CQChartsModelData::ColumnRealsP
+CQChartsModelData::
+columnReals(const QAbstractItemModel *model, const CQChartsColumn &column) const
+{
+  if (! model || ! column.isValid())
+    return ColumnRealsP();
+
+  std::unique_lock<std::mutex> lock(columnMutex_);
+
+  ColumnRealsKey key(model, column.toString());
+
+  auto p = columnReals_.find(key);
+
+  if (p == columnReals_.end()) {
+    auto reals = calcColumnReals(model, column);
+
+    p = columnReals_.insert(p, ColumnRealsMap::value_type(key, reals));
+  }
+
+  return (*p).second;
+}
+
+CQChartsModelData::ColumnRealsP
+CQChartsModelData::
+calcColumnReals(const QAbstractItemModel *model, const CQChartsColumn &column) const
+{
+  CQPerfTrace trace("CQChartsModelData::calcColumnReals");
+
+  int nr = model->rowCount();
+
+  auto reals = std::make_shared<CQChartsColumnReals>(nr);
+
+  //---
+
+  // data column of base data model (not extra column) can be read from source directly
+  // if proxy chain is only filter/sort and expression models (rows map one to one)
+  const CQDataModel *dataModel = nullptr;
+
+  using ProxyModels = std::vector<const QAbstractProxyModel *>;
+
+  ProxyModels proxyModels;
+
+  if (column.type() == CQChartsColumn::Type::DATA && ! column.hasRole()) {
+    auto *model1 = model;
+
+    while (model1) {
+      dataModel = qobject_cast<const CQDataModel *>(model1);
+      if (dataModel) break;
+
+      auto *proxyModel = qobject_cast<const QAbstractProxyModel *>(model1);
+
+      if (! qobject_cast<const QSortFilterProxyModel *>(proxyModel) &&
+          ! qobject_cast<const CQChartsExprModel     *>(proxyModel))
+        break;
+
+      proxyModels.push_back(proxyModel);
+
+      model1 = proxyModel->sourceModel();
+    }
+
+    if (dataModel && (column.column() < 0 || column.column() >= dataModel->columnCount()))
+      dataModel = nullptr;
+  }
+
+  // values of time columns must be converted by the column type (input format) so
+  // are read through the model
+  if (dataModel) {
+    CQChartsModelTypeData typeData;
+
+    if (CQChartsModelUtil::columnValueType(charts_, model, column, typeData) &&
+        typeData.type == CQBaseModelType::TIME)
+      dataModel = nullptr;
+  }
+
+  //---
+
+  if (dataModel) {
+    int icolumn = column.column();
+
+    // map row through proxy models to data model row
+    auto mapRow = [&](int row) {
+      QModelIndex ind = model->index(row, icolumn, QModelIndex());
+
+      for (const auto *proxyModel : proxyModels)
+        ind = proxyModel->mapToSource(ind);
+
+      return ind;
+    };
+
+    const auto *dataColumn = dataModel->dataColumn(icolumn);
+
+    if      (dataColumn && dataColumn->type() == CQDataColumn::Type::REAL) {
+      const auto &values = dataColumn->reals();
+
+      for (int r = 0; r < nr; ++r) {
+        int r1 = mapRow(r).row();
+
+        if (r1 >= 0 && ! dataColumn->isNull(r1))
+          reals->setValue(r, values[r1]);
+      }
+    }
+    else if (dataColumn && dataColumn->type() == CQDataColumn::Type::INTEGER) {
+      const auto &values = dataColumn->integers();
+
+      for (int r = 0; r < nr; ++r) {
+        int r1 = mapRow(r).row();
+
+        if (r1 >= 0 && ! dataColumn->isNull(r1))
+          reals->setValue(r, double(values[r1]));
+      }
+    }
+    else {
+      for (int r = 0; r < nr; ++r) {
+        QModelIndex ind1 = mapRow(r);
+
+        bool ok;
+
+        double rv = CQChartsModelUtil::modelReal(dataModel, ind1, ok);
+
+        if (ok)
+          reals->setValue(r, rv);
+      }
+    }
+  }
+  else {
+    // fallback to value lookup through proxy models (and column type conversion)
+    for (int r = 0; r < nr; ++r) {
+      bool ok;
+
+      double rv = CQChartsModelUtil::modelReal(charts_, model, r, column, QModelIndex(), ok);
+
+      if (ok)
+        reals->setValue(r, rv);
+    }
+  }
+
+  return reals;
+}
+
+CQChartsModelData::SortedValuesP
+CQChartsModelData::
+sortedValues(const QAbstractItemModel *model, const CQChartsColumn &column,
+             const QString &filter, const std::vector<double> &values) const
+{
+  if (! model || ! column.isValid())
+    return std::make_shared<CQChartsSortedValues>(values);
+
+  SortedValuesKey key(ColumnRealsKey(model, column.toString()), filter);
+
+  // reuse cached sorted values if built from same values
+  SortedValuesP sortedValues;
+
+  {
+    std::unique_lock<std::mutex> lock(sortedMutex_);
+
+    auto p = sortedValues_.find(key);
+
+    if (p != sortedValues_.end())
+      sortedValues = (*p).second;
+  }
+
+  if (sortedValues && sortedValues->isSame(values))
+    return sortedValues;
+
+  //---
+
+  // sort values (outside lock) and update cache
+  CQPerfTrace trace("CQChartsModelData::sortedValues");
+
+  sortedValues = std::make_shared<CQChartsSortedValues>(values);
+
+  {
+    std::unique_lock<std::mutex> lock(sortedMutex_);
+
+    sortedValues_[key] = sortedValues;
+  }
+
+  return sortedValues;
+}
+
+void
+CQChartsModelData::
+resetColumnValues()
+{
+  {
+    std::unique_lock<std::mutex> lock(columnMutex_);
+
+    columnReals_.clear();
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(sortedMutex_);
+
+    sortedValues_.clear();
+  }
+}
+
 CQChartsModelData::ModelP
 CQChartsModelData::
 currentModel() const
@@ -665,6 +946,8 @@ foldClear(bool notify)
 
   hierSepModel_ = ModelP();
 
+  resetColumnValues();
+
   //---
 
   if (notify) {
@@ -1663,25 +1946,158 @@ copy(const CopyData &copyData)
 
 //------
 
+namespace {
+
+// typed key value (null never matches). Values of numeric columns are compared as numbers
+// and other values as strings, so the key does not depend on the stored variant type
+struct KeyValue {
+  enum class Type {
+    NONE,
+    REAL,
+    STRING
+  };
+
+  Type    type { Type::NONE };
+  double  r    { 0.0 };
+  QString s;
+
+  KeyValue() = default;
+
+  KeyValue(const QVariant &var, bool numeric) {
+    if (! var.isValid())
+      return;
+
+    if (numeric) {
+      bool ok;
+
+      double r1 = CQChartsVariant::toReal(var, ok);
+
+      if (ok && ! CMathUtil::isNaN(r1)) {
+        r    = (r1 != 0.0 ? r1 : 0.0); // -0.0 same as 0.0
+        type = Type::REAL;
+
+        return;
+      }
+    }
+
+    s    = var.toString();
+    type = Type::STRING;
+  }
+
+  bool operator==(const KeyValue &rhs) const {
+    if (type != rhs.type) return false;
+
+    if      (type == Type::REAL  ) return (r == rhs.r);
+    else if (type == Type::STRING) return (s == rhs.s);
+
+    return true;
+  }
+};
+
+struct KeyValueHash {
+  size_t operator()(const KeyValue &value) const {
+    if      (value.type == KeyValue::Type::REAL)
+      return std::hash<double>()(value.r);
+    else if (value.type == KeyValue::Type::STRING)
+      return qHash(value.s);
+
+    return 0;
+  }
+};
+
+// composite row key (value per key column)
+using RowKey = std::vector<KeyValue>;
+
+struct RowKeyHash {
+  size_t operator()(const RowKey &key) const {
+    size_t h = 0;
+
+    for (const auto &value : key) {
+      size_t h1 = KeyValueHash()(value);
+
+      h ^= h1 + 0x9e3779b9 + (h << 6) + (h >> 2);
+    }
+
+    return h;
+  }
+};
+
+bool isNullRowKey(const RowKey &key) {
+  for (const auto &value : key)
+    if (value.type == KeyValue::Type::NONE)
+      return true;
+
+  return false;
+}
+
+// is column type numeric (key values compared as numbers)
+bool isNumericKeyColumn(CQCharts *charts, const QAbstractItemModel *model, int icolumn) {
+  CQChartsModelTypeData typeData;
+
+  if (! CQChartsModelUtil::columnValueType(charts, model, CQChartsColumn(icolumn), typeData))
+    return false;
+
+  return (typeData.type == CQBaseModelType::INTEGER || typeData.type == CQBaseModelType::REAL);
+}
+
+// process rows in parallel chunks (chunk index passed to function)
+template<typename FN>
+int processRowsParallel(int nr, const FN &fn) {
+  int numThreads = std::max(int(std::thread::hardware_concurrency()), 1);
+
+  const int minThreadRows = 10000;
+
+  if (numThreads < 2 || nr < minThreadRows) {
+    fn(0, 0, nr);
+    return 1;
+  }
+
+  int n = (nr + numThreads - 1)/numThreads;
+
+  std::vector<std::future<void>> futures;
+
+  int i = 0;
+
+  for (int r1 = 0; r1 < nr; r1 += n, ++i)
+    futures.push_back(std::async(std::launch::async, fn, i, r1, std::min(r1 + n, nr)));
+
+  for (auto &future : futures)
+    future.wait();
+
+  return i;
+}
+
+}
+
 QAbstractItemModel *
 CQChartsModelData::
-join(CQChartsModelData *joinModelData, const Columns &joinColumns)
+join(CQChartsModelData *joinModelData, const Columns &joinColumns, const JoinType &joinType)
 {
+  CQPerfTrace trace("CQChartsModelData::join");
+
   if (joinColumns.empty())
     return nullptr;
 
   //--
 
-  auto *details = this->details();
+  auto *model = this->model().data();
+  if (! model) return nullptr;
 
-  int nc = details->numColumns();
-  int nr = details->numRows();
+  auto *joinModel = joinModelData->model().data();
+  if (! joinModel) return nullptr;
+
+  int nc = model->columnCount();
+  int nr = model->rowCount();
+
+  int joinNc = joinModel->columnCount();
+  int joinNr = joinModel->rowCount();
 
   //---
 
-  using ColumnSet = std::set<int>;
+  using ColumnArray = std::vector<int>;
+  using ColumnSet   = std::set<int>;
 
-  ColumnSet columnSet;
+  ColumnArray keyColumns;
 
   for (const auto &joinColumn : joinColumns) {
     int ijoinColumn = joinColumn.column();
@@ -1689,177 +2105,236 @@ join(CQChartsModelData *joinModelData, const Columns &joinColumns)
     if (ijoinColumn < 0 || ijoinColumn >= nc)
       return nullptr;
 
-    columnSet.insert(ijoinColumn);
+    keyColumns.push_back(ijoinColumn);
   }
 
   //---
 
-  auto *joinDetails = joinModelData->details();
+  // find column with matching name in join model (in join column order)
+  ColumnArray joinKeyColumns;
+  ColumnSet   joinColumnSet;
 
-  int joinNc = joinDetails->numColumns();
-  int joinNr = joinDetails->numRows();
+  for (const auto &joinColumn : joinColumns) {
+    bool ok;
 
-  //---
+    QString columnName = CQChartsModelUtil::modelHHeaderString(model, joinColumn, ok);
 
-  auto *model = this->model().data();
-  if (! model) return nullptr;
+    int joinKeyColumn = -1;
 
-  auto *joinModel = joinModelData->model().data();
-  if (! joinModel) return nullptr;
+    for (int ic = 0; ic < joinNc; ++ic) {
+      CQChartsColumn c(ic);
 
-  //---
+      QString joinColumnName = CQChartsModelUtil::modelHHeaderString(joinModel, c, ok);
 
-  // get name of join column(s)
-  bool ok;
+      if (joinColumnName == columnName) {
+        joinKeyColumn = ic;
+        break;
+      }
+    }
 
-  QStringList columnNames;
+    if (joinKeyColumn < 0 || joinColumnSet.find(joinKeyColumn) != joinColumnSet.end())
+      return nullptr;
 
-  for (const auto &joinColumn : joinColumns) {
-    QString columnName = CQChartsModelUtil::modelHHeaderString(model, joinColumn, ok);
+    joinKeyColumns.push_back(joinKeyColumn);
 
-    columnNames.push_back(columnName);
+    joinColumnSet.insert(joinKeyColumn);
   }
 
-  //---
-
-  // find column with matching name in join model
-  ColumnSet joinColumnSet;
+  // join model value columns (non join columns)
+  ColumnArray joinValueColumns;
 
   for (int ic = 0; ic < joinNc; ++ic) {
-    CQChartsColumn c(ic);
-
-    bool ok;
-
-    QString joinColumnName = CQChartsModelUtil::modelHHeaderString(joinModel, c, ok);
-
-    if (columnNames.contains(joinColumnName))
-      joinColumnSet.insert(ic);
+    if (joinColumnSet.find(ic) == joinColumnSet.end())
+      joinValueColumns.push_back(ic);
   }
 
-  if (joinColumnSet.size() != joinColumns.size())
-    return nullptr;
+  int nk  = int(keyColumns.size());
+  int njv = int(joinValueColumns.size());
+  int nc1 = nc + njv;
 
   //---
 
-  auto encodeVariantList = [&](const QVariantList &vars) {
-    if (vars.size() == 1)
-      return vars[0];
+  auto editData = [](const QAbstractItemModel *model, int r, int c) {
+    QModelIndex ind = model->index(r, c);
 
-    QStringList strs;
+    QVariant var = model->data(ind, Qt::EditRole);
 
-    for (const auto &var : vars)
-      strs.push_back(var.toString());
+    if (! var.isValid())
+      var = model->data(ind, Qt::DisplayRole);
 
-    return QVariant(strs.join(":"));
+    return var;
   };
 
   //---
 
-  // build map of join columns variant/name to row
-  using VariantRowMap = std::map<QVariant, int>;
+  // key columns pairs are compared as numbers if both columns are numeric, otherwise
+  // as strings
+  using NumericKeys = std::vector<bool>;
 
-  VariantRowMap variantRowMap;
+  NumericKeys numericKeys(nk);
 
-  for (int r = 0; r < joinNr; ++r) {
-    QVariantList vars;
+  for (int k = 0; k < nk; ++k)
+    numericKeys[k] = (isNumericKeyColumn(charts_, model    , keyColumns    [k]) &&
+                      isNumericKeyColumn(charts_, joinModel, joinKeyColumns[k]));
+
+  //---
 
-    for (const auto &ijoinColumn : joinColumnSet) {
-      QModelIndex ind1 = joinModel->index(r, ijoinColumn);
+  // get join model row keys (in parallel) and build hash table of key to rows
+  using RowKeys = std::vector<RowKey>;
 
-      QVariant var = joinModel->data(ind1, Qt::EditRole);
+  RowKeys joinKeys(joinNr);
 
-      if (! var.isValid())
-        var = joinModel->data(ind1, Qt::DisplayRole);
+  (void) processRowsParallel(joinNr, [&](int, int r1, int r2) {
+    for (int r = r1; r < r2; ++r) {
+      auto &key = joinKeys[r];
 
-      vars.push_back(var);
+      key.reserve(nk);
+
+      for (int k = 0; k < nk; ++k)
+        key.push_back(KeyValue(editData(joinModel, r, joinKeyColumns[k]), numericKeys[k]));
     }
+  });
+
+  using Rows       = std::vector<int>;
+  using KeyRowsMap = std::unordered_map<RowKey, Rows, RowKeyHash>;
+
+  KeyRowsMap keyRowsMap;
 
-    QVariant var = encodeVariantList(vars);
+  keyRowsMap.reserve(joinNr);
 
-    variantRowMap[var] = r;
+  for (int r = 0; r < joinNr; ++r) {
+    if (! isNullRowKey(joinKeys[r]))
+      keyRowsMap[joinKeys[r]].push_back(r);
   }
 
   //---
 
-  auto *dataModel = new CQDataModel(nc + joinNc - joinColumns.size(), nr);
+  // probe with model rows (in parallel chunks) and build output rows
+  using Cells     = std::vector<QVariant>;
+  using RowsData  = std::vector<Cells>;
+  using ChunkRows = std::vector<RowsData>;
+  using RowsArray = std::vector<Rows>;
 
-  //---
+  int numThreads = std::max(int(std::thread::hardware_concurrency()), 1);
 
-  // copy model data
-  for (int r = 0; r < nr; ++r) {
-    // add model column data and generate join key
-    QVariantList joinVars;
+  ChunkRows chunkRows   (numThreads);
+  RowsArray chunkMatched(numThreads);
 
-    for (int ic = 0; ic < nc; ++ic) {
-      QModelIndex ind1 = model->index(r, ic);
+  auto addJoinValues = [&](Cells &cells, int joinRow) {
+    for (int i = 0; i < njv; ++i)
+      cells[nc + i] = editData(joinModel, joinRow, joinValueColumns[i]);
+  };
 
-      QVariant var = model->data(ind1);
+  int numChunks = processRowsParallel(nr, [&](int i, int r1, int r2) {
+    auto &rows    = chunkRows   [i];
+    auto &matched = chunkMatched[i];
 
-      if (columnSet.find(ic) != columnSet.end())
-        joinVars.push_back(var);
+    rows.reserve(r2 - r1);
 
-      if (var.isValid()) {
-        QModelIndex ind2 = dataModel->index(r, ic);
+    RowKey key;
 
-        dataModel->setData(ind2, var);
+    for (int r = r1; r < r2; ++r) {
+      Cells cells(nc1);
+
+      for (int ic = 0; ic < nc; ++ic)
+        cells[ic] = model->data(model->index(r, ic));
+
+      key.clear();
+
+      for (int k = 0; k < nk; ++k)
+        key.push_back(KeyValue(editData(model, r, keyColumns[k]), numericKeys[k]));
+
+      auto p = (! isNullRowKey(key) ? keyRowsMap.find(key) : keyRowsMap.end());
+
+      if (p == keyRowsMap.end()) {
+        if (joinType != JoinType::INNER)
+          rows.push_back(std::move(cells));
+
+        continue;
+      }
+
+      // add row for each matching join model row
+      const auto &joinRows = (*p).second;
+
+      int nj = int(joinRows.size());
+
+      for (int j = 0; j < nj; ++j) {
+        int joinRow = joinRows[j];
+
+        if (j < nj - 1) {
+          Cells cells1 = cells;
+
+          addJoinValues(cells1, joinRow);
+
+          rows.push_back(std::move(cells1));
+        }
+        else {
+          addJoinValues(cells, joinRow);
+
+          rows.push_back(std::move(cells));
+        }
+
+        if (joinType == JoinType::OUTER)
+          matched.push_back(joinRow);
       }
     }
+  });
 
-    QVariant joinVar = encodeVariantList(joinVars);
+  //---
 
-    //---
+  // combine chunk rows (in model row order)
+  int numRows = 0;
 
-    // get matching row in join model for key
-    auto p = variantRowMap.find(joinVar);
+  for (int i = 0; i < numChunks; ++i)
+    numRows += int(chunkRows[i].size());
 
-    if (p == variantRowMap.end())
-      continue;
+  RowsData rowsData;
 
-    int joinRow = (*p).second;
+  rowsData.reserve(numRows);
 
-    //---
+  for (int i = 0; i < numChunks; ++i) {
+    for (auto &cells : chunkRows[i])
+      rowsData.push_back(std::move(cells));
 
-    // add join module column values for matching row
-    int c1 = nc;
+    RowsData().swap(chunkRows[i]);
+  }
 
-    for (int ic = 0; ic < joinNc; ++ic) {
-      // skip join columns
-      if (joinColumnSet.find(ic) != joinColumnSet.end())
-        continue;
+  // outer join adds unmatched join model rows (with join column values)
+  if (joinType == JoinType::OUTER) {
+    std::vector<bool> joinMatched(joinNr, false);
 
-      QModelIndex ind1 = joinModel->index(joinRow, ic);
+    for (int i = 0; i < numChunks; ++i)
+      for (const auto &joinRow : chunkMatched[i])
+        joinMatched[joinRow] = true;
 
-      QVariant var = joinModel->data(ind1, Qt::EditRole);
+    for (int r = 0; r < joinNr; ++r) {
+      if (joinMatched[r])
+        continue;
 
-      if (! var.isValid())
-        var = joinModel->data(ind1, Qt::DisplayRole);
+      Cells cells(nc1);
 
-      if (var.isValid()) {
-        QModelIndex ind2 = dataModel->index(r, c1);
+      for (int k = 0; k < nk; ++k)
+        cells[keyColumns[k]] = editData(joinModel, r, joinKeyColumns[k]);
 
-        dataModel->setData(ind2, var);
-      }
+      addJoinValues(cells, r);
 
-      ++c1;
+      rowsData.push_back(std::move(cells));
     }
   }
 
   //---
 
-  // copy horizontal header data
-  copyHeaderRoles(dataModel);
+  auto *dataModel = new CQDataModel(nc1, 0);
 
-  int c1 = nc;
+  dataModel->setRowsData(nc1, std::move(rowsData));
 
-  for (int ic = 0; ic < joinNc; ++ic) {
-    // skip join columns
-    if (joinColumnSet.find(ic) != joinColumnSet.end())
-      continue;
+  //---
 
-    joinModelData->copyColumnHeaderRoles(dataModel, ic, c1);
+  // copy horizontal header data
+  copyHeaderRoles(dataModel);
 
-    ++c1;
-  }
+  for (int i = 0; i < njv; ++i)
+    joinModelData->copyColumnHeaderRoles(dataModel, joinValueColumns[i], nc + i);
 
   //---
 
@@ -1990,6 +2465,222 @@ groupColumns(const Columns &groupColumns)
   return filterModel;
 }
 
+QAbstractItemModel *
+CQChartsModelData::
+groupBy(const Columns &groupColumns, const GroupAggregates &aggregates)
+{
+  CQPerfTrace trace("CQChartsModelData::groupBy");
+
+  auto *model = this->model().data();
+  if (! model) return nullptr;
+
+  int nc = model->columnCount();
+  int nr = model->rowCount();
+
+  //---
+
+  using ColumnArray = std::vector<int>;
+
+  ColumnArray keyColumns;
+
+  for (const auto &groupColumn : groupColumns) {
+    int icolumn = groupColumn.column();
+
+    if (icolumn < 0 || icolumn >= nc)
+      return nullptr;
+
+    keyColumns.push_back(icolumn);
+  }
+
+  // unique value columns of aggregates
+  ColumnArray valueColumns;
+
+  using ColumnInd = std::map<int, int>;
+
+  ColumnInd valueColumnInd;
+
+  for (const auto &aggregate : aggregates) {
+    if (aggregate.type == CQGroupBy::AggType::COUNT && ! aggregate.column.isValid())
+      continue;
+
+    int icolumn = aggregate.column.column();
+
+    if (icolumn < 0 || icolumn >= nc)
+      return nullptr;
+
+    if (valueColumnInd.find(icolumn) == valueColumnInd.end()) {
+      valueColumnInd[icolumn] = int(valueColumns.size());
+
+      valueColumns.push_back(icolumn);
+    }
+  }
+
+  int nk = int(keyColumns  .size());
+  int nv = int(valueColumns.size());
+
+  //---
+
+  auto editData = [](const QAbstractItemModel *model, int r, int c) {
+    QModelIndex ind = model->index(r, c);
+
+    QVariant var = model->data(ind, Qt::EditRole);
+
+    if (! var.isValid())
+      var = model->data(ind, Qt::DisplayRole);
+
+    return var;
+  };
+
+  //---
+
+  // key values of numeric columns are grouped by number, otherwise by string
+  std::vector<bool> numericKeys(nk);
+
+  for (int k = 0; k < nk; ++k)
+    numericKeys[k] = isNumericKeyColumn(charts_, model, keyColumns[k]);
+
+  //---
+
+  // read key and value columns (in parallel)
+  using KeyValues    = std::vector<KeyValue>;
+  using ColumnKeys   = std::vector<KeyValues>;
+  using ColumnValues = std::vector<CQGroupBy::Values>;
+
+  ColumnKeys   columnKeys  (nk, KeyValues(nr));
+  ColumnValues columnValues(nv, CQGroupBy::Values(nr));
+
+  (void) processRowsParallel(nr, [&](int, int r1, int r2) {
+    for (int r = r1; r < r2; ++r) {
+      for (int k = 0; k < nk; ++k)
+        columnKeys[k][r] = KeyValue(editData(model, r, keyColumns[k]), numericKeys[k]);
+
+      for (int v = 0; v < nv; ++v) {
+        QModelIndex ind = model->index(r, valueColumns[v]);
+
+        bool ok;
+
+        double rv = CQChartsModelUtil::modelReal(model, ind, ok);
+
+        columnValues[v][r] = (ok ? rv : CMathUtil::getNaN());
+      }
+    }
+  });
+
+  //---
+
+  // group by integer coded key values (null values group together)
+  CQGroupBy groupBy(nr);
+
+  for (int k = 0; k < nk; ++k) {
+    CQGroupBy::KeyCoder<KeyValue, KeyValueHash> coder;
+
+    CQGroupBy::Codes codes(nr);
+
+    for (int r = 0; r < nr; ++r)
+      codes[r] = coder.code(columnKeys[k][r]);
+
+    groupBy.addKeyColumn(codes, coder.numCodes());
+  }
+
+  columnKeys.clear();
+
+  for (int v = 0; v < nv; ++v)
+    groupBy.addValueColumn(columnValues[v]);
+
+  columnValues.clear();
+
+  for (const auto &aggregate : aggregates) {
+    int iv = -1;
+
+    if (aggregate.column.isValid())
+      iv = valueColumnInd[aggregate.column.column()];
+
+    groupBy.addAggregate(CQGroupBy::Aggregate(aggregate.type, iv, aggregate.quantile));
+  }
+
+  groupBy.calc();
+
+  //---
+
+  // create model with row per group of key columns and aggregate values
+  int na  = int(aggregates.size());
+  int ng  = groupBy.numGroups();
+  int nc1 = nk + na;
+
+  using Cells    = std::vector<QVariant>;
+  using RowsData = std::vector<Cells>;
+
+  RowsData rowsData(ng);
+
+  for (int g = 0; g < ng; ++g) {
+    auto &cells = rowsData[g];
+
+    cells.resize(nc1);
+
+    int r = groupBy.groupFirstRow(g);
+
+    for (int k = 0; k < nk; ++k)
+      cells[k] = editData(model, r, keyColumns[k]);
+
+    for (int ia = 0; ia < na; ++ia) {
+      double value = groupBy.value(g, ia);
+
+      if      (aggregates[ia].type == CQGroupBy::AggType::COUNT)
+        cells[nk + ia] = QVariant(int(value));
+      else if (! CMathUtil::isNaN(value))
+        cells[nk + ia] = QVariant(value);
+    }
+  }
+
+  auto *dataModel = new CQDataModel(nc1, 0);
+
+  dataModel->setRowsData(nc1, std::move(rowsData));
+
+  //---
+
+  // set header data
+  for (int k = 0; k < nk; ++k)
+    copyColumnHeaderRoles(dataModel, keyColumns[k], k);
+
+  for (int ia = 0; ia < na; ++ia) {
+    const auto &aggregate = aggregates[ia];
+
+    QString columnName;
+
+    if (aggregate.column.isValid()) {
+      bool ok;
+
+      columnName = CQChartsModelUtil::modelHHeaderString(model, aggregate.column, ok);
+    }
+
+    QString name;
+
+    switch (aggregate.type) {
+      case CQGroupBy::AggType::COUNT   : name = "count"; break;
+      case CQGroupBy::AggType::SUM     : name = "sum"  ; break;
+      case CQGroupBy::AggType::MEAN    : name = "mean" ; break;
+      case CQGroupBy::AggType::MIN     : name = "min"  ; break;
+      case CQGroupBy::AggType::MAX     : name = "max"  ; break;
+      case CQGroupBy::AggType::QUANTILE:
+        name = QString("quantile%1").arg(aggregate.quantile); break;
+    }
+
+    dataModel->setHeaderData(nk + ia, Qt::Horizontal,
+                             QString("%1(%2)").arg(name).arg(columnName), Qt::DisplayRole);
+  }
+
+  //---
+
+  // create model
+  auto *filterModel = new CQChartsFilterModel(charts_, dataModel);
+
+  filterModel->setObjectName("groupByModel");
+
+  //---
+
+  return filterModel;
+}
+
 //------
 
 void
@@ -11,6 +11,7 @@
 #include <CMathCorrelation.h>
 
 #include <QAbstractItemModel>
+#include <thread>
 
 CQChartsModelDetails::
 CQChartsModelDetails(CQChartsModelData *data) :
@@ -149,6 +150,25 @@ resetValues()
   columnDetails_.clear();
 }
 
+//! visitor to calculate details of multiple columns in one pass of the model rows
+class CQChartsModelDetails::ColumnsVisitor : public CQChartsModelVisitor {
+ public:
+  ColumnsVisitor() { }
+
+  void addVisitor(CQChartsModelVisitor *visitor) { visitors_.push_back(visitor); }
+
+  State visit(const QAbstractItemModel *model, const VisitData &data) override {
+    // skipped value only skips row for that column
+    for (auto *visitor : visitors_)
+      (void) visitor->visit(model, data);
+
+    return State::OK;
+  }
+
+ private:
+  std::vector<CQChartsModelVisitor *> visitors_;
+};
+
 void
 CQChartsModelDetails::
 updateSimple()
@@ -175,20 +195,142 @@ updateFull()
 
   assert(initialized_ != Initialized::FULL);
 
-  if (initialized_ == Initialized::NONE)
-    updateSimple();
-
   resetValues();
 
+  updateSimple();
+
+  //---
+
+  // create details for all columns (mutex is already locked)
+  std::vector<ColumnDetails *> columnDetails;
+
   for (int c = 0; c < numColumns_; ++c) {
-    auto *columnDetails = this->columnDetails(CQChartsColumn(c));
+    CQChartsColumn column(c);
+
+    auto *details = new CQChartsModelColumnDetails(this, column);
+
+    columnDetails_[column] = details;
+
+    columnDetails.push_back(details);
+  }
+
+  //---
+
+  // calculate column types in parallel
+  auto calcTypes = [&](int c1, int c2) {
+    for (int c = c1; c < c2; ++c)
+      columnDetails[c]->initType();
+  };
+
+  int numThreads = std::max(int(std::thread::hardware_concurrency()), 1);
+
+  const int minThreadColumns = 2;
+
+  if (numThreads > 1 && numColumns_ >= minThreadColumns) {
+    std::vector<std::future<void>> futures;
+
+    int n = (numColumns_ + numThreads - 1)/numThreads;
+
+    for (int c1 = 0; c1 < numColumns_; c1 += n)
+      futures.push_back(std::async(std::launch::async, calcTypes, c1,
+                                   std::min(c1 + n, numColumns_)));
+
+    for (auto &future : futures)
+      future.wait();
+  }
+  else
+    calcTypes(0, numColumns_);
+
+  //---
+
+  // calculate column details in a single visit of the model rows (columns with mapped
+  // values need the model filter mapping disabled so are calculated in a second visit)
+  auto *model  = this->model();
+  auto *charts = this->charts();
+
+  auto calcColumns = [&](bool mapped) {
+    std::vector<ColumnDetails *> visitDetails;
+
+    ColumnsVisitor visitor;
+
+    for (auto *details : columnDetails) {
+      if (details->isMappedType() != mapped)
+        continue;
+
+      auto *columnVisitor = details->initVisitData();
+      if (! columnVisitor) continue;
+
+      visitDetails.push_back(details);
+
+      visitor.addVisitor(columnVisitor);
+    }
 
-    numRows_ = std::max(numRows_, columnDetails->numRows());
+    if (visitDetails.empty())
+      return;
+
+    auto *modelFilter = (mapped ? qobject_cast<CQChartsModelFilter *>(model) : nullptr);
+
+    if (modelFilter)
+      modelFilter->setMapping(false);
+
+    CQChartsModelVisit::exec(charts, model, visitor);
+
+    if (modelFilter)
+      modelFilter->setMapping(true);
+
+    for (auto *details : visitDetails)
+      details->termVisitData(visitor.numRows());
+  };
+
+  if (model && charts) {
+    calcColumns(/*mapped*/false);
+    calcColumns(/*mapped*/true );
   }
 
+  for (auto *details : columnDetails)
+    numRows_ = std::max(numRows_, details->numRows());
+
   initialized_ = Initialized::FULL;
 }
 
+bool
+CQChartsModelDetails::
+appendRows(int first, int /*last*/)
+{
+  CQPerfTrace trace("CQChartsModelDetails::appendRows");
+
+  bool rc = true;
+
+  {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  if (initialized_ != Initialized::NONE) {
+    auto *model = this->model();
+
+    // only flat model column details can be continued for appended rows
+    if (! hierarchical_ && model) {
+      numRows_ = model->rowCount();
+
+      for (auto &cd : columnDetails_) {
+        if (! cd.second->addRows(first)) {
+          rc = false;
+          break;
+        }
+      }
+    }
+    else
+      rc = false;
+
+    if (! rc)
+      resetValues();
+  }
+  }
+
+  emit detailsReset();
+
+  return rc;
+}
+
 void
 CQChartsModelDetails::
 modelTypeChangedSlot(int modelInd)
@@ -350,6 +492,346 @@ model() const
 
 //------
 
+//! visitor to calculate column details (kept to continue with appended rows)
+class CQChartsModelColumnDetails::DetailVisitor : public CQChartsModelVisitor {
+ public:
+  DetailVisitor(CQChartsModelColumnDetails *details) :
+   details_(details) {
+    charts_ = details_->details()->charts();
+
+    auto *columnTypeMgr = charts_->columnTypeMgr();
+
+    const auto *columnType = columnTypeMgr->getType(details_->type());
+
+    if (columnType) {
+      min_ = columnType->minValue(details->nameValues()); // type custom min value
+      max_ = columnType->maxValue(details->nameValues()); // type custom max value
+
+      visitMin_ = ! min_.isValid();
+      visitMax_ = ! max_.isValid();
+    }
+
+    monotonicSet_ = false;
+    monotonic_    = true;
+    increasing_   = true;
+  }
+
+  // visit row
+  State visit(const QAbstractItemModel *model, const VisitData &data) override {
+    bool ok;
+
+    QVariant var = CQChartsModelUtil::modelValue(
+      charts_, model, data.row, details_->column(), data.parent, ok);
+    if (! ok) return State::SKIP;
+
+    details_->addValue(var);
+
+    if      (details_->type() == CQBaseModelType::INTEGER) {
+      long i = CQChartsVariant::toInt(var, ok);
+
+      if (ok && ! details_->checkRow(int(i)))
+        return State::SKIP;
+
+      details_->addInt(i, ok);
+
+      if (ok)
+        addInt(i);
+    }
+    else if (details_->type() == CQBaseModelType::REAL) {
+      double r = CQChartsVariant::toReal(var, ok);
+
+      if (ok && ! details_->checkRow(r))
+        return State::SKIP;
+
+      details_->addReal(r, ok);
+
+      if (ok)
+        addReal(r);
+    }
+    else if (details_->type() == CQBaseModelType::STRING) {
+      QString s;
+
+      ok = CQChartsVariant::toString(var, s);
+
+      if (ok && ! details_->checkRow(s))
+        return State::SKIP;
+
+      details_->addString(s);
+
+      addString(s);
+    }
+    else if (details_->type() == CQBaseModelType::TIME) {
+      double t = CQChartsVariant::toReal(var, ok);
+
+      if (ok && ! details_->checkRow(t))
+        return State::SKIP;
+
+      details_->addTime(t, ok);
+
+      if (ok)
+        addReal(t);
+    }
+    else if (details_->type() == CQBaseModelType::COLOR) {
+      CQChartsColor color;
+
+      ok = details_->columnColor(var, color);
+
+      if (ok && ! details_->checkRow(CQChartsVariant::fromColor(color)))
+        return State::SKIP;
+
+      details_->addColor(color, ok);
+
+      if (ok)
+        addColor(color);
+    }
+    else if (details_->type() == CQBaseModelType::SYMBOL_SIZE) {
+      double r = CQChartsVariant::toReal(var, ok);
+
+      if (ok && ! details_->checkRow(r))
+        return State::SKIP;
+
+      details_->addReal(r, ok);
+
+      if (ok)
+        addReal(r);
+    }
+    else if (details_->type() == CQBaseModelType::FONT_SIZE) {
+      double r = CQChartsVariant::toReal(var, ok);
+
+      if (ok && ! details_->checkRow(r))
+        return State::SKIP;
+
+      details_->addReal(r, ok);
+
+      if (ok)
+        addReal(r);
+    }
+    else {
+      QString s;
+
+      ok = CQChartsVariant::toString(var, s);
+
+      if (ok && ! details_->checkRow(s))
+        return State::SKIP;
+
+      details_->addString(s);
+
+      addString(s);
+    }
+
+    return State::OK;
+  }
+
+  void addInt(long i) {
+    // if no type defined min, update min value
+    if (visitMin_) {
+      bool ok1;
+
+      long imin = CQChartsVariant::toInt(min_, ok1);
+
+      imin = (! ok1 ? i : std::min(imin, i));
+
+      min_ = QVariant(int(imin));
+    }
+
+    // if no type defined max, update max value
+    if (visitMax_) {
+      bool ok1;
+
+      long imax = CQChartsVariant::toInt(max_, ok1);
+
+      imax = (! ok1 ? i : std::max(imax, i));
+
+      max_ = QVariant(int(imax));
+    }
+
+    if (lastValue1_.isValid() && lastValue2_.isValid()) {
+      bool ok1, ok2;
+
+      long i1 = CQChartsVariant::toInt(lastValue1_, ok1);
+      long i2 = CQChartsVariant::toInt(lastValue2_, ok2);
+
+      if (! monotonicSet_) {
+        if (i1 != i2) {
+          increasing_   = (i2 > i1);
+          monotonicSet_ = true;
+        }
+      }
+      else {
+        if (monotonic_) {
+          if (increasing_) {
+            if (i2 < i1)
+              monotonic_ = false;
+          }
+          else {
+            if (i2 > i1)
+              monotonic_ = false;
+          }
+        }
+      }
+    }
+
+    lastValue1_ = lastValue2_;
+    lastValue2_ = int(i);
+  }
+
+  void addReal(double r) {
+    // if no type defined min, update min value
+    if (visitMin_) {
+      bool ok1;
+
+      double rmin = CQChartsVariant::toReal(min_, ok1);
+
+      rmin = (! ok1 ? r : std::min(rmin, r));
+
+      min_ = QVariant(rmin);
+    }
+
+    // if no type defined max, update max value
+    if (visitMax_) {
+      bool ok1;
+
+      double rmax = CQChartsVariant::toReal(max_, ok1);
+
+      rmax = (! ok1 ? r : std::max(rmax, r));
+
+      max_ = QVariant(rmax);
+    }
+
+    if (lastValue1_.isValid() && lastValue2_.isValid()) {
+      bool ok1, ok2;
+
+      double r1 = CQChartsVariant::toReal(lastValue1_, ok1);
+      double r2 = CQChartsVariant::toReal(lastValue2_, ok2);
+
+      if (! monotonicSet_) {
+        if (r1 != r2) {
+          increasing_   = (r2 > r1);
+          monotonicSet_ = true;
+        }
+      }
+      else {
+        if (monotonic_) {
+          if (increasing_) {
+            if (r2 < r1)
+              monotonic_ = false;
+          }
+          else {
+            if (r2 > r1)
+              monotonic_ = false;
+          }
+        }
+      }
+    }
+
+    lastValue1_ = lastValue2_;
+    lastValue2_ = r;
+  }
+
+  void addString(const QString &s) {
+    // if no type defined min, update min value
+    if (visitMin_) {
+      bool ok1;
+
+      QString smin = CQChartsVariant::toString(min_, ok1);
+
+      smin = (! ok1 ? s : std::min(smin, s));
+
+      min_ = QVariant(smin);
+    }
+
+    // if no type defined max, update max value
+    if (visitMax_) {
+      bool ok1;
+
+      QString smax = CQChartsVariant::toString(max_, ok1);
+
+      smax = (! ok1 ? s : std::max(smax, s));
+
+      max_ = QVariant(smax);
+    }
+
+    if (lastValue1_.isValid() && lastValue2_.isValid()) {
+      bool ok1, ok2;
+
+      QString s1 = CQChartsVariant::toString(lastValue1_, ok1);
+      QString s2 = CQChartsVariant::toString(lastValue2_, ok2);
+
+      if (! monotonicSet_) {
+        if (s1 != s2) {
+          increasing_   = (s2 > s1);
+          monotonicSet_ = true;
+        }
+      }
+      else {
+        if (monotonic_) {
+          if (increasing_) {
+            if (s2 < s1)
+              monotonic_ = false;
+          }
+          else {
+            if (s2 > s1)
+              monotonic_ = false;
+          }
+        }
+      }
+    }
+
+    lastValue1_ = lastValue2_;
+    lastValue2_ = s;
+  }
+
+  void addColor(const CQChartsColor &c) {
+    // if no type defined min, update min value
+    if (visitMin_) {
+      CQChartsColor cmin;
+
+      if (details_->columnColor(min_, cmin))
+        cmin = std::min(cmin, c);
+      else
+        cmin = c;
+
+      min_ = CQChartsVariant::fromColor(cmin);
+    }
+
+    // if no type defined max, update max value
+    if (visitMax_) {
+      CQChartsColor cmax;
+
+      if (details_->columnColor(max_, cmax))
+        cmax = std::max(cmax, c);
+      else
+        cmax = c;
+
+      max_ = CQChartsVariant::fromColor(cmax);
+    }
+
+    lastValue1_ = lastValue2_;
+    lastValue2_ = CQChartsVariant::fromColor(c);
+  }
+
+  QVariant minValue() const { return min_; }
+  QVariant maxValue() const { return max_; }
+
+  bool isMonotonic () const { return monotonicSet_ && monotonic_; }
+  bool isIncreasing() const { return increasing_; }
+
+ private:
+  CQChartsModelColumnDetails* details_      { nullptr };
+  CQCharts*                   charts_       { nullptr };
+  QVariant                    min_;
+  QVariant                    max_;
+  bool                        visitMin_     { true };
+  bool                        visitMax_     { true };
+  QVariant                    lastValue1_;
+  QVariant                    lastValue2_;
+  bool                        monotonicSet_ { false };
+  bool                        monotonic_    { true };
+  bool                        increasing_   { true };
+};
+
+//---
+
 CQChartsModelColumnDetails::
 CQChartsModelColumnDetails(CQChartsModelDetails *details, const CQChartsColumn &column) :
  details_(details), column_(column)
@@ -357,6 +839,17 @@ CQChartsModelColumnDetails(CQChartsModelDetails *details, const CQChartsColumn &
   assert(details_);
 
   valueSet_ = new CQChartsValueSet;
+
+  // share sorted column values (median/outlier stats) with plots for same column values
+  valueSet_->setSortedValuesFn([this](const std::vector<double> &values) {
+    auto *data  = details_->data();
+    auto *model = details_->model();
+
+    if (! data || ! model)
+      return std::make_shared<CQChartsSortedValues>(values);
+
+    return data->sortedValues(model, column_, QString(), values);
+  });
 }
 
 CQChartsModelColumnDetails::
@@ -549,16 +1042,16 @@ meanValue(bool useNaN) const
   initCache();
 
   if      (type() == CQBaseModelType::INTEGER) {
-    return valueSet_->ivals().mean();
+    return moments_.mean;
   }
   else if (type() == CQBaseModelType::REAL) {
-    return valueSet_->rvals().mean();
+    return moments_.mean;
   }
   else if (type() == CQBaseModelType::STRING) {
     return (useNaN ? QVariant(CMathUtil::getNaN()) : QVariant());
   }
   else if (type() == CQBaseModelType::TIME) {
-    return valueSet_->tvals().mean();
+    return moments_.mean;
   }
   else if (type() == CQBaseModelType::COLOR) {
     return (useNaN ? QVariant(CMathUtil::getNaN()) : QVariant());
@@ -574,16 +1067,16 @@ stdDevValue(bool useNaN) const
   initCache();
 
   if      (type() == CQBaseModelType::INTEGER) {
-    return valueSet_->ivals().stddev();
+    return moments_.stddev();
   }
   else if (type() == CQBaseModelType::REAL) {
-    return valueSet_->rvals().stddev();
+    return moments_.stddev();
   }
   else if (type() == CQBaseModelType::STRING) {
     return (useNaN ? QVariant(CMathUtil::getNaN()) : QVariant());
   }
   else if (type() == CQBaseModelType::TIME) {
-    return valueSet_->tvals().stddev();
+    return moments_.stddev();
   }
   else if (type() == CQBaseModelType::COLOR) {
     return (useNaN ? QVariant(CMathUtil::getNaN()) : QVariant());
@@ -1190,413 +1683,163 @@ initData()
 
   //---
 
-  if (! typeInitialized_) {
-    if (! calcType())
-      return false;
-  }
-
-  //---
-
-  auto *model = details_->model();
-  if (! model) return false;
+  auto *visitor = initVisitData();
 
-  //---
-
-  if (column_.type() == CQChartsColumn::Type::ROW) {
-    initialized_ = true;
+  if (! visitor)
+    return initialized_;
 
-    return true;
-  }
+  auto *model  = details_->model();
+  auto *charts = details()->charts();
 
   //---
 
-  CQChartsModelFilter *modelFilter = nullptr;
+  // values of mapped types are calculated from unmapped model data
+  auto *modelFilter = (isMappedType() ? qobject_cast<CQChartsModelFilter *>(model) : nullptr);
 
-  if      (type() == CQBaseModelType::COLOR ||
-           type() == CQBaseModelType::SYMBOL) {
-    modelFilter = qobject_cast<CQChartsModelFilter *>(model);
+  if (modelFilter)
+    modelFilter->setMapping(false);
 
-    if (modelFilter)
-      modelFilter->setMapping(false);
-  }
-  else if (type() == CQBaseModelType::SYMBOL_SIZE ||
-           type() == CQBaseModelType::FONT_SIZE) {
-    if (baseType() == CQBaseModelType::REAL ||
-        baseType() == CQBaseModelType::INTEGER) {
-      modelFilter = qobject_cast<CQChartsModelFilter *>(model);
+  CQChartsModelVisit::exec(charts, model, *visitor);
 
-      if (modelFilter)
-        modelFilter->setMapping(false);
-    }
-  }
+  if (modelFilter)
+    modelFilter->setMapping(true);
 
   //---
 
-  // TODO: replace monotonic with sorted and sort dir
-  // auto update sorted when model sorted
-
-  class DetailVisitor : public CQChartsModelVisitor {
-   public:
-    DetailVisitor(CQChartsModelColumnDetails *details) :
-     details_(details) {
-      charts_ = details_->details()->charts();
-
-      auto *columnTypeMgr = charts_->columnTypeMgr();
-
-      const auto *columnType = columnTypeMgr->getType(details_->type());
-
-      if (columnType) {
-        min_ = columnType->minValue(details->nameValues()); // type custom min value
-        max_ = columnType->maxValue(details->nameValues()); // type custom max value
-
-        visitMin_ = ! min_.isValid();
-        visitMax_ = ! max_.isValid();
-      }
-
-      monotonicSet_ = false;
-      monotonic_    = true;
-      increasing_   = true;
-    }
-
-    // visit row
-    State visit(const QAbstractItemModel *model, const VisitData &data) override {
-      bool ok;
-
-      QVariant var = CQChartsModelUtil::modelValue(
-        charts_, model, data.row, details_->column(), data.parent, ok);
-      if (! ok) return State::SKIP;
-
-      details_->addValue(var);
-
-      if      (details_->type() == CQBaseModelType::INTEGER) {
-        long i = CQChartsVariant::toInt(var, ok);
-
-        if (ok && ! details_->checkRow(int(i)))
-          return State::SKIP;
-
-        details_->addInt(i, ok);
-
-        if (ok)
-          addInt(i);
-      }
-      else if (details_->type() == CQBaseModelType::REAL) {
-        double r = CQChartsVariant::toReal(var, ok);
-
-        if (ok && ! details_->checkRow(r))
-          return State::SKIP;
-
-        details_->addReal(r, ok);
-
-        if (ok)
-          addReal(r);
-      }
-      else if (details_->type() == CQBaseModelType::STRING) {
-        QString s;
-
-        ok = CQChartsVariant::toString(var, s);
-
-        if (ok && ! details_->checkRow(s))
-          return State::SKIP;
-
-        details_->addString(s);
-
-        addString(s);
-      }
-      else if (details_->type() == CQBaseModelType::TIME) {
-        double t = CQChartsVariant::toReal(var, ok);
-
-        if (ok && ! details_->checkRow(t))
-          return State::SKIP;
-
-        details_->addTime(t, ok);
-
-        if (ok)
-          addReal(t);
-      }
-      else if (details_->type() == CQBaseModelType::COLOR) {
-        CQChartsColor color;
-
-        ok = details_->columnColor(var, color);
-
-        if (ok && ! details_->checkRow(CQChartsVariant::fromColor(color)))
-          return State::SKIP;
-
-        details_->addColor(color, ok);
-
-        if (ok)
-          addColor(color);
-      }
-      else if (details_->type() == CQBaseModelType::SYMBOL_SIZE) {
-        double r = CQChartsVariant::toReal(var, ok);
-
-        if (ok && ! details_->checkRow(r))
-          return State::SKIP;
-
-        details_->addReal(r, ok);
-
-        if (ok)
-          addReal(r);
-      }
-      else if (details_->type() == CQBaseModelType::FONT_SIZE) {
-        double r = CQChartsVariant::toReal(var, ok);
-
-        if (ok && ! details_->checkRow(r))
-          return State::SKIP;
-
-        details_->addReal(r, ok);
-
-        if (ok)
-          addReal(r);
-      }
-      else {
-        QString s;
-
-        ok = CQChartsVariant::toString(var, s);
-
-        if (ok && ! details_->checkRow(s))
-          return State::SKIP;
-
-        details_->addString(s);
-
-        addString(s);
-      }
-
-      return State::OK;
-    }
-
-    void addInt(long i) {
-      // if no type defined min, update min value
-      if (visitMin_) {
-        bool ok1;
-
-        long imin = CQChartsVariant::toInt(min_, ok1);
-
-        imin = (! ok1 ? i : std::min(imin, i));
-
-        min_ = QVariant(int(imin));
-      }
-
-      // if no type defined max, update max value
-      if (visitMax_) {
-        bool ok1;
-
-        long imax = CQChartsVariant::toInt(max_, ok1);
-
-        imax = (! ok1 ? i : std::max(imax, i));
-
-        max_ = QVariant(int(imax));
-      }
-
-      if (lastValue1_.isValid() && lastValue2_.isValid()) {
-        bool ok1, ok2;
-
-        long i1 = CQChartsVariant::toInt(lastValue1_, ok1);
-        long i2 = CQChartsVariant::toInt(lastValue2_, ok2);
+  termVisitData(visitor->numRows());
 
-        if (! monotonicSet_) {
-          if (i1 != i2) {
-            increasing_   = (i2 > i1);
-            monotonicSet_ = true;
-          }
-        }
-        else {
-          if (monotonic_) {
-            if (increasing_) {
-              if (i2 < i1)
-                monotonic_ = false;
-            }
-            else {
-              if (i2 > i1)
-                monotonic_ = false;
-            }
-          }
-        }
-      }
-
-      lastValue1_ = lastValue2_;
-      lastValue2_ = int(i);
-    }
-
-    void addReal(double r) {
-      // if no type defined min, update min value
-      if (visitMin_) {
-        bool ok1;
-
-        double rmin = CQChartsVariant::toReal(min_, ok1);
-
-        rmin = (! ok1 ? r : std::min(rmin, r));
+  return true;
+}
 
-        min_ = QVariant(rmin);
-      }
+CQChartsModelVisitor *
+CQChartsModelColumnDetails::
+initVisitData()
+{
+  assert(! initialized_);
 
-      // if no type defined max, update max value
-      if (visitMax_) {
-        bool ok1;
+  //---
 
-        double rmax = CQChartsVariant::toReal(max_, ok1);
+  if (! typeInitialized_) {
+    if (! calcType())
+      return nullptr;
+  }
 
-        rmax = (! ok1 ? r : std::max(rmax, r));
+  //---
 
-        max_ = QVariant(rmax);
-      }
+  auto *model = details_->model();
+  if (! model) return nullptr;
 
-      if (lastValue1_.isValid() && lastValue2_.isValid()) {
-        bool ok1, ok2;
+  auto *charts = details()->charts();
+  if (! charts) return nullptr;
 
-        double r1 = CQChartsVariant::toReal(lastValue1_, ok1);
-        double r2 = CQChartsVariant::toReal(lastValue2_, ok2);
+  //---
 
-        if (! monotonicSet_) {
-          if (r1 != r2) {
-            increasing_   = (r2 > r1);
-            monotonicSet_ = true;
-          }
-        }
-        else {
-          if (monotonic_) {
-            if (increasing_) {
-              if (r2 < r1)
-                monotonic_ = false;
-            }
-            else {
-              if (r2 > r1)
-                monotonic_ = false;
-            }
-          }
-        }
-      }
+  if (column_.type() == CQChartsColumn::Type::ROW) {
+    initialized_ = true;
 
-      lastValue1_ = lastValue2_;
-      lastValue2_ = r;
-    }
+    return nullptr;
+  }
 
-    void addString(const QString &s) {
-      // if no type defined min, update min value
-      if (visitMin_) {
-        bool ok1;
+  //---
 
-        QString smin = CQChartsVariant::toString(min_, ok1);
+  // TODO: replace monotonic with sorted and sort dir
+  // auto update sorted when model sorted
 
-        smin = (! ok1 ? s : std::min(smin, s));
+  //---
 
-        min_ = QVariant(smin);
-      }
+  valueSet_->clearVals();
 
-      // if no type defined max, update max value
-      if (visitMax_) {
-        bool ok1;
+  valueInds_.clear();
 
-        QString smax = CQChartsVariant::toString(max_, ok1);
+  moments_ = Moments();
 
-        smax = (! ok1 ? s : std::max(smax, s));
+  visitor_ = std::make_unique<DetailVisitor>(this);
 
-        max_ = QVariant(smax);
-      }
+  return visitor_.get();
+}
 
-      if (lastValue1_.isValid() && lastValue2_.isValid()) {
-        bool ok1, ok2;
+void
+CQChartsModelColumnDetails::
+termVisitData(int numRows)
+{
+  visitor_->setNumRows(numRows);
 
-        QString s1 = CQChartsVariant::toString(lastValue1_, ok1);
-        QString s2 = CQChartsVariant::toString(lastValue2_, ok2);
+  updateVisitorData();
 
-        if (! monotonicSet_) {
-          if (s1 != s2) {
-            increasing_   = (s2 > s1);
-            monotonicSet_ = true;
-          }
-        }
-        else {
-          if (monotonic_) {
-            if (increasing_) {
-              if (s2 < s1)
-                monotonic_ = false;
-            }
-            else {
-              if (s2 > s1)
-                monotonic_ = false;
-            }
-          }
-        }
-      }
+  initialized_ = true;
+}
 
-      lastValue1_ = lastValue2_;
-      lastValue2_ = s;
-    }
+bool
+CQChartsModelColumnDetails::
+addRows(int firstRow)
+{
+  CQPerfTrace trace("CQChartsModelColumnDetails::addRows");
 
-    void addColor(const CQChartsColor &c) {
-      // if no type defined min, update min value
-      if (visitMin_) {
-        CQChartsColor cmin;
+  std::unique_lock<std::mutex> lock(mutex_);
 
-        if (details_->columnColor(min_, cmin))
-          cmin = std::min(cmin, c);
-        else
-          cmin = c;
+  // nothing to update if not calculated yet (will be calculated on demand)
+  if (! initialized_)
+    return true;
 
-        min_ = CQChartsVariant::fromColor(cmin);
-      }
+  if (column_.type() == CQChartsColumn::Type::ROW)
+    return true;
 
-      // if no type defined max, update max value
-      if (visitMax_) {
-        CQChartsColor cmax;
+  // values are added to existing visitor state (caller ensures model is flat)
+  auto *model = details_->model();
 
-        if (details_->columnColor(max_, cmax))
-          cmax = std::max(cmax, c);
-        else
-          cmax = c;
+  if (! model || ! visitor_) {
+    initialized_ = false;
 
-        max_ = CQChartsVariant::fromColor(cmax);
-      }
-
-      lastValue1_ = lastValue2_;
-      lastValue2_ = CQChartsVariant::fromColor(c);
-    }
+    return false;
+  }
 
-    QVariant minValue() const { return min_; }
-    QVariant maxValue() const { return max_; }
-
-    bool isMonotonic () const { return monotonicSet_ && monotonic_; }
-    bool isIncreasing() const { return increasing_; }
-
-   private:
-    CQChartsModelColumnDetails* details_      { nullptr };
-    CQCharts*                   charts_       { nullptr };
-    QVariant                    min_;
-    QVariant                    max_;
-    bool                        visitMin_     { true };
-    bool                        visitMax_     { true };
-    QVariant                    lastValue1_;
-    QVariant                    lastValue2_;
-    bool                        monotonicSet_ { false };
-    bool                        monotonic_    { true };
-    bool                        increasing_   { true };
-  };
+  auto *charts = details()->charts();
+  if (! charts) return false;
 
   //---
 
-  DetailVisitor detailVisitor(this);
+  auto *modelFilter = (isMappedType() ? qobject_cast<CQChartsModelFilter *>(model) : nullptr);
 
-  auto *charts = details()->charts();
-  if (! charts) return false;
+  if (modelFilter)
+    modelFilter->setMapping(false);
 
-  CQChartsModelVisit::exec(charts, model, detailVisitor);
+  // continue visit from first appended row
+  visitor_->setFirstRow(firstRow);
 
-  //---
+  CQChartsModelVisit::exec(charts, model, *visitor_);
+
+  visitor_->setFirstRow(0);
 
-  minValue_   = detailVisitor.minValue();
-  maxValue_   = detailVisitor.maxValue();
-  numRows_    = detailVisitor.numRows();
-  monotonic_  = detailVisitor.isMonotonic();
-  increasing_ = detailVisitor.isIncreasing();
+  updateVisitorData();
 
   if (modelFilter)
     modelFilter->setMapping(true);
 
-  //---
+  return true;
+}
 
-  initialized_ = true;
+void
+CQChartsModelColumnDetails::
+updateVisitorData()
+{
+  minValue_   = visitor_->minValue();
+  maxValue_   = visitor_->maxValue();
+  numRows_    = visitor_->numRows();
+  monotonic_  = visitor_->isMonotonic();
+  increasing_ = visitor_->isIncreasing();
+}
 
-  return true;
+bool
+CQChartsModelColumnDetails::
+isMappedType() const
+{
+  if (type() == CQBaseModelType::COLOR || type() == CQBaseModelType::SYMBOL)
+    return true;
+
+  if (type() == CQBaseModelType::SYMBOL_SIZE || type() == CQBaseModelType::FONT_SIZE)
+    return (baseType() == CQBaseModelType::REAL || baseType() == CQBaseModelType::INTEGER);
+
+  return false;
 }
 
 void
@@ -1699,8 +1942,11 @@ void
 CQChartsModelColumnDetails::
 addInt(long i, bool ok)
 {
-  if (ok)
+  if (ok) {
     valueSet_->ivals().addValue(i);
+
+    moments_.add(double(i));
+  }
   else
     valueSet_->ivals().addValue(CQChartsIValues::OptInt());
 }
@@ -1709,8 +1955,11 @@ void
 CQChartsModelColumnDetails::
 addReal(double r, bool ok)
 {
-  if (ok && ! CMathUtil::isNaN(r))
+  if (ok && ! CMathUtil::isNaN(r)) {
     valueSet_->rvals().addValue(r);
+
+    moments_.add(r);
+  }
   else
     valueSet_->rvals().addValue(CQChartsRValues::OptReal());
 }
@@ -1726,8 +1975,11 @@ void
 CQChartsModelColumnDetails::
 addTime(double t, bool ok)
 {
-  if (ok)
+  if (ok) {
     valueSet_->tvals().addValue(t);
+
+    moments_.add(t);
+  }
 }
 
 void
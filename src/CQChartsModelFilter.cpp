@@ -6,8 +6,28 @@
 #include <CQCharts.h>
 
 #include <CQDataModel.h>
+#include <CQPerfMonitor.h>
 #include <QItemSelectionModel>
 #include <cassert>
+#include <thread>
+
+namespace {
+
+// row match bitmap access
+bool getRowBit(const std::vector<uint64_t> &bits, int row) {
+  return (bits[row >> 6] >> (row & 63)) & 1;
+}
+
+void setRowBit(std::vector<uint64_t> &bits, int row, bool b) {
+  uint64_t mask = uint64_t(1) << (row & 63);
+
+  if (b)
+    bits[row >> 6] |=  mask;
+  else
+    bits[row >> 6] &= ~mask;
+}
+
+}
 
 CQChartsModelFilter::
 CQChartsModelFilter(CQCharts *charts) :
@@ -28,6 +48,53 @@ CQChartsModelFilter::
   delete expr_;
 }
 
+void
+CQChartsModelFilter::
+setSourceModel(QAbstractItemModel *model)
+{
+  auto *oldModel = sourceModel();
+
+  if (oldModel)
+    connectDisconnectSourceSlots(oldModel, false);
+
+  // connect before base class so row matches are updated before rows are filtered
+  if (model)
+    connectDisconnectSourceSlots(model, true);
+
+  invalidateRowMatches();
+
+  QSortFilterProxyModel::setSourceModel(model);
+}
+
+void
+CQChartsModelFilter::
+connectDisconnectSourceSlots(QAbstractItemModel *model, bool b)
+{
+  auto connectDisconnect = [&](bool b, const char *from, const char *to) {
+    if (b)
+      connect(model, from, this, to);
+    else
+      disconnect(model, from, this, to);
+  };
+
+  connectDisconnect(b,
+    SIGNAL(dataChanged(const QModelIndex &, const QModelIndex &, const QVector<int> &)),
+    SLOT(sourceDataChangedSlot(const QModelIndex &, const QModelIndex &, const QVector<int> &)));
+  connectDisconnect(b,
+    SIGNAL(rowsInserted(const QModelIndex &, int, int)),
+    SLOT(sourceRowsInsertedSlot(const QModelIndex &, int, int)));
+  connectDisconnect(b,
+    SIGNAL(rowsRemoved(const QModelIndex &, int, int)),
+    SLOT(sourceRowsRemovedSlot(const QModelIndex &, int, int)));
+  connectDisconnect(b,
+    SIGNAL(rowsMoved(const QModelIndex &, int, int, const QModelIndex &, int)),
+    SLOT(sourceResetSlot()));
+  connectDisconnect(b,
+    SIGNAL(modelReset()), SLOT(sourceResetSlot()));
+  connectDisconnect(b,
+    SIGNAL(layoutChanged()), SLOT(sourceResetSlot()));
+}
+
 void
 CQChartsModelFilter::
 resetFilterData()
@@ -178,6 +245,16 @@ filterAcceptsRow(int row, const QModelIndex &parent) const
   auto *model = sourceModel();
   assert(model);
 
+  // top level rows of non-hierarchical model use cached row matches
+  if (! parent.isValid()) {
+    initRowMatches();
+
+    if (! rowMatchesHier_)
+      return rowAccepted(row);
+  }
+
+  //---
+
   class RowVisitor : public CQChartsModelVisitor {
    public:
     RowVisitor(const CQChartsModelFilter *filter, int column) :
@@ -227,6 +304,256 @@ filterAcceptsRow(int row, const QModelIndex &parent) const
   return visitor.isAccepted();
 }
 
+bool
+CQChartsModelFilter::
+rowAccepted(int row) const
+{
+  if (row < 0 || row >= numRowMatches_)
+    return false;
+
+  return getRowBit(rowMatches_, row);
+}
+
+void
+CQChartsModelFilter::
+initRowMatches() const
+{
+  std::unique_lock<std::mutex> lock(rowMatchesMutex_);
+
+  if (rowMatchesValid_)
+    return;
+
+  CQPerfTrace trace("CQChartsModelFilter::initRowMatches");
+
+  auto *model = sourceModel();
+  assert(model);
+
+  rowMatchesValid_ = true;
+  rowMatchesHier_  = CQChartsModelUtil::isHierarchical(model);
+
+  rowMatches_.clear();
+
+  numRowMatches_ = 0;
+
+  if (rowMatchesHier_)
+    return;
+
+  //---
+
+  int nr = model->rowCount();
+
+  numRowMatches_ = nr;
+
+  rowMatches_.resize((nr + 63)/64, 0);
+
+  int column = std::max(filterKeyColumn(), 0);
+
+  //---
+
+  // expressions are evaluated by the (single threaded) expression interpreter
+  bool hasExpr = false;
+
+  for (const auto &filterData : filterDatas_) {
+    if (filterData.isExpr())
+      hasExpr = true;
+  }
+
+  // ignore source model changes caused by filter evaluation (cached values)
+  rowMatchesBusy_.store(true);
+
+  int numThreads = std::max(int(std::thread::hardware_concurrency()), 1);
+
+  const int minThreadRows = 10000;
+
+  if (! hasExpr && numThreads > 1 && nr >= minThreadRows) {
+    // split rows on bitmap word boundaries so threads never write the same word
+    int nw  = int(rowMatches_.size());
+    int nw1 = (nw + numThreads - 1)/numThreads;
+
+    std::vector<std::future<void>> futures;
+
+    for (int w1 = 0; w1 < nw; w1 += nw1) {
+      int r1 = w1*64;
+      int r2 = std::min((w1 + nw1)*64, nr);
+
+      futures.push_back(std::async(std::launch::async, [this, r1, r2, column]() {
+        calcRowMatches(r1, r2, column);
+      }));
+    }
+
+    for (auto &future : futures)
+      future.wait();
+  }
+  else
+    calcRowMatches(0, nr, column);
+
+  rowMatchesBusy_.store(false);
+}
+
+void
+CQChartsModelFilter::
+calcRowMatches(int r1, int r2, int column) const
+{
+  auto *model = sourceModel();
+  assert(model);
+
+  // copy filter data for thread (regexp match state is not thread safe)
+  auto filterDatas = filterDatas_;
+
+  for (int r = r1; r < r2; ++r) {
+    QModelIndex ind = model->index(r, column, QModelIndex());
+
+    setRowBit(rowMatches_, r, itemMatch(filterDatas, ind));
+  }
+}
+
+void
+CQChartsModelFilter::
+invalidateRowMatches()
+{
+  std::unique_lock<std::mutex> lock(rowMatchesMutex_);
+
+  rowMatchesValid_ = false;
+
+  rowMatches_.clear();
+
+  numRowMatches_ = 0;
+}
+
+void
+CQChartsModelFilter::
+sourceDataChangedSlot(const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                      const QVector<int> &roles)
+{
+  // ignore update of cached (mapped) values
+  bool cacheRoles = ! roles.empty();
+
+  for (const auto &role : roles) {
+    if (role != int(CQBaseModelRole::OutputValue) &&
+        role != int(CQBaseModelRole::IntermediateValue))
+      cacheRoles = false;
+  }
+
+  if (cacheRoles || rowMatchesBusy_.load())
+    return;
+
+  //---
+
+  matches_.clear();
+
+  // recalc changed top level rows
+  {
+    std::unique_lock<std::mutex> lock(rowMatchesMutex_);
+
+    if (rowMatchesValid_ && ! rowMatchesHier_ && ! topLeft.parent().isValid()) {
+      int r1 = std::max(topLeft.row(), 0);
+      int r2 = std::min(bottomRight.row() + 1, numRowMatches_);
+
+      rowMatchesBusy_.store(true);
+
+      calcRowMatches(r1, r2, std::max(filterKeyColumn(), 0));
+
+      rowMatchesBusy_.store(false);
+
+      return;
+    }
+  }
+
+  invalidateRowMatches();
+}
+
+void
+CQChartsModelFilter::
+sourceRowsInsertedSlot(const QModelIndex &parent, int first, int last)
+{
+  if (rowMatchesBusy_.load())
+    return;
+
+  matches_.clear();
+
+  {
+    std::unique_lock<std::mutex> lock(rowMatchesMutex_);
+
+    // insert row bits and calc inserted rows
+    if (rowMatchesValid_ && ! rowMatchesHier_ && ! parent.isValid() &&
+        first >= 0 && first <= numRowMatches_) {
+      int n  = last - first + 1;
+      int nr = numRowMatches_ + n;
+
+      RowBits rowMatches((nr + 63)/64, 0);
+
+      for (int r = 0; r < first; ++r)
+        setRowBit(rowMatches, r, getRowBit(rowMatches_, r));
+
+      for (int r = first; r < numRowMatches_; ++r)
+        setRowBit(rowMatches, r + n, getRowBit(rowMatches_, r));
+
+      rowMatches_.swap(rowMatches);
+
+      numRowMatches_ = nr;
+
+      rowMatchesBusy_.store(true);
+
+      calcRowMatches(first, last + 1, std::max(filterKeyColumn(), 0));
+
+      rowMatchesBusy_.store(false);
+
+      return;
+    }
+  }
+
+  invalidateRowMatches();
+}
+
+void
+CQChartsModelFilter::
+sourceRowsRemovedSlot(const QModelIndex &parent, int first, int last)
+{
+  if (rowMatchesBusy_.load())
+    return;
+
+  matches_.clear();
+
+  {
+    std::unique_lock<std::mutex> lock(rowMatchesMutex_);
+
+    // remove row bits
+    if (rowMatchesValid_ && ! rowMatchesHier_ && ! parent.isValid() &&
+        first >= 0 && last < numRowMatches_) {
+      int n  = last - first + 1;
+      int nr = numRowMatches_ - n;
+
+      RowBits rowMatches((nr + 63)/64, 0);
+
+      for (int r = 0; r < first; ++r)
+        setRowBit(rowMatches, r, getRowBit(rowMatches_, r));
+
+      for (int r = last + 1; r < numRowMatches_; ++r)
+        setRowBit(rowMatches, r - n, getRowBit(rowMatches_, r));
+
+      rowMatches_.swap(rowMatches);
+
+      numRowMatches_ = nr;
+
+      return;
+    }
+  }
+
+  invalidateRowMatches();
+}
+
+void
+CQChartsModelFilter::
+sourceResetSlot()
+{
+  if (rowMatchesBusy_.load())
+    return;
+
+  matches_.clear();
+
+  invalidateRowMatches();
+}
+
 bool
 CQChartsModelFilter::
 acceptsItem(const QModelIndex &ind) const
@@ -246,9 +573,16 @@ acceptsItem(const QModelIndex &ind) const
 bool
 CQChartsModelFilter::
 itemMatch(const QModelIndex &ind) const
+{
+  return itemMatch(filterDatas_, ind);
+}
+
+bool
+CQChartsModelFilter::
+itemMatch(const FilterDatas &filterDatas, const QModelIndex &ind) const
 {
   if (filterCombine_ == Combine::AND) {
-    for (const auto &filterData : filterDatas_) {
+    for (const auto &filterData : filterDatas) {
       if (! filterItemMatch(filterData, ind))
         return false;
     }
@@ -256,7 +590,7 @@ itemMatch(const QModelIndex &ind) const
     return true;
   }
   else {
-    for (const auto &filterData : filterDatas_) {
+    for (const auto &filterData : filterDatas) {
       if (filterItemMatch(filterData, ind))
         return true;
     }
@@ -279,9 +613,18 @@ filterItemMatch(const CQChartsModelFilterData &filterData, const QModelIndex &in
     auto *model = sourceModel();
     assert(model);
 
-    QModelIndex ind1 = model->index(ind.row(), 0, ind.parent());
+    bool rc;
+
+    if (! ind.parent().isValid()) {
+      const auto &rows = filterData.filterTopRows();
+
+      rc = (rows.find(ind.row()) != rows.end());
+    }
+    else {
+      QModelIndex ind1 = model->index(ind.row(), 0, ind.parent());
 
-    bool rc = filterData.filterRows().contains(ind1);
+      rc = filterData.filterRows().contains(ind1);
+    }
 
     return (filterData.isInvert() ? ! rc  : rc);
   }
@@ -362,16 +705,23 @@ initFilterData(CQChartsModelFilterData &filterData)
 
       QModelIndexList selectedRows1;
 
+      CQChartsModelFilterData::RowSet topRows;
+
       for (int i = 0; i < selectedRows.size(); ++i) {
         QModelIndex ind1 = mapToSource(selectedRows[i]);
 
         selectedRows1.push_back(ind1);
+
+        if (! ind1.parent().isValid())
+          topRows.insert(ind1.row());
       }
 
-      filterData.setFilterRows(selectedRows1);
+      filterData.setFilterRows   (selectedRows1);
+      filterData.setFilterTopRows(topRows);
     }
     else {
-      filterData.setFilterRows(QModelIndexList());
+      filterData.setFilterRows   (QModelIndexList());
+      filterData.setFilterTopRows(CQChartsModelFilterData::RowSet());
     }
   }
   else if (filterData.isRegExp() || filterData.isWildcard()) {
@@ -426,6 +776,8 @@ initFilter()
   matches_.clear();
   expand_ .clear();
 
+  invalidateRowMatches();
+
   //---
 
   if (selectionModel_)
@@ -332,8 +332,12 @@ connectDisconnectModel(bool isConnect)
       }
     }
 
+    connectDisconnect(isConnect, modelData, SIGNAL(modelAboutToChange()),
+                      SLOT(modelAboutToChangeSlot()));
     connectDisconnect(isConnect, modelData, SIGNAL(modelChanged()),
                       SLOT(modelChangedSlot()));
+    connectDisconnect(isConnect, modelData, SIGNAL(modelRowsAppended(int, int)),
+                      SLOT(modelRowsAppendedSlot(int, int)));
 
     connectDisconnect(isConnect, modelData, SIGNAL(currentModelChanged()),
                       SLOT(currentModelChangedSlot()));
@@ -404,13 +408,40 @@ animateSlot()
 
 //---
 
+void
+CQChartsPlot::
+modelAboutToChangeSlot()
+{
+  // stop update threads reading model before it is changed
+  interruptRange();
+}
+
 void
 CQChartsPlot::
 modelChangedSlot()
 {
+  // if change is only appended rows then try and add objects for new rows
+  if (appendRows_.first >= 0) {
+    int first = appendRows_.first;
+    int last  = appendRows_.last;
+
+    appendRows_ = AppendRowsData();
+
+    if (appendRowsAndObjs(first, last))
+      return;
+  }
+
   updateRangeAndObjs();
 }
 
+void
+CQChartsPlot::
+modelRowsAppendedSlot(int first, int last)
+{
+  appendRows_.first = first;
+  appendRows_.last  = last;
+}
+
 void
 CQChartsPlot::
 currentModelChangedSlot()
@@ -446,7 +477,9 @@ selectionSlot(QItemSelectionModel *sm)
     if (! plotObj->isSelectable())
       continue;
 
-    if (plotObj->isSelectIndices(selectIndices))
+    if      (plotObj->hasSubSelect())
+      plotObj->subSelectIndices(selectIndices);
+    else if (plotObj->isSelectIndices(selectIndices))
       plotObj->setSelected(true);
   }
 
@@ -4755,8 +4788,13 @@ addPlotObject(PlotObj *obj)
 
   assert(! objTreeData_.tree->isBusy());
 
+  obj->setPlotInd(int(plotObjs_.size()));
+
   plotObjs_.push_back(obj);
 
+  if (obj->isSelected()) plotObjSelectedChanged();
+  if (obj->isInside  ()) plotObjInsideChanged  ();
+
   // TODO: needed ? Do post thread finished
 #if 0
   obj->moveToThread(this->thread());
@@ -4847,6 +4885,82 @@ initPlotObjs()
     emit plotObjsAdded();
 }
 
+bool
+CQChartsPlot::
+appendRowsAndObjs(int first, int last)
+{
+  CQPerfTrace trace("CQChartsPlot::appendRowsAndObjs");
+
+  // only for single plot with up to date objects for previous rows
+  if (parentPlot() || isOverlay())
+    return false;
+
+  if (! isUpdatesEnabled() || ! isReady())
+    return false;
+
+  if (noData_ || plotObjs_.empty() || ! calcDataRange_.isSet())
+    return false;
+
+  if (objTreeData_.tree->isBusy())
+    return false;
+
+  // row filters which depend on visit order or all objects need full update
+  if (isEveryEnabled() || visibleFilterStr().length())
+    return false;
+
+  //---
+
+  // create objects for new rows and extend range
+  auto range = calcDataRange_;
+
+  PlotObjs objs;
+
+  if (! createAppendedObjs(first, last, range, objs)) {
+    for (auto &obj : objs)
+      delete obj;
+
+    return false;
+  }
+
+  //---
+
+  // update range (if changed)
+  bool rangeChanged = (range != calcDataRange_);
+
+  if (rangeChanged) {
+    calcDataRange_  = range;
+    dataRange_      = adjustDataRange(getCalcDataRange());
+    outerDataRange_ = dataRange_;
+  }
+
+  //---
+
+  // add new objects and add to search tree (rebuild if not built yet)
+  bool addToTree = ! objTreeData_.init;
+
+  for (auto &obj : objs) {
+    addPlotObject(obj);
+
+    if (addToTree && ! objTreeData_.tree->addObject(obj))
+      addToTree = false;
+  }
+
+  if (! addToTree)
+    invalidateObjTree();
+
+  //---
+
+  if (rangeChanged)
+    applyDataRangeAndDraw();
+  else
+    drawObjs();
+
+  if (! objs.empty())
+    emit plotObjsAdded();
+
+  return true;
+}
+
 bool
 CQChartsPlot::
 addNoDataObj()
@@ -5017,6 +5131,9 @@ clearPlotObjects()
 
   insideObjs_    .clear();
   sizeInsideObjs_.clear();
+
+  plotObjSelectedChanged();
+  plotObjInsideChanged  ();
 }
 
 void
@@ -5028,6 +5145,17 @@ invalidateObjTree()
   objTreeData_.tree->clearObjects();
 }
 
+void
+CQChartsPlot::
+updateObjTreeObj(PlotObj *obj)
+{
+  if (objTreeData_.init)
+    return;
+
+  if (! objTreeData_.tree->moveObject(obj))
+    invalidateObjTree();
+}
+
 CQChartsGeom::BBox
 CQChartsPlot::
 findEmptyBBox(double w, double h) const
@@ -5063,6 +5191,18 @@ updateInsideObjects(const Point &w)
     changed = true;
   }
 
+  // check if item under mouse changed for objects with sub items
+  if (! changed) {
+    for (const auto &obj : objs) {
+      auto *plotObj = dynamic_cast<PlotObj *>(obj);
+
+      if (plotObj && plotObj->isSubInsideChanged()) {
+        changed = true;
+        break;
+      }
+    }
+  }
+
   //---
 
   // if changed update inside objects
@@ -5538,8 +5678,15 @@ objectsSelectPress(const Point &w, SelMod selMod)
   //---
 
   // change selection depending on selection modifier
+  // (object with sub items selects item under mouse after deselect)
+  PlotObj *subSelectObj = nullptr;
+
   if (selectObj) {
-    if      (selMod == SelMod::TOGGLE)
+    auto *selectPlotObj = dynamic_cast<PlotObj *>(selectObj);
+
+    if      (selectPlotObj && selectPlotObj->hasSubSelect())
+      subSelectObj = selectPlotObj;
+    else if (selMod == SelMod::TOGGLE)
       objsSelected[selectObj] = ! selectObj->isSelected();
     else if (selMod == SelMod::REPLACE)
       objsSelected[selectObj] = true;
@@ -5552,8 +5699,6 @@ objectsSelectPress(const Point &w, SelMod selMod)
 
     //selectObj->selectPress();
 
-    auto *selectPlotObj = dynamic_cast<PlotObj *>(selectObj);
-
     if (selectPlotObj) {
       emit objPressed  (selectPlotObj);
       emit objIdPressed(selectPlotObj->id());
@@ -5581,6 +5726,14 @@ objectsSelectPress(const Point &w, SelMod selMod)
       setObjSelected(objSelected.first, false);
   }
 
+  if (subSelectObj && subSelectObj->isSelectable()) {
+    if (! changed) { startSelection(); changed = true; }
+
+    (void) subSelectObj->subSelectPoint(w, selMod);
+
+    objsSelected[subSelectObj] = subSelectObj->isSelected();
+  }
+
   for (const auto &objSelected : objsSelected) {
     if (! objSelected.first->isSelectable())
       continue;
@@ -6753,8 +6906,15 @@ rectSelect(const BBox &r, SelMod selMod)
   //---
 
   // change selection depending on selection modifier
+  // (objects with sub items select items in rect after deselect)
+  PlotObjs subSelectObjs;
+
   for (auto &obj : objs) {
-    if      (selMod == SelMod::TOGGLE)
+    auto *plotObj = dynamic_cast<PlotObj *>(obj);
+
+    if      (plotObj && plotObj->hasSubSelect())
+      subSelectObjs.push_back(plotObj);
+    else if (selMod == SelMod::TOGGLE)
       objsSelected[obj] = ! obj->isSelected();
     else if (selMod == SelMod::REPLACE)
       objsSelected[obj] = true;
@@ -6783,6 +6943,14 @@ rectSelect(const BBox &r, SelMod selMod)
       setObjSelected(objSelected.first, false);
   }
 
+  for (auto &subSelectObj : subSelectObjs) {
+    if (! changed) { startSelection(); changed = true; }
+
+    (void) subSelectObj->subSelectRect(r, view()->isSelectInside(), selMod);
+
+    objsSelected[subSelectObj] = subSelectObj->isSelected();
+  }
+
   for (const auto &objSelected : objsSelected) {
     if (! objSelected.first->isSelectable())
       continue;
@@ -9669,7 +9837,11 @@ hasObjs(const Layer::Type &layerType) const
 
   bool anyObjs = false;
 
-  for (const auto &plotObj : plotObjects()) {
+  PlotObjs plotObjs;
+
+  drawLayerObjs(layerType, bbox, plotObjs);
+
+  for (const auto &plotObj : plotObjs) {
     if      (layerType == Layer::Type::SELECTION) {
       if (! plotObj->isSelected())
         continue;
@@ -9727,7 +9899,11 @@ execDrawObjs(PaintDevice *device, const Layer::Type &layerType) const
 
   auto bbox = displayRangeBBox();
 
-  for (const auto &plotObj : plotObjects()) {
+  PlotObjs plotObjs;
+
+  drawLayerObjs(layerType, bbox, plotObjs);
+
+  for (const auto &plotObj : plotObjs) {
     if (! plotObj->isVisible())
       continue;
 
@@ -9799,6 +9975,69 @@ objInsideBox(PlotObj *plotObj, const BBox &bbox) const
   return plotObj->rectIntersect(bbox, /*inside*/ false);
 }
 
+void
+CQChartsPlot::
+drawLayerObjs(const Layer::Type &layerType, const BBox &bbox, PlotObjs &objs) const
+{
+  // selection and mouse over layers only need selected/inside objects
+  if      (layerType == Layer::Type::SELECTION) {
+    objs = selectedPlotObjs();
+    return;
+  }
+  else if (layerType == Layer::Type::MOUSE_OVER) {
+    objs = insidePlotObjs();
+    return;
+  }
+
+  // use object tree to skip objects outside clipped draw box (if built)
+  if (isPlotClip() && isObjTreeDraw()) {
+    if (objTreeData_.tree->drawObjectsIntersectRect(bbox, objs))
+      return;
+
+    objs.clear();
+  }
+
+  objs = plotObjects();
+}
+
+CQChartsPlot::PlotObjs
+CQChartsPlot::
+selectedPlotObjs() const
+{
+  std::unique_lock<std::mutex> lock(stateObjsData_.mutex);
+
+  // update if selection changed (mark valid first so change during update is kept)
+  if (! stateObjsData_.selectedValid.exchange(true)) {
+    stateObjsData_.selectedObjs.clear();
+
+    for (const auto &plotObj : plotObjects()) {
+      if (plotObj->isSelected())
+        stateObjsData_.selectedObjs.push_back(plotObj);
+    }
+  }
+
+  return stateObjsData_.selectedObjs;
+}
+
+CQChartsPlot::PlotObjs
+CQChartsPlot::
+insidePlotObjs() const
+{
+  std::unique_lock<std::mutex> lock(stateObjsData_.mutex);
+
+  // update if inside changed (mark valid first so change during update is kept)
+  if (! stateObjsData_.insideValid.exchange(true)) {
+    stateObjsData_.insideObjs.clear();
+
+    for (const auto &plotObj : plotObjects()) {
+      if (plotObj->isInside())
+        stateObjsData_.insideObjs.push_back(plotObj);
+    }
+  }
+
+  return stateObjsData_.insideObjs;
+}
+
 bool
 CQChartsPlot::
 hasGroupedFgAxes() const
@@ -12565,6 +12804,53 @@ modelMappedReal(const ModelIndex &ind, double &r, bool log, double def) const
   return ok;
 }
 
+bool
+CQChartsPlot::
+modelMappedReal(const CQChartsColumnReals *reals, const ModelIndex &ind, double &r,
+                bool log, double def) const
+{
+  // only top level rows are cached
+  if (! reals || ind.parent().isValid() || ind.row() < 0 || ind.row() >= reals->size())
+    return modelMappedReal(ind, r, log, def);
+
+  bool ok = reals->isValid(ind.row());
+
+  r = (ok ? reals->value(ind.row()) : def);
+
+  if (ok && (CMathUtil::isNaN(r) || CMathUtil::isInf(r)))
+    return false;
+
+  if (log) {
+    if (r <= 0)
+      return false;
+
+    r = logValue(r);
+  }
+
+  return ok;
+}
+
+CQChartsColumnRealsP
+CQChartsPlot::
+columnReals(const Column &column) const
+{
+  auto *modelData = getModelData();
+  if (! modelData) return CQChartsColumnRealsP();
+
+  return modelData->columnReals(model().data(), column);
+}
+
+CQChartsSortedValuesP
+CQChartsPlot::
+sortedValues(const Column &column, const QString &filter,
+             const std::vector<double> &values) const
+{
+  auto *modelData = getModelData();
+  if (! modelData) return std::make_shared<CQChartsSortedValues>(values);
+
+  return modelData->sortedValues(model().data(), column, filter, values);
+}
+
 //------
 
 // used to lookup row by name in tcl
@@ -3,6 +3,88 @@
 #include <CQChartsPaintDevice.h>
 #include <CQPropertyViewItem.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+// stable sort of indices by increasing key (LSD radix sort on order preserving
+// integer of double key, std::stable_sort for small arrays)
+void sortIndicesByKey(const std::vector<double> &keys, std::vector<int> &order) {
+  int n = int(keys.size());
+
+  order.resize(n);
+
+  for (int i = 0; i < n; ++i)
+    order[i] = i;
+
+  const int minRadixSize = 1024;
+
+  if (n < minRadixSize) {
+    std::stable_sort(order.begin(), order.end(), [&](int i1, int i2) {
+      return keys[i1] < keys[i2];
+    });
+
+    return;
+  }
+
+  // map double to unsigned integer with same order (flip sign bit of positive values and
+  // all bits of negative values)
+  std::vector<uint64_t> ikeys(n);
+
+  for (int i = 0; i < n; ++i) {
+    double k = keys[i] + 0.0; // -0.0 same as 0.0
+
+    uint64_t u;
+
+    memcpy(&u, &k, sizeof(u));
+
+    ikeys[i] = (u & 0x8000000000000000ULL ? ~u : u | 0x8000000000000000ULL);
+  }
+
+  // 11 bit digits (6 passes), skip passes where all keys have the same digit
+  const int      digitBits = 11;
+  const int      numDigits = 1 << digitBits;
+  const uint64_t digitMask = numDigits - 1;
+
+  std::vector<int> order1(n);
+  std::vector<int> counts(numDigits);
+
+  for (int shift = 0; shift < 64; shift += digitBits) {
+    std::fill(counts.begin(), counts.end(), 0);
+
+    for (int i = 0; i < n; ++i)
+      ++counts[(ikeys[i] >> shift) & digitMask];
+
+    if (counts[(ikeys[0] >> shift) & digitMask] == n)
+      continue;
+
+    int pos = 0;
+
+    for (auto &count : counts) {
+      int count1 = count;
+
+      count = pos;
+
+      pos += count1;
+    }
+
+    for (int i = 0; i < n; ++i) {
+      int j = order[i];
+
+      order1[counts[(ikeys[j] >> shift) & digitMask]++] = j;
+    }
+
+    std::swap(order, order1);
+  }
+}
+
+}
+
+//---
+
 CQChartsPlot3DType::
 CQChartsPlot3DType() :
  CQChartsGroupPlotType()
@@ -203,6 +285,14 @@ deletePointObjs()
   bgPointObjs_.clear();
   pointObjs_  .clear();
   fgPointObjs_.clear();
+
+  bgDepthData_ = DepthData();
+  depthData_   = DepthData();
+  fgDepthData_ = DepthData();
+
+  std::unique_lock<std::mutex> lock(pickMutex_);
+
+  pickGrid_ = PickGrid();
 }
 
 //---
@@ -211,31 +301,171 @@ bool
 CQChartsPlot3D::
 objNearestPoint(const Point &p, CQChartsPlotObj* &nearestObj) const
 {
-  for (auto &po : pointObjs_) {
-    for (const auto &obj : po.second) {
-      if (! obj->drawBBox().inside(p))
-        continue;
+  bool found = false;
 
-      nearestObj = obj;
+  pickObjs(p, [&](Obj *obj) {
+    nearestObj = obj;
+    found      = true;
 
-      return true;
-    }
-  }
+    return false;
+  });
 
-  return false;
+  return found;
 }
 
 void
 CQChartsPlot3D::
 plotObjsAtPoint(const Point &p, PlotObjs &objs) const
 {
+  pickObjs(p, [&](Obj *obj) {
+    objs.push_back(obj);
+
+    return true;
+  });
+}
+
+// call function for objects whose draw box contains point (in point objs order)
+// until function returns false
+template<typename FN>
+void
+CQChartsPlot3D::
+pickObjs(const Point &p, const FN &fn) const
+{
+  std::unique_lock<std::mutex> lock(pickMutex_);
+
+  updatePickGrid();
+
+  const auto &grid = pickGrid_;
+
+  if (! grid.bbox.isSet() || ! grid.bbox.inside(p))
+    return;
+
+  int ix = std::min(int((p.x - grid.bbox.getXMin())*grid.nx/grid.bbox.getWidth ()), grid.nx - 1);
+  int iy = std::min(int((p.y - grid.bbox.getYMin())*grid.ny/grid.bbox.getHeight()), grid.ny - 1);
+
+  int cell = iy*grid.nx + ix;
+
+  // merge cell and big objects (both in object order)
+  auto pc1 = grid.cellObjs.begin() + grid.cellStart[cell];
+  auto pc2 = grid.cellObjs.begin() + grid.cellStart[cell + 1];
+  auto pb1 = grid.bigObjs.begin();
+  auto pb2 = grid.bigObjs.end();
+
+  while (pc1 != pc2 || pb1 != pb2) {
+    int i;
+
+    if (pb1 == pb2 || (pc1 != pc2 && *pc1 < *pb1))
+      i = *pc1++;
+    else
+      i = *pb1++;
+
+    auto *obj = grid.objs[i];
+
+    if (! obj->drawBBox().inside(p))
+      continue;
+
+    if (! fn(obj))
+      break;
+  }
+}
+
+void
+CQChartsPlot3D::
+updatePickGrid() const
+{
+  auto &grid = pickGrid_;
+
+  if (grid.valid)
+    return;
+
+  grid = PickGrid();
+
+  grid.valid = true;
+
+  // objects with draw box (set when drawn)
   for (auto &po : pointObjs_) {
     for (const auto &obj : po.second) {
-      if (! obj->drawBBox().inside(p))
+      const auto &bbox = obj->drawBBox();
+
+      if (! bbox.isSet())
         continue;
 
-      objs.push_back(obj);
+      grid.objs.push_back(obj);
+
+      grid.bbox += bbox;
+    }
+  }
+
+  int n = int(grid.objs.size());
+
+  if (n == 0 || grid.bbox.getWidth() <= 0.0 || grid.bbox.getHeight() <= 0.0) {
+    grid.bbox = BBox();
+    return;
+  }
+
+  //---
+
+  // about two objects per cell
+  const int maxCells = 256;
+
+  int nc = std::min(std::max(int(std::sqrt(n/2.0)), 1), maxCells);
+
+  grid.nx = nc;
+  grid.ny = nc;
+
+  double xmin = grid.bbox.getXMin(), sx = grid.nx/grid.bbox.getWidth ();
+  double ymin = grid.bbox.getYMin(), sy = grid.ny/grid.bbox.getHeight();
+
+  auto cellRange = [&](const BBox &bbox, int &ix1, int &iy1, int &ix2, int &iy2) {
+    ix1 = std::min(int((bbox.getXMin() - xmin)*sx), grid.nx - 1);
+    iy1 = std::min(int((bbox.getYMin() - ymin)*sy), grid.ny - 1);
+    ix2 = std::min(int((bbox.getXMax() - xmin)*sx), grid.nx - 1);
+    iy2 = std::min(int((bbox.getYMax() - ymin)*sy), grid.ny - 1);
+  };
+
+  // objects spanning more than a quarter of the cells are checked for every cell
+  int numCells = grid.nx*grid.ny;
+
+  int maxObjCells = std::max(numCells/4, 1);
+
+  auto isBigObj = [&](int ix1, int iy1, int ix2, int iy2) {
+    return ((ix2 - ix1 + 1)*(iy2 - iy1 + 1) > maxObjCells);
+  };
+
+  // count objects per cell then store object indices per cell (in object order)
+  grid.cellStart.assign(numCells + 1, 0);
+
+  int ix1, iy1, ix2, iy2;
+
+  for (int i = 0; i < n; ++i) {
+    cellRange(grid.objs[i]->drawBBox(), ix1, iy1, ix2, iy2);
+
+    if (isBigObj(ix1, iy1, ix2, iy2)) {
+      grid.bigObjs.push_back(i);
+      continue;
     }
+
+    for (int iy = iy1; iy <= iy2; ++iy)
+      for (int ix = ix1; ix <= ix2; ++ix)
+        ++grid.cellStart[iy*grid.nx + ix + 1];
+  }
+
+  for (int i = 0; i < numCells; ++i)
+    grid.cellStart[i + 1] += grid.cellStart[i];
+
+  grid.cellObjs.resize(grid.cellStart[numCells]);
+
+  Indices pos(grid.cellStart.begin(), grid.cellStart.end() - 1);
+
+  for (int i = 0; i < n; ++i) {
+    cellRange(grid.objs[i]->drawBBox(), ix1, iy1, ix2, iy2);
+
+    if (isBigObj(ix1, iy1, ix2, iy2))
+      continue;
+
+    for (int iy = iy1; iy <= iy2; ++iy)
+      for (int ix = ix1; ix <= ix2; ++ix)
+        grid.cellObjs[pos[iy*grid.nx + ix]++] = i;
   }
 }
 
@@ -581,6 +811,8 @@ addBgPointObj(const Point3D &p, CQChartsPlot3DObj *obj)
   obj->setRefPoint(p);
 
   bgPointObjs_[p].push_back(obj);
+
+  bgDepthData_.valid = false;
 }
 
 void
@@ -590,6 +822,8 @@ addPointObj(const Point3D &p, CQChartsPlot3DObj *obj)
   obj->setRefPoint(p);
 
   pointObjs_[p].push_back(obj);
+
+  depthData_.valid = false;
 }
 
 void
@@ -599,6 +833,8 @@ addFgPointObj(const Point3D &p, CQChartsPlot3DObj *obj)
   obj->setRefPoint(p);
 
   fgPointObjs_[p].push_back(obj);
+
+  fgDepthData_.valid = false;
 }
 
 void
@@ -626,7 +862,7 @@ drawPointObjs(CQChartsPaintDevice *device) const
     th->boxZMin_ = z[0];
     th->boxZMax_ = z[0];
 
-    for (int i = 1; i < 7; ++i) {
+    for (int i = 1; i < 8; ++i) {
       th->boxZMin_ = std::min(th->boxZMin_, z[i]);
       th->boxZMax_ = std::max(th->boxZMax_, z[i]);
     }
@@ -634,54 +870,85 @@ drawPointObjs(CQChartsPaintDevice *device) const
 
   //---
 
-  using ZObjs = std::map<double, Objs>;
+  // draw background, main and foreground objects back to front
+  auto matrix = camera->transformMatrix();
 
-  //---
+  drawDepthObjs(device, bgPointObjs_, bgDepthData_, matrix);
+  drawDepthObjs(device, pointObjs_  , depthData_  , matrix);
+  drawDepthObjs(device, fgPointObjs_, fgDepthData_, matrix);
 
-  ZObjs bgZObjs;
+  // draw boxes changed
+  std::unique_lock<std::mutex> lock(pickMutex_);
 
-  for (auto &po : bgPointObjs_) {
-    double z = camera->transform(po.first).z;
+  pickGrid_.valid = false;
+}
 
-    for (const auto &bgObj : po.second)
-      bgZObjs[-z].push_back(bgObj);
-  }
+void
+CQChartsPlot3D::
+drawDepthObjs(PaintDevice *device, const PointObjs &pointObjs, DepthData &depthData,
+              const Camera::Matrix &matrix) const
+{
+  // store reference points as arrays
+  if (! depthData.valid) {
+    int n = int(pointObjs.size());
 
-  for (auto &po : bgZObjs) {
-    for (const auto &bgObj : po.second)
-      bgObj->postDraw(device);
-  }
+    depthData.x.resize(n);
+    depthData.y.resize(n);
+    depthData.z.resize(n);
 
-  //---
+    depthData.objs.resize(n);
 
-  ZObjs zObjs;
+    int i = 0;
 
-  for (auto &po : pointObjs_) {
-    double z = camera->transform(po.first).z;
+    for (auto &po : pointObjs) {
+      depthData.x[i] = po.first.x;
+      depthData.y[i] = po.first.y;
+      depthData.z[i] = po.first.z;
 
-    for (const auto &obj : po.second)
-      zObjs[-z].push_back(obj);
-  }
+      depthData.objs[i] = &po.second;
 
-  for (auto &po : zObjs) {
-    for (const auto &obj : po.second)
-      obj->postDraw(device);
+      ++i;
+    }
+
+    depthData.valid  = true;
+    depthData.sorted = false;
   }
 
   //---
 
-  ZObjs fgZObjs;
+  // transform all points and sort by decreasing z (reused if camera unchanged)
+  if (! depthData.sorted || depthData.matrix != matrix) {
+    int n = int(depthData.x.size());
 
-  for (auto &po : fgPointObjs_) {
-    double z = camera->transform(po.first).z;
+    depthData.tx.resize(n);
+    depthData.ty.resize(n);
+    depthData.tz.resize(n);
+
+    Camera::transformPoints(matrix, n, depthData.x.data(), depthData.y.data(),
+                            depthData.z.data(), depthData.tx.data(), depthData.ty.data(),
+                            depthData.tz.data());
+
+    Reals keys(n);
 
-    for (const auto &fgObj : po.second)
-      fgZObjs[-z].push_back(fgObj);
+    for (int i = 0; i < n; ++i)
+      keys[i] = -depthData.tz[i];
+
+    sortIndicesByKey(keys, depthData.order);
+
+    depthData.matrix = matrix;
+    depthData.sorted = true;
   }
 
-  for (auto &po : fgZObjs) {
-    for (const auto &fgObj : po.second)
-      fgObj->postDraw(device);
+  //---
+
+  for (const auto &i : depthData.order) {
+    Point3D pt(depthData.tx[i], depthData.ty[i], depthData.tz[i]);
+
+    for (const auto &obj : *depthData.objs[i]) {
+      obj->setDrawRefPoint(pt);
+
+      obj->postDraw(device);
+    }
   }
 }
 
@@ -29,6 +29,8 @@ initVisit()
   if (plot_->filterStr().length())
     expr_->initMatch(plot_->filterStr());
 
+  prevExpr_ = plot_->charts()->currentExpr();
+
   plot_->charts()->setCurrentExpr(expr_->qtcl());
 }
 
@@ -36,7 +38,10 @@ void
 CQChartsPlotModelVisitor::
 termVisit()
 {
-  plot_->charts()->setCurrentExpr(nullptr);
+  // restore expression of enclosing visit (if any)
+  plot_->charts()->setCurrentExpr(const_cast<CQChartsExprTcl *>(prevExpr_));
+
+  prevExpr_ = nullptr;
 
   delete expr_;
 
@@ -31,6 +31,32 @@ CQChartsPlotObj::
 
 //---
 
+void
+CQChartsPlotObj::
+setSelected(bool b)
+{
+  bool changed = (b != isSelected());
+
+  CQChartsObj::setSelected(b);
+
+  if (changed)
+    plot_->plotObjSelectedChanged();
+}
+
+void
+CQChartsPlotObj::
+setInside(bool b)
+{
+  bool changed = (b != isInside());
+
+  CQChartsObj::setInside(b);
+
+  if (changed)
+    plot_->plotObjInsideChanged();
+}
+
+//---
+
 CQChartsEditHandles *
 CQChartsPlotObj::
 editHandles() const
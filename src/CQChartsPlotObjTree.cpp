@@ -4,6 +4,7 @@
 #include <CQPerfMonitor.h>
 #include <QPainter>
 #include <future>
+#include <algorithm>
 
 CQChartsPlotObjTree::
 CQChartsPlotObjTree(CQChartsPlot *plot, bool wait) :
@@ -62,15 +63,13 @@ addObjectsThread()
 
       plotObjTree = new PlotObjTree(bbox);
 
+      objRects_.reserve(plotObjs.size());
+
       for (const auto &obj : plotObjs) {
         if (interrupt_.load())
           break;
 
-        if (! obj->isVisible())
-          continue;
-
-        if (obj->rect().isSet())
-          plotObjTree->add(obj);
+        addTreeObject(plotObjTree, obj);
       }
     }
   }
@@ -86,9 +85,90 @@ clearObjects()
 {
   interruptTree();
 
+  std::unique_lock<std::mutex> lock(mutex_);
+
   delete plotObjTree_;
 
   plotObjTree_ = nullptr;
+
+  otherObjs_.clear();
+  objRects_ .clear();
+}
+
+bool
+CQChartsPlotObjTree::
+addObject(Obj *obj)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  if (! waitTreeUnlocked()) return false;
+
+  addTreeObject(plotObjTree_, obj);
+
+  return true;
+}
+
+bool
+CQChartsPlotObjTree::
+removeObject(Obj *obj)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  if (! waitTreeUnlocked()) return false;
+
+  removeTreeObject(obj);
+
+  return true;
+}
+
+bool
+CQChartsPlotObjTree::
+moveObject(Obj *obj)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  if (! waitTreeUnlocked()) return false;
+
+  // remove using rect it was added with and re-add with current rect
+  removeTreeObject(obj);
+
+  addTreeObject(plotObjTree_, obj);
+
+  return true;
+}
+
+void
+CQChartsPlotObjTree::
+addTreeObject(PlotObjTree *plotObjTree, Obj *obj)
+{
+  // keep objects not in tree (may become visible) for draw
+  if (! obj->isVisible() || ! obj->rect().isSet()) {
+    otherObjs_.push_back(obj);
+    return;
+  }
+
+  plotObjTree->add(obj);
+
+  objRects_[obj] = obj->rect();
+}
+
+void
+CQChartsPlotObjTree::
+removeTreeObject(Obj *obj)
+{
+  auto p = objRects_.find(obj);
+
+  if (p != objRects_.end()) {
+    plotObjTree_->remove(obj, (*p).second);
+
+    objRects_.erase(p);
+  }
+  else {
+    auto po = std::find(otherObjs_.begin(), otherObjs_.end(), obj);
+
+    if (po != otherObjs_.end())
+      otherObjs_.erase(po);
+  }
 }
 
 void
@@ -105,6 +185,15 @@ interruptTree()
 bool
 CQChartsPlotObjTree::
 waitTree() const
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  return waitTreeUnlocked();
+}
+
+bool
+CQChartsPlotObjTree::
+waitTreeUnlocked() const
 {
   if (plotObjTreeFuture_.valid()) {
     auto *th = const_cast<CQChartsPlotObjTree *>(this);
@@ -124,6 +213,10 @@ void
 CQChartsPlotObjTree::
 objectsAtPoint(const Point &p, Objs &objs) const
 {
+  // don't block while tree is being built
+  if (isBusy())
+    return objectsAtPointBusy(p, objs);
+
   if (! waitTree()) return;
 
   PlotObjTree::DataList dataList;
@@ -143,6 +236,10 @@ void
 CQChartsPlotObjTree::
 objectsIntersectRect(const BBox &r, Objs &objs, bool inside) const
 {
+  // don't block while tree is being built
+  if (isBusy())
+    return objectsIntersectRectBusy(r, objs, inside);
+
   if (! waitTree()) return;
 
   PlotObjTree::DataList dataList;
@@ -161,14 +258,40 @@ objectsIntersectRect(const BBox &r, Objs &objs, bool inside) const
   }
 }
 
+void
+CQChartsPlotObjTree::
+objectsAtPointBusy(const Point &p, Objs &objs) const
+{
+  // check all objects (plot objects can't change while tree is built)
+  for (const auto &obj : plot_->plotObjects()) {
+    if (! obj->isVisible() || ! obj->rect().isSet())
+      continue;
+
+    if (obj->rect().inside(p) && obj->inside(p))
+      objs.push_back(obj);
+  }
+}
+
+void
+CQChartsPlotObjTree::
+objectsIntersectRectBusy(const BBox &r, Objs &objs, bool inside) const
+{
+  // check all objects (plot objects can't change while tree is built)
+  for (const auto &obj : plot_->plotObjects()) {
+    if (! obj->isVisible() || ! obj->rect().isSet())
+      continue;
+
+    if (obj->rectIntersect(r, inside))
+      objs.push_back(obj);
+  }
+}
+
 bool
 CQChartsPlotObjTree::
 objectNearest(const Point &p, double searchX, double searchY, CQChartsPlotObj* &obj) const
 {
   obj = nullptr;
 
-  if (! waitTree()) return false;
-
   BBox bbox(p.x - searchX, p.y - searchY, p.x + searchX, p.y + searchY);
 
   Objs objs;
@@ -189,6 +312,37 @@ objectNearest(const Point &p, double searchX, double searchY, CQChartsPlotObj* &
   return obj;
 }
 
+bool
+CQChartsPlotObjTree::
+drawObjectsIntersectRect(const BBox &r, Objs &objs) const
+{
+  // don't wait for tree (caller draws all objects)
+  if (isBusy())
+    return false;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  if (! waitTreeUnlocked()) return false;
+
+  PlotObjTree::DataList dataList;
+
+  plotObjTree_->dataTouchingRect(r, dataList);
+
+  objs.reserve(dataList.size() + otherObjs_.size());
+
+  for (const auto &obj : dataList)
+    objs.push_back(obj);
+
+  for (const auto &obj : otherObjs_)
+    objs.push_back(obj);
+
+  std::sort(objs.begin(), objs.end(), [](const Obj *lhs, const Obj *rhs) {
+    return (lhs->plotInd() < rhs->plotInd());
+  });
+
+  return true;
+}
+
 CQChartsGeom::BBox
 CQChartsPlotObjTree::
 findEmptyBBox(double w, double h) const
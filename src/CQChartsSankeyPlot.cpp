@@ -25,6 +25,36 @@
 #include <CQPerfMonitor.h>
 #include <CMathRound.h>
 
+#include <future>
+#include <thread>
+
+namespace {
+
+// process sub ranges of [0, n) in separate threads (if threaded) or in current thread
+template<typename FN>
+void processRange(int n, bool threaded, const FN &fn) {
+  int numThreads = std::max(int(std::thread::hardware_concurrency()), 1);
+
+  if (threaded && numThreads > 1 && n > 1) {
+    std::vector<std::future<void>> futures;
+
+    int n1 = (n + numThreads - 1)/numThreads;
+
+    for (int i1 = 0; i1 < n; i1 += n1)
+      futures.push_back(std::async(std::launch::async, fn, i1, std::min(i1 + n1, n)));
+
+    for (auto &future : futures)
+      future.wait();
+  }
+  else
+    fn(0, n);
+}
+
+// min number of nodes to process in separate threads
+const int minThreadNodes = 1000;
+
+}
+
 CQChartsSankeyPlotType::
 CQChartsSankeyPlotType()
 {
@@ -251,7 +281,7 @@ void
 CQChartsSankeyPlot::
 setAdjustNodes(bool b)
 {
-  CQChartsUtil::testAndSet(adjustNodes_, b, [&]() { updateRangeAndObjs(); } );
+  CQChartsUtil::testAndSet(adjustNodes_, b, [&]() { resetLayout(); updateRangeAndObjs(); } );
 }
 
 void
@@ -445,6 +475,9 @@ createObjs(PlotObjs &objs) const
 
   //---
 
+  // save current placement to start next layout from
+  th->saveLayout();
+
   // init objects
   th->clearNodesAndEdges();
 
@@ -1274,8 +1307,14 @@ placeGraphNodes(const Nodes &nodes) const
 
   //---
 
-  // adjust nodes in graph
-  adjustGraphNodes(nodes);
+  // adjust nodes in graph (starting from previous layout if possible and only
+  // re-adjusting changed depths)
+  PosSet posSet;
+
+  if (restoreLayout(posSet))
+    adjustGraphPosNodes(nodes, &posSet);
+  else
+    adjustGraphNodes(nodes);
 
   //---
 
@@ -1616,6 +1655,15 @@ bool
 CQChartsSankeyPlot::
 adjustGraphNodes(const Nodes &nodes) const
 {
+  return adjustGraphPosNodes(nodes, nullptr);
+}
+
+bool
+CQChartsSankeyPlot::
+adjustGraphPosNodes(const Nodes &nodes, const PosSet *posSet) const
+{
+  CQPerfTrace trace("CQChartsSankeyPlot::adjustGraphPosNodes");
+
 //auto *th = const_cast<CQChartsSankeyPlot *>(this);
 
   //---
@@ -1632,17 +1680,24 @@ adjustGraphNodes(const Nodes &nodes) const
   //---
 
   if (isAdjustNodes()) {
-    int numPasses = 25;
+    // adjust all depths (no pos set) or only specified depths
+    if (! posSet || ! posSet->empty()) {
+      int numPasses = 25;
 
-    for (int pass = 0; pass < numPasses; ++pass) {
-      //std::cerr << "Pass " << pass << "\n";
+      for (int pass = 0; pass < numPasses; ++pass) {
+        //std::cerr << "Pass " << pass << "\n";
 
-      if (! adjustNodeCenters()) {
-        //std::cerr << "adjustNodeCenters (#" << pass + 1 << " Passes)\n";
-        break;
+        if (! adjustNodeCenters(posSet)) {
+          //std::cerr << "adjustNodeCenters (#" << pass + 1 << " Passes)\n";
+          break;
+        }
       }
     }
 
+    // restored depths may overlap after node size change
+    if (posSet)
+      removeOverlaps();
+
     //---
 
     reorderNodeEdges(nodes);
@@ -1672,42 +1727,71 @@ initPosNodesMap(const Nodes &nodes) const
 
 bool
 CQChartsSankeyPlot::
-adjustNodeCenters() const
+adjustNodeCenters(const PosSet *posSet) const
 {
   // adjust nodes so centered on src nodes
   bool changed = false;
 
+  auto adjustDepthNodes = [&](int xpos) {
+    if (! graph_->hasPosNodes(xpos)) return;
+
+    if (posSet && posSet->find(xpos) == posSet->end()) return;
+
+    if (adjustPosNodes(graph_->posNodes(xpos)))
+      changed = true;
+  };
+
   // second to last
   int posNodesDepth = graph_->posNodesMap().size();
 
-  for (int xpos = 1; xpos <= posNodesDepth; ++xpos) {
-    if (! graph_->hasPosNodes(xpos)) continue;
+  for (int xpos = 1; xpos <= posNodesDepth; ++xpos)
+    adjustDepthNodes(xpos);
 
-    const auto &nodes = graph_->posNodes(xpos);
+  removeOverlaps(posSet);
 
-    for (const auto &node : nodes) {
-      if (adjustNode(node))
-        changed = true;
+  //---
+
+  // second to last to first
+  for (int xpos = posNodesDepth - 1; xpos >= 0; --xpos)
+    adjustDepthNodes(xpos);
+
+  removeOverlaps(posSet);
+
+  return changed;
+}
+
+bool
+CQChartsSankeyPlot::
+adjustPosNodes(const Nodes &nodes) const
+{
+  // calc move of all nodes at depth from current positions (in parallel for large
+  // number of nodes) and then move nodes
+  int n = int(nodes.size());
+
+  std::vector<double> dys(n, 0.0);
+
+  auto calcNodes = [&](int i1, int i2) {
+    for (int i = i1; i < i2; ++i) {
+      double dy;
+
+      if (calcNodeAdjust(nodes[i], dy))
+        dys[i] = dy;
     }
-  }
+  };
 
-  removeOverlaps();
+  processRange(n, n >= minThreadNodes, calcNodes);
 
   //---
 
-  // second to last to first
-  for (int xpos = posNodesDepth - 1; xpos >= 0; --xpos) {
-    if (! graph_->hasPosNodes(xpos)) continue;
+  bool changed = false;
 
-    const auto &nodes = graph_->posNodes(xpos);
+  for (int i = 0; i < n; ++i) {
+    if (dys[i] == 0.0) continue;
 
-    for (const auto &node : nodes) {
-      if (adjustNode(node))
-        changed = true;
-    }
-  }
+    nodes[i]->moveBy(Point(0, dys[i]));
 
-  removeOverlaps();
+    changed = true;
+  }
 
   return changed;
 }
@@ -1795,16 +1879,38 @@ adjustEdgeOverlaps() const
 
 bool
 CQChartsSankeyPlot::
-removeOverlaps() const
+removeOverlaps(const PosSet *posSet) const
 {
-  bool changed = false;
+  // get nodes for each depth (all or specified depths)
+  std::vector<const Nodes *> posNodesArray;
+
+  int numNodes = 0;
 
   for (const auto &posNodes : graph_->posNodesMap()) {
-    if (removePosOverlaps(posNodes.second))
-      changed = true;
+    if (posSet && posSet->find(posNodes.first) == posSet->end()) continue;
+
+    posNodesArray.push_back(&posNodes.second);
+
+    numNodes += int(posNodes.second.size());
   }
 
-  return changed;
+  //---
+
+  // nodes at each depth are only moved in y so depths are processed in parallel
+  int n = int(posNodesArray.size());
+
+  std::vector<int> changed(n, 0);
+
+  auto removeDepthOverlaps = [&](int i1, int i2) {
+    for (int i = i1; i < i2; ++i) {
+      if (removePosOverlaps(*posNodesArray[i]))
+        changed[i] = 1;
+    }
+  };
+
+  processRange(n, numNodes >= minThreadNodes, removeDepthOverlaps);
+
+  return (std::find(changed.begin(), changed.end(), 1) != changed.end());
 }
 
 bool
@@ -1905,42 +2011,61 @@ spreadPosNodes(const Nodes &nodes) const
 bool
 CQChartsSankeyPlot::
 reorderNodeEdges(const Nodes &nodes) const
+{
+  // sort node edges nodes by bbox
+  // (only updates edges of each node so nodes are processed in parallel)
+  int n = int(nodes.size());
+
+  std::vector<int> changed(n, 0);
+
+  auto reorderNodes = [&](int i1, int i2) {
+    for (int i = i1; i < i2; ++i) {
+      if (reorderNodeEdges(nodes[i]))
+        changed[i] = 1;
+    }
+  };
+
+  processRange(n, n >= minThreadNodes, reorderNodes);
+
+  return (std::find(changed.begin(), changed.end(), 1) != changed.end());
+}
+
+bool
+CQChartsSankeyPlot::
+reorderNodeEdges(Node *node) const
 {
   bool changed = false;
 
-  // sort node edges nodes by bbox
-  for (const auto &node : nodes) {
-    PosEdgeMap srcPosEdgeMap;
+  PosEdgeMap srcPosEdgeMap;
 
-    createPosEdgeMap(node->srcEdges(), srcPosEdgeMap, /*isSrc*/true);
+  createPosEdgeMap(node->srcEdges(), srcPosEdgeMap, /*isSrc*/true);
 
-    if (srcPosEdgeMap.size() > 1) {
-      Edges srcEdges;
+  if (srcPosEdgeMap.size() > 1) {
+    Edges srcEdges;
 
-      for (const auto &srcPosNode : srcPosEdgeMap)
-        srcEdges.push_back(srcPosNode.second);
+    for (const auto &srcPosNode : srcPosEdgeMap)
+      srcEdges.push_back(srcPosNode.second);
 
-      node->setSrcEdges(srcEdges);
+    node->setSrcEdges(srcEdges);
 
-      changed = true;
-    }
+    changed = true;
+  }
 
-    //---
+  //---
 
-    PosEdgeMap destPosEdgeMap;
+  PosEdgeMap destPosEdgeMap;
 
-    createPosEdgeMap(node->destEdges(), destPosEdgeMap, /*isSrc*/false);
+  createPosEdgeMap(node->destEdges(), destPosEdgeMap, /*isSrc*/false);
 
-    if (destPosEdgeMap.size() > 1) {
-      Edges destEdges;
+  if (destPosEdgeMap.size() > 1) {
+    Edges destEdges;
 
-      for (const auto &destPosNode : destPosEdgeMap)
-        destEdges.push_back(destPosNode.second);
+    for (const auto &destPosNode : destPosEdgeMap)
+      destEdges.push_back(destPosNode.second);
 
-      node->setDestEdges(destEdges);
+    node->setDestEdges(destEdges);
 
-      changed = true;
-    }
+    changed = true;
   }
 
   return changed;
@@ -1998,6 +2123,20 @@ createPosEdgeMap(const Edges &edges, PosEdgeMap &posEdgeMap, bool isSrc) const
 bool
 CQChartsSankeyPlot::
 adjustNode(Node *node) const
+{
+  double dy;
+
+  if (! calcNodeAdjust(node, dy))
+    return false;
+
+  node->moveBy(Point(0, dy));
+
+  return true;
+}
+
+bool
+CQChartsSankeyPlot::
+calcNodeAdjust(Node *node, double &dy) const
 {
   // get bounds of source edges
   BBox srcBBox;
@@ -2041,13 +2180,124 @@ adjustNode(Node *node) const
 
   //---
 
-  // move node to average
-  double dy = midY - node->rect().getYMid();
+  // calc move of node to average
+  dy = midY - node->rect().getYMid();
 
   if (std::abs(dy) < 1E-6) // better tolerance ?
     return false;
 
-  node->moveBy(Point(0, dy));
+  return true;
+}
+
+//---
+
+void
+CQChartsSankeyPlot::
+saveLayout()
+{
+  resetLayout();
+
+  if (! graph_ || ! graph_->rect().isSet())
+    return;
+
+  layoutData_.align       = align();
+  layoutData_.minX        = minX();
+  layoutData_.maxX        = maxX();
+  layoutData_.valueScale  = graph_->valueScale ();
+  layoutData_.valueMargin = graph_->valueMargin();
+
+  for (const auto &node : graph_->nodes()) {
+    const auto &rect = node->rect();
+    if (! rect.isValid()) continue;
+
+    auto &layoutNode = layoutData_.nodes[node->name()];
+
+    layoutNode.xpos = node->xpos();
+    layoutNode.size = node->edgeSum();
+    layoutNode.y    = rect.getYMid();
+  }
+
+  layoutData_.valid = true;
+}
+
+void
+CQChartsSankeyPlot::
+resetLayout()
+{
+  layoutData_.valid = false;
+
+  layoutData_.nodes.clear();
+}
+
+bool
+CQChartsSankeyPlot::
+restoreLayout(PosSet &posSet) const
+{
+  // only restore adjusted layout with same x placement
+  if (! layoutData_.valid || ! isAdjustNodes())
+    return false;
+
+  if (layoutData_.align != align() || layoutData_.minX != minX() || layoutData_.maxX != maxX())
+    return false;
+
+  // all depths adjusted if node size scale or margin changed (e.g. resize)
+  bool scaleChanged = (! CMathUtil::realEq(layoutData_.valueScale , graph_->valueScale ()) ||
+                       ! CMathUtil::realEq(layoutData_.valueMargin, graph_->valueMargin()));
+
+  // get number of saved nodes at each depth
+  std::map<int, int> xposCount;
+
+  for (const auto &pn : layoutData_.nodes)
+    ++xposCount[pn.second.xpos];
+
+  //---
+
+  // move nodes to previous center and get depths with added, removed or resized nodes
+  PosSet changedPos;
+
+  for (const auto &depthNodes : graph_->depthNodesMap()) {
+    int         xpos  = depthNodes.first;
+    const auto &nodes = depthNodes.second.nodes;
+
+    bool changed = (scaleChanged || xposCount[xpos] != int(nodes.size()));
+
+    for (const auto &node : nodes) {
+      auto p = layoutData_.nodes.find(node->name());
+
+      if (p == layoutData_.nodes.end() || (*p).second.xpos != xpos) {
+        changed = true;
+        continue;
+      }
+
+      const auto &layoutNode = (*p).second;
+
+      if (! CMathUtil::realEq(layoutNode.size, node->edgeSum()))
+        changed = true;
+
+      node->moveBy(Point(0, layoutNode.y - node->rect().getYMid()));
+    }
+
+    if (changed)
+      changedPos.insert(xpos);
+  }
+
+  //---
+
+  // adjust changed depths and depths of nodes connected to them
+  for (const auto &depthNodes : graph_->depthNodesMap()) {
+    int xpos = depthNodes.first;
+    if (changedPos.find(xpos) == changedPos.end()) continue;
+
+    posSet.insert(xpos);
+
+    for (const auto &node : depthNodes.second.nodes) {
+      for (const auto &edge : node->srcEdges())
+        posSet.insert(edge->srcNode()->xpos());
+
+      for (const auto &edge : node->destEdges())
+        posSet.insert(edge->destNode()->xpos());
+    }
+  }
 
   return true;
 }
@@ -3006,7 +3256,17 @@ editMove(const Point &p)
 
   editChanged_ = true;
 
-  const_cast<CQChartsSankeyPlot *>(plot())->drawObjs();
+  // update moved node and its edges in search tree
+  auto *plot = const_cast<CQChartsSankeyPlot *>(this->plot());
+
+  plot->updateObjTreeObj(this);
+
+  for (auto *obj : getConnected()) {
+    if (obj)
+      plot->updateObjTreeObj(obj);
+  }
+
+  plot->drawObjs();
 
   return true;
 }
@@ -3022,9 +3282,7 @@ bool
 CQChartsSankeyNodeObj::
 editRelease(const Point &)
 {
-  if (editChanged_)
-    const_cast<CQChartsSankeyPlot *>(plot())->invalidateObjTree();
-
+  // search tree updated on move
   return true;
 }
 
@@ -283,6 +283,47 @@ setPlotType(PlotType type)
   CQChartsUtil::testAndSet(plotType_, type, [&]() { updateRangeAndObjs(); } );
 }
 
+void
+CQChartsScatterPlot::
+setPointBatchThreshold(int n)
+{
+  CQChartsUtil::testAndSet(pointBatchThreshold_, n, [&]() { updateObjs(); } );
+}
+
+bool
+CQChartsScatterPlot::
+isPointBatchValues() const
+{
+  if (pointBatchThreshold() <= 0)
+    return false;
+
+  // per point style, label or image needs individual point objects
+  if (symbolTypeColumn().isValid() || symbolSizeColumn().isValid() ||
+      fontSizeColumn  ().isValid() || fontColumn      ().isValid() ||
+      colorColumn     ().isValid() || imageColumn     ().isValid() ||
+      labelColumn     ().isValid() || nameColumn      ().isValid())
+    return false;
+
+  // value color uses individual point value index or position
+  if (colorType() != ColorType::AUTO)
+    return false;
+
+  // batch points use flat model rows
+  if (isHierarchical())
+    return false;
+
+  //---
+
+  int n = 0;
+
+  for (const auto &groupNameValue : groupNameValues_) {
+    for (const auto &nameValue : groupNameValue.second)
+      n += int(nameValue.second.values.size());
+  }
+
+  return (n > pointBatchThreshold());
+}
+
 //---
 
 void
@@ -482,7 +523,9 @@ addProperties()
   //---
 
   // options
-  addProp("options", "plotType", "plotType", "Plot type");
+  addProp("options", "plotType"           , "plotType"           , "Plot type");
+  addProp("options", "pointBatchThreshold", "pointBatchThreshold",
+          "Number of points above which points are drawn in batches");
 
   //---
 
@@ -636,6 +679,13 @@ calcRange() const
     RowVisitor(const CQChartsScatterPlot *plot) :
      plot_(plot) {
       hasGroups_ = (plot_->numGroups() > 1);
+
+      // get cached column values for numeric columns
+      if (isNumeric(plot_->xColumnType()))
+        xReals_ = plot_->columnReals(plot_->xColumn());
+
+      if (isNumeric(plot_->yColumnType()))
+        yReals_ = plot_->columnReals(plot_->yColumn());
     }
 
     State visit(const QAbstractItemModel *, const VisitData &data) override {
@@ -660,7 +710,7 @@ calcRange() const
 
         if      (plot_->xColumnType() == ColumnType::REAL ||
                  plot_->xColumnType() == ColumnType::INTEGER) {
-          okx = plot_->modelMappedReal(xModelInd, x, plot_->isLogX(), data.row);
+          okx = plot_->modelMappedReal(xReals_.get(), xModelInd, x, plot_->isLogX(), data.row);
         }
         else if (plot_->xColumnType() == ColumnType::TIME) {
           x = plot_->modelReal(xModelInd, okx);
@@ -673,7 +723,7 @@ calcRange() const
 
         if      (plot_->yColumnType() == ColumnType::REAL ||
                  plot_->yColumnType() == ColumnType::INTEGER) {
-          oky = plot_->modelMappedReal(yModelInd, y, plot_->isLogY(), data.row);
+          oky = plot_->modelMappedReal(yReals_.get(), yModelInd, y, plot_->isLogY(), data.row);
         }
         else if (plot_->yColumnType() == ColumnType::TIME) {
           y = plot_->modelReal(yModelInd, oky);
@@ -726,6 +776,10 @@ calcRange() const
     bool isUniqueX() const { return numUniqueX_ == numRows(); }
     bool isUniqueY() const { return numUniqueY_ == numRows(); }
 
+    static bool isNumeric(ColumnType type) {
+      return (type == ColumnType::REAL || type == ColumnType::INTEGER);
+    }
+
    private:
     const CQChartsScatterPlot* plot_       { nullptr };
     int                        hasGroups_  { false };
@@ -733,6 +787,8 @@ calcRange() const
     CQChartsModelDetails*      details_    { nullptr };
     int                        numUniqueX_ { 0 };
     int                        numUniqueY_ { 0 };
+    CQChartsColumnRealsP       xReals_;
+    CQChartsColumnRealsP       yReals_;
   };
 
   Range dataRange;
@@ -952,6 +1008,7 @@ clearPlotObjects()
   groupNameValues_  .clear();
   groupNameGridData_.clear();
   groupNameHexData_ .clear();
+  groupNameDensity_ .clear();
 
   CQChartsPlot::clearPlotObjects();
 }
@@ -982,9 +1039,10 @@ createObjs(PlotObjs &objs) const
   if (groupInds_.empty())
     addNameValues();
 
-  th->groupPoints_  .clear();
-  th->groupFitData_ .clear();
-  th->groupStatData_.clear();
+  th->groupPoints_     .clear();
+  th->groupFitData_    .clear();
+  th->groupStatData_   .clear();
+  th->groupNameDensity_.clear();
 
   //---
 
@@ -1019,6 +1077,147 @@ createObjs(PlotObjs &objs) const
   return true;
 }
 
+bool
+CQChartsScatterPlot::
+createAppendedObjs(int first, int, Range &range, PlotObjs &objs) const
+{
+  CQPerfTrace trace("CQChartsScatterPlot::createAppendedObjs");
+
+  // only symbols whose position and style do not depend on other rows
+  if (! isSymbols() || isDensityMap())
+    return false;
+
+  if (isXDensity() || isYDensity() || isXWhisker() || isYWhisker())
+    return false;
+
+  auto isNumeric = [](ColumnType type) {
+    return (type == ColumnType::REAL || type == ColumnType::INTEGER || type == ColumnType::TIME);
+  };
+
+  if (! isNumeric(xColumnType()) || ! isNumeric(yColumnType()))
+    return false;
+
+  // mapped values and colors use range of all values
+  if (symbolTypeColumn().isValid() || symbolSizeColumn().isValid() ||
+      fontSizeColumn().isValid() || colorColumn().isValid())
+    return false;
+
+  if (colorType() != ColorType::AUTO)
+    return false;
+
+  if (numGroups() > 1)
+    return false;
+
+  //---
+
+  auto *th = const_cast<CQChartsScatterPlot *>(this);
+
+  // save number of values for each group and name
+  using NameCount      = std::map<QString, int>;
+  using GroupNameCount = std::map<int, NameCount>;
+
+  GroupNameCount groupNameCount;
+
+  for (const auto &groupNameValue : groupNameValues_) {
+    auto &nameCount = groupNameCount[groupNameValue.first];
+
+    for (const auto &nameValue : groupNameValue.second)
+      nameCount[nameValue.first] = nameValue.second.values.size();
+  }
+
+  //---
+
+  // add values for new rows (fails if new rows add group or name set)
+  addNameValues(first);
+
+  if (groupNameValues_.size() != groupNameCount.size())
+    return false;
+
+  for (const auto &groupNameValue : groupNameValues_) {
+    auto pg = groupNameCount.find(groupNameValue.first);
+
+    if (pg == groupNameCount.end() || (*pg).second.size() != groupNameValue.second.size())
+      return false;
+  }
+
+  // batch points are binned by position so recreate all
+  if (isPointBatchValues())
+    return false;
+
+  //---
+
+  // create point objects for new values
+  int ig = 0;
+  int ng = groupInds_.size();
+
+  for (const auto &groupNameValue : groupNameValues_) {
+    int         groupInd   = groupNameValue.first;
+    const auto &nameValues = groupNameValue.second;
+
+    const auto &nameCount = groupNameCount[groupInd];
+
+    auto &points = th->groupPoints_[groupInd];
+
+    int is = 0;
+    int ns = nameValues.size();
+
+    for (const auto &nameValue : nameValues) {
+      bool hidden = isSetHidden(is);
+
+      if (hidden) { ++is; continue; }
+
+      //---
+
+      auto pn = nameCount.find(nameValue.first);
+
+      if (pn == nameCount.end())
+        return false;
+
+      const auto &values = nameValue.second.values;
+
+      int nv = values.size();
+
+      for (int iv = (*pn).second; iv < nv; ++iv) {
+        const auto &valuePoint = values[iv];
+
+        const auto &p = valuePoint.p;
+
+        ColorInd is1(is, ns);
+        ColorInd ig1(ig, ng);
+        ColorInd iv1(iv, nv);
+
+        auto *pointObj = createValuePointObj(groupInd, valuePoint, is1, ig1, iv1);
+
+        objs.push_back(pointObj);
+
+        points.push_back(p);
+
+        range.updateRange(p.x, p.y);
+      }
+
+      ++is;
+    }
+
+    ++ig;
+  }
+
+  range = adjustDataRange(range);
+
+  //---
+
+  // reset data calculated from group points
+  th->groupFitData_    .clear();
+  th->groupStatData_   .clear();
+  th->groupNameDensity_.clear();
+
+  for (const auto &ghull : th->groupHull_)
+    delete ghull.second;
+
+  th->groupHull_.clear();
+
+  return true;
+}
+
 void
 CQChartsScatterPlot::
 updateColumnNames()
@@ -1061,6 +1260,9 @@ addPointObjects(PlotObjs &objs) const
 
   int hasGroups = (numGroups() > 1);
 
+  // store points in batch objects instead of individual objects for large point counts
+  bool pointBatch = isPointBatchValues();
+
   int ig = 0;
   int ng = groupInds_.size();
 
@@ -1114,6 +1316,17 @@ addPointObjects(PlotObjs &objs) const
 
       int nv = values.size();
 
+      if (pointBatch) {
+        addPointBatchObjects(groupInd, nameValue.second, ColorInd(is, ns), ColorInd(ig, ng), objs);
+
+        for (const auto &valuePoint : values)
+          points.push_back(valuePoint.p);
+
+        ++is;
+
+        continue;
+      }
+
       for (int iv = 0; iv < nv; ++iv) {
         if (isInterrupt())
           break;
@@ -1127,146 +1340,248 @@ addPointObjects(PlotObjs &objs) const
 
         //---
 
-        // get symbol size (needed for bounding box)
-        Length symbolSize(CQChartsUnits::NONE, 0.0);
+        // create point object
+        ColorInd is1(is, ns);
+        ColorInd ig1(ig, ng);
+        ColorInd iv1(iv, nv);
 
-        if (symbolSizeColumn().isValid()) {
-          if (! columnSymbolSize(valuePoint.row, valuePoint.ind.parent(), symbolSize))
-            symbolSize = Length(CQChartsUnits::NONE, 0.0);
-        }
+        auto *pointObj = createValuePointObj(groupInd, valuePoint, is1, ig1, iv1);
 
-        double sx, sy;
+        objs.push_back(pointObj);
 
-        plotSymbolSize(symbolSize.isValid() ? symbolSize : this->symbolSize(), sx, sy);
+        points.push_back(p);
+      }
 
-        //---
+      ++is;
+    }
 
-        // create point object
-        ColorInd is1(is, ns);
-        ColorInd ig1(ig, ng);
-        ColorInd iv1(iv, nv);
+    ++ig;
+  }
 
-        BBox bbox(p.x - sx, p.y - sy, p.x + sx, p.y + sy);
+  //---
 
-        auto *pointObj = createPointObj(groupInd, bbox, p, is1, ig1, iv1);
+  columnTypeMgr->endCache(model().data());
+}
 
-        if (valuePoint.ind.isValid())
-          pointObj->setModelInd(valuePoint.ind);
+void
+CQChartsScatterPlot::
+addPointBatchObjects(int groupInd, const ValuesData &valuesData, const ColorInd &is,
+                     const ColorInd &ig, PlotObjs &objs) const
+{
+  const auto &values = valuesData.values;
 
-        if (symbolSize.isValid())
-          pointObj->setSymbolSize(symbolSize);
+  int nv = values.size();
+  if (nv <= 0) return;
 
-        objs.push_back(pointObj);
+  //---
 
-        points.push_back(p);
+  // bin points into grid of cells (about batchSize points per cell) so each batch
+  // covers a compact area for object tree lookup and draw culling
+  const int batchSize = 1024;
 
-        //---
+  int nb = std::max(int(std::ceil(std::sqrt(double(nv)/batchSize))), 1);
 
-        // set optional symbol type
-        CQChartsSymbol symbolType(CQChartsSymbol::Type::NONE);
+  double xmin = valuesData.xrange.min(0.0), xmax = valuesData.xrange.max(0.0);
+  double ymin = valuesData.yrange.min(0.0), ymax = valuesData.yrange.max(0.0);
 
-        if (symbolTypeColumn().isValid()) {
-          if (! columnSymbolType(valuePoint.row, valuePoint.ind.parent(), symbolType))
-            symbolType = CQChartsSymbol(CQChartsSymbol::Type::NONE);
-        }
+  double dx = (xmax > xmin ? nb/(xmax - xmin) : 0.0);
+  double dy = (ymax > ymin ? nb/(ymax - ymin) : 0.0);
 
-        if (symbolType.isValid())
-          pointObj->setSymbolType(symbolType);
+  auto cellInd = [&](const Point &p) {
+    int ix = std::min(std::max(int((p.x - xmin)*dx), 0), nb - 1);
+    int iy = std::min(std::max(int((p.y - ymin)*dy), 0), nb - 1);
 
-        //---
+    return iy*nb + ix;
+  };
 
-        // set optional font size
-        Length fontSize(CQChartsUnits::NONE, 0.0);
+  std::vector<int> cellCount(nb*nb, 0);
 
-        if (fontSizeColumn().isValid()) {
-          if (! columnFontSize(valuePoint.row, valuePoint.ind.parent(), fontSize))
-            fontSize = Length(CQChartsUnits::NONE, 0.0);
-        }
+  for (const auto &valuePoint : values)
+    ++cellCount[cellInd(valuePoint.p)];
 
-        if (fontSize.isValid())
-          pointObj->setFontSize(fontSize);
+  //---
 
-        //---
+  // create batch object per non empty cell
+  double sx, sy;
 
-        // set optional font
-        if (fontColumn().isValid()) {
-          CQChartsFont font;
+  plotSymbolSize(symbolSize(), sx, sy);
 
-          if (fontColumnFont(valuePoint.row, valuePoint.ind.parent(), font))
-            pointObj->setFont(font);
-        }
+  int nc = 0;
 
-        //---
+  for (const auto &n : cellCount)
+    if (n > 0) ++nc;
 
-        // set optional symbol fill color
-        Color symbolColor(Color::Type::NONE);
+  std::vector<PointBatchObj *> cellObjs(nb*nb, nullptr);
 
-        if (colorColumn().isValid()) {
-          if (! colorColumnColor(valuePoint.row, valuePoint.ind.parent(), symbolColor))
-            symbolColor = Color(Color::Type::NONE);
-        }
+  int ib = 0;
 
-        if (symbolColor.isValid())
-          pointObj->setColor(symbolColor);
+  for (int i = 0; i < nb*nb; ++i) {
+    if (cellCount[i] <= 0) continue;
 
-        //---
+    auto *batchObj = createPointBatchObj(groupInd, BBox(), is, ig, ColorInd(ib, nc));
 
-        // set optional point label
-        QString pointName;
-        Column  pointNameColumn;
+    batchObj->reserve(cellCount[i]);
 
-        if (labelColumn().isValid() || nameColumn().isValid()) {
-          bool ok;
+    cellObjs[i] = batchObj;
 
-          if (labelColumn().isValid()) {
-            ModelIndex labelInd(th, valuePoint.row, labelColumn(), valuePoint.ind.parent());
+    objs.push_back(batchObj);
 
-            pointName = modelString(labelInd, ok);
-            if (ok) pointNameColumn = labelColumn();
-          }
+    ++ib;
+  }
 
-          if (nameColumn().isValid() && ! pointNameColumn.isValid()) {
-            ModelIndex nameInd(th, valuePoint.row, nameColumn(), valuePoint.ind.parent());
+  //---
 
-            pointName = modelString(nameInd, ok);
-            if (ok) pointNameColumn = nameColumn();
-          }
-        }
+  // add points (in value order) to cell batches
+  for (const auto &valuePoint : values) {
+    const auto &p = valuePoint.p;
 
-        if (pointNameColumn.isValid() && pointName.length()) {
-          pointObj->setName      (pointName);
-          pointObj->setNameColumn(pointNameColumn);
-        }
+    auto *batchObj = cellObjs[cellInd(p)];
 
-        //---
+    batchObj->addPoint(p, valuePoint.ind.row());
+  }
+
+  for (auto &batchObj : cellObjs) {
+    if (batchObj)
+      batchObj->updateRect(sx, sy);
+  }
+}
+
+CQChartsScatterPointObj *
+CQChartsScatterPlot::
+createValuePointObj(int groupInd, const ValueData &valuePoint, const ColorInd &is,
+                    const ColorInd &ig, const ColorInd &iv) const
+{
+  auto *th = const_cast<CQChartsScatterPlot *>(this);
 
-        // set optional image
-        CQChartsImage image;
+  const auto &p = valuePoint.p;
 
-        if (imageColumn().isValid()) {
-          ModelIndex imageModelInd(th, valuePoint.row, imageColumn(), valuePoint.ind.parent());
+  //---
 
-          bool ok;
+  // get symbol size (needed for bounding box)
+  Length symbolSize(CQChartsUnits::NONE, 0.0);
 
-          auto imageVar = modelValue(imageModelInd, ok);
+  if (symbolSizeColumn().isValid()) {
+    if (! columnSymbolSize(valuePoint.row, valuePoint.ind.parent(), symbolSize))
+      symbolSize = Length(CQChartsUnits::NONE, 0.0);
+  }
 
-          if (ok)
-            image = CQChartsVariant::toImage(imageVar, ok);
-        }
+  double sx, sy;
 
-        if (image.isValid())
-          pointObj->setImage(image);
-      }
+  plotSymbolSize(symbolSize.isValid() ? symbolSize : this->symbolSize(), sx, sy);
 
-      ++is;
+  //---
+
+  // create point object
+  BBox bbox(p.x - sx, p.y - sy, p.x + sx, p.y + sy);
+
+  auto *pointObj = createPointObj(groupInd, bbox, p, is, ig, iv);
+
+  if (valuePoint.ind.isValid())
+    pointObj->setModelInd(valuePoint.ind);
+
+  if (symbolSize.isValid())
+    pointObj->setSymbolSize(symbolSize);
+
+  //---
+
+  // set optional symbol type
+  CQChartsSymbol symbolType(CQChartsSymbol::Type::NONE);
+
+  if (symbolTypeColumn().isValid()) {
+    if (! columnSymbolType(valuePoint.row, valuePoint.ind.parent(), symbolType))
+      symbolType = CQChartsSymbol(CQChartsSymbol::Type::NONE);
+  }
+
+  if (symbolType.isValid())
+    pointObj->setSymbolType(symbolType);
+
+  //---
+
+  // set optional font size
+  Length fontSize(CQChartsUnits::NONE, 0.0);
+
+  if (fontSizeColumn().isValid()) {
+    if (! columnFontSize(valuePoint.row, valuePoint.ind.parent(), fontSize))
+      fontSize = Length(CQChartsUnits::NONE, 0.0);
+  }
+
+  if (fontSize.isValid())
+    pointObj->setFontSize(fontSize);
+
+  //---
+
+  // set optional font
+  if (fontColumn().isValid()) {
+    CQChartsFont font;
+
+    if (fontColumnFont(valuePoint.row, valuePoint.ind.parent(), font))
+      pointObj->setFont(font);
+  }
+
+  //---
+
+  // set optional symbol fill color
+  Color symbolColor(Color::Type::NONE);
+
+  if (colorColumn().isValid()) {
+    if (! colorColumnColor(valuePoint.row, valuePoint.ind.parent(), symbolColor))
+      symbolColor = Color(Color::Type::NONE);
+  }
+
+  if (symbolColor.isValid())
+    pointObj->setColor(symbolColor);
+
+  //---
+
+  // set optional point label
+  QString pointName;
+  Column  pointNameColumn;
+
+  if (labelColumn().isValid() || nameColumn().isValid()) {
+    bool ok;
+
+    if (labelColumn().isValid()) {
+      ModelIndex labelInd(th, valuePoint.row, labelColumn(), valuePoint.ind.parent());
+
+      pointName = modelString(labelInd, ok);
+      if (ok) pointNameColumn = labelColumn();
     }
 
-    ++ig;
+    if (nameColumn().isValid() && ! pointNameColumn.isValid()) {
+      ModelIndex nameInd(th, valuePoint.row, nameColumn(), valuePoint.ind.parent());
+
+      pointName = modelString(nameInd, ok);
+      if (ok) pointNameColumn = nameColumn();
+    }
+  }
+
+  if (pointNameColumn.isValid() && pointName.length()) {
+    pointObj->setName      (pointName);
+    pointObj->setNameColumn(pointNameColumn);
   }
 
   //---
 
-  columnTypeMgr->endCache(model().data());
+  // set optional image
+  CQChartsImage image;
+
+  if (imageColumn().isValid()) {
+    ModelIndex imageModelInd(th, valuePoint.row, imageColumn(), valuePoint.ind.parent());
+
+    bool ok;
+
+    auto imageVar = modelValue(imageModelInd, ok);
+
+    if (ok)
+      image = CQChartsVariant::toImage(imageVar, ok);
+  }
+
+  if (image.isValid())
+    pointObj->setImage(image);
+
+  //---
+
+  return pointObj;
 }
 
 void
@@ -1457,7 +1772,7 @@ addHexObjects(PlotObjs &objs) const
 
 void
 CQChartsScatterPlot::
-addNameValues() const
+addNameValues(int firstRow) const
 {
   CQPerfTrace trace("CQChartsScatterPlot::addNameValues");
 
@@ -1465,6 +1780,12 @@ addNameValues() const
    public:
     RowVisitor(const CQChartsScatterPlot *plot) :
      plot_(plot) {
+      // get cached column values for numeric columns
+      if (isNumeric(plot_->xColumnType()))
+        xReals_ = plot_->columnReals(plot_->xColumn());
+
+      if (isNumeric(plot_->yColumnType()))
+        yReals_ = plot_->columnReals(plot_->yColumn());
     }
 
     State visit(const QAbstractItemModel *, const VisitData &data) override {
@@ -1489,7 +1810,7 @@ addNameValues() const
 
       if      (plot_->xColumnType() == ColumnType::REAL ||
                plot_->xColumnType() == ColumnType::INTEGER) {
-        okx = plot_->modelMappedReal(xModelInd, x, plot_->isLogX(), data.row);
+        okx = plot_->modelMappedReal(xReals_.get(), xModelInd, x, plot_->isLogX(), data.row);
       }
       else if (plot_->xColumnType() == ColumnType::TIME) {
         x = plot_->modelReal(xModelInd, okx);
@@ -1502,7 +1823,7 @@ addNameValues() const
 
       if      (plot_->yColumnType() == ColumnType::REAL ||
                plot_->yColumnType() == ColumnType::INTEGER) {
-        oky = plot_->modelMappedReal(yModelInd, y, plot_->isLogY(), data.row);
+        oky = plot_->modelMappedReal(yReals_.get(), yModelInd, y, plot_->isLogY(), data.row);
       }
       else if (plot_->yColumnType() == ColumnType::TIME) {
         y = plot_->modelReal(yModelInd, oky);
@@ -1582,13 +1903,21 @@ addNameValues() const
       return (details_ ? details_->columnDetails(column) : nullptr);
     }
 
+    static bool isNumeric(ColumnType type) {
+      return (type == ColumnType::REAL || type == ColumnType::INTEGER);
+    }
+
    private:
     const CQChartsScatterPlot* plot_    { nullptr };
     CQChartsModelDetails*      details_ { nullptr };
+    CQChartsColumnRealsP       xReals_;
+    CQChartsColumnRealsP       yReals_;
   };
 
   RowVisitor visitor(this);
 
+  visitor.setFirstRow(firstRow);
+
   visitModel(visitor);
 }
 
@@ -1695,6 +2024,14 @@ createPointObj(int groupInd, const BBox &rect, const Point &p, const ColorInd &i
   return new CQChartsScatterPointObj(this, groupInd, rect, p, is, ig, iv);
 }
 
+CQChartsScatterPointBatchObj *
+CQChartsScatterPlot::
+createPointBatchObj(int groupInd, const BBox &rect, const ColorInd &is, const ColorInd &ig,
+                    const ColorInd &ib) const
+{
+  return new CQChartsScatterPointBatchObj(this, groupInd, rect, is, ig, ib);
+}
+
 CQChartsScatterCellObj *
 CQChartsScatterPlot::
 createCellObj(int groupInd, const BBox &rect, const ColorInd &is, const ColorInd &ig,
@@ -2646,14 +2983,33 @@ drawXYRug(PaintDevice *device, const RugP &rug, double delta) const
 
     //---
 
-    auto *cellObj = dynamic_cast<CQChartsScatterCellObj *>(plotObj);
+    auto *batchObj = dynamic_cast<CQChartsScatterPointBatchObj *>(plotObj);
 
-    if (cellObj) {
+    if (batchObj) {
       PenBrush penBrush;
 
-      cellObj->calcRugPenBrush(penBrush, /*updateState*/false);
+      batchObj->calcPenBrush(penBrush, /*updateState*/false);
+
+      for (int i = 0; i < batchObj->numPoints(); ++i) {
+        auto p = batchObj->point(i);
 
-      for (const auto &p : cellObj->points()) {
+        if (rug->direction() == Qt::Horizontal)
+          rug->addPoint(CQChartsAxisRug::RugPoint(p.x, penBrush.pen.color()));
+        else
+          rug->addPoint(CQChartsAxisRug::RugPoint(p.y, penBrush.pen.color()));
+      }
+    }
+
+    //---
+
+    auto *cellObj = dynamic_cast<CQChartsScatterCellObj *>(plotObj);
+
+    if (cellObj) {
+      PenBrush penBrush;
+
+      cellObj->calcRugPenBrush(penBrush, /*updateState*/false);
+
+      for (const auto &p : cellObj->points()) {
         if (rug->direction() == Qt::Horizontal)
           rug->addPoint(CQChartsAxisRug::RugPoint(p.x, penBrush.pen.color()));
         else
@@ -2877,7 +3233,7 @@ drawDensityMap(PaintDevice *device) const
 
   //---
 
-  CQChartsBivariateDensity density;
+  auto *th = const_cast<CQChartsScatterPlot *>(this);
 
   CQChartsBivariateDensity::Data data;
 
@@ -2891,12 +3247,17 @@ drawDensityMap(PaintDevice *device) const
 
     const auto &nameValues = groupNameValue.second;
 
+    auto &nameDensity = th->groupNameDensity_[groupNameValue.first];
+
     for (const auto &nameValue : nameValues) {
       if (isInterrupt())
         return;
 
       const auto &values = nameValue.second;
 
+      // cached density grid for group name values
+      auto &density = nameDensity[nameValue.first];
+
       data.values.clear();
 
       for (const auto &v : values.values)
@@ -2960,6 +3321,15 @@ initWhiskerData() const
 
           whiskerData1->addValue(pointObj->point().x);
         }
+
+        const auto *batchObj = dynamic_cast<CQChartsScatterPointBatchObj *>(plotObj);
+
+        if (batchObj && batchObj->groupInd() == groupInd) {
+          auto *whiskerData1 = const_cast<AxisBoxWhisker *>(xWhiskerData);
+
+          for (int i = 0; i < batchObj->numPoints(); ++i)
+            whiskerData1->addValue(batchObj->point(i).x);
+        }
       }
     }
 
@@ -2975,6 +3345,15 @@ initWhiskerData() const
 
           whiskerData1->addValue(pointObj->point().y);
         }
+
+        const auto *batchObj = dynamic_cast<CQChartsScatterPointBatchObj *>(plotObj);
+
+        if (batchObj && batchObj->groupInd() == groupInd) {
+          auto *whiskerData1 = const_cast<AxisBoxWhisker *>(yWhiskerData);
+
+          for (int i = 0; i < batchObj->numPoints(); ++i)
+            whiskerData1->addValue(batchObj->point(i).y);
+        }
       }
     }
   }
@@ -3577,6 +3956,560 @@ yColorValue(bool relative) const
 
 //------
 
+CQChartsScatterPointBatchObj::
+CQChartsScatterPointBatchObj(const Plot *plot, int groupInd, const BBox &rect,
+                             const ColorInd &is, const ColorInd &ig, const ColorInd &ib) :
+ CQChartsPlotObj(const_cast<Plot *>(plot), rect, is, ig, ib), plot_(plot),
+ groupInd_(groupInd)
+{
+  setDetailHint(DetailHint::MAJOR);
+}
+
+void
+CQChartsScatterPointBatchObj::
+reserve(int n)
+{
+  xs_  .reserve(n);
+  ys_  .reserve(n);
+  rows_.reserve(n);
+}
+
+void
+CQChartsScatterPointBatchObj::
+addPoint(const Point &p, int row)
+{
+  xs_  .push_back(p.x);
+  ys_  .push_back(p.y);
+  rows_.push_back(row);
+
+  selected_.push_back(false);
+}
+
+void
+CQChartsScatterPointBatchObj::
+updateRect(double sx, double sy)
+{
+  BBox bbox;
+
+  int n = numPoints();
+
+  for (int i = 0; i < n; ++i)
+    bbox += pointBBox(i, sx, sy);
+
+  setRect(bbox);
+}
+
+//---
+
+QString
+CQChartsScatterPointBatchObj::
+calcId() const
+{
+  return QString("%1:%2:%3:%4").arg(typeName()).arg(is_.i).arg(ig_.i).arg(iv_.i);
+}
+
+QString
+CQChartsScatterPointBatchObj::
+calcTipId() const
+{
+  CQChartsTableTip tableTip;
+
+  plot()->addNoTipColumns(tableTip);
+
+  //---
+
+  // add group column (TODO: check group column)
+  if (ig_.n > 1) {
+    QString groupName = plot_->groupIndName(groupInd_);
+
+    tableTip.addTableRow("Group", groupName);
+  }
+
+  //---
+
+  // no point under mouse so show number of points
+  if (hitInd_ < 0 || hitInd_ >= numPoints()) {
+    tableTip.addTableRow("Points", numPoints());
+
+    return tableTip.str();
+  }
+
+  //---
+
+  // add x, y columns for point under mouse
+  auto p = point(hitInd_);
+
+  if (! tableTip.hasColumn(plot()->xColumn())) {
+    QString xstr;
+
+    if (plot()->isUniqueX()) {
+      auto *columnDetails = plot()->columnDetails(plot()->xColumn());
+
+      xstr = (columnDetails ? columnDetails->uniqueValue(int(p.x)).toString() :
+                              plot()->xStr(p.x));
+    }
+    else
+      xstr = plot()->xStr(p.x);
+
+    tableTip.addTableRow(plot_->xHeaderName(/*tip*/true), xstr);
+
+    tableTip.addColumn(plot()->xColumn());
+  }
+
+  if (! tableTip.hasColumn(plot()->yColumn())) {
+    QString ystr;
+
+    if (plot()->isUniqueY()) {
+      auto *columnDetails = plot()->columnDetails(plot()->yColumn());
+
+      ystr = (columnDetails ? columnDetails->uniqueValue(int(p.y)).toString() :
+                              plot()->yStr(p.y));
+    }
+    else
+      ystr = plot()->yStr(p.y);
+
+    tableTip.addTableRow(plot_->yHeaderName(/*tip*/true), ystr);
+
+    tableTip.addColumn(plot()->yColumn());
+  }
+
+  //---
+
+  auto ind = plot_->selectIndex(row(hitInd_), plot()->xColumn(), QModelIndex());
+
+  plot()->addTipColumns(tableTip, ind);
+
+  //---
+
+  return tableTip.str();
+}
+
+//---
+
+bool
+CQChartsScatterPointBatchObj::
+isSelected() const
+{
+  if (drawState_.set)
+    return drawState_.selected;
+
+  return (numSelected_ > 0);
+}
+
+void
+CQChartsScatterPointBatchObj::
+setSelected(bool b)
+{
+  int n = numPoints();
+
+  for (int i = 0; i < n; ++i)
+    selected_[i] = b;
+
+  numSelected_ = (b ? n : 0);
+
+  updateSelected();
+}
+
+bool
+CQChartsScatterPointBatchObj::
+isInside() const
+{
+  if (drawState_.set)
+    return drawState_.inside;
+
+  return CQChartsPlotObj::isInside();
+}
+
+void
+CQChartsScatterPointBatchObj::
+setInside(bool b)
+{
+  // highlight point under mouse
+  insideInd_ = (b ? hitInd_ : -1);
+
+  CQChartsPlotObj::setInside(b);
+}
+
+bool
+CQChartsScatterPointBatchObj::
+isSubInsideChanged() const
+{
+  return (CQChartsPlotObj::isInside() && hitInd_ != insideInd_);
+}
+
+//---
+
+CQChartsGeom::BBox
+CQChartsScatterPointBatchObj::
+pointBBox(int i, double sx, double sy) const
+{
+  return BBox(xs_[i] - sx, ys_[i] - sy, xs_[i] + sx, ys_[i] + sy);
+}
+
+int
+CQChartsScatterPointBatchObj::
+pointInd(const Point &p) const
+{
+  double sx, sy;
+
+  plot_->plotSymbolSize(plot_->symbolSize(), sx, sy);
+
+  // find closest point (last drawn if same distance) whose symbol contains position
+  int    ind   = -1;
+  double dist2 = 0.0;
+
+  int n = numPoints();
+
+  for (int i = 0; i < n; ++i) {
+    double dx = std::abs(xs_[i] - p.x);
+    double dy = std::abs(ys_[i] - p.y);
+
+    if (dx > sx || dy > sy)
+      continue;
+
+    double d2 = dx*dx + dy*dy;
+
+    if (ind < 0 || d2 <= dist2) {
+      ind   = i;
+      dist2 = d2;
+    }
+  }
+
+  return ind;
+}
+
+bool
+CQChartsScatterPointBatchObj::
+inside(const Point &p) const
+{
+  if (! isVisible()) return false;
+
+  int ind = pointInd(p);
+
+  // update point under mouse (tip shows point under mouse)
+  if (ind != hitInd_) {
+    hitInd_ = ind;
+
+    const_cast<CQChartsScatterPointBatchObj *>(this)->resetTipId();
+  }
+
+  return (ind >= 0);
+}
+
+bool
+CQChartsScatterPointBatchObj::
+rectIntersect(const BBox &r, bool inside) const
+{
+  if (! isVisible()) return false;
+
+  if (! r.overlaps(rect()))
+    return false;
+
+  double sx, sy;
+
+  plot_->plotSymbolSize(plot_->symbolSize(), sx, sy);
+
+  int n = numPoints();
+
+  for (int i = 0; i < n; ++i) {
+    auto pbbox = pointBBox(i, sx, sy);
+
+    if (inside ? r.inside(pbbox) : r.overlaps(pbbox))
+      return true;
+  }
+
+  return false;
+}
+
+//---
+
+bool
+CQChartsScatterPointBatchObj::
+subSelectPoint(const Point &p, SelMod selMod)
+{
+  int ind = pointInd(p);
+
+  bool changed = false;
+
+  // replace deselects other points
+  if (selMod == SelMod::REPLACE) {
+    int n = numPoints();
+
+    for (int i = 0; i < n; ++i) {
+      if (i != ind && setPointSelected(i, false))
+        changed = true;
+    }
+  }
+
+  if (ind >= 0 && selectPoint(ind, selMod))
+    changed = true;
+
+  if (changed)
+    updateSelected();
+
+  return changed;
+}
+
+bool
+CQChartsScatterPointBatchObj::
+subSelectRect(const BBox &r, bool inside, SelMod selMod)
+{
+  double sx, sy;
+
+  plot_->plotSymbolSize(plot_->symbolSize(), sx, sy);
+
+  bool changed = false;
+
+  int n = numPoints();
+
+  for (int i = 0; i < n; ++i) {
+    auto pbbox = pointBBox(i, sx, sy);
+
+    bool inRect = (inside ? r.inside(pbbox) : r.overlaps(pbbox));
+
+    if      (inRect) {
+      if (selectPoint(i, selMod))
+        changed = true;
+    }
+    // replace deselects points outside rect
+    else if (selMod == SelMod::REPLACE) {
+      if (setPointSelected(i, false))
+        changed = true;
+    }
+  }
+
+  if (changed)
+    updateSelected();
+
+  return changed;
+}
+
+bool
+CQChartsScatterPointBatchObj::
+subSelectIndices(const Indices &inds)
+{
+  if (inds.empty())
+    return false;
+
+  // select points whose x or y value index is selected
+  const auto &xColumn = plot_->xColumn();
+  const auto &yColumn = plot_->yColumn();
+
+  bool changed = false;
+
+  int n = numPoints();
+
+  for (int i = 0; i < n; ++i) {
+    if (selected_[i])
+      continue;
+
+    auto xind = plot_->selectIndex(row(i), xColumn, QModelIndex());
+    auto yind = plot_->selectIndex(row(i), yColumn, QModelIndex());
+
+    if (inds.find(xind) != inds.end() || inds.find(yind) != inds.end()) {
+      if (setPointSelected(i, true))
+        changed = true;
+    }
+  }
+
+  if (changed)
+    updateSelected();
+
+  return changed;
+}
+
+bool
+CQChartsScatterPointBatchObj::
+setPointSelected(int i, bool b)
+{
+  if (selected_[i] == b)
+    return false;
+
+  selected_[i] = b;
+
+  numSelected_ += (b ? 1 : -1);
+
+  return true;
+}
+
+bool
+CQChartsScatterPointBatchObj::
+selectPoint(int i, SelMod selMod)
+{
+  if      (selMod == SelMod::TOGGLE)
+    return setPointSelected(i, ! selected_[i]);
+  else if (selMod == SelMod::REPLACE)
+    return setPointSelected(i, true);
+  else if (selMod == SelMod::ADD)
+    return setPointSelected(i, true);
+  else if (selMod == SelMod::REMOVE)
+    return setPointSelected(i, false);
+
+  return false;
+}
+
+void
+CQChartsScatterPointBatchObj::
+updateSelected()
+{
+  CQChartsObj::setSelected(isSelected());
+
+  // selected points changed so always update plot selected objects
+  CQChartsPlotObj::plot()->plotObjSelectedChanged();
+}
+
+//---
+
+void
+CQChartsScatterPointBatchObj::
+getObjSelectIndices(Indices &inds) const
+{
+  if (numSelected_ <= 0)
+    return;
+
+  int n = numPoints();
+
+  for (int i = 0; i < n; ++i) {
+    if (! selected_[i])
+      continue;
+
+    addSelectIndex(inds, row(i), plot_->xColumn());
+    addSelectIndex(inds, row(i), plot_->yColumn());
+  }
+}
+
+//---
+
+void
+CQChartsScatterPointBatchObj::
+draw(PaintDevice *device)
+{
+  bool updateState = device->isInteractive();
+
+  //---
+
+  // selection and mouse over layers only draw selected and inside points
+  using LayerType = CQChartsLayer::Type;
+
+  const auto &layerType = plot_->drawLayerType();
+
+  bool selectedOnly = (updateState &&
+    (layerType == LayerType::SELECTION  || layerType == LayerType::SELECTION_EXTRA ));
+  bool insideOnly   = (updateState &&
+    (layerType == LayerType::MOUSE_OVER || layerType == LayerType::MOUSE_OVER_EXTRA));
+
+  //---
+
+  // get symbol type and size
+  auto symbolType = plot_->symbolType();
+  auto symbolSize = plot_->symbolSize();
+
+  //---
+
+  device->setColorNames();
+
+  // set pen and brush for point state (points share style so only state differs)
+  auto setStatePenBrush = [&](bool selected, bool inside) {
+    PenBrush penBrush;
+
+    drawState_.set      = true;
+    drawState_.selected = selected;
+    drawState_.inside   = inside;
+
+    calcPenBrush(penBrush, updateState);
+
+    drawState_.set = false;
+
+    CQChartsDrawUtil::setPenBrush(device, penBrush);
+  };
+
+  auto drawPoint = [&](int i) {
+    plot_->drawSymbol(device, point(i), symbolType, symbolSize);
+  };
+
+  int n = numPoints();
+
+  // draw inside point only
+  if      (insideOnly) {
+    if (insideInd_ >= 0 && insideInd_ < n) {
+      setStatePenBrush(selected_[insideInd_], true);
+
+      drawPoint(insideInd_);
+    }
+  }
+  // draw selected points only
+  else if (selectedOnly) {
+    if (numSelected_ > 0) {
+      setStatePenBrush(true, false);
+
+      for (int i = 0; i < n; ++i) {
+        if (selected_[i] && i != insideInd_)
+          drawPoint(i);
+      }
+
+      if (insideInd_ >= 0 && insideInd_ < n && selected_[insideInd_]) {
+        setStatePenBrush(true, true);
+
+        drawPoint(insideInd_);
+      }
+    }
+  }
+  // draw all points (grouped by state)
+  else {
+    setStatePenBrush(false, false);
+
+    bool checkState = (updateState && (numSelected_ > 0 || insideInd_ >= 0));
+
+    for (int i = 0; i < n; ++i) {
+      if (checkState && (selected_[i] || i == insideInd_))
+        continue;
+
+      drawPoint(i);
+    }
+
+    if (checkState) {
+      if (numSelected_ > 0) {
+        setStatePenBrush(true, false);
+
+        for (int i = 0; i < n; ++i) {
+          if (selected_[i] && i != insideInd_)
+            drawPoint(i);
+        }
+      }
+
+      if (insideInd_ >= 0 && insideInd_ < n) {
+        setStatePenBrush(selected_[insideInd_], true);
+
+        drawPoint(insideInd_);
+      }
+    }
+  }
+
+  device->resetColorNames();
+}
+
+void
+CQChartsScatterPointBatchObj::
+calcPenBrush(PenBrush &penBrush, bool updateState) const
+{
+  // default for scatter is set or group color (not value color !!)
+  ColorInd ic;
+
+  if      (is_.n > 1)
+    ic = is_;
+  else if (ig_.n > 1)
+    ic = ig_;
+
+  //--
+
+  plot_->setSymbolPenBrush(penBrush, ic);
+
+  if (updateState)
+    plot()->updateObjPenBrushState(this, penBrush, CQChartsPlot::DrawType::SYMBOL);
+}
+
+//------
+
 CQChartsScatterCellObj::
 CQChartsScatterCellObj(const Plot *plot, int groupInd, const BBox &rect, const ColorInd &is,
                        const ColorInd &ig, int ix, int iy, const Points &points, int maxN) :
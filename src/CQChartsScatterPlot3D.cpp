@@ -1689,11 +1689,8 @@ postDraw(CQChartsPaintDevice *device)
 
   //---
 
-  auto *camera = plot3D()->camera();
-
-  auto pt = camera->transform(point());
-
-  auto pt2 = pt.point2D();
+  // point is reference point so use batch transformed point
+  auto pt2 = drawRefPoint().point2D();
 
   plot_->drawSymbol(device, pt2, symbolType, symbolSize, penBrush);
 
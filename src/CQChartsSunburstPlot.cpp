@@ -891,11 +891,7 @@ childHierNode(HierNode *parent, const QString &name) const
 
   //--
 
-  for (const auto &child : parent->getChildren())
-    if (child->name() == name)
-      return child;
-
-  return nullptr;
+  return parent->childByName(name);
 }
 
 CQChartsSunburstNode *
@@ -904,11 +900,7 @@ childNode(HierNode *parent, const QString &name) const
 {
   assert(parent);
 
-  for (const auto &node : parent->getNodes())
-    if (node->name() == name)
-      return node;
-
-  return nullptr;
+  return parent->nodeByName(name);
 }
 
 bool
@@ -1483,8 +1475,12 @@ CQChartsSunburstHierNode::
 CQChartsSunburstHierNode(const Plot *plot, HierNode *parent, const QString &name) :
  CQChartsSunburstNode(plot, parent, name)
 {
-  if (parent_)
+  if (parent_) {
     parent_->children_.push_back(this);
+
+    if (! parent_->nameChildren_.contains(name))
+      parent_->nameChildren_.insert(name, this);
+  }
 }
 
 CQChartsSunburstHierNode::
@@ -1639,6 +1635,9 @@ CQChartsSunburstHierNode::
 addNode(Node *node)
 {
   nodes_.push_back(node);
+
+  if (! nameNodes_.contains(node->name()))
+    nameNodes_.insert(node->name(), node);
 }
 
 void
@@ -1662,6 +1661,18 @@ removeNode(Node *node)
     nodes_[i - 1] = nodes_[i];
 
   nodes_.pop_back();
+
+  // update name lookup (to next node with same name)
+  if (nameNodes_.value(node->name()) == node) {
+    nameNodes_.remove(node->name());
+
+    for (const auto &node1 : nodes_) {
+      if (node1->name() == node->name()) {
+        nameNodes_.insert(node1->name(), node1);
+        break;
+      }
+    }
+  }
 }
 
 QColor
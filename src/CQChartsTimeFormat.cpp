@@ -0,0 +1,354 @@
+#include <CQChartsTimeFormat.h>
+#include <CQChartsUtil.h>
+
+#include <cstring>
+#include <ctime>
+
+namespace {
+
+// month names (full then abbreviated) matched case insensitive as strptime in C locale
+const char *monthNames[] = {
+  "january", "february", "march", "april", "may", "june", "july",
+  "august", "september", "october", "november", "december"
+};
+
+// match lower case name at string position (case insensitive)
+bool matchName(const QString &str, int &pos, const char *name, int len) {
+  int n = str.length();
+
+  if (pos + len > n)
+    return false;
+
+  for (int i = 0; i < len; ++i) {
+    if (str[pos + i].toLower().toLatin1() != name[i])
+      return false;
+  }
+
+  pos += len;
+
+  return true;
+}
+
+// read number of up to maxDigits digits (leading spaces skipped) in range [minValue, maxValue]
+bool readNumber(const QString &str, int &pos, int maxDigits, int minValue, int maxValue,
+                int &value) {
+  int n = str.length();
+
+  while (pos < n && str[pos] == ' ')
+    ++pos;
+
+  if (pos >= n || ! str[pos].isDigit())
+    return false;
+
+  value = 0;
+
+  int nd = 0;
+
+  while (pos < n && nd < maxDigits && str[pos].isDigit()) {
+    value = value*10 + str[pos].digitValue();
+
+    ++pos;
+    ++nd;
+  }
+
+  return (value >= minValue && value <= maxValue);
+}
+
+// get time of start of day (local time, no daylight saving as for stringToTime)
+// (last day is cached as consecutive values are usually on the same day)
+double dayTime(int year, int mon, int mday) {
+  struct DayData {
+    bool   set  { false };
+    int    year { 0 };
+    int    mon  { 0 };
+    int    mday { 0 };
+    double t    { 0.0 };
+  };
+
+  static thread_local DayData dayData;
+
+  if (! dayData.set || dayData.year != year || dayData.mon != mon || dayData.mday != mday) {
+    struct tm tm1; memset(&tm1, 0, sizeof(tm1));
+
+    tm1.tm_year = year;
+    tm1.tm_mon  = mon;
+    tm1.tm_mday = mday;
+
+    dayData.set  = true;
+    dayData.year = year;
+    dayData.mon  = mon;
+    dayData.mday = mday;
+    dayData.t    = double(mktime(&tm1));
+  }
+
+  return dayData.t;
+}
+
+}
+
+//---
+
+CQChartsTimeFormat::
+CQChartsTimeFormat(const QString &format)
+{
+  setFormat(format);
+}
+
+void
+CQChartsTimeFormat::
+setFormat(const QString &format)
+{
+  format_ = format;
+
+  compiled_ = compile();
+}
+
+bool
+CQChartsTimeFormat::
+compile()
+{
+  tokens_.clear();
+
+  auto addLiteral = [&](const QChar &c) {
+    tokens_.push_back(Token(TokenType::LITERAL, c));
+  };
+
+  auto addToken = [&](TokenType type) {
+    tokens_.push_back(Token(type));
+  };
+
+  int n = format_.length();
+
+  for (int i = 0; i < n; ++i) {
+    const auto &c = format_[i];
+
+    if (c.isSpace()) {
+      addToken(TokenType::SPACE);
+      continue;
+    }
+
+    if (c != '%') {
+      addLiteral(c);
+      continue;
+    }
+
+    if (i + 1 >= n)
+      return false;
+
+    char c1 = format_[++i].toLatin1();
+
+    switch (c1) {
+      case 'Y': addToken(TokenType::YEAR      ); break;
+      case 'y': addToken(TokenType::YEAR2     ); break;
+      case 'm': addToken(TokenType::MONTH     ); break;
+      case 'b':
+      case 'B':
+      case 'h': addToken(TokenType::MONTH_NAME); break;
+      case 'd':
+      case 'e': addToken(TokenType::DAY       ); break;
+      case 'H': addToken(TokenType::HOUR      ); break;
+      case 'I': addToken(TokenType::HOUR12    ); break;
+      case 'M': addToken(TokenType::MINUTE    ); break;
+      case 'S': addToken(TokenType::SECOND    ); break;
+      case 'p': addToken(TokenType::AM_PM     ); break;
+      case 's': addToken(TokenType::EPOCH     ); break;
+      case 'n':
+      case 't': addToken(TokenType::SPACE     ); break;
+      case '%': addLiteral('%'); break;
+
+      // %H:%M:%S
+      case 'T': {
+        addToken(TokenType::HOUR  ); addLiteral(':');
+        addToken(TokenType::MINUTE); addLiteral(':');
+        addToken(TokenType::SECOND);
+        break;
+      }
+      // %m/%d/%y
+      case 'D': {
+        addToken(TokenType::MONTH); addLiteral('/');
+        addToken(TokenType::DAY  ); addLiteral('/');
+        addToken(TokenType::YEAR2);
+        break;
+      }
+      // %Y-%m-%d
+      case 'F': {
+        addToken(TokenType::YEAR ); addLiteral('-');
+        addToken(TokenType::MONTH); addLiteral('-');
+        addToken(TokenType::DAY  );
+        break;
+      }
+      // %H:%M
+      case 'R': {
+        addToken(TokenType::HOUR  ); addLiteral(':');
+        addToken(TokenType::MINUTE);
+        break;
+      }
+
+      default:
+        return false;
+    }
+  }
+
+  return true;
+}
+
+bool
+CQChartsTimeFormat::
+stringToTime(const QString &str, double &t) const
+{
+  if (! compiled_)
+    return CQChartsUtil::stringToTime(format_, str, t);
+
+  return parse(str, t);
+}
+
+bool
+CQChartsTimeFormat::
+parse(const QString &str, double &t) const
+{
+  // same defaults as zero initialized tm for strptime
+  int year = 0, mon = 0, mday = 0, hour = 0, min = 0, sec = 0;
+
+  bool hasHour12 = false, isPM = false, hasEpoch = false;
+
+  double epoch = 0.0;
+
+  int n   = str.length();
+  int pos = 0;
+
+  int value;
+
+  for (const auto &token : tokens_) {
+    switch (token.type) {
+      case TokenType::LITERAL: {
+        if (pos >= n || str[pos] != token.c)
+          return false;
+
+        ++pos;
+
+        break;
+      }
+      case TokenType::SPACE: {
+        while (pos < n && str[pos].isSpace())
+          ++pos;
+
+        break;
+      }
+      case TokenType::YEAR: {
+        if (! readNumber(str, pos, 4, 0, 9999, value)) return false;
+
+        year = value - 1900;
+
+        break;
+      }
+      case TokenType::YEAR2: {
+        if (! readNumber(str, pos, 2, 0, 99, value)) return false;
+
+        year = (value >= 69 ? value : value + 100);
+
+        break;
+      }
+      case TokenType::MONTH: {
+        if (! readNumber(str, pos, 2, 1, 12, value)) return false;
+
+        mon = value - 1;
+
+        break;
+      }
+      case TokenType::MONTH_NAME: {
+        bool found = false;
+
+        for (int i = 0; i < 12; ++i) {
+          const char *name = monthNames[i];
+
+          if (matchName(str, pos, name, int(strlen(name))) || matchName(str, pos, name, 3)) {
+            mon   = i;
+            found = true;
+            break;
+          }
+        }
+
+        if (! found) return false;
+
+        break;
+      }
+      case TokenType::DAY: {
+        if (! readNumber(str, pos, 2, 1, 31, value)) return false;
+
+        mday = value;
+
+        break;
+      }
+      case TokenType::HOUR: {
+        if (! readNumber(str, pos, 2, 0, 23, value)) return false;
+
+        hour      = value;
+        hasHour12 = false;
+
+        break;
+      }
+      case TokenType::HOUR12: {
+        if (! readNumber(str, pos, 2, 1, 12, value)) return false;
+
+        hour      = value % 12;
+        hasHour12 = true;
+
+        break;
+      }
+      case TokenType::MINUTE: {
+        if (! readNumber(str, pos, 2, 0, 59, value)) return false;
+
+        min = value;
+
+        break;
+      }
+      case TokenType::SECOND: {
+        if (! readNumber(str, pos, 2, 0, 61, value)) return false;
+
+        sec = value;
+
+        break;
+      }
+      case TokenType::AM_PM: {
+        if      (matchName(str, pos, "am", 2))
+          isPM = false;
+        else if (matchName(str, pos, "pm", 2))
+          isPM = true;
+        else
+          return false;
+
+        break;
+      }
+      case TokenType::EPOCH: {
+        if (pos >= n || ! str[pos].isDigit())
+          return false;
+
+        epoch = 0.0;
+
+        while (pos < n && str[pos].isDigit())
+          epoch = epoch*10 + str[pos++].digitValue();
+
+        hasEpoch = true;
+
+        break;
+      }
+    }
+  }
+
+  //---
+
+  // epoch seconds are used as is
+  if (hasEpoch) {
+    t = epoch;
+
+    return true;
+  }
+
+  if (hasHour12 && isPM)
+    hour += 12;
+
+  // time in day is linear as daylight saving is not used
+  t = dayTime(year, mon, mday) + hour*3600.0 + min*60.0 + sec;
+
+  return true;
+}
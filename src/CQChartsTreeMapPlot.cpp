@@ -1043,22 +1043,14 @@ CQChartsTreeMapHierNode *
 CQChartsTreeMapPlot::
 childHierNode(HierNode *parent, const QString &name) const
 {
-  for (const auto &child : parent->getChildren())
-    if (child->name() == name)
-      return child;
-
-  return nullptr;
+  return parent->childByName(name);
 }
 
 CQChartsTreeMapNode *
 CQChartsTreeMapPlot::
 childNode(HierNode *parent, const QString &name) const
 {
-  for (const auto &node : parent->getNodes())
-    if (node->name() == name)
-      return node;
-
-  return nullptr;
+  return parent->nodeByName(name);
 }
 
 bool
@@ -1941,6 +1933,9 @@ CQChartsTreeMapHierNode::
 addChild(HierNode *child)
 {
   children_.push_back(child);
+
+  if (! nameChildren_.contains(child->name()))
+    nameChildren_.insert(child->name(), child);
 }
 
 void
@@ -1957,6 +1952,8 @@ removeChild(HierNode *child)
 
   assert(i < nc);
 
+  auto name = child->name();
+
   delete children_[i];
 
   ++i;
@@ -1965,6 +1962,18 @@ removeChild(HierNode *child)
     children_[i - 1] = children_[i];
 
   children_.pop_back();
+
+  // update name lookup (to next child with same name)
+  if (nameChildren_.value(name) == child) {
+    nameChildren_.remove(name);
+
+    for (const auto &child1 : children_) {
+      if (child1->name() == name) {
+        nameChildren_.insert(name, child1);
+        break;
+      }
+    }
+  }
 }
 
 void
@@ -2120,6 +2129,9 @@ CQChartsTreeMapHierNode::
 addNode(Node *node)
 {
   nodes_.push_back(node);
+
+  if (! nameNodes_.contains(node->name()))
+    nameNodes_.insert(node->name(), node);
 }
 
 void
@@ -2143,6 +2155,18 @@ removeNode(Node *node)
     nodes_[i - 1] = nodes_[i];
 
   nodes_.pop_back();
+
+  // update name lookup (to next node with same name)
+  if (nameNodes_.value(node->name()) == node) {
+    nameNodes_.remove(node->name());
+
+    for (const auto &node1 : nodes_) {
+      if (node1->name() == node->name()) {
+        nameNodes_.insert(node1->name(), node1);
+        break;
+      }
+    }
+  }
 }
 
 QColor
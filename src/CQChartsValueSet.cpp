@@ -715,6 +715,7 @@ addValue(const OptReal &r)
   values_.push_back(r);
 
   calculated_ = false;
+  calcValid_.store(false);
 
   // TODO: don't calc key unless needed
 
@@ -758,7 +759,7 @@ calc()
 
   outliers_.clear();
 
-  svalues_.clear();
+  sortedValues_.reset();
 
   //---
 
@@ -768,37 +769,32 @@ calc()
 
   //---
 
-  // get value to sort (skip null values)
+  // get values to sort (skip null values)
+  std::vector<double> values;
+
+  values.reserve(values_.size());
+
   for (auto &v : values_) {
     if (! v) continue;
 
-    double r = *v;
-
-    svalues_.push_back(r);
+    values.push_back(double(*v));
   }
 
-  if (svalues_.empty())
+  if (values.empty())
     return;
 
   //---
 
-  // sort values
-  std::sort(svalues_.begin(), svalues_.end());
-
-  //---
-
-  statData_.calcStatValues(svalues_);
+  // sort values (reuse shared sorted values if available)
+  if (sortedValuesFn_)
+    sortedValues_ = sortedValuesFn_(values);
+  else
+    sortedValues_ = std::make_shared<CQChartsSortedValues>(values);
 
   //---
 
-  int i = 0;
-
-  for (auto v : svalues_) {
-    if (statData_.isOutlier(v))
-      outliers_.push_back(i);
-
-    ++i;
-  }
+  statData_ = sortedValues_->statData();
+  outliers_ = sortedValues_->outliers();
 }
 
 bool
@@ -820,6 +816,7 @@ addValue(const OptInt &i)
   values_.push_back(i);
 
   calculated_ = false;
+  calcValid_.store(false);
 
   // TODO: don't calc key unless needed
 
@@ -863,7 +860,7 @@ calc()
 
   outliers_.clear();
 
-  svalues_.clear();
+  sortedValues_.reset();
 
   //---
 
@@ -873,37 +870,32 @@ calc()
 
   //---
 
-  // get value to sort (skip null values)
+  // get values to sort (skip null values)
+  std::vector<double> values;
+
+  values.reserve(values_.size());
+
   for (auto &v : values_) {
     if (! v) continue;
 
-    int i = *v;
-
-    svalues_.push_back(i);
+    values.push_back(double(*v));
   }
 
-  if (svalues_.empty())
+  if (values.empty())
     return;
 
   //---
 
-  // sort values
-  std::sort(svalues_.begin(), svalues_.end());
-
-  //---
-
-  statData_.calcStatValues(svalues_);
+  // sort values (reuse shared sorted values if available)
+  if (sortedValuesFn_)
+    sortedValues_ = sortedValuesFn_(values);
+  else
+    sortedValues_ = std::make_shared<CQChartsSortedValues>(values);
 
   //---
 
-  int i = 0;
-
-  for (auto v : svalues_) {
-    if (statData_.isOutlier(v))
-      outliers_.push_back(i);
-
-    ++i;
-  }
+  statData_ = sortedValues_->statData();
+  outliers_ = sortedValues_->outliers();
 }
 
 bool
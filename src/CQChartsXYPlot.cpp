@@ -709,6 +709,8 @@ calcRange() const
 
       if (plot_->isColumnSeries())
         plot_->headerSeriesData(sx_);
+
+      plot_->initRowColumnReals(reals_);
     }
 
     State visit(const QAbstractItemModel *, const VisitData &data) override {
@@ -728,7 +730,7 @@ calcRange() const
       // get x and y values
       double x; std::vector<double> y; QModelIndex rowInd;
 
-      if (! plot_->rowData(data, x, y, rowInd, plot_->isSkipBad()))
+      if (! plot_->rowData(data, x, y, rowInd, plot_->isSkipBad(), &reals_))
         return State::SKIP;
 
       int ny = y.size();
@@ -780,6 +782,7 @@ calcRange() const
     Reals                 sum_;
     Reals                 lastSum_;
     std::vector<double>   sx_;
+    RowColumnReals        reals_;
   };
 
   RowVisitor visitor(this);
@@ -1057,6 +1060,188 @@ createObjs(PlotObjs &objs) const
   return true;
 }
 
+bool
+CQChartsXYPlot::
+createAppendedObjs(int first, int, Range &range, PlotObjs &objs) const
+{
+  CQPerfTrace trace("CQChartsXYPlot::createAppendedObjs");
+
+  // only unstacked lines whose points do not depend on other rows
+  if (isStacked() || isCumulative() || isColumnSeries() || isMapXColumn())
+    return false;
+
+  if (isBivariateLines() || isImpulseLines() || isVectors())
+    return false;
+
+  if (pointDelta() > 1 || pointCount() > 0)
+    return false;
+
+  // mapped values and colors use range of all values
+  if (labelColumn().isValid() || symbolTypeColumn().isValid() || symbolSizeColumn().isValid() ||
+      fontSizeColumn().isValid() || colorColumn().isValid() || imageColumn().isValid())
+    return false;
+
+  if (colorType() != ColorType::AUTO)
+    return false;
+
+  if (numGroups() > 1)
+    return false;
+
+  //---
+
+  // get points for new rows
+  GroupSetIndPoly groupSetIndPoly;
+
+  createGroupSetIndPoly(groupSetIndPoly, first);
+
+  if (groupSetIndPoly.empty())
+    return true;
+
+  if (groupSetIndPoly.size() > 1)
+    return false;
+
+  int         groupInd = (*groupSetIndPoly.begin()).first;
+  const auto &setPoly  = (*groupSetIndPoly.begin()).second;
+
+  int ns = numSets();
+
+  if (int(setPoly.size()) != ns)
+    return false;
+
+  //---
+
+  // find current (last) poly line, fill under polygon and number of points for each set
+  std::vector<PolylineObj *> lineObjs   (ns);
+  std::vector<PolygonObj  *> polygonObjs(ns);
+  std::vector<int>           numPoints  (ns);
+
+  for (auto *plotObj : plotObjects()) {
+    int is = plotObj->is().i;
+
+    if (is < 0 || is >= ns)
+      continue;
+
+    if      (auto *lineObj = dynamic_cast<PolylineObj *>(plotObj))
+      lineObjs[is] = lineObj;
+    else if (auto *polygonObj = dynamic_cast<PolygonObj *>(plotObj))
+      polygonObjs[is] = polygonObj;
+    else if (dynamic_cast<PointObj *>(plotObj))
+      ++numPoints[is];
+  }
+
+  //---
+
+  // extend range (invalid points split lines so need full update)
+  auto range1 = range;
+
+  for (int is = 0; is < ns; ++is) {
+    const auto &poly = setPoly[is].poly;
+
+    for (int ip = 0; ip < poly.size(); ++ip) {
+      auto p = poly.point(ip);
+
+      if (CMathUtil::isNaN(p.x) || CMathUtil::isInf(p.x) ||
+          CMathUtil::isNaN(p.y) || CMathUtil::isInf(p.y))
+        return false;
+
+      range1.updateRange(p.x, p.y);
+    }
+  }
+
+  // fill under polygon points depend on data range
+  const auto &dataRange  = this->dataRange();
+  auto        dataRange1 = adjustDataRange(range1);
+
+  const auto &pos = fillUnderPos();
+
+  if      (pos.ytype() == CQChartsFillUnderPos::Type::MAX) {
+    if (dataRange1.ymax() != dataRange.ymax())
+      return false;
+  }
+  else if (pos.ytype() != CQChartsFillUnderPos::Type::POS) {
+    if (dataRange1.ymin() != dataRange.ymin())
+      return false;
+  }
+
+  if      (pos.xtype() == CQChartsFillUnderPos::Type::MIN) {
+    if (dataRange1.xmin() != dataRange.xmin())
+      return false;
+  }
+  else if (pos.xtype() == CQChartsFillUnderPos::Type::MAX) {
+    if (dataRange1.xmax() != dataRange.xmax())
+      return false;
+  }
+
+  // need existing line for each visible set
+  bool hidden = (ns <= 1 && isSetHidden(0));
+
+  for (int is = 0; is < ns; ++is) {
+    if (hidden || (ns > 1 && isSetHidden(is)))
+      continue;
+
+    if (setPoly[is].poly.size() && ! lineObjs[is])
+      return false;
+  }
+
+  range = range1;
+
+  //---
+
+  // append points to lines and fill under polygons and add point objects
+  auto *th = const_cast<CQChartsXYPlot *>(this);
+
+  ColorInd ig(0, 1);
+
+  for (int is = 0; is < ns; ++is) {
+    if (hidden || (ns > 1 && isSetHidden(is)))
+      continue;
+
+    const auto &poly = setPoly[is].poly;
+    const auto &inds = setPoly[is].inds;
+
+    int np = poly.size();
+    if (np == 0) continue;
+
+    lineObjs[is]->appendPoints(poly);
+
+    if (polygonObjs[is]) {
+      auto p = poly.point(np - 1);
+
+      polygonObjs[is]->appendUnderPoints(poly, calcFillUnderPos(p.x, dataRange.ymin()));
+    }
+
+    //---
+
+    int np1 = numPoints[is];
+    int np2 = np1 + np;
+
+    ColorInd is1(is, ns);
+
+    double sx, sy;
+
+    plotSymbolSize(symbolSize(), sx, sy);
+
+    for (int ip = 0; ip < np; ++ip) {
+      auto p = poly.point(ip);
+
+      BBox bbox(p.x - sx, p.y - sy, p.x + sx, p.y + sy);
+
+      auto *pointObj = th->createPointObj(groupInd, bbox, p, is1, ig, ColorInd(np1 + ip, np2));
+
+      QModelIndex xind1 = normalizeIndex(inds[ip]);
+
+      if (xind1.isValid())
+        pointObj->setModelInd(xind1);
+
+      pointObj->setLineObj(lineObjs[is]);
+
+      objs.push_back(pointObj);
+    }
+  }
+
+  return true;
+}
+
 void
 CQChartsXYPlot::
 updateColumnNames()
@@ -1072,7 +1257,7 @@ updateColumnNames()
 
 void
 CQChartsXYPlot::
-createGroupSetIndPoly(GroupSetIndPoly &groupSetIndPoly) const
+createGroupSetIndPoly(GroupSetIndPoly &groupSetIndPoly, int firstRow) const
 {
   CQPerfTrace trace("CQChartsXYPlot::createGroupSetIndPoly");
 
@@ -1085,6 +1270,8 @@ createGroupSetIndPoly(GroupSetIndPoly &groupSetIndPoly) const
 
       if (plot_->isColumnSeries())
         plot_->headerSeriesData(sx_);
+
+      plot_->initRowColumnReals(reals_);
     }
 
     State visit(const QAbstractItemModel *, const VisitData &data) override {
@@ -1105,7 +1292,7 @@ createGroupSetIndPoly(GroupSetIndPoly &groupSetIndPoly) const
       // get x and y values
       double x; std::vector<double> y; QModelIndex rowInd;
 
-      if (! plot_->rowData(data, x, y, rowInd, plot_->isSkipBad()))
+      if (! plot_->rowData(data, x, y, rowInd, plot_->isSkipBad(), &reals_))
         return State::SKIP;
 
       int ny = y.size();
@@ -1197,12 +1384,15 @@ createGroupSetIndPoly(GroupSetIndPoly &groupSetIndPoly) const
     int                   ns_;
     std::vector<double>   sx_;
     GroupSetIndPoly       groupSetPoly_;
+    RowColumnReals        reals_;
   };
 
   //---
 
   RowVisitor visitor(this);
 
+  visitor.setFirstRow(firstRow);
+
   visitModel(visitor);
 
   if      (isStacked())
@@ -1952,10 +2142,23 @@ headerSeriesData(std::vector<double> &x) const
   return true;
 }
 
+void
+CQChartsXYPlot::
+initRowColumnReals(RowColumnReals &reals) const
+{
+  if (! isMapXColumn())
+    reals.xReals = columnReals(xColumn());
+
+  int nc = yColumns().count();
+
+  for (int i = 0; i < nc; ++i)
+    reals.yReals.push_back(columnReals(yColumns().getColumn(i)));
+}
+
 bool
 CQChartsXYPlot::
 rowData(const ModelVisitor::VisitData &data, double &x, std::vector<double> &y,
-        QModelIndex &ind, bool skipBad) const
+        QModelIndex &ind, bool skipBad, const RowColumnReals *reals) const
 {
   auto *th = const_cast<CQChartsXYPlot *>(this);
 
@@ -1969,7 +2172,9 @@ rowData(const ModelVisitor::VisitData &data, double &x, std::vector<double> &y,
   ind = modelIndex(xModelInd);
 
   if (! isMapXColumn()) {
-    bool ok = modelMappedReal(xModelInd, x, isLogX(), data.row);
+    const auto *xReals = (reals ? reals->xReals.get() : nullptr);
+
+    bool ok = modelMappedReal(xReals, xModelInd, x, isLogX(), data.row);
 
     if (! ok) {
       th->addDataError(xModelInd, "Invalid X Value");
@@ -2006,9 +2211,12 @@ rowData(const ModelVisitor::VisitData &data, double &x, std::vector<double> &y,
 
     ModelIndex yModelInd(th, data.row, yColumn, data.parent);
 
+    const auto *yReals = (reals && i < int(reals->yReals.size()) ?
+                          reals->yReals[i].get() : nullptr);
+
     double y1;
 
-    bool ok = modelMappedReal(yModelInd, y1, isLogY(), data.row);
+    bool ok = modelMappedReal(yReals, yModelInd, y1, isLogY(), data.row);
 
     if (! ok) {
       y1 = CMathUtil::getNaN();
@@ -3789,6 +3997,25 @@ isOutlier(double y) const
   return statData_.isOutlier(y);
 }
 
+void
+CQChartsXYPolylineObj::
+appendPoints(const Polygon &poly)
+{
+  for (int i = 0; i < poly.size(); ++i)
+    poly_.addPoint(poly.point(i));
+
+  setRect(poly_.boundingBox());
+
+  // reset data calculated from points
+  delete smooth_;
+
+  smooth_ = nullptr;
+
+  resetBestFit();
+
+  statData_.reset();
+}
+
 void
 CQChartsXYPolylineObj::
 getObjSelectIndices(Indices &) const
@@ -4105,6 +4332,27 @@ isSelectable() const
   return plot()->isFillUnderSelectable();
 }
 
+void
+CQChartsXYPolygonObj::
+appendUnderPoints(const Polygon &poly, const Point &underPos)
+{
+  // replace last under point with new points and new last under point
+  if (under_ && poly_.size())
+    poly_.removePoint();
+
+  for (int i = 0; i < poly.size(); ++i)
+    poly_.addPoint(poly.point(i));
+
+  if (under_)
+    poly_.addPoint(underPos);
+
+  setRect(poly_.boundingBox());
+
+  delete smooth_;
+
+  smooth_ = nullptr;
+}
+
 void
 CQChartsXYPolygonObj::
 getObjSelectIndices(Indices &) const
@@ -1,4 +1,5 @@
 #include <CQCsvModel.h>
+#include <CQCsvParser.h>
 #include <CCsv.h>
 
 #include <iostream>
@@ -14,12 +15,130 @@ CQCsvModel()
   setReadOnly(true);
 }
 
+template<typename META>
+void
+CQCsvModel::
+processMeta(const META &meta)
+{
+  if (! meta.empty()) {
+    for (const auto &fields : meta) {
+      int numFields = fields.size();
+
+      // handle column data:
+      //   column <column_name> <value_type> <value>
+      if      (fields[0] == "column") {
+        std::string name, type, value;
+
+        if (numFields == 4) {
+          name  = fields[1];
+          type  = fields[2];
+          value = fields[3];
+        }
+        else {
+          std::cerr << "Invalid column data\n";
+          continue;
+        }
+
+        int icolumn = modelColumnNameToInd(name.c_str());
+
+        if      (type == "type") {
+          CQBaseModelType columnType = nameType(value.c_str());
+
+          if (columnType != CQBaseModelType::NONE)
+            setColumnType(icolumn, columnType);
+        }
+        else if (type == "min") {
+          CQBaseModelType columnType = this->columnType(icolumn);
+
+          if      (columnType == CQBaseModelType::INTEGER) {
+            bool ok;
+
+            int min = QString(value.c_str()).toInt(&ok);
+
+            if (! ok)
+              std::cerr << "Invalid integer column min '" << value << "'\n";
+
+            setColumnMin(icolumn, min);
+          }
+          else if (columnType == CQBaseModelType::REAL) {
+            bool ok;
+
+            double min = QString(value.c_str()).toDouble(&ok);
+
+            if (! ok)
+              std::cerr << "Invalid real column min '" << value << "'\n";
+
+            setColumnMin(icolumn, min);
+          }
+        }
+        else if (type == "max") {
+          CQBaseModelType columnType = this->columnType(icolumn);
+
+          if      (columnType == CQBaseModelType::INTEGER) {
+            bool ok;
+
+            int max = QString(value.c_str()).toInt(&ok);
+
+            if (! ok)
+              std::cerr << "Invalid integer column max '" << value << "'\n";
+
+            setColumnMax(icolumn, max);
+          }
+          else if (columnType == CQBaseModelType::REAL) {
+            bool ok;
+
+            double max = QString(value.c_str()).toDouble(&ok);
+
+            if (! ok)
+              std::cerr << "Invalid real column max '" << value << "'\n";
+
+            setColumnMax(icolumn, max);
+          }
+        }
+        else if (type == "title") {
+          setColumnTitle(icolumn, value.c_str());
+        }
+        else {
+          setColumnNameValue(icolumn, type.c_str(), value.c_str());
+        }
+      }
+      // handle global data
+      //   global <> <name> <value>
+      else if (fields[0] == "global") {
+        std::string name, value;
+
+        if      (numFields == 3) {
+          name  = fields[1];
+          value = fields[2];
+        }
+        else if (numFields == 4) {
+          name  = fields[1];
+          value = fields[3];
+        }
+        else {
+          std::cerr << "Invalid global data\n";
+          continue;
+        }
+
+        setNameValue(name.c_str(), value.c_str());
+      }
+      else {
+        std::cerr << "Unknown meta data '" << fields[0] << "\n";
+        continue;
+      }
+    }
+  }
+}
+
 bool
 CQCsvModel::
 load(const QString &filename)
 {
   filename_ = filename;
 
+  if (isMapped() || isProgressive() || isTail())
+    return loadMapped();
+
   //---
 
   // parse file into array of fields
@@ -42,7 +161,7 @@ load(const QString &filename)
 
   hheader_.clear();
   vheader_.clear();
-  data_   .clear();
+  clearData();
 
   //---
 
@@ -113,7 +232,7 @@ load(const QString &filename)
     if (isFirstColumnHeader())
       vheader_.push_back(vheader);
 
-    data_.push_back(cells);
+    addRow(cells);
 
     //---
 
@@ -127,7 +246,7 @@ load(const QString &filename)
   //---
 
   // expand vertical header to number of rows
-  int numRows = data_.size();
+  int numRows = numDataRows();
 
   while (int(vheader_.size()) < numRows)
     vheader_.push_back("");
@@ -146,120 +265,84 @@ load(const QString &filename)
   //---
 
   // process meta data
-  const CCsv::Data &meta = csv.meta();
-
-  if (! meta.empty()) {
-    for (const auto &fields : meta) {
-      int numFields = fields.size();
-
-      // handle column data:
-      //   column <column_name> <value_type> <value>
-      if      (fields[0] == "column") {
-        std::string name, type, value;
-
-        if (numFields == 4) {
-          name  = fields[1];
-          type  = fields[2];
-          value = fields[3];
-        }
-        else {
-          std::cerr << "Invalid column data\n";
-          continue;
-        }
-
-        int icolumn = modelColumnNameToInd(name.c_str());
+  processMeta(csv.meta());
 
-        if      (type == "type") {
-          CQBaseModelType columnType = nameType(value.c_str());
+  //---
 
-          if (columnType != CQBaseModelType::NONE)
-            setColumnType(icolumn, columnType);
-        }
-        else if (type == "min") {
-          CQBaseModelType columnType = this->columnType(icolumn);
+  // pack columns into typed storage (after meta data so column types can be used as hints)
+  if (isColumnar())
+    packColumns();
 
-          if      (columnType == CQBaseModelType::INTEGER) {
-            bool ok;
+  return true;
+}
 
-            int min = QString(value.c_str()).toInt(&ok);
+int
+CQCsvModel::
+loadTail()
+{
+  // parse rows appended to file since last load
+  std::unique_ptr<CQCsvParser> parser(createParser());
 
-            if (! ok)
-              std::cerr << "Invalid integer column min '" << value << "'\n";
+  return loadParserTail(*parser);
+}
 
-            setColumnMin(icolumn, min);
-          }
-          else if (columnType == CQBaseModelType::REAL) {
-            bool ok;
+CQCsvParser *
+CQCsvModel::
+createParser() const
+{
+  auto *parser = new CQCsvParser(filename_);
 
-            double min = QString(value.c_str()).toDouble(&ok);
+  parser->setCommentHeader  (isCommentHeader());
+  parser->setFirstLineHeader(isFirstLineHeader());
+  parser->setSeparator      (separator().toLatin1());
 
-            if (! ok)
-              std::cerr << "Invalid real column min '" << value << "'\n";
+  return parser;
+}
 
-            setColumnMin(icolumn, min);
-          }
-        }
-        else if (type == "max") {
-          CQBaseModelType columnType = this->columnType(icolumn);
+bool
+CQCsvModel::
+loadMapped()
+{
+  // map file and find records
+  auto *parser = createParser();
 
-          if      (columnType == CQBaseModelType::INTEGER) {
-            bool ok;
+  // max rows can be applied during scan if rows are not filtered
+  if (maxRows_ > 0 && ! hasFilter())
+    parser->setMaxRecords(maxRows_);
 
-            int max = QString(value.c_str()).toInt(&ok);
+  // only load complete lines if file is being appended to
+  if (isTail())
+    parser->setCompleteRecords(true);
 
-            if (! ok)
-              std::cerr << "Invalid integer column max '" << value << "'\n";
+  // load rows in batches after first batch
+  if (isProgressive())
+    return startParserLoad(parser, isFirstColumnHeader(), maxRows_, columns_);
 
-            setColumnMax(icolumn, max);
-          }
-          else if (columnType == CQBaseModelType::REAL) {
-            bool ok;
+  std::unique_ptr<CQCsvParser> parserP(parser);
 
-            double max = QString(value.c_str()).toDouble(&ok);
+  if (! parser->load())
+    return false;
 
-            if (! ok)
-              std::cerr << "Invalid real column max '" << value << "'\n";
+  //---
 
-            setColumnMax(icolumn, max);
-          }
-        }
-        else if (type == "title") {
-          setColumnTitle(icolumn, value.c_str());
-        }
-        else {
-          setColumnNameValue(icolumn, type.c_str(), value.c_str());
-        }
-      }
-      // handle global data
-      //   global <> <name> <value>
-      else if (fields[0] == "global") {
-        std::string name, value;
+  // split records into model rows (applying max rows and columns)
+  loadParserRows(*parser, isFirstColumnHeader(), maxRows_, columns_);
 
-        if      (numFields == 3) {
-          name  = fields[1];
-          value = fields[2];
-        }
-        else if (numFields == 4) {
-          name  = fields[1];
-          value = fields[3];
-        }
-        else {
-          std::cerr << "Invalid global data\n";
-          continue;
-        }
+  //---
 
-        setNameValue(name.c_str(), value.c_str());
-      }
-      else {
-        std::cerr << "Unknown meta data '" << fields[0] << "\n";
-        continue;
-      }
-    }
-  }
+  // clear column types, process meta data and pack columns
+  finishParserLoad(*parser);
 
   return true;
 }
 
+void
+CQCsvModel::
+processParserMeta(const CQCsvParser &parser)
+{
+  processMeta(parser.meta());
+}
+
 void
 CQCsvModel::
 save(std::ostream &os)
@@ -369,7 +452,8 @@ encodeVariant(const QVariant &var, const QChar &separator)
   if      (var.type() == QVariant::Double) {
     double r = var.value<double>();
 
-    str = std::to_string(r);
+    // save without loss of precision (so reload gives same value)
+    str = CQDataColumn::realToString(r).toStdString();
   }
   else if (var.type() == QVariant::Int) {
     int i = var.value<int>();
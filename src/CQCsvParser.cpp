@@ -0,0 +1,296 @@
+#include <CQCsvParser.h>
+
+#include <cstring>
+#include <cctype>
+#include <algorithm>
+
+CQCsvParser::
+CQCsvParser(const QString &filename) :
+ filename_(filename), file_(filename)
+{
+}
+
+CQCsvParser::
+~CQCsvParser()
+{
+  // closing file unmaps data
+  file_.close();
+}
+
+bool
+CQCsvParser::
+load()
+{
+  if (! open())
+    return false;
+
+  scan();
+
+  return true;
+}
+
+bool
+CQCsvParser::
+open()
+{
+  header_ .clear();
+  meta_   .clear();
+  records_.clear();
+
+  maxFields_ = 0;
+
+  pos_            = 0;
+  inMeta_         = false;
+  isFirstComment_ = true;
+  headerSet_      = false;
+  scanDone_       = false;
+
+  // header and comment header are before start position
+  if (startPos_ > 0) {
+    isFirstComment_ = false;
+    headerSet_      = true;
+  }
+
+  //---
+
+  if (! file_.open(QIODevice::ReadOnly))
+    return false;
+
+  // fail if file is now smaller than start position (truncated or replaced)
+  if (file_.size() < startPos_)
+    return false;
+
+  size_ = file_.size() - startPos_;
+
+  if (size_ > 0) {
+    auto *data = file_.map(startPos_, size_);
+
+    if (data)
+      data_ = reinterpret_cast<const char *>(data);
+    else {
+      // fallback to reading whole file (from start position)
+      if (startPos_ > 0)
+        file_.seek(startPos_);
+
+      bytes_ = file_.readAll();
+
+      data_ = bytes_.constData();
+      size_ = bytes_.size();
+    }
+  }
+
+  return true;
+}
+
+bool
+CQCsvParser::
+scan(int maxNew)
+{
+  if (scanDone_)
+    return false;
+
+  auto startsWith = [&](qint64 pos, int len, const char *str) {
+    int len1 = int(strlen(str));
+
+    return (len >= len1 && memcmp(data_ + pos, str, len1) == 0);
+  };
+
+  int numNew = 0;
+
+  while (pos_ < size_) {
+    // stop if hit maximum records
+    if (maxRecords_ > 0 && int(records_.size()) >= maxRecords_)
+      break;
+
+    // stop (and resume from here on next scan) if hit maximum new records
+    if (maxNew > 0 && numNew >= maxNew)
+      return true;
+
+    //---
+
+    qint64 start = pos_;
+
+    bool isComment = (data_[pos_] == '#');
+
+    // find end of record (newlines in quoted fields are part of record)
+    bool inQuote = false;
+    int  numSep  = 0;
+
+    while (pos_ < size_) {
+      char c = data_[pos_];
+
+      if      (c == '"' && quoted_ && ! isComment)
+        inQuote = ! inQuote;
+      else if (c == '\n' && ! inQuote)
+        break;
+      else if (c == separator_ && ! inQuote)
+        ++numSep;
+
+      ++pos_;
+    }
+
+    // skip incomplete last record (no newline) if only complete records required
+    if (pos_ >= size_ && completeRecords_) {
+      pos_ = start;
+      break;
+    }
+
+    qint64 end = pos_;
+
+    if (end > start && data_[end - 1] == '\r')
+      --end;
+
+    ++pos_; // skip newline
+
+    int len = int(end - start);
+
+    if (len == 0)
+      continue;
+
+    //---
+
+    // handle comments and meta data
+    if (isComment) {
+      if (! inMeta_) {
+        if (allowMeta_ && startsWith(start, len, "#META_DATA")) {
+          inMeta_ = true;
+        }
+        else {
+          if (isFirstComment_ && commentHeader_ && ! headerSet_) {
+            splitComment(data_ + start, len, header_);
+
+            headerSet_ = true;
+          }
+
+          isFirstComment_ = false;
+        }
+      }
+      else {
+        if (startsWith(start, len, "#END_META_DATA")) {
+          inMeta_ = false;
+        }
+        else {
+          Fields fields;
+
+          splitComment(data_ + start, len, fields);
+
+          MetaFields metaFields;
+
+          for (const auto &field : fields)
+            metaFields.push_back(field.toStdString());
+
+          if (! metaFields.empty())
+            meta_.push_back(metaFields);
+        }
+      }
+
+      continue;
+    }
+
+    //---
+
+    // handle header line
+    if (firstLineHeader_ && ! headerSet_) {
+      splitFields(data_ + start, len, header_);
+
+      headerSet_ = true;
+
+      continue;
+    }
+
+    //---
+
+    records_.push_back(Record(start, len));
+
+    maxFields_ = std::max(maxFields_, numSep + 1);
+
+    ++numNew;
+  }
+
+  scanDone_ = true;
+
+  return false;
+}
+
+void
+CQCsvParser::
+parseRecord(int i, Fields &fields) const
+{
+  fields.clear();
+
+  const auto &record = records_[i];
+
+  splitFields(data_ + record.pos, record.len, fields);
+}
+
+void
+CQCsvParser::
+splitFields(const char *str, int len, Fields &fields) const
+{
+  int i = 0;
+
+  while (true) {
+    // quoted field ("" is escaped quote, text after closing quote is appended)
+    if (quoted_ && i < len && str[i] == '"') {
+      ++i;
+
+      QByteArray bytes;
+
+      while (i < len) {
+        if (str[i] == '"') {
+          if (i + 1 < len && str[i + 1] == '"') {
+            bytes += '"';
+
+            i += 2;
+
+            continue;
+          }
+
+          ++i;
+
+          break;
+        }
+
+        bytes += str[i++];
+      }
+
+      while (i < len && str[i] != separator_)
+        bytes += str[i++];
+
+      fields.push_back(QString::fromUtf8(bytes));
+    }
+    else {
+      int j = i;
+
+      while (j < len && str[j] != separator_)
+        ++j;
+
+      fields.push_back(QString::fromUtf8(str + i, j - i));
+
+      i = j;
+    }
+
+    // next field
+    if (i < len && str[i] == separator_)
+      ++i;
+    else
+      break;
+  }
+}
+
+void
+CQCsvParser::
+splitComment(const char *str, int len, Fields &fields) const
+{
+  // skip comment char and leading space
+  int i = 0;
+
+  if (i < len && str[i] == '#')
+    ++i;
+
+  while (i < len && isspace((unsigned char) str[i]))
+    ++i;
+
+  if (i < len)
+    splitFields(str + i, len - i, fields);
+}
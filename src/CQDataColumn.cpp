@@ -0,0 +1,431 @@
+#include <CQDataColumn.h>
+#include <CQBaseModel.h>
+#include <QLocale>
+#include <limits>
+
+namespace {
+
+// check string converts to number and back without loss (so display value is unchanged)
+bool stringToInteger(const QString &str, long &i) {
+  bool ok;
+
+  i = CQBaseModel::toInt(str, ok);
+
+  return (ok && QString::number(i) == str);
+}
+
+bool stringToReal(const QString &str, double &r) {
+  bool ok;
+
+  r = CQBaseModel::toReal(str, ok);
+
+  if (! ok)
+    return false;
+
+  return (CQDataColumn::realToString(r) == str);
+}
+
+}
+
+//---
+
+void
+CQDataColumn::
+clear()
+{
+  type_ = Type::STRING;
+  size_ = 0;
+
+  std::vector<long>  ().swap(integers_);
+  std::vector<double>().swap(reals_);
+  std::vector<Code>  ().swap(codes_);
+  Strings            ().swap(strings_);
+  Variants           ().swap(variants_);
+  Nulls              ().swap(nulls_);
+
+  stringInds_.clear();
+}
+
+void
+CQDataColumn::
+reserve(int n)
+{
+  switch (type_) {
+    case Type::STRING : codes_   .reserve(n); break;
+    case Type::INTEGER: integers_.reserve(n); break;
+    case Type::REAL   : reals_   .reserve(n); break;
+    case Type::VARIANT: variants_.reserve(n); break;
+  }
+}
+
+void
+CQDataColumn::
+append(const QVariant &var)
+{
+  if      (! var.isValid())
+    appendNull();
+  else if (var.type() == QVariant::String && type_ == Type::STRING)
+    appendString(var.toString());
+  else {
+    int row = size_;
+
+    appendNull();
+
+    setValue(row, var);
+  }
+}
+
+void
+CQDataColumn::
+appendString(const QString &str)
+{
+  // keep packed numeric storage if string converts without loss
+  if      (type_ == Type::INTEGER) {
+    long i;
+
+    if      (str.isEmpty())
+      return appendNull();
+    else if (stringToInteger(str, i)) {
+      integers_.push_back(i);
+
+      if (! nulls_.empty())
+        nulls_.push_back(false);
+
+      ++size_;
+
+      return;
+    }
+  }
+  else if (type_ == Type::REAL) {
+    double r;
+
+    if      (str.isEmpty())
+      return appendNull();
+    else if (stringToReal(str, r)) {
+      reals_.push_back(r);
+
+      if (! nulls_.empty())
+        nulls_.push_back(false);
+
+      ++size_;
+
+      return;
+    }
+  }
+
+  if (type_ != Type::STRING) {
+    int row = size_;
+
+    appendNull();
+
+    setValue(row, QVariant(str));
+
+    return;
+  }
+
+  codes_.push_back(stringCode(str));
+
+  if (! nulls_.empty())
+    nulls_.push_back(false);
+
+  ++size_;
+}
+
+void
+CQDataColumn::
+appendNull()
+{
+  switch (type_) {
+    case Type::STRING : codes_   .push_back(0); break;
+    case Type::INTEGER: integers_.push_back(0); break;
+    case Type::REAL   : reals_   .push_back(0.0); break;
+    case Type::VARIANT: variants_.push_back(QVariant()); break;
+  }
+
+  ++size_;
+
+  setNull(size_ - 1, true);
+}
+
+void
+CQDataColumn::
+pack(CQBaseModelType hint)
+{
+  if (type_ != Type::STRING)
+    return;
+
+  if (hint != CQBaseModelType::NONE && hint != CQBaseModelType::INTEGER &&
+      hint != CQBaseModelType::REAL)
+    return;
+
+  //---
+
+  // convert each unique string once (empty strings are treated as null)
+  int ns = strings_.size();
+
+  if (ns == 0)
+    return;
+
+  std::vector<long>   codeIntegers(ns, 0);
+  std::vector<double> codeReals   (ns, 0.0);
+  std::vector<bool>   codeNulls   (ns, false);
+
+  bool isInteger = (hint != CQBaseModelType::REAL);
+  bool isReal    = true;
+
+  for (int i = 0; i < ns; ++i) {
+    const auto &str = strings_[i];
+
+    if (str.isEmpty()) {
+      codeNulls[i] = true;
+      continue;
+    }
+
+    if (isInteger && ! stringToInteger(str, codeIntegers[i]))
+      isInteger = false;
+
+    if (! isInteger) {
+      if (! stringToReal(str, codeReals[i])) {
+        isReal = false;
+        break;
+      }
+    }
+  }
+
+  if (! isInteger && ! isReal)
+    return;
+
+  // if integer check failed part way through then earlier reals are not set
+  if (! isInteger) {
+    for (int i = 0; i < ns; ++i) {
+      if (! codeNulls[i])
+        (void) stringToReal(strings_[i], codeReals[i]);
+    }
+  }
+
+  //---
+
+  // remap codes to values
+  Nulls nulls;
+
+  bool anyNull = ! nulls_.empty();
+
+  for (int i = 0; ! anyNull && i < ns; ++i)
+    anyNull = codeNulls[i];
+
+  if (anyNull)
+    nulls.resize(size_, false);
+
+  if (isInteger) {
+    integers_.resize(size_);
+
+    for (int r = 0; r < size_; ++r) {
+      auto code = codes_[r];
+
+      if (isNull(r) || codeNulls[code])
+        nulls[r] = true;
+      else
+        integers_[r] = codeIntegers[code];
+    }
+
+    type_ = Type::INTEGER;
+  }
+  else {
+    reals_.resize(size_);
+
+    for (int r = 0; r < size_; ++r) {
+      auto code = codes_[r];
+
+      if (isNull(r) || codeNulls[code])
+        nulls[r] = true;
+      else
+        reals_[r] = codeReals[code];
+    }
+
+    type_ = Type::REAL;
+  }
+
+  nulls_.swap(nulls);
+
+  std::vector<Code>().swap(codes_);
+  Strings          ().swap(strings_);
+
+  stringInds_.clear();
+}
+
+QString
+CQDataColumn::
+realToString(double r)
+{
+  // shortest string which converts back to the same value
+#if QT_VERSION >= 0x050700
+  return QString::number(r, 'g', QLocale::FloatingPointShortest);
+#else
+  QString str = QString::number(r);
+
+  if (str.toDouble() != r)
+    str = QString::number(r, 'g', 17);
+
+  return str;
+#endif
+}
+
+QVariant
+CQDataColumn::
+integerValue(long i)
+{
+  // use int variant when value fits (as for string to integer conversion)
+  if (i >= std::numeric_limits<int>::min() && i <= std::numeric_limits<int>::max())
+    return QVariant(int(i));
+
+  return QVariant(qlonglong(i));
+}
+
+QVariant
+CQDataColumn::
+value(int row) const
+{
+  if (row < 0 || row >= size_ || isNull(row))
+    return QVariant();
+
+  switch (type_) {
+    case Type::STRING : return QVariant(strings_[codes_[row]]);
+    case Type::INTEGER: return integerValue(integers_[row]);
+    case Type::REAL   : return QVariant(reals_[row]);
+    case Type::VARIANT: return variants_[row];
+  }
+
+  return QVariant();
+}
+
+void
+CQDataColumn::
+setValue(int row, const QVariant &var)
+{
+  if (row < 0 || row >= size_)
+    return;
+
+  if (! var.isValid()) {
+    setNull(row, true);
+    return;
+  }
+
+  //---
+
+  // store in existing type if value is compatible
+  if      (type_ == Type::STRING) {
+    if (var.type() == QVariant::String) {
+      codes_[row] = stringCode(var.toString());
+
+      setNull(row, false);
+
+      return;
+    }
+  }
+  else if (type_ == Type::INTEGER) {
+    if (var.type() == QVariant::Int || var.type() == QVariant::LongLong) {
+      integers_[row] = long(var.toLongLong());
+
+      setNull(row, false);
+
+      return;
+    }
+  }
+  else if (type_ == Type::REAL) {
+    if (var.type() == QVariant::Double) {
+      reals_[row] = var.toDouble();
+
+      setNull(row, false);
+
+      return;
+    }
+  }
+
+  //---
+
+  // fallback to variant storage
+  toVariant();
+
+  variants_[row] = var;
+
+  setNull(row, false);
+}
+
+size_t
+CQDataColumn::
+memUsage() const
+{
+  size_t n = sizeof(*this);
+
+  n += integers_.capacity()*sizeof(long);
+  n += reals_   .capacity()*sizeof(double);
+  n += codes_   .capacity()*sizeof(Code);
+  n += variants_.capacity()*sizeof(QVariant);
+  n += nulls_   .capacity()/8;
+
+  for (const auto &str : strings_)
+    n += sizeof(QString) + str.capacity()*sizeof(QChar);
+
+  return n;
+}
+
+CQDataColumn::Code
+CQDataColumn::
+stringCode(const QString &str)
+{
+  auto p = stringInds_.find(str);
+
+  if (p != stringInds_.end())
+    return p.value();
+
+  Code code = strings_.size();
+
+  strings_.push_back(str);
+
+  stringInds_.insert(str, code);
+
+  return code;
+}
+
+void
+CQDataColumn::
+setNull(int row, bool b)
+{
+  if (nulls_.empty()) {
+    if (! b)
+      return;
+
+    nulls_.resize(size_, false);
+  }
+
+  if (int(nulls_.size()) < size_)
+    nulls_.resize(size_, false);
+
+  nulls_[row] = b;
+}
+
+void
+CQDataColumn::
+toVariant()
+{
+  if (type_ == Type::VARIANT)
+    return;
+
+  Variants variants;
+
+  variants.resize(size_);
+
+  for (int r = 0; r < size_; ++r)
+    variants[r] = value(r);
+
+  variants_.swap(variants);
+
+  type_ = Type::VARIANT;
+
+  std::vector<long>  ().swap(integers_);
+  std::vector<double>().swap(reals_);
+  std::vector<Code>  ().swap(codes_);
+  Strings            ().swap(strings_);
+
+  stringInds_.clear();
+}
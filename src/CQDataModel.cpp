@@ -1,6 +1,11 @@
 #include <CQDataModel.h>
 #include <CQModelDetails.h>
+#include <CQCsvParser.h>
+#include <QFile>
+#include <QTimer>
 #include <iostream>
+#include <future>
+#include <thread>
 
 CQDataModel::
 CQDataModel()
@@ -30,6 +35,9 @@ void
 CQDataModel::
 init(int numCols, int numRows)
 {
+  if (isPacked())
+    unpackColumns();
+
   hheader_.resize(numCols);
   vheader_.resize(numRows);
 
@@ -39,6 +47,235 @@ init(int numCols, int numRows)
     data_[i].resize(numCols);
 }
 
+void
+CQDataModel::
+setRowsData(int numCols, std::vector<std::vector<QVariant>> &&rows)
+{
+  beginResetModel();
+
+  clearData();
+
+  int numRows = int(rows.size());
+
+  hheader_.resize(numCols);
+  vheader_.resize(numRows);
+
+  data_ = std::move(rows);
+
+  for (auto &cells : data_)
+    cells.resize(numCols);
+
+  if (isColumnar())
+    moveRowsToColumns();
+
+  endResetModel();
+}
+
+//------
+
+void
+CQDataModel::
+setColumnar(bool b)
+{
+  if (b == columnar_)
+    return;
+
+  columnar_ = b;
+
+  // switch storage of existing data
+  if (! columnar_ && isPacked())
+    unpackColumns();
+}
+
+int
+CQDataModel::
+numDataRows() const
+{
+  if (isPacked())
+    return numColRows_;
+
+  return data_.size();
+}
+
+void
+CQDataModel::
+addRow(const Cells &cells)
+{
+  if (! isColumnar() && ! isPacked()) {
+    data_.push_back(cells);
+    return;
+  }
+
+  // move any existing row data into columns
+  if (! isPacked())
+    moveRowsToColumns();
+
+  //---
+
+  // add new columns (null for previous rows)
+  int nc = std::max(int(cells.size()), int(hheader_.size()));
+
+  while (int(columns_.size()) < nc) {
+    columns_.emplace_back();
+
+    auto &column = columns_.back();
+
+    for (int r = 0; r < numColRows_; ++r)
+      column.appendNull();
+  }
+
+  //---
+
+  // add cells to columns (null for missing cells)
+  nc = columns_.size();
+
+  int nc1 = cells.size();
+
+  for (int c = 0; c < nc; ++c) {
+    if (c < nc1)
+      columns_[c].append(cells[c]);
+    else
+      columns_[c].appendNull();
+  }
+
+  ++numColRows_;
+}
+
+void
+CQDataModel::
+clearData()
+{
+  data_.clear();
+
+  columns_.clear();
+
+  numColRows_ = 0;
+  packed_     = false;
+}
+
+QVariant
+CQDataModel::
+cellValue(int row, int column) const
+{
+  if (isPacked()) {
+    if (column < 0 || column >= int(columns_.size()))
+      return QVariant();
+
+    return columns_[column].value(row);
+  }
+
+  const Cells &cells = data_[row];
+
+  if (column < 0 || column >= int(cells.size()))
+    return QVariant();
+
+  return cells[column];
+}
+
+CQDataModel::Cells
+CQDataModel::
+rowCells(int row) const
+{
+  if (! isPacked())
+    return data_[row];
+
+  int nc = columns_.size();
+
+  Cells cells;
+
+  cells.resize(nc);
+
+  for (int c = 0; c < nc; ++c)
+    cells[c] = columns_[c].value(row);
+
+  return cells;
+}
+
+void
+CQDataModel::
+moveRowsToColumns()
+{
+  Data data;
+
+  std::swap(data, data_);
+
+  packed_ = true;
+
+  int nc = hheader_.size();
+
+  for (const auto &cells : data)
+    nc = std::max(nc, int(cells.size()));
+
+  columns_.resize(nc);
+
+  for (auto &column : columns_)
+    column.reserve(data.size());
+
+  for (auto &cells : data) {
+    for (int c = 0; c < nc; ++c) {
+      if (c < int(cells.size()))
+        columns_[c].append(cells[c]);
+      else
+        columns_[c].appendNull();
+    }
+
+    ++numColRows_;
+
+    Cells().swap(cells);
+  }
+}
+
+void
+CQDataModel::
+packColumns()
+{
+  if (! isPacked())
+    moveRowsToColumns();
+
+  //---
+
+  // pack each column using assigned type (if any) as hint
+  int nc = columns_.size();
+
+  for (int c = 0; c < nc; ++c) {
+    const ColumnData &columnData = getColumnData(c);
+
+    columns_[c].pack(columnData.type);
+  }
+}
+
+void
+CQDataModel::
+unpackColumns()
+{
+  if (! isPacked())
+    return;
+
+  Data data;
+
+  data.resize(numColRows_);
+
+  for (int r = 0; r < numColRows_; ++r)
+    data[r] = rowCells(r);
+
+  clearData();
+
+  std::swap(data, data_);
+}
+
+const CQDataColumn *
+CQDataModel::
+dataColumn(int column) const
+{
+  if (! isPacked())
+    return nullptr;
+
+  if (column < 0 || column >= int(columns_.size()))
+    return nullptr;
+
+  return &columns_[column];
+}
+
 //------
 
 void
@@ -152,7 +389,7 @@ rowCount(const QModelIndex &parent) const
   if (parent.isValid())
     return 0;
 
-  return data_.size();
+  return numDataRows();
 }
 
 QVariant
@@ -289,14 +526,12 @@ data(const QModelIndex &index, int role) const
   int r = index.row();
   int c = index.column();
 
-  int nr = data_.size();
+  int nr = numDataRows();
 
   if (r < 0 || r >= nr)
     return QVariant();
 
-  const Cells &cells = data_[r];
-
-  int nc = int(cells.size());
+  int nc = (isPacked() ? int(columns_.size()) : int(data_[r].size()));
 
   if (c < 0 || c >= nc)
     return QVariant();
@@ -334,7 +569,7 @@ data(const QModelIndex &index, int role) const
   //---
 
   if      (role == Qt::DisplayRole) {
-    return cells[c];
+    return cellValue(r, c);
   }
   else if (role == Qt::EditRole) {
     CQBaseModelType type = columnType(c);
@@ -348,7 +583,7 @@ data(const QModelIndex &index, int role) const
     }
 
     // not cached so get raw value
-    var = cells[c];
+    var = cellValue(r, c);
 
     // column has no type or already correct type then just return
     if (type == CQBaseModelType::NONE || isSameType(var, type))
@@ -366,7 +601,7 @@ data(const QModelIndex &index, int role) const
     return var;
   }
   else if (role == Qt::ToolTipRole) {
-    return cells[c];
+    return cellValue(r, c);
   }
   else if (role == int(CQBaseModelRole::RawValue) ||
            role == int(CQBaseModelRole::IntermediateValue) ||
@@ -378,7 +613,7 @@ data(const QModelIndex &index, int role) const
       return var;
 
     if (role == int(CQBaseModelRole::RawValue)) {
-      return cells[c];
+      return cellValue(r, c);
     }
 
     return QVariant();
@@ -410,16 +645,23 @@ setData(const QModelIndex &index, const QVariant &value, int role)
   int r = index.row();
   int c = index.column();
 
-  int nr = data_.size();
+  int nr = numDataRows();
 
-  if (r >= nr)
+  if (r < 0 || r >= nr)
     return false;
 
-  Cells &cells = data_[r];
+  int nc = (isPacked() ? int(columns_.size()) : int(data_[r].size()));
 
-  if (c >= int(cells.size()))
+  if (c < 0 || c >= nc)
     return false;
 
+  auto setCellValue = [&](const QVariant &value) {
+    if (isPacked())
+      columns_[c].setValue(r, value);
+    else
+      data_[r][c] = value;
+  };
+
   //---
 
   ColumnData &columnData = getColumnData(c);
@@ -453,14 +695,14 @@ setData(const QModelIndex &index, const QVariant &value, int role)
   if      (role == Qt::DisplayRole) {
     //CQBaseModelType type = columnType(c);
 
-    cells[c] = value;
+    setCellValue(value);
 
     emit dataChanged(index, index, QVector<int>(1, role));
   }
   else if (role == Qt::EditRole) {
     //CQBaseModelType type = columnType(c);
 
-    cells[c] = value;
+    setCellValue(value);
 
     clearRowRoleValue(r, int(CQBaseModelRole::RawValue));
     clearRowRoleValue(r, int(CQBaseModelRole::IntermediateValue));
@@ -608,6 +850,29 @@ applyFilterColumns(const QStringList &columns)
   // remap horizontal header and row data
   hheader_.clear(); hheader_.resize(nc2);
 
+  // column storage just reorders columns
+  if (isPacked()) {
+    Columns columns;
+
+    std::swap(columns, columns_);
+
+    columns_.resize(nc2);
+
+    for (int c = 0; c < nc1; ++c) {
+      int c1 = columnMap[c];
+
+      if (c1 < 0 || c1 >= nc2)
+        continue;
+
+      hheader_[c1] = hheader[c];
+
+      if (c < int(columns.size()))
+        std::swap(columns_[c1], columns[c]);
+    }
+
+    return;
+  }
+
   int nr = data.size();
 
   for (int r = 0; r < nr; ++r) {
@@ -627,3 +892,538 @@ applyFilterColumns(const QStringList &columns)
     }
   }
 }
+
+//------
+
+void
+CQDataModel::
+loadParserRows(const CQCsvParser &parser, bool firstColumnHeader, int maxRows,
+               const QStringList &columns)
+{
+  initParserRows(parser, firstColumnHeader, maxRows, columns);
+
+  //---
+
+  // split records into cells in blocks and add rows (in file order)
+  int nr = parser.numRecords();
+
+  const int blockSize = 65536;
+
+  for (int r1 = 0; r1 < nr; r1 += blockSize) {
+    Data  rows;
+    Cells vheaders;
+
+    parseParserRows(parser, r1, std::min(r1 + blockSize, nr), rows, vheaders);
+
+    addParserRows(rows, vheaders);
+
+    if (parserLoadData_.maxRows > 0 && parserLoadData_.numRows >= parserLoadData_.maxRows)
+      break;
+  }
+
+  //---
+
+  // expand vertical header to number of rows
+  int numRows = numDataRows();
+
+  while (int(vheader_.size()) < numRows)
+    vheader_.push_back("");
+}
+
+void
+CQDataModel::
+initParserRows(const CQCsvParser &parser, bool firstColumnHeader, int maxRows,
+               const QStringList &columns)
+{
+  hheader_.clear();
+  vheader_.clear();
+  clearData();
+
+  parserLoadData_ = ParserLoadData();
+
+  parserLoadData_.firstColumnHeader = firstColumnHeader;
+  parserLoadData_.maxRows           = maxRows;
+
+  //---
+
+  // add header to model (skip vertical header column)
+  int ih = 0;
+
+  for (const auto &f : parser.header()) {
+    if (ih > 0 || ! firstColumnHeader)
+      hheader_.push_back(f);
+
+    ++ih;
+  }
+
+  // expand horizontal header to max number of columns
+  int numColumns = parser.maxFields();
+
+  if (firstColumnHeader)
+    --numColumns;
+
+  while (int(hheader_.size()) < numColumns)
+    hheader_.push_back("");
+
+  //---
+
+  // get source column for each output column (if columns specified)
+  auto &columnInds = parserLoadData_.columnInds;
+
+  if (columns.length()) {
+    int nc = hheader_.size();
+
+    for (const auto &name : columns) {
+      // get index for matching column name
+      int ind = -1;
+
+      for (int c = 0; c < nc; ++c) {
+        if (hheader_[c] == name) {
+          ind = c;
+          break;
+        }
+      }
+
+      // if name not found, try and convert column name to number
+      if (ind == -1) {
+        bool ok;
+
+        int ind1 = name.toInt(&ok);
+
+        if (ok && ind1 >= 0 && ind1 < nc)
+          ind = ind1;
+      }
+
+      if (ind == -1) {
+        std::cerr << "Invalid column name '" << name.toStdString() << "'\n";
+        continue;
+      }
+
+      columnInds.push_back(ind);
+    }
+  }
+
+  // filter regexps are not thread safe and need all columns so are applied when rows are added
+  // (filter columns are from the full header so init before it is remapped)
+  parserLoadData_.filtered = hasFilter();
+
+  if (parserLoadData_.filtered && ! isFilterInited())
+    initFilter();
+
+  // remap horizontal header to selected columns
+  if (! columnInds.empty()) {
+    Cells hheader;
+
+    for (const auto &ind : columnInds)
+      hheader.push_back(hheader_[ind]);
+
+    std::swap(hheader_, hheader);
+  }
+}
+
+void
+CQDataModel::
+parseParserRows(const CQCsvParser &parser, int r1, int r2, Data &rows, Cells &vheaders)
+{
+  const auto &loadData = parserLoadData_;
+
+  const auto &columnInds = loadData.columnInds;
+
+  auto selectColumns = [&](Cells &cells) {
+    Cells cells1;
+
+    cells1.resize(columnInds.size());
+
+    int nc = cells.size();
+
+    for (std::size_t c = 0; c < columnInds.size(); ++c) {
+      int ind = columnInds[c];
+
+      if (ind < nc)
+        cells1[c] = cells[ind];
+    }
+
+    std::swap(cells, cells1);
+  };
+
+  //---
+
+  // split records into cells in parallel
+  using Fields = CQCsvParser::Fields;
+
+  int nb = r2 - r1;
+
+  Data  block    (nb);
+  Cells vheaders1(loadData.firstColumnHeader ? nb : 0);
+
+  auto parseRange = [&](int i1, int i2) {
+    Fields fields;
+
+    for (int i = i1; i < i2; ++i) {
+      parser.parseRecord(r1 + i, fields);
+
+      auto &cells = block[i];
+
+      int nf = fields.size();
+      int f1 = 0;
+
+      if (loadData.firstColumnHeader && nf > 0) {
+        vheaders1[i] = fields[0];
+
+        f1 = 1;
+      }
+
+      cells.reserve(nf - f1);
+
+      for (int f = f1; f < nf; ++f)
+        cells.push_back(fields[f]);
+
+      if (! loadData.filtered && ! columnInds.empty())
+        selectColumns(cells);
+    }
+  };
+
+  int numThreads = std::max(int(std::thread::hardware_concurrency()), 1);
+
+  const int minThreadRows = 1024;
+
+  if (numThreads > 1 && nb > minThreadRows) {
+    std::vector<std::future<void>> futures;
+
+    int n = (nb + numThreads - 1)/numThreads;
+
+    for (int i1 = 0; i1 < nb; i1 += n)
+      futures.push_back(std::async(std::launch::async, parseRange, i1, std::min(i1 + n, nb)));
+
+    for (auto &future : futures)
+      future.wait();
+  }
+  else
+    parseRange(0, nb);
+
+  //---
+
+  // filter rows (sequentially) and apply max rows
+  rows    .reserve(nb);
+  vheaders.reserve(vheaders1.size());
+
+  int numRows = loadData.numRows;
+
+  for (int i = 0; i < nb; ++i) {
+    if (loadData.maxRows > 0 && numRows >= loadData.maxRows)
+      break;
+
+    auto &cells = block[i];
+
+    // skip row if not accepted by model
+    if (loadData.filtered) {
+      if (! acceptsRow(cells))
+        continue;
+
+      if (! columnInds.empty())
+        selectColumns(cells);
+    }
+
+    if (loadData.firstColumnHeader)
+      vheaders.push_back(vheaders1[i]);
+
+    rows.push_back(std::move(cells));
+
+    ++numRows;
+  }
+}
+
+void
+CQDataModel::
+addParserRows(Data &rows, Cells &vheaders)
+{
+  // add row vertical header and cells to model
+  for (auto &vheader : vheaders)
+    vheader_.push_back(std::move(vheader));
+
+  for (auto &cells : rows) {
+    if (isColumnar())
+      addRow(cells);
+    else
+      data_.push_back(std::move(cells));
+  }
+
+  parserLoadData_.numRows += rows.size();
+}
+
+void
+CQDataModel::
+finishParserLoad(const CQCsvParser &parser)
+{
+  // clear column types
+  resetColumnTypes();
+
+  //---
+
+  // process meta data
+  processParserMeta(parser);
+
+  //---
+
+  // pack columns into typed storage (after meta data so column types can be used as hints)
+  if (isColumnar())
+    packColumns();
+
+  //---
+
+  // save end of parsed data for load of appended data
+  setParserPos(parser.scanPos());
+}
+
+int
+CQDataModel::
+insertParserRows(const CQCsvParser &parser, int r1, int r2)
+{
+  // add any new columns (if all columns used)
+  if (parserLoadData_.columnInds.empty()) {
+    int nc1 = hheader_.size();
+    int nc2 = parser.maxFields();
+
+    if (parserLoadData_.firstColumnHeader)
+      --nc2;
+
+    if (nc2 > nc1) {
+      beginInsertColumns(QModelIndex(), nc1, nc2 - 1);
+
+      while (int(hheader_.size()) < nc2)
+        hheader_.push_back("");
+
+      endInsertColumns();
+    }
+  }
+
+  //---
+
+  // split records and add to model
+  Data  rows;
+  Cells vheaders;
+
+  parseParserRows(parser, r1, r2, rows, vheaders);
+
+  int numNew = int(rows.size());
+
+  if (numNew == 0)
+    return 0;
+
+  int nr = numDataRows();
+
+  // pad vertical header for previous rows
+  if (! vheaders.empty()) {
+    while (int(vheader_.size()) < nr)
+      vheader_.push_back("");
+  }
+
+  beginInsertRows(QModelIndex(), nr, nr + numNew - 1);
+
+  addParserRows(rows, vheaders);
+
+  // pad vertical header for new rows
+  if (! vheader_.empty()) {
+    int numRows = numDataRows();
+
+    while (int(vheader_.size()) < numRows)
+      vheader_.push_back("");
+  }
+
+  endInsertRows();
+
+  return numNew;
+}
+
+int
+CQDataModel::
+loadParserTail(CQCsvParser &parser)
+{
+  // need previous mapped load
+  if (isLoading() || parserPos_ <= 0)
+    return -1;
+
+  // previously parsed data must be unchanged (file only appended to, not replaced)
+  if (parserCheckData(parserPos_) != parserCheck_)
+    return -1;
+
+  // scan complete records after end of previously parsed data
+  parser.setStartPos       (parserPos_);
+  parser.setCompleteRecords(true);
+
+  if (! parser.open())
+    return -1;
+
+  parser.scan();
+
+  setParserPos(parser.scanPos());
+
+  //---
+
+  // split new records and add to end of model
+  return insertParserRows(parser, 0, parser.numRecords());
+}
+
+void
+CQDataModel::
+setParserPos(qint64 pos)
+{
+  parserPos_   = pos;
+  parserCheck_ = parserCheckData(pos);
+}
+
+QByteArray
+CQDataModel::
+parserCheckData(qint64 pos) const
+{
+  // compare block at start of file and block before end of parsed data
+  const qint64 blockSize = 4096;
+
+  QFile file(filename_);
+
+  if (pos <= 0 || ! file.open(QIODevice::ReadOnly) || file.size() < pos)
+    return QByteArray();
+
+  QByteArray data = file.read(std::min(blockSize, pos));
+
+  qint64 pos1 = std::max(pos - blockSize, qint64(data.size()));
+
+  if (pos1 < pos && file.seek(pos1))
+    data += file.read(pos - pos1);
+
+  return data;
+}
+
+//------
+
+bool
+CQDataModel::
+startParserLoad(CQCsvParser *parser, bool firstColumnHeader, int maxRows,
+                const QStringList &columns)
+{
+  parser_ = ParserP(parser);
+
+  if (! parser_->open()) {
+    parser_.reset();
+    return false;
+  }
+
+  //---
+
+  // scan and add first batch of rows so model is usable
+  const int batchSize = 65536;
+
+  parser_->scan(batchSize);
+
+  initParserRows(*parser_, firstColumnHeader, maxRows, columns);
+
+  parserLoadData_.numRecords = parser_->numRecords();
+
+  Data  rows;
+  Cells vheaders;
+
+  parseParserRows(*parser_, 0, parser_->numRecords(), rows, vheaders);
+
+  addParserRows(rows, vheaders);
+
+  // clear column types and process meta data (normally at start of file)
+  resetColumnTypes();
+
+  processParserMeta(*parser_);
+
+  //---
+
+  // load remaining rows in batches from event loop
+  if (parserLoadDone())
+    finishProgressiveLoad();
+  else
+    QTimer::singleShot(0, this, SLOT(progressiveLoadSlot()));
+
+  return true;
+}
+
+bool
+CQDataModel::
+parserLoadDone() const
+{
+  if (! parser_)
+    return true;
+
+  const auto &loadData = parserLoadData_;
+
+  if (loadData.maxRows > 0 && loadData.numRows >= loadData.maxRows)
+    return true;
+
+  return (parser_->isScanDone() && loadData.numRecords >= parser_->numRecords());
+}
+
+void
+CQDataModel::
+progressiveLoadSlot()
+{
+  if (! parser_)
+    return;
+
+  //---
+
+  // scan next batch of records (batch grows with rows loaded to limit number of
+  // updates on large files)
+  const int minBatchSize = 65536;
+  const int maxBatchSize = 1048576;
+
+  int r1 = parserLoadData_.numRecords;
+
+  int batchSize = std::min(std::max(r1, minBatchSize), maxBatchSize);
+
+  parser_->scan(batchSize);
+
+  int r2 = parser_->numRecords();
+
+  parserLoadData_.numRecords = r2;
+
+  //---
+
+  // split new records and add to model
+  insertParserRows(*parser_, r1, r2);
+
+  //---
+
+  if (parserLoadDone())
+    finishProgressiveLoad();
+  else
+    QTimer::singleShot(0, this, SLOT(progressiveLoadSlot()));
+}
+
+void
+CQDataModel::
+finishProgressiveLoad()
+{
+  if (! parser_)
+    return;
+
+  // expand vertical header to number of rows
+  int numRows = numDataRows();
+
+  while (int(vheader_.size()) < numRows)
+    vheader_.push_back("");
+
+  //---
+
+  // pack columns into typed storage (column types and meta data were processed on first
+  // batch and values are unchanged)
+  if (isColumnar()) {
+    emit layoutAboutToBeChanged();
+
+    packColumns();
+
+    emit layoutChanged();
+  }
+
+  //---
+
+  setParserPos(parser_->scanPos());
+
+  parser_.reset();
+
+  emit loadFinished();
+}
@@ -1,5 +1,6 @@
 #include <CQFoldedModel.h>
 #include <CQBaseModel.h>
+#include <CQGroupBy.h>
 #include <cassert>
 #include <iostream>
 
@@ -284,17 +285,45 @@ foldNode(Node *parent, int depth)
   // fold rows at column
   int nr = model->rowCount(parent->sourceInd);
 
+  // group leaf rows by integer coded bucket (non-leaf rows excluded)
+  CQGroupBy::KeyCoder<int> bucketCoder;
+
+  CQGroupBy::Codes codes(nr, -1);
+  CQGroupBy::Codes buckets(nr);
+
   for (int r = 0; r < nr; ++r) {
-    // if leaf node then add to folded rows for this parent node
     QModelIndex ind = model->index(r, 0, parent->sourceInd);
 
-    if (! model->hasChildren(ind)) {
-      // get value for column
-      QModelIndex ind = model->index(r, foldColumn(), parent->sourceInd);
+    if (model->hasChildren(ind))
+      continue;
 
-      QVariant var = model->data(ind, Qt::DisplayRole);
+    // get value for column
+    QModelIndex ind1 = model->index(r, foldColumn(), parent->sourceInd);
 
-      int bucket = bucketer_.bucket(var);
+    QVariant var = model->data(ind1, Qt::DisplayRole);
+
+    buckets[r] = bucketer_.bucket(var);
+    codes  [r] = bucketCoder.code(buckets[r]);
+  }
+
+  CQGroupBy groupBy(nr);
+
+  groupBy.addKeyColumn(codes, bucketCoder.numCodes());
+
+  groupBy.calc();
+
+  //---
+
+  // add bucket node (with all its rows) at first row of group and child node for
+  // non-leaf rows (keeps row order of nodes)
+  for (int r = 0; r < nr; ++r) {
+    int g = groupBy.rowGroup(r);
+
+    if (g >= 0) {
+      if (groupBy.groupFirstRow(g) != r)
+        continue;
+
+      int bucket = buckets[r];
 
       bool isNew = false;
 
@@ -305,9 +334,16 @@ foldNode(Node *parent, int depth)
         node->str    = bucketer_.bucketName(bucket);
       }
 
-      node->addSourceRow(r);
+      int n = groupBy.groupNumRows(g);
+
+      node->sourceRows.reserve(node->sourceRows.size() + n);
+
+      for (int i = 0; i < n; ++i)
+        node->addSourceRow(groupBy.groupRow(g, i));
     }
     else {
+      QModelIndex ind = model->index(r, 0, parent->sourceInd);
+
       QString str = model->data(ind, Qt::DisplayRole).toString();
 
       Node *child = new Node(parent, ind);
@@ -0,0 +1,300 @@
+#include <CQGroupBy.h>
+
+#include <cassert>
+#include <cstdint>
+#include <future>
+#include <thread>
+
+CQGroupBy::
+CQGroupBy(int numRows) :
+ nr_(numRows)
+{
+}
+
+void
+CQGroupBy::
+addKeyColumn(const Codes &codes, int numCodes)
+{
+  assert(int(codes.size()) == nr_);
+
+  keyColumns_.push_back(codes);
+  numCodes_  .push_back(numCodes);
+}
+
+int
+CQGroupBy::
+addValueColumn(const Values &values)
+{
+  assert(int(values.size()) == nr_);
+
+  valueCols_.push_back(values);
+
+  return int(valueCols_.size()) - 1;
+}
+
+int
+CQGroupBy::
+addAggregate(const Aggregate &aggregate)
+{
+  assert(aggregate.column < int(valueCols_.size()));
+
+  aggregates_.push_back(aggregate);
+
+  return int(aggregates_.size()) - 1;
+}
+
+void
+CQGroupBy::
+calc()
+{
+  calcGroups();
+
+  //---
+
+  // streaming aggregates (per group and value column)
+  int nv = int(valueCols_.size());
+
+  Accums accums;
+
+  calcAccums(accums);
+
+  //---
+
+  // aggregate values
+  int na = int(aggregates_.size());
+
+  aggValues_.assign(size_t(ng_)*na, 0.0);
+
+  Values values;
+
+  for (int g = 0; g < ng_; ++g) {
+    for (int ia = 0; ia < na; ++ia) {
+      const auto &aggregate = aggregates_[ia];
+
+      double &value = aggValues_[size_t(g)*na + ia];
+
+      if (aggregate.column < 0) {
+        value = groupNumRows(g);
+        continue;
+      }
+
+      const auto &accum = accums[size_t(g)*nv + aggregate.column];
+
+      switch (aggregate.type) {
+        case AggType::COUNT   : value = accum.count; break;
+        case AggType::SUM     : value = accum.sum; break;
+        case AggType::MEAN    : value = (accum.count > 0 ? accum.sum/accum.count : NAN); break;
+        case AggType::MIN     : value = accum.min; break;
+        case AggType::MAX     : value = accum.max; break;
+        case AggType::QUANTILE: value = calcQuantile(g, aggregate, values); break;
+      }
+    }
+  }
+}
+
+void
+CQGroupBy::
+calcGroups()
+{
+  // combine key columns one at a time into dense group ids (in order of first row).
+  // Previous ids and next codes are both less than the number of rows so the
+  // combined key (id*numCodes + code) always fits in 64 bits.
+  rowGroups_.assign(nr_, 0);
+
+  ng_ = (nr_ > 0 ? 1 : 0);
+
+  int nk = int(keyColumns_.size());
+
+  for (int ik = 0; ik < nk; ++ik) {
+    const auto &codes = keyColumns_[ik];
+
+    auto nc = uint64_t(std::max(numCodes_[ik], 1));
+
+    uint64_t nkey = uint64_t(ng_)*nc;
+
+    int ng = 0;
+
+    // small key range uses array lookup, otherwise hash map
+    const uint64_t maxDirectKeys = std::max(uint64_t(4)*nr_, uint64_t(1 << 16));
+
+    if (nkey <= maxDirectKeys) {
+      Codes keyGroup(nkey, -1);
+
+      for (int r = 0; r < nr_; ++r) {
+        int &g = rowGroups_[r];
+        if (g < 0) continue;
+
+        if (codes[r] < 0) { g = -1; continue; }
+
+        int &g1 = keyGroup[uint64_t(g)*nc + codes[r]];
+
+        if (g1 < 0)
+          g1 = ng++;
+
+        g = g1;
+      }
+    }
+    else {
+      std::unordered_map<uint64_t, int> keyGroup;
+
+      keyGroup.reserve(nr_);
+
+      for (int r = 0; r < nr_; ++r) {
+        int &g = rowGroups_[r];
+        if (g < 0) continue;
+
+        if (codes[r] < 0) { g = -1; continue; }
+
+        auto p = keyGroup.insert(std::make_pair(uint64_t(g)*nc + codes[r], ng));
+
+        if (p.second)
+          ++ng;
+
+        g = (*p.first).second;
+      }
+    }
+
+    ng_ = ng;
+  }
+
+  //---
+
+  // store rows of each group contiguously (counting sort keeps row order)
+  groupStart_.assign(ng_ + 1, 0);
+
+  for (int r = 0; r < nr_; ++r) {
+    int g = rowGroups_[r];
+
+    if (g >= 0)
+      ++groupStart_[g + 1];
+  }
+
+  for (int g = 0; g < ng_; ++g)
+    groupStart_[g + 1] += groupStart_[g];
+
+  groupRows_.resize(groupStart_[ng_]);
+
+  Codes pos(groupStart_.begin(), groupStart_.end() - 1);
+
+  for (int r = 0; r < nr_; ++r) {
+    int g = rowGroups_[r];
+
+    if (g >= 0)
+      groupRows_[pos[g]++] = r;
+  }
+}
+
+void
+CQGroupBy::
+calcAccums(Accums &accums) const
+{
+  int nv = int(valueCols_.size());
+
+  accums.assign(size_t(ng_)*nv, Accum());
+
+  if (nv == 0)
+    return;
+
+  // accumulate rows [r1, r2) into accums
+  auto accumRows = [&](Accums &accums, int r1, int r2) {
+    for (int r = r1; r < r2; ++r) {
+      int g = rowGroups_[r];
+      if (g < 0) continue;
+
+      auto *accum = &accums[size_t(g)*nv];
+
+      for (int iv = 0; iv < nv; ++iv) {
+        double v = valueCols_[iv][r];
+
+        if (! std::isnan(v))
+          accum[iv].add(v);
+      }
+    }
+  };
+
+  //---
+
+  int numThreads = std::max(int(std::thread::hardware_concurrency()), 1);
+
+  const int minThreadRows = 10000;
+
+  // run serial if few rows or too many groups for per thread partials
+  if (numThreads < 2 || nr_ < minThreadRows || ng_ > nr_/numThreads) {
+    accumRows(accums, 0, nr_);
+    return;
+  }
+
+  // calc per thread partial accums then merge
+  int n = (nr_ + numThreads - 1)/numThreads;
+
+  using ThreadAccums = std::vector<Accums>;
+
+  ThreadAccums threadAccums(numThreads);
+
+  std::vector<std::future<void>> futures;
+
+  int i = 0;
+
+  for (int r1 = 0; r1 < nr_; r1 += n, ++i) {
+    int r2 = std::min(r1 + n, nr_);
+
+    auto &accums1 = threadAccums[i];
+
+    futures.push_back(std::async(std::launch::async, [&, r1, r2]() {
+      accums1.assign(size_t(ng_)*nv, Accum());
+
+      accumRows(accums1, r1, r2);
+    }));
+  }
+
+  for (auto &future : futures)
+    future.wait();
+
+  // merge in row order
+  for (const auto &accums1 : threadAccums) {
+    size_t na = accums1.size();
+
+    for (size_t j = 0; j < na; ++j)
+      accums[j].merge(accums1[j]);
+  }
+}
+
+double
+CQGroupBy::
+calcQuantile(int g, const Aggregate &aggregate, Values &values) const
+{
+  // gather non-missing group values
+  const auto &valueCol = valueCols_[aggregate.column];
+
+  values.clear();
+
+  int n = groupNumRows(g);
+
+  for (int i = 0; i < n; ++i) {
+    double v = valueCol[groupRow(g, i)];
+
+    if (! std::isnan(v))
+      values.push_back(v);
+  }
+
+  int nv = int(values.size());
+
+  if (nv == 0)
+    return NAN;
+
+  // linear interpolation between closest ranks
+  double h = std::min(std::max(aggregate.quantile, 0.0), 1.0)*(nv - 1);
+
+  int i1 = int(std::floor(h));
+
+  std::nth_element(values.begin(), values.begin() + i1, values.end());
+
+  double v1 = values[i1];
+
+  if (i1 >= nv - 1)
+    return v1;
+
+  double v2 = *std::min_element(values.begin() + i1 + 1, values.end());
+
+  return v1 + (h - i1)*(v2 - v1);
+}
@@ -1,5 +1,6 @@
 #include <CQModelVisitor.h>
 #include <CQModelUtil.h>
+#include <algorithm>
 
 void
 CQModelVisitor::
@@ -85,7 +86,10 @@ execIndex(const QAbstractItemModel *model, const QModelIndex &parent, CQModelVis
 
   visitor.setNumRows(nr);
 
-  for (int row = 0; row < nr; ++row) {
+  // top level rows can start at first row (e.g. to visit appended rows)
+  int row1 = (! parent.isValid() ? std::max(visitor.firstRow(), 0) : 0);
+
+  for (int row = row1; row < nr; ++row) {
     CQModelVisitor::State state = execRow(model, parent, row, visitor);
 
     if (state == CQModelVisitor::State::TERMINATE) return state;
@@ -1,4 +1,6 @@
 #include <CQPivotModel.h>
+#include <future>
+#include <thread>
 #include <assert.h>
 
 //------
@@ -29,11 +31,70 @@ void
 CQPivotModel::
 setSourceModel(QAbstractItemModel *sourceModel)
 {
+  connectSlots(false);
+
   sourceModel_ = sourceModel;
 
+  connectSlots(true);
+
   invalidateModel();
 }
 
+void
+CQPivotModel::
+connectSlots(bool b)
+{
+  QAbstractItemModel *model = this->sourceModel();
+  if (! model) return;
+
+  auto connectDisconnect = [&](bool b, const char *from, const char *to) {
+    if (b)
+      connect(model, from, this, to);
+    else
+      disconnect(model, from, this, to);
+  };
+
+  connectDisconnect(b,
+    SIGNAL(dataChanged(const QModelIndex &, const QModelIndex &)), SLOT(sourceChangedSlot()));
+  connectDisconnect(b,
+    SIGNAL(layoutChanged()), SLOT(sourceChangedSlot()));
+  connectDisconnect(b,
+    SIGNAL(modelReset()), SLOT(sourceChangedSlot()));
+
+  connectDisconnect(b,
+    SIGNAL(columnsInserted(const QModelIndex &, int, int)), SLOT(sourceChangedSlot()));
+  connectDisconnect(b,
+    SIGNAL(columnsRemoved(const QModelIndex &, int, int)), SLOT(sourceChangedSlot()));
+
+  connectDisconnect(b,
+    SIGNAL(rowsInserted(const QModelIndex &, int, int)),
+    SLOT(sourceRowsInsertedSlot(const QModelIndex &, int, int)));
+  connectDisconnect(b,
+    SIGNAL(rowsRemoved(const QModelIndex &, int, int)), SLOT(sourceChangedSlot()));
+}
+
+void
+CQPivotModel::
+sourceRowsInsertedSlot(const QModelIndex &parent, int /*first*/, int last)
+{
+  // rows appended to end of source are added to current values on next update
+  if (parent.isValid() || last != sourceModel()->rowCount() - 1)
+    invalidateModel();
+
+  beginResetModel();
+  endResetModel();
+}
+
+void
+CQPivotModel::
+sourceChangedSlot()
+{
+  invalidateModel();
+
+  beginResetModel();
+  endResetModel();
+}
+
 //------
 
 // get number of columns
@@ -134,10 +195,9 @@ data(const QModelIndex &index, int role) const
           return "Totals";
       }
 
-      auto pv = vRowKeys_.find(r);
-      assert(pv != vRowKeys_.end());
+      assert(r >= 0 && r < int(vRowKeys_.size()));
 
-      return (*pv).second.key();
+      return vRowKeys_[r].key();
     }
     else
       return CQBaseModel::data(index, role);
@@ -177,23 +237,14 @@ data(const QModelIndex &index, int role) const
   // grid data
   int c1 = c - 1;
 
-  auto pv = vRowKeys_.find(r);
-  assert(pv != vRowKeys_.end());
-
-  auto ph = hColKeys_.find(c1);
-  assert(ph != hColKeys_.end());
-
-  const Keys &vkeys = (*pv).second;
-  const Keys &hkeys = (*ph).second;
+  assert(r  >= 0 && r  < int(vRowKeys_.size()));
+  assert(c1 >= 0 && c1 < int(hColKeys_.size()));
 
   if (role == Qt::DisplayRole || role == Qt::EditRole || role == Qt::ToolTipRole) {
-    auto p = values_.find(hkeys.key());
+    auto p = values_.find(cellKey(c1, r));
     if (p == values_.end()) return QVariant();
 
-    auto p1 = (*p).second.find(vkeys.key());
-    if (p1 == (*p).second.end()) return QVariant();
-
-    const Values &values = (*p1).second;
+    const Values &values = (*p).second;
 
     if      (values.count() != 0)
       return typeValue(values);
@@ -276,11 +327,10 @@ headerData(int section, Qt::Orientation orientation, int role) const
     // horizontal keys
     int section1 = section - 1;
 
-    auto ph = hColKeys_.find(section1);
-    assert(ph != hColKeys_.end());
+    assert(section1 >= 0 && section1 < int(hColKeys_.size()));
 
     if (role == Qt::DisplayRole || role == Qt::EditRole)
-      return (*ph).second.key();
+      return hColKeys_[section1].key();
     else
       return CQBaseModel::headerData(section, orientation, role);
   }
@@ -344,15 +394,19 @@ bool
 CQPivotModel::
 modelInds(const QString &hkey, const QString &vkey, Inds &inds) const
 {
-  auto p = values_.find(hkey);
+  int c = hkeyCol(hkey);
+  int r = vkeyRow(vkey);
+  if (c < 0 || r < 0) return false;
+
+  auto p = values_.find(cellKey(c, r));
   if (p == values_.end()) return false;
 
-  auto p1 = (*p).second.find(vkey);
-  if (p1 == (*p).second.end()) return false;
+  const Values &values = (*p).second;
 
-  const Values &values = (*p1).second;
+  QAbstractItemModel *sm = sourceModel();
 
-  inds = values.inds();
+  for (const auto &row : values.rows())
+    inds.push_back(sm->index(row, valueColumn_));
 
   return true;
 }
@@ -363,11 +417,18 @@ void
 CQPivotModel::
 updateModel() const
 {
-  if (modelValid_)
+  QAbstractItemModel *sm = sourceModel();
+
+  if (modelValid_ && sm->rowCount() == numRows_)
     return;
 
   //---
 
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  if (modelValid_ && sm->rowCount() == numRows_)
+    return;
+
   CQPivotModel *th = const_cast<CQPivotModel *>(this);
 
   th->updateModel();
@@ -377,19 +438,111 @@ void
 CQPivotModel::
 updateModel()
 {
-  modelValid_ = true;
+  QAbstractItemModel *sm = sourceModel();
+
+  int nr = sm->rowCount();
+
+  // add appended rows to current values if valid, otherwise recalc all
+  if (! modelValid_ || nr < numRows_) {
+    modelValid_ = true;
+    numRows_    = 0;
+
+    hKeysCol_ .clear();
+    hColKeys_ .clear();
+    vKeysRow_ .clear();
+    vRowKeys_ .clear();
+    valueIds_ = StringIds();
+    values_   .clear();
+  }
+
+  addRows(numRows_, nr);
+
+  numRows_ = nr;
+
+  //---
+
+  // calc summary data
+  calcData();
+
+  //---
+
+  // set horizontal header (keys)
+  Keys hkeys;
+
+  for (auto &column : hColumns_) {
+    QString value = sm->headerData(column, Qt::Horizontal).toString();
+
+    hkeys.add(value);
+  }
+
+  hheader_ = hkeys.key();
+
+  //---
+
+  // set vertical header (keys)
+  Keys vkeys;
+
+  for (auto &column : vColumns_) {
+    QString value = sm->headerData(column, Qt::Horizontal).toString();
+
+    vkeys.add(value);
+  }
+
+  vheader_ = vkeys.key();
+}
+
+void
+CQPivotModel::
+addRows(int row1, int row2)
+{
+  if (row2 <= row1)
+    return;
 
-  hKeysCol_.clear();
-  hColKeys_.clear();
-  vKeysRow_.clear();
-  vRowKeys_.clear();
-  values_  .clear();
+  // aggregate row ranges in parallel into partitions (with local key ids) and
+  // merge partitions in row order so key order matches a serial scan
+  int nr = row2 - row1;
 
+  int numThreads = std::max(int(std::thread::hardware_concurrency()), 1);
+
+  const int minThreadRows = 10000;
+
+  if (numThreads > 1 && nr > minThreadRows) {
+    int n = (nr + numThreads - 1)/numThreads;
+
+    std::vector<Partition> partitions((nr + n - 1)/n);
+
+    std::vector<std::future<void>> futures;
+
+    int ip = 0;
+
+    for (int r1 = row1; r1 < row2; r1 += n, ++ip)
+      futures.push_back(std::async(std::launch::async, &CQPivotModel::calcPartition, this,
+                                   std::ref(partitions[ip]), r1, std::min(r1 + n, row2)));
+
+    for (auto &future : futures)
+      future.wait();
+
+    for (const auto &partition : partitions)
+      mergePartition(partition);
+  }
+  else {
+    Partition partition;
+
+    calcPartition(partition, row1, row2);
+
+    mergePartition(partition);
+  }
+}
+
+void
+CQPivotModel::
+calcPartition(Partition &partition, int row1, int row2) const
+{
   QAbstractItemModel *sm = sourceModel();
 
-  int nr = sm->rowCount();
+  bool unique = (valueType() == ValueType::COUNT_UNIQUE);
 
-  for (int row = 0; row < nr; ++row) {
+  for (int row = row1; row < row2; ++row) {
     Keys hkeys;
 
     for (auto &column : hColumns_) {
@@ -416,25 +569,18 @@ updateModel()
 
     //---
 
-    auto ph = hKeysCol_.find(hkeys.key());
+    // dictionary encode keys
+    int hid = partition.hkeyIds.id(hkeys.key());
 
-    if (ph == hKeysCol_.end()) {
-      int col = hKeysCol_.size();
+    if (hid >= int(partition.hkeys.size()))
+      partition.hkeys.push_back(hkeys);
 
-      hKeysCol_[hkeys.key()] = col;
-      hColKeys_[col        ] = hkeys;
-    }
+    int vid = partition.vkeyIds.id(vkeys.key());
 
-    auto pv = vKeysRow_.find(vkeys.key());
+    if (vid >= int(partition.vkeys.size()))
+      partition.vkeys.push_back(vkeys);
 
-    if (pv == vKeysRow_.end()) {
-      int row = vKeysRow_.size();
-
-      vKeysRow_[vkeys.key()] = row;
-      vRowKeys_[row        ] = vkeys;
-    }
-
-    Values &values = values_[hkeys.key()][vkeys.key()];
+    Values &values = partition.cells[cellKey(hid, vid)];
 
     if (valueColumn_ >= 0) {
       QModelIndex ind = sm->index(row, valueColumn_);
@@ -449,122 +595,103 @@ updateModel()
         if (ok)
           values.add(r);
 
-        values.add(ind, data.toString());
+        values.add(row, unique ? partition.valueIds.id(data.toString()) : -1);
       }
     }
     else {
       values.add(1);
     }
   }
-
-  //---
-
-  // calc summary data
-  calcData();
-
-  //---
-
-  // set horizontal header (keys)
-  Keys hkeys;
-
-  for (auto &column : hColumns_) {
-    QString value = sm->headerData(column, Qt::Horizontal).toString();
-
-    hkeys.add(value);
-  }
-
-  hheader_ = hkeys.key();
-
-  //---
-
-  // set vertical header (keys)
-  Keys vkeys;
-
-  for (auto &column : vColumns_) {
-    QString value = sm->headerData(column, Qt::Horizontal).toString();
-
-    vkeys.add(value);
-  }
-
-  vheader_ = vkeys.key();
 }
 
 void
 CQPivotModel::
-calcData()
+mergePartition(const Partition &partition)
 {
-  int nr = vKeysRow_.size();
+  // map partition key ids to model column/row
+  auto mapKeys = [](const IndKeys &keys, KeyInd &keysInd, IndKeys &indKeys) {
+    std::vector<int> keyMap;
 
-  vdata_.resize(nr);
+    for (const auto &key : keys) {
+      auto p = keysInd.find(key.key());
 
-  for (const auto &pv : vKeysRow_) {
-    const QString &vkey = pv.first;
-    int            r    = pv.second;
+      if (p == keysInd.end()) {
+        int ind = int(indKeys.size());
 
-    ValueData data;
+        p = keysInd.insert(p, KeyInd::value_type(key.key(), ind));
 
-    for (const auto &ph : hKeysCol_) {
-      const QString &hkey = ph.first;
+        indKeys.push_back(key);
+      }
 
-      const Values &values = values_[hkey][vkey];
+      keyMap.push_back((*p).second);
+    }
 
-      if      (values.count() != 0) {
-        double value = typeValue(values);
+    return keyMap;
+  };
 
-        data.min  = (data.set ? std::min(data.min, value) : value);
-        data.max  = (data.set ? std::max(data.max, value) : value);
-        data.sum += value;
-        data.set  = true;
-      }
-      else if (values.rcount()) {
-        data.min  = 0;
-        data.max  = 1;
-        data.sum += values.rcount();
-        data.set  = true;
-      }
-    }
+  auto hKeyMap = mapKeys(partition.hkeys, hKeysCol_, hColKeys_);
+  auto vKeyMap = mapKeys(partition.vkeys, vKeysRow_, vRowKeys_);
 
-    assert(r >= 0 && r < nr);
+  // map partition string value ids to model ids
+  std::vector<int> sidMap;
 
-    vdata_[r] = data;
-  }
+  for (const auto &str : partition.valueIds.strs)
+    sidMap.push_back(valueIds_.id(str));
 
   //---
 
-  int nc = hKeysCol_.size();
-
-  hdata_.resize(nc);
+  for (const auto &pc : partition.cells) {
+    int c = hKeyMap[cellCol(pc.first)];
+    int r = vKeyMap[cellRow(pc.first)];
 
-  for (const auto &ph : hKeysCol_) {
-    const QString &hkey = ph.first;
-    int            c    = ph.second;
+    values_[cellKey(c, r)].add(pc.second, sidMap);
+  }
+}
 
-    ValueData data;
+void
+CQPivotModel::
+calcData()
+{
+  int nr = vRowKeys_.size();
+  int nc = hColKeys_.size();
+
+  vdata_.clear(); vdata_.resize(nr);
+  hdata_.clear(); hdata_.resize(nc);
+
+  auto addValue = [](ValueData &data, double value) {
+    data.min  = (data.set ? std::min(data.min, value) : value);
+    data.max  = (data.set ? std::max(data.max, value) : value);
+    data.sum += value;
+    data.set  = true;
+  };
+
+  auto addCount = [](ValueData &data, int count) {
+    data.min  = 0;
+    data.max  = 1;
+    data.sum += count;
+    data.set  = true;
+  };
+
+  // single pass over set cells to update row and column data
+  for (const auto &pc : values_) {
+    int c = cellCol(pc.first);
+    int r = cellRow(pc.first);
 
-    for (const auto &pv : vKeysRow_) {
-      const QString &vkey = pv.first;
+    assert(r >= 0 && r < nr);
+    assert(c >= 0 && c < nc);
 
-      const Values &values = values_[hkey][vkey];
+    const Values &values = pc.second;
 
-      if      (values.count() != 0) {
-        double value = typeValue(values);
+    if      (values.count() != 0) {
+      double value = typeValue(values);
 
-        data.min = (data.set ? std::min(data.min, value) : value);
-        data.max = (data.set ? std::max(data.max, value) : value);
-        data.sum = value;
-        data.set = true;
-      }
-      else if (values.rcount()) {
-        data.min  = 0;
-        data.max  = 1;
-        data.sum += values.rcount();
-        data.set  = true;
-      }
+      addValue(vdata_[r], value);
+      addValue(hdata_[c], value);
+    }
+    else if (values.rcount()) {
+      addCount(vdata_[r], values.rcount());
+      addCount(hdata_[c], values.rcount());
     }
-
-    assert(c >= 0 && c < nc);
-
-    hdata_[c] = data;
   }
 
   //---
@@ -574,7 +701,7 @@ calcData()
   for (const auto &d : vdata_) {
     data_.min  = (data_.set ? std::min(data_.min, d.min) : d.min);
     data_.max  = (data_.set ? std::max(data_.max, d.max) : d.max);
-    data_.sum  = d.sum;
+    data_.sum += d.sum;
     data_.set  = true;
   }
 }
@@ -614,8 +741,8 @@ hkeys(bool sorted) const
       strs << ph.first;
   }
   else {
-    for (const auto &ph : hColKeys_)
-      strs << ph.second.key();
+    for (const auto &keys : hColKeys_)
+      strs << keys.key();
   }
 
   return strs;
@@ -634,8 +761,8 @@ vkeys(bool sorted) const
       strs << ph.first;
   }
   else {
-    for (const auto &ph : vRowKeys_)
-      strs << ph.second.key();
+    for (const auto &keys : vRowKeys_)
+      strs << keys.key();
   }
 
   return strs;
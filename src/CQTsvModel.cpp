@@ -1,4 +1,5 @@
 #include <CQTsvModel.h>
+#include <CQCsvParser.h>
 #include <CTsv.h>
 
 CQTsvModel::
@@ -18,6 +19,9 @@ load(const QString &filename)
 {
   filename_ = filename;
 
+  if (isMapped() || isProgressive() || isTail())
+    return loadMapped();
+
   //---
 
   // parse file into array of fields
@@ -101,13 +105,13 @@ load(const QString &filename)
     if (isFirstColumnHeader())
       vheader_.push_back(vheader);
 
-    data_.push_back(cells);
+    addRow(cells);
   }
 
   //---
 
   // expand vertical header to max number of rows
-  int numRows = data_.size();
+  int numRows = numDataRows();
 
   while (int(vheader_.size()) < numRows)
     vheader_.push_back("");
@@ -123,6 +127,71 @@ load(const QString &filename)
   // clear column types
   resetColumnTypes();
 
+  //---
+
+  // pack columns into typed storage
+  if (isColumnar())
+    packColumns();
+
+  return true;
+}
+
+int
+CQTsvModel::
+loadTail()
+{
+  // parse rows appended to file since last load
+  std::unique_ptr<CQCsvParser> parser(createParser());
+
+  return loadParserTail(*parser);
+}
+
+CQCsvParser *
+CQTsvModel::
+createParser() const
+{
+  // tab separated, no quotes or meta data
+  auto *parser = new CQCsvParser(filename_);
+
+  parser->setCommentHeader  (isCommentHeader());
+  parser->setFirstLineHeader(isFirstLineHeader());
+  parser->setSeparator      ('\t');
+  parser->setQuoted         (false);
+  parser->setAllowMeta      (false);
+
+  return parser;
+}
+
+bool
+CQTsvModel::
+loadMapped()
+{
+  // map file and find records
+  auto *parser = createParser();
+
+  // only load complete lines if file is being appended to
+  if (isTail())
+    parser->setCompleteRecords(true);
+
+  // load rows in batches after first batch
+  if (isProgressive())
+    return startParserLoad(parser, isFirstColumnHeader(), -1, columns_);
+
+  std::unique_ptr<CQCsvParser> parserP(parser);
+
+  if (! parser->load())
+    return false;
+
+  //---
+
+  // split records into model rows (applying columns)
+  loadParserRows(*parser, isFirstColumnHeader(), -1, columns_);
+
+  //---
+
+  // clear column types and pack columns
+  finishParserLoad(*parser);
+
   return true;
 }
 
@@ -235,7 +304,8 @@ encodeVariant(const QVariant &var) const
   if      (var.type() == QVariant::Double) {
     double r = var.value<double>();
 
-    str = std::to_string(r);
+    // save without loss of precision (so reload gives same value)
+    str = CQDataColumn::realToString(r).toStdString();
   }
   else if (var.type() == QVariant::Int) {
     int i = var.value<int>();
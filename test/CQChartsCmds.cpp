@@ -277,6 +277,10 @@ loadChartsModelCmd(CQChartsCmdArgs &argv)
 
   argv.addCmdArg("-num_rows"   , CQChartsCmdArg::Type::Integer, "number of expression rows");
   argv.addCmdArg("-max_rows"   , CQChartsCmdArg::Type::Integer, "maximum number of file rows");
+  argv.addCmdArg("-columnar"   , CQChartsCmdArg::Type::Boolean, "store data in typed columns");
+  argv.addCmdArg("-mapped"     , CQChartsCmdArg::Type::Boolean, "memory map and parse in parallel");
+  argv.addCmdArg("-progressive", CQChartsCmdArg::Type::Boolean, "load file rows in batches");
+  argv.addCmdArg("-tail"       , CQChartsCmdArg::Type::Boolean, "only load appended rows on change");
   argv.addCmdArg("-filter"     , CQChartsCmdArg::Type::String , "filter expression");
   argv.addCmdArg("-filter_type", CQChartsCmdArg::Type::String , "filter expression type");
   argv.addCmdArg("-column_type", CQChartsCmdArg::Type::String , "column type");
@@ -352,6 +356,11 @@ loadChartsModelCmd(CQChartsCmdArgs &argv)
   if (argv.hasParseArg("max_rows"))
     inputData.maxRows = std::max(argv.getParseInt("max_rows"), 1);
 
+  inputData.columnar    = argv.getParseBool("columnar");
+  inputData.mapped      = argv.getParseBool("mapped");
+  inputData.progressive = argv.getParseBool("progressive");
+  inputData.tail        = argv.getParseBool("tail");
+
   inputData.filter = argv.getParseStr("filter");
 
   if (argv.hasParseArg("filter_type")) {
@@ -2893,6 +2902,7 @@ joinChartsModelCmd(CQChartsCmdArgs &argv)
 
   argv.addCmdArg("-models" , CQChartsCmdArg::Type::String, "model ids");
   argv.addCmdArg("-columns", CQChartsCmdArg::Type::String, "columns");
+  argv.addCmdArg("-type"   , CQChartsCmdArg::Type::String, "join type (inner, left, outer)");
 
   bool rc;
 
@@ -2901,6 +2911,29 @@ joinChartsModelCmd(CQChartsCmdArgs &argv)
 
   //---
 
+  // get join type
+  auto joinType = CQChartsModelData::JoinType::LEFT;
+
+  if (argv.hasParseArg("type")) {
+    auto type = argv.getParseStr("type");
+
+    if      (type == "inner")
+      joinType = CQChartsModelData::JoinType::INNER;
+    else if (type == "left")
+      joinType = CQChartsModelData::JoinType::LEFT;
+    else if (type == "outer")
+      joinType = CQChartsModelData::JoinType::OUTER;
+    else if (type == "?") {
+      QStringList names = QStringList() << "inner" << "left" << "outer";
+
+      return cmdBase_->setCmdRc(names);
+    }
+    else
+      return errorMsg(QString("Invalid join type '%1'").arg(type));
+  }
+
+  //---
+
   // split into strings per model
   auto modelsStr = argv.getParseStr("models");
 
@@ -2958,7 +2991,7 @@ joinChartsModelCmd(CQChartsCmdArgs &argv)
 
   //---
 
-  auto *newModel = modelDatas[0]->join(modelDatas[1], columns);
+  auto *newModel = modelDatas[0]->join(modelDatas[1], columns, joinType);
 
   if (! newModel)
     return errorMsg("Join failed");
@@ -2988,8 +3021,11 @@ groupChartsModelCmd(CQChartsCmdArgs &argv)
 
   CQPerfTrace trace("CQChartsCmds::groupChartsModelCmd");
 
-  argv.addCmdArg("-model"  , CQChartsCmdArg::Type::String, "model id");
-  argv.addCmdArg("-columns", CQChartsCmdArg::Type::String, "columns");
+  argv.addCmdArg("-model"    , CQChartsCmdArg::Type::String, "model id");
+  argv.addCmdArg("-columns"  , CQChartsCmdArg::Type::String, "columns");
+  argv.addCmdArg("-by"       , CQChartsCmdArg::Type::String, "group by columns");
+  argv.addCmdArg("-aggregate", CQChartsCmdArg::Type::String,
+                 "group by aggregates ({type [column] [quantile]} ...)");
 
   bool rc;
 
@@ -3008,29 +3044,100 @@ groupChartsModelCmd(CQChartsCmdArgs &argv)
 
   //---
 
-  auto columnsStr = argv.getParseStr("columns");
+  auto stringToColumns = [&](const QString &columnsStr, CQChartsModelData::Columns &columns) {
+    QStringList columnStrs;
 
-  QStringList columnStrs;
+    if (! CQTcl::splitList(columnsStr, columnStrs))
+      return errorMsg(QString("Invalid columns string '%1'").arg(columnsStr));
 
-  if (! CQTcl::splitList(columnsStr, columnStrs))
-    return errorMsg(QString("Invalid columns string '%1'").arg(columnsStr));
+    for (const auto &columnStr : columnStrs) {
+      CQChartsColumn column;
 
-  CQChartsModelData::Columns columns;
+      if (! CQChartsModelUtil::stringToColumn(model.data(), columnStr, column)) {
+        (void) errorMsg("Bad column '" + columnStr + "'");
+        continue;
+      }
 
-  for (const auto &columnStr : columnStrs) {
-    CQChartsColumn column;
+      columns.push_back(column);
+    }
 
-    if (! CQChartsModelUtil::stringToColumn(model.data(), columnStr, column)) {
-      (void) errorMsg("Bad column '" + columnStr + "'");
-      continue;
+    return true;
+  };
+
+  //---
+
+  QAbstractItemModel *newModel = nullptr;
+
+  if (argv.hasParseArg("by")) {
+    // group by columns with aggregates
+    CQChartsModelData::Columns columns;
+
+    if (! stringToColumns(argv.getParseStr("by"), columns))
+      return false;
+
+    CQChartsModelData::GroupAggregates aggregates;
+
+    auto aggregatesStr = argv.getParseStr("aggregate", "count");
+
+    QStringList aggregateStrs;
+
+    if (! CQTcl::splitList(aggregatesStr, aggregateStrs))
+      return errorMsg(QString("Invalid aggregates string '%1'").arg(aggregatesStr));
+
+    for (const auto &aggregateStr : aggregateStrs) {
+      QStringList strs;
+
+      if (! CQTcl::splitList(aggregateStr, strs) || strs.empty())
+        return errorMsg(QString("Invalid aggregate string '%1'").arg(aggregateStr));
+
+      CQChartsModelData::GroupAggregate aggregate;
+
+      const auto &type = strs[0];
+
+      if      (type == "count"   ) aggregate.type = CQGroupBy::AggType::COUNT;
+      else if (type == "sum"     ) aggregate.type = CQGroupBy::AggType::SUM;
+      else if (type == "mean"    ) aggregate.type = CQGroupBy::AggType::MEAN;
+      else if (type == "min"     ) aggregate.type = CQGroupBy::AggType::MIN;
+      else if (type == "max"     ) aggregate.type = CQGroupBy::AggType::MAX;
+      else if (type == "median"  ) aggregate.type = CQGroupBy::AggType::QUANTILE;
+      else if (type == "quantile") aggregate.type = CQGroupBy::AggType::QUANTILE;
+      else
+        return errorMsg(QString("Invalid aggregate type '%1'").arg(type));
+
+      if (strs.length() > 1) {
+        if (! CQChartsModelUtil::stringToColumn(model.data(), strs[1], aggregate.column))
+          return errorMsg("Bad column '" + strs[1] + "'");
+      }
+      else if (aggregate.type != CQGroupBy::AggType::COUNT)
+        return errorMsg(QString("Missing column for aggregate '%1'").arg(type));
+
+      // only quantile has an extra (quantile) value
+      if (strs.length() > 2 && (type != "quantile" || strs.length() > 3))
+        return errorMsg(QString("Too many values for aggregate '%1'").arg(type));
+
+      if (strs.length() > 2) {
+        bool ok;
+
+        aggregate.quantile = CQChartsUtil::toReal(strs[2], ok);
+
+        if (! ok || aggregate.quantile < 0.0 || aggregate.quantile > 1.0)
+          return errorMsg(QString("Invalid quantile '%1'").arg(strs[2]));
+      }
+
+      aggregates.push_back(aggregate);
     }
 
-    columns.push_back(column);
+    newModel = modelData->groupBy(columns, aggregates);
   }
+  else {
+    // group columns into group name and value columns
+    CQChartsModelData::Columns columns;
 
-  //---
+    if (! stringToColumns(argv.getParseStr("columns"), columns))
+      return false;
 
-  auto *newModel = modelData->groupColumns(columns);
+    newModel = modelData->groupColumns(columns);
+  }
 
   if (! newModel)
     return errorMsg("Grouping failed");
@@ -3476,6 +3583,7 @@ createChartsCorrelationModelCmd(CQChartsCmdArgs &argv)
 
   argv.addCmdArg("-model", CQChartsCmdArg::Type::Integer, "model id");
   argv.addCmdArg("-flip" , CQChartsCmdArg::Type::Boolean, "correlate rows instead of columns");
+  argv.addCmdArg("-type" , CQChartsCmdArg::Type::String , "correlation type (pearson, spearman)");
 
   bool rc;
 
@@ -3487,6 +3595,25 @@ createChartsCorrelationModelCmd(CQChartsCmdArgs &argv)
   int  modelInd = argv.getParseInt ("model", -1);
   bool flip     = argv.getParseBool("flip");
 
+  // get correlation type
+  auto correlationType = CQChartsLoader::CorrelationType::PEARSON;
+
+  if (argv.hasParseArg("type")) {
+    auto type = argv.getParseStr("type");
+
+    if      (type == "pearson")
+      correlationType = CQChartsLoader::CorrelationType::PEARSON;
+    else if (type == "spearman")
+      correlationType = CQChartsLoader::CorrelationType::SPEARMAN;
+    else if (type == "?") {
+      QStringList names = QStringList() << "pearson" << "spearman";
+
+      return cmdBase_->setCmdRc(names);
+    }
+    else
+      return errorMsg(QString("Invalid correlation type '%1'").arg(type));
+  }
+
   //------
 
   // get model
@@ -3498,7 +3625,7 @@ createChartsCorrelationModelCmd(CQChartsCmdArgs &argv)
   CQChartsLoader loader(charts_);
 
   QAbstractItemModel *correlationModel =
-    loader.createCorrelationModel(modelData->currentModel().data(), flip);
+    loader.createCorrelationModel(modelData->currentModel().data(), flip, correlationType);
 
   ModelP correlationModelP(correlationModel);
 
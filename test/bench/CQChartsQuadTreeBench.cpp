@@ -0,0 +1,197 @@
+// Micro-benchmark comparing CQChartsQuadTree (pointer tree) and CQChartsFlatQuadTree
+// (flat storage) for the plot object tree queries (point, rect and nearest)
+//
+// Usage: CQChartsQuadTreeBench [num_objects] [num_queries]
+
+#include <CQChartsQuadTree.h>
+#include <CQChartsFlatQuadTree.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+// minimal rect (as CQChartsGeom::BBox)
+class Rect {
+ public:
+  Rect() = default;
+
+  Rect(double x1, double y1, double x2, double y2) :
+   xmin_(std::min(x1, x2)), ymin_(std::min(y1, y2)),
+   xmax_(std::max(x1, x2)), ymax_(std::max(y1, y2)), set_(true) {
+  }
+
+  bool isSet() const { return set_; }
+
+  double getXMin() const { return xmin_; }
+  double getYMin() const { return ymin_; }
+  double getXMax() const { return xmax_; }
+  double getYMax() const { return ymax_; }
+
+  double distanceTo(double x, double y) const {
+    double dx = std::max(std::max(xmin_ - x, x - xmax_), 0.0);
+    double dy = std::max(std::max(ymin_ - y, y - ymax_), 0.0);
+
+    return std::hypot(dx, dy);
+  }
+
+ private:
+  double xmin_ { 0.0 }, ymin_ { 0.0 }, xmax_ { 0.0 }, ymax_ { 0.0 };
+  bool   set_  { false };
+};
+
+// plot object (heap allocated as plot objects are)
+class Obj {
+ public:
+  Obj(const Rect &rect) : rect_(rect) { }
+
+  const Rect &rect() const { return rect_; }
+
+ private:
+  Rect rect_;
+  char data_[256]; // typical plot object payload
+};
+
+using Objs = std::vector<Obj *>;
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed(const Clock::time_point &t1) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - t1).count();
+}
+
+struct Query {
+  double x, y; // point
+  Rect   rect; // search rect
+};
+
+struct Result {
+  double build   { 0.0 };
+  double point   { 0.0 };
+  double rect    { 0.0 };
+  double nearest { 0.0 };
+  size_t count   { 0 };
+};
+
+template<typename TREE>
+Result runTree(const Objs &objs, const std::vector<Query> &queries) {
+  Result res;
+
+  auto t1 = Clock::now();
+
+  TREE tree(Rect(0, 0, 1000, 1000));
+
+  for (const auto &obj : objs)
+    tree.add(obj);
+
+  res.build = elapsed(t1);
+
+  typename TREE::DataList dataList;
+
+  // objects at point (mouse over)
+  t1 = Clock::now();
+
+  for (const auto &q : queries) {
+    tree.dataAtPoint(q.x, q.y, dataList);
+
+    res.count += dataList.size();
+  }
+
+  res.point = elapsed(t1);
+
+  // objects touching rect (rubber band select)
+  t1 = Clock::now();
+
+  for (const auto &q : queries) {
+    tree.dataTouchingRect(q.rect, dataList);
+
+    res.count += dataList.size();
+  }
+
+  res.rect = elapsed(t1);
+
+  // nearest object (as CQChartsPlotObjTree::objectNearest)
+  t1 = Clock::now();
+
+  for (const auto &q : queries) {
+    Rect r(q.x - 2, q.y - 2, q.x + 2, q.y + 2);
+
+    tree.dataTouchingRect(r, dataList);
+
+    const Obj *nearest = nullptr;
+    double     d       = 0.0;
+
+    for (const auto &obj : dataList) {
+      double d1 = obj->rect().distanceTo(q.x, q.y);
+
+      if (! nearest || d1 < d) {
+        nearest = obj;
+        d       = d1;
+      }
+    }
+
+    res.count += (nearest ? 1 : 0);
+  }
+
+  res.nearest = elapsed(t1);
+
+  return res;
+}
+
+void printResult(const char *name, const Result &res) {
+  std::cout << name << ": build " << res.build << "ms, point " << res.point <<
+               "ms, rect " << res.rect << "ms, nearest " << res.nearest <<
+               "ms (" << res.count << " hits)\n";
+}
+
+}
+
+int
+main(int argc, char **argv)
+{
+  int numObjs    = (argc > 1 ? std::atoi(argv[1]) : 200000);
+  int numQueries = (argc > 2 ? std::atoi(argv[2]) : 100000);
+
+  std::mt19937 gen(1234);
+
+  std::uniform_real_distribution<double> pos (0.0, 1000.0);
+  std::uniform_real_distribution<double> size(0.1, 4.0);
+
+  Objs objs;
+
+  objs.reserve(numObjs);
+
+  for (int i = 0; i < numObjs; ++i) {
+    double x = pos(gen), y = pos(gen);
+
+    objs.push_back(new Obj(Rect(x, y, x + size(gen), y + size(gen))));
+  }
+
+  std::vector<Query> queries;
+
+  queries.reserve(numQueries);
+
+  for (int i = 0; i < numQueries; ++i) {
+    double x = pos(gen), y = pos(gen);
+
+    queries.push_back(Query{x, y, Rect(x, y, x + 10, y + 10)});
+  }
+
+  std::cout << numObjs << " objects, " << numQueries << " queries\n";
+
+  auto res1 = runTree<CQChartsQuadTree    <Obj, Rect>>(objs, queries);
+  auto res2 = runTree<CQChartsFlatQuadTree<Obj, Rect>>(objs, queries);
+
+  printResult("CQChartsQuadTree    ", res1);
+  printResult("CQChartsFlatQuadTree", res2);
+
+  for (auto &obj : objs)
+    delete obj;
+
+  // both trees must find the same objects
+  return (res1.count == res2.count ? 0 : 1);
+}
@@ -0,0 +1,18 @@
+TEMPLATE = app
+
+TARGET = CQChartsQuadTreeBench
+
+CONFIG += console
+CONFIG -= qt
+
+QMAKE_CXXFLAGS += \
+-std=c++14 \
+
+SOURCES += \
+CQChartsQuadTreeBench.cpp \
+
+INCLUDEPATH += \
+../../include \
+.
+
+DESTDIR = ../../bin